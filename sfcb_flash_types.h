@@ -47,9 +47,16 @@
     #define SFCB_FLASH_IST_WR_DSBL          0x04        /**<  Instruction Write disable             W25Q16JV_Rev_H: p.23, Write Disable (04h)                       */
     #define SFCB_FLASH_IST_ERASE_BULK       0xc7        /**<  Instruction Chip Erase                W25Q16JV_Rev_H: p.38, Chip Erase (C7h / 60h)                    */
     #define SFCB_FLASH_IST_ERASE_SECTOR     0x20        /**<  Instruction Sector Erase              W25Q16JV_Rev_H: p.35, Sector Erase (20h)                        */
+    #define SFCB_FLASH_IST_ERASE_BLK32      0x52        /**<  Instruction 32KB Block Erase          W25Q16JV_Rev_H: p.36, 32KB Block Erase (52h)                    */
+    #define SFCB_FLASH_IST_ERASE_BLK64      0xd8        /**<  Instruction 64KB Block Erase          W25Q16JV_Rev_H: p.37, 64KB Block Erase (D8h)                    */
     #define SFCB_FLASH_IST_RD_STATE_REG     0x05        /**<  Instruction Read Status Register      W25Q16JV_Rev_H: p.23, Read Status Register-1 (05h)              */
     #define SFCB_FLASH_IST_RD_DATA          0x03        /**<  Instruction Read Data                 W25Q16JV_Rev_H: p.26, Read Data, Single SPI Mode (03h)          */
     #define SFCB_FLASH_IST_WR_PAGE          0x02        /**<  Instruction Write Page                W25Q16JV_Rev_H: p.33, Page Program (02h)                        */
+    #define SFCB_FLASH_IST_WR_PAGE_QUAD     0x32        /**<  Instruction Quad Write Page           W25Q16JV_Rev_H: p.34, Quad Input Page Program (32h)             */
+    #define SFCB_FLASH_IST_RD_STATE_REG2    0x35        /**<  Instruction Read Status Register 2    W25Q16JV_Rev_H: p.23, Read Status Register-2 (35h)              */
+    #define SFCB_FLASH_IST_WR_STATE_REG2    0x31        /**<  Instruction Write Status Register 2   W25Q16JV_Rev_H: p.24, Write Status Register-2 (31h)             */
+    #define SFCB_FLASH_IST_PWR_DOWN         0xb9        /**<  Instruction Deep Power-down           W25Q16JV_Rev_H: Power-down (B9h)                                */
+    #define SFCB_FLASH_IST_PWR_UP           0xab        /**<  Instruction Release Power-down        W25Q16JV_Rev_H: Release Power-down / Device ID (ABh)           */
     #define SFCB_FLASH_TOPO_ADR_BYTE        3           /**<  Topology Number address bytes         W25Q16JV_Rev_H: p.26, Read Data                                 */
     #define SFCB_FLASH_TOPO_SECTOR_SIZE     4096        /**<  Topology Sector Size in bytes         W25Q16JV_Rev_H: p.35, Sector Erase (20h)
                                                                 #SFCB_FLASH_IST_ERASE_SECTOR                                                                        */
@@ -60,6 +67,95 @@
                                                                 #SFCB_FLASH_IST_RDID                                                                                */
     #define SFCB_FLASH_MNG_WIP_MSK          0x01        /**<  MGMT: write-in-progress               W25Q16JV_Rev_H: p.11, Erase/Write In Progress (BUSY) - RO       */
     #define SFCB_FLASH_MNG_WRENA_MSK        0x02        /**<  MGMT: write enable                    W25Q16JV_Rev_H: p.11, Write Enable Latch (WEL) - RO             */
+    #define SFCB_FLASH_MNG_QE_MSK           0x02        /**<  MGMT: quad enable                     W25Q16JV_Rev_H: p.16, Quad Enable (QE), Status Register-2       */
+
+#elif defined(W25N01GV)
+    /* @brief W25N01GV
+    *
+    *  Winbond SPI NAND Flash W25N01GV, 128MByte
+    *    sector:     erase unit is the 128KiB block
+    *    address:    linear byte address, translated by the NAND layer into page/column address
+    *    bad blocks: skipped via #sfcb_nand_bbt
+    *    program:    collected in page buffer, one program execute per page and element
+    *    ECC:        internal ECC stays enabled (ECC-E=1 default), every ECC sector is programmed once
+    *
+    *  @see https://www.winbond.com/resource-files/w25n01gv%20revl%20050918%20unsecured.pdf
+    *
+    */
+    #define SFCB_FLASH_TYPE_NAND                        /**<  Flash is NAND, enables page cache read, program load/execute and bad block skipping                    */
+    #define SFCB_FLASH_NAME                 "W25N01GV"  /**<  Flash name                                                                                            */
+    #define SFCB_FLASH_ID_HEX               "efaa21"    /**<  HexID as asccii-hex                   W25N01GV_Rev_L: p.27, JEDEC ID (9Fh)                            */
+    #define SFCB_FLASH_IST_RDID             0x9f        /**<  Instruction Read ID                   W25N01GV_Rev_L: p.27, JEDEC ID (9Fh)                            */
+    #define SFCB_FLASH_IST_WR_ENA           0x06        /**<  Instruction Write enable              W25N01GV_Rev_L: p.24, Write Enable (06h)                        */
+    #define SFCB_FLASH_IST_WR_DSBL          0x04        /**<  Instruction Write disable             W25N01GV_Rev_L: p.24, Write Disable (04h)                       */
+    #define SFCB_FLASH_IST_ERASE_BULK       0x0         /**<  Instruction Chip Erase                not available                                                   */
+    #define SFCB_FLASH_IST_ERASE_SECTOR     0xd8        /**<  Instruction Sector Erase              W25N01GV_Rev_L: p.33, 128KB Block Erase (D8h)                   */
+    #define SFCB_FLASH_IST_ERASE_BLK32      0x0         /**<  Instruction 32KB Block Erase          not available                                                   */
+    #define SFCB_FLASH_IST_ERASE_BLK64      0x0         /**<  Instruction 64KB Block Erase          not available                                                   */
+    #define SFCB_FLASH_IST_RD_STATE_REG     0x0f        /**<  Instruction Read Status Register      W25N01GV_Rev_L: p.25, Read Status Register (0Fh / 05h)          */
+    #define SFCB_FLASH_IST_RD_DATA          0x03        /**<  Instruction Read Data                 W25N01GV_Rev_L: p.39, Read Data (03h), from data buffer         */
+    #define SFCB_FLASH_IST_WR_PAGE          0x02        /**<  Instruction Write Page                W25N01GV_Rev_L: p.34, Load Program Data (02h), into data buffer */
+    #define SFCB_FLASH_IST_NAND_PAGE_RD     0x13        /**<  Instruction Page Data Read            W25N01GV_Rev_L: p.38, Page Data Read (13h), array to buffer     */
+    #define SFCB_FLASH_IST_NAND_PRG_EXE     0x10        /**<  Instruction Program Execute           W25N01GV_Rev_L: p.36, Program Execute (10h), buffer to array    */
+    #define SFCB_FLASH_IST_NAND_PRG_RND     0x84        /**<  Instruction Random Load Program Data  W25N01GV_Rev_L: p.35, Random Load Program Data (84h), keeps buffer */
+    #define SFCB_FLASH_IST_WR_PAGE_QUAD     0x0         /**<  Instruction Quad Write Page           not supported by NAND layer                                     */
+    #define SFCB_FLASH_IST_RD_STATE_REG2    0x0         /**<  Instruction Read Status Register 2    not available                                                   */
+    #define SFCB_FLASH_IST_WR_STATE_REG2    0x0         /**<  Instruction Write Status Register 2   not available                                                   */
+    #define SFCB_FLASH_IST_PWR_DOWN         0x0         /**<  Instruction Deep Power-down           not available                                                   */
+    #define SFCB_FLASH_IST_PWR_UP           0x0         /**<  Instruction Release Power-down        not available                                                   */
+    #define SFCB_FLASH_TOPO_ADR_BYTE        4           /**<  Topology Number address bytes         linear byte address, see NAND layer                             */
+    #define SFCB_FLASH_TOPO_SECTOR_SIZE     131072      /**<  Topology Sector Size in bytes         W25N01GV_Rev_L: p.33, 128KB Block Erase (D8h)
+                                                                #SFCB_FLASH_IST_ERASE_SECTOR                                                                        */
+    #define SFCB_FLASH_TOPO_PAGE_SIZE       2048        /**<  Topology Page Size in bytes           W25N01GV_Rev_L: p.34, Load Program Data (02h)
+                                                                #SFCB_FLASH_IST_WR_PAGE                                                                             */
+    #define SFCB_FLASH_TOPO_FLASH_SIZE      134217728   /**<  Topology Total flash size in bytes    W25N01GV_Rev_L: p.8, 1024 blocks                                */
+    #define SFCB_FLASH_TOPO_RDID_DUMMY      1           /**<  Topology Number of dummy bytes        W25N01GV_Rev_L: p.27, JEDEC ID (9Fh)
+                                                                #SFCB_FLASH_IST_RDID                                                                                */
+    #define SFCB_FLASH_TOPO_NAND_SR_ADR     0xc0        /**<  Topology Status Register address      W25N01GV_Rev_L: p.18, Status Register-3 (SR3)                  */
+    #define SFCB_FLASH_TOPO_NAND_RD_DUMMY   1           /**<  Topology Number of dummy bytes        W25N01GV_Rev_L: p.39, Read Data (03h)                           */
+    #define SFCB_FLASH_MNG_WIP_MSK          0x01        /**<  MGMT: write-in-progress               W25N01GV_Rev_L: p.20, Operation In Progress (BUSY) - RO         */
+    #define SFCB_FLASH_MNG_WRENA_MSK        0x02        /**<  MGMT: write enable                    W25N01GV_Rev_L: p.20, Write Enable Latch (WEL) - RO             */
+    #define SFCB_FLASH_MNG_QE_MSK           0x00        /**<  MGMT: quad enable                     not available                                                   */
+
+#elif defined(FM25V20A)
+    /* @brief FM25V20A
+    *
+    *  Cypress/Infineon SPI F-RAM FM25V20A, 256KByte
+    *    erase:  not required, oldest element is overwritten with 0xFF
+    *    busy:   no write cycle time, status register polling is skipped
+    *    page:   no page boundaries, used as transfer unit
+    *    sector: queue allocation unit
+    *
+    *  @see https://www.infineon.com/dgdl/Infineon-FM25V20A_2-Mbit_(256K_8)_Serial_(SPI)_F-RAM-DataSheet-v12_00-EN.pdf
+    *
+    */
+    #define SFCB_FLASH_TYPE_NOERASE                     /**<  Memory is erase-less and busy-free, f. e. FRAM/MRAM. Byte granular queue elements                      */
+    #define SFCB_FLASH_NAME                 "FM25V20A"  /**<  Flash name                                                                                            */
+    #define SFCB_FLASH_ID_HEX               "7f7f7f7f7f7fc22508"    /**<  HexID as asccii-hex       FM25V20A_Rev_L: p.9, Read Device ID                             */
+    #define SFCB_FLASH_IST_RDID             0x9f        /**<  Instruction Read ID                   FM25V20A_Rev_L: p.9, Read Device ID (9Fh)                       */
+    #define SFCB_FLASH_IST_WR_ENA           0x06        /**<  Instruction Write enable              FM25V20A_Rev_L: p.6, WREN - Set Write Enable Latch (06h)        */
+    #define SFCB_FLASH_IST_WR_DSBL          0x04        /**<  Instruction Write disable             FM25V20A_Rev_L: p.6, WRDI - Reset Write Enable Latch (04h)      */
+    #define SFCB_FLASH_IST_ERASE_BULK       0x0         /**<  Instruction Chip Erase                not available                                                   */
+    #define SFCB_FLASH_IST_ERASE_SECTOR     0x0         /**<  Instruction Sector Erase              not available                                                   */
+    #define SFCB_FLASH_IST_ERASE_BLK32      0x0         /**<  Instruction 32KB Block Erase          not available                                                   */
+    #define SFCB_FLASH_IST_ERASE_BLK64      0x0         /**<  Instruction 64KB Block Erase          not available                                                   */
+    #define SFCB_FLASH_IST_RD_STATE_REG     0x05        /**<  Instruction Read Status Register      FM25V20A_Rev_L: p.7, RDSR - Read Status Register (05h)          */
+    #define SFCB_FLASH_IST_RD_DATA          0x03        /**<  Instruction Read Data                 FM25V20A_Rev_L: p.8, READ - Read Memory Data (03h)              */
+    #define SFCB_FLASH_IST_WR_PAGE          0x02        /**<  Instruction Write Page                FM25V20A_Rev_L: p.8, WRITE - Write Memory Data (02h)            */
+    #define SFCB_FLASH_IST_WR_PAGE_QUAD     0x0         /**<  Instruction Quad Write Page           not available                                                   */
+    #define SFCB_FLASH_IST_RD_STATE_REG2    0x0         /**<  Instruction Read Status Register 2    not available                                                   */
+    #define SFCB_FLASH_IST_WR_STATE_REG2    0x0         /**<  Instruction Write Status Register 2   not available                                                   */
+    #define SFCB_FLASH_IST_PWR_DOWN         0xb9        /**<  Instruction Deep Power-down           FM25V20A_Rev_L: SLEEP - Enter Sleep Mode (B9h)                  */
+    #define SFCB_FLASH_IST_PWR_UP           0xab        /**<  Instruction Release Power-down        FM25V20A_Rev_L: wake-up with chip select, opcode is ignored     */
+    #define SFCB_FLASH_TOPO_ADR_BYTE        3           /**<  Topology Number address bytes         FM25V20A_Rev_L: p.8, Memory Operation                           */
+    #define SFCB_FLASH_TOPO_SECTOR_SIZE     256         /**<  Topology Sector Size in bytes         no sectors, queue allocation unit                               */
+    #define SFCB_FLASH_TOPO_PAGE_SIZE       256         /**<  Topology Page Size in bytes           no pages, transfer unit                                         */
+    #define SFCB_FLASH_TOPO_FLASH_SIZE      262144      /**<  Topology Total flash size in bytes    FM25V20A_Rev_L: p.1, 256K x 8                                   */
+    #define SFCB_FLASH_TOPO_RDID_DUMMY      0           /**<  Topology Number of dummy bytes        FM25V20A_Rev_L: p.9, Read Device ID
+                                                                #SFCB_FLASH_IST_RDID                                                                                */
+    #define SFCB_FLASH_MNG_WIP_MSK          0x00        /**<  MGMT: write-in-progress               not available, no write cycle time                              */
+    #define SFCB_FLASH_MNG_WRENA_MSK        0x02        /**<  MGMT: write enable                    FM25V20A_Rev_L: p.7, Write Enable Latch (WEL)                   */
+    #define SFCB_FLASH_MNG_QE_MSK           0x00        /**<  MGMT: quad enable                     not available                                                   */
 
 #elif defined(NEWFLASH)
     /* @brief NEWFLASH
@@ -84,9 +180,16 @@
     #define SFCB_FLASH_IST_WR_DSBL          0x0     /**<  Instruction Write disable                                     */
     #define SFCB_FLASH_IST_ERASE_BULK       0x0     /**<  Instruction Chip Erase                                        */
     #define SFCB_FLASH_IST_ERASE_SECTOR     0x0     /**<  Instruction Sector Erase                                      */
+    #define SFCB_FLASH_IST_ERASE_BLK32      0x0     /**<  Instruction 32KB Block Erase                                  */
+    #define SFCB_FLASH_IST_ERASE_BLK64      0x0     /**<  Instruction 64KB Block Erase                                  */
     #define SFCB_FLASH_IST_RD_STATE_REG     0x0     /**<  Instruction Read Status Register                              */
     #define SFCB_FLASH_IST_RD_DATA          0x0     /**<  Instruction Read Data                                         */
     #define SFCB_FLASH_IST_WR_PAGE          0x0     /**<  Instruction Write Page                                        */
+    #define SFCB_FLASH_IST_WR_PAGE_QUAD     0x0     /**<  Instruction Quad Write Page                                   */
+    #define SFCB_FLASH_IST_RD_STATE_REG2    0x0     /**<  Instruction Read Status Register 2                            */
+    #define SFCB_FLASH_IST_WR_STATE_REG2    0x0     /**<  Instruction Write Status Register 2                           */
+    #define SFCB_FLASH_IST_PWR_DOWN         0x0     /**<  Instruction Deep Power-down                                   */
+    #define SFCB_FLASH_IST_PWR_UP           0x0     /**<  Instruction Release Power-down                                */
     #define SFCB_FLASH_TOPO_ADR_BYTE        0       /**<  Topology Number address bytes                                 */
     #define SFCB_FLASH_TOPO_SECTOR_SIZE     0       /**<  Topology Sector Size in bytes, #SFCB_FLASH_IST_ERASE_SECTOR   */
     #define SFCB_FLASH_TOPO_PAGE_SIZE       0       /**<  Topology Page Size in bytes, #SFCB_FLASH_IST_WR_PAGE          */
@@ -94,6 +197,7 @@
     #define SFCB_FLASH_TOPO_RDID_DUMMY      0       /**<  Topology Number of dummy bytes, #SFCB_FLASH_IST_RDID          */
     #define SFCB_FLASH_MNG_WIP_MSK          0x0     /**<  MGMT: write-in-progress                                       */
     #define SFCB_FLASH_MNG_WRENA_MSK        0x0     /**<  MGMT: write enable                                            */
+    #define SFCB_FLASH_MNG_QE_MSK           0x0     /**<  MGMT: quad enable                                             */
 
 #endif
 /** @} */
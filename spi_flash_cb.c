@@ -90,6 +90,73 @@
 
 
 
+/**
+ *  @brief commit word
+ *
+ *  committed element in #SFCB_FMT_COMMIT, programmed over the erased word
+ *
+ *  @since  2026-10-18
+ */
+#define SFCB_COMMIT_WORD    ((uint32_t) 0x00000000)
+
+
+
+/**
+ *  @defgroup SFCB_UCODE
+ *
+ *  microcode of table driven commands, see #t_sfcb_uop
+ *
+ *  @{
+ */
+static const t_sfcb_uop g_sfcbUcodeRaw[] = {    /**< #sfcb_flash_read */
+    {SFCB_UOP_POLL, 0},
+    {SFCB_UOP_RD, 0},
+    {SFCB_UOP_CPY, 0},
+    {SFCB_UOP_END, 0}
+};
+static const t_sfcb_uop g_sfcbUcodeQe[] = {     /**< #sfcb_quad */
+    {SFCB_UOP_POLL, 0},
+    {SFCB_UOP_RDSR2, 0},
+    {SFCB_UOP_QE, 6},       // set or written, done
+    {SFCB_UOP_WREN, 0},
+    {SFCB_UOP_WRSR2, 0},
+    {SFCB_UOP_JMP, 0},      // wait for write cycle and read back
+    {SFCB_UOP_END, 0}
+};
+static const t_sfcb_uop g_sfcbUcodeAdd[] = {    /**< #sfcb_addv, #sfcb_add_done, #sfcb_add_post */
+    {SFCB_UOP_POLL, 0},
+    {SFCB_UOP_NEXT, 5},     // element written, done
+    {SFCB_UOP_WREN, 0},
+    {SFCB_UOP_PROG, 0},
+    {SFCB_UOP_JMP, 0},      // wait for write cycle
+    {SFCB_UOP_FLUSH, 0},    // SPI NAND: program staged page
+    {SFCB_UOP_END, 0}
+};
+static const t_sfcb_uop g_sfcbUcodeErase[] = {  /**< #sfcb_mkcb, sub-sequence of queue scan */
+    {SFCB_UOP_WREN, 0},
+#if defined(SFCB_FLASH_TYPE_NOERASE)
+    {SFCB_UOP_ERASE, 3},    // oldest element filled
+    {SFCB_UOP_JMP, 0},      // next chunk
+#else
+    {SFCB_UOP_ERASE, 2},
+#endif
+    {SFCB_UOP_RET, SFCB_STG00}  // wait for erase, rescan queue
+};
+static const t_sfcb_uop g_sfcbUcodeBlank[] = {  /**< #sfcb_blank_check */
+    {SFCB_UOP_POLL, 0},
+    {SFCB_UOP_BLANK, 0},
+    {SFCB_UOP_END, 0}
+};
+static const t_sfcb_uop g_sfcbUcodeRdq[] = {    /**< #sfcb_read_q */
+    {SFCB_UOP_POLL, 0},
+    {SFCB_UOP_RD, 0},
+    {SFCB_UOP_SCAT, 0},
+    {SFCB_UOP_END, 0}
+};
+/** @} */   // SFCB_UCODE
+
+
+
 /**
  *  @brief ceildivide
  *
@@ -148,6 +215,11 @@ static void sfcb_adr32_uint8 (uint32_t adr, uint8_t *spi, uint8_t adrBytes)
  */
 static int sfcb_spi_wip_poll (t_sfcb *self)
 {
+#if defined(SFCB_FLASH_TYPE_NOERASE)
+    /* no write cycle time */
+    self->uint16SpiLen = 0;
+    return 0;
+#else
     if ( (0 == self->uint16SpiLen) || (0 != (self->uint8PtrSpi[1] & SFCB_FLASH_MNG_WIP_MSK)) ) {
         /* First Request or WIP */
         self->uint8PtrSpi[0] = SFCB_FLASH_IST_RD_STATE_REG;
@@ -157,6 +229,26 @@ static int sfcb_spi_wip_poll (t_sfcb *self)
     }
     self->uint16SpiLen = 0;
     return 0;
+#endif
+}
+
+
+
+/**
+ *  @brief page program instruction
+ *
+ *  selects single or quad input page program
+ *
+ *  @param[in]      self                handle, #t_sfcb
+ *  @return         uint8_t             flash instruction
+ *  @since          October 18, 2026
+ */
+static uint8_t sfcb_ist_wr_page (const t_sfcb *self)
+{
+    if ( (0 != self->uint8Quad) && (0 != SFCB_FLASH_IST_WR_PAGE_QUAD) ) {
+        return SFCB_FLASH_IST_WR_PAGE_QUAD;
+    }
+    return SFCB_FLASH_IST_WR_PAGE;
 }
 
 
@@ -177,16 +269,70 @@ static uint32_t sfcb_flash_adr_head (t_sfcb *self, uint16_t elem)
 {
     /** Variables **/
     uint32_t    adr;
+#if defined(SFCB_FLASH_TYPE_NAND)
+    /* NAND: elements not crossing blocks, block erase leaves no programmed element tail in next block */
+    const uint16_t  uint16ElemPerBlk = (uint16_t) ((SFCB_FLASH_TOPO_SECTOR_SIZE / SFCB_FLASH_TOPO_PAGE_SIZE) / ((self->ptrCbs)[self->uint8IterCb]).uint16NumPagesPerElem);
+    /* calculate address */
+    adr =   (((self->ptrCbs)[self->uint8IterCb]).uint32StartSector + (uint32_t) (elem / uint16ElemPerBlk)) * (uint32_t) SFCB_FLASH_TOPO_SECTOR_SIZE   // start address of block
+            +
+            ((self->ptrCbs)[self->uint8IterCb]).uint32SlotSize * (uint32_t) (elem % uint16ElemPerBlk);  // offset in block
+#else
+    /* compact: packed slots, sector summary in front of the elements of every sector */
+    if ( SFCB_FMT_COMPACT == ((self->ptrCbs)[self->uint8IterCb]).uint8Fmt ) {
+        const uint16_t  uint16ElemPerSec = (uint16_t) (SFCB_FLASH_TOPO_SECTOR_SIZE / ((self->ptrCbs)[self->uint8IterCb]).uint32SlotSize - 1);
+        adr =   (((self->ptrCbs)[self->uint8IterCb]).uint32StartSector + (uint32_t) (elem / uint16ElemPerSec)) * (uint32_t) SFCB_FLASH_TOPO_SECTOR_SIZE   // start address of sector
+                +
+                ((self->ptrCbs)[self->uint8IterCb]).uint32SlotSize * (uint32_t) (1 + elem % uint16ElemPerSec); // offset in sector, skip summary
+        return adr;
+    }
     /* calculate address */
     adr =   ((self->ptrCbs)[self->uint8IterCb]).uint32StartSector * (uint32_t) SFCB_FLASH_TOPO_SECTOR_SIZE  // start address of circular buffer queue
             +
-            ((self->ptrCbs)[self->uint8IterCb]).uint16NumPagesPerElem * (uint32_t) SFCB_FLASH_TOPO_PAGE_SIZE * elem;    // offset based on element count
+            ((self->ptrCbs)[self->uint8IterCb]).uint32SlotSize * elem;  // offset based on element count
+#endif
     /* return header address */
     return adr;
 }
 
 
 
+/**
+ *  @brief magic hash
+ *
+ *  16-bit hash of queue magic number in #SFCB_FMT_COMPACT header, never the erased pattern
+ *
+ *  @param[in]      magic               magic number of queue
+ *  @return         uint16_t            hash
+ *  @since          October 18, 2026
+ */
+static uint16_t sfcb_magic_hash (uint32_t magic)
+{
+    /** Variables **/
+    const uint16_t  uint16Hash = (uint16_t) (magic ^ (magic >> 16));
+
+    return (uint16_t) ((0xFFFF == uint16Hash) ? 0xFFFE : uint16Hash);
+}
+
+
+
+/**
+ *  @brief sector summary ahead
+ *
+ *  checks for first element of sector in #SFCB_FMT_COMPACT, the sector summary
+ *  takes place in the slot in front of it
+ *
+ *  @param[in]      *cb                 queue, #t_sfcb_cb
+ *  @param[in]      adr                 flash address of element
+ *  @return         uint8_t             first element in sector
+ *  @since          October 18, 2026
+ */
+static uint8_t sfcb_sum_ahead (const t_sfcb_cb *cb, uint32_t adr)
+{
+    return (uint8_t) ((SFCB_FMT_COMPACT == cb->uint8Fmt) && (cb->uint32SlotSize == (adr % SFCB_FLASH_TOPO_SECTOR_SIZE)));
+}
+
+
+
 /**
  *  @brief SPI packet header request
  *
@@ -201,393 +347,2337 @@ static uint32_t sfcb_flash_adr_head (t_sfcb *self, uint16_t elem)
  */
 static void sfcb_spi_get_head (t_sfcb *self)
 {
-    self->uint16SpiLen = SFCB_FLASH_TOPO_ADR_BYTE + 1 + sizeof(spi_flash_cb_elem_head);     // +1: IST, + Address bytes
+    /* compact: sector summary in front of the first element of the sector is read ahead */
+    self->uint16HeadOfs = 0;
+    if ( 0 != sfcb_sum_ahead(&((self->ptrCbs)[self->uint8IterCb]), self->uint32IterAdr) ) {
+        self->uint16HeadOfs = (uint16_t) ((self->ptrCbs)[self->uint8IterCb]).uint32SlotSize;
+    }
+    self->uint16SpiLen = (uint16_t) (SFCB_FLASH_TOPO_ADR_BYTE + 1 + self->uint16HeadOfs + ((self->ptrCbs)[self->uint8IterCb]).uint8HeadLen);   // +1: IST, + Address bytes, header with commit word
     memset(self->uint8PtrSpi, 0, self->uint16SpiLen);   // make empty
     self->uint8PtrSpi[0] = SFCB_FLASH_IST_RD_DATA;      // Flash read instruction
-    sfcb_adr32_uint8(self->uint32IterAdr, self->uint8PtrSpi+1, SFCB_FLASH_TOPO_ADR_BYTE);   // serialize address into bytes, +1 first byte is instruction
+    sfcb_adr32_uint8(self->uint32IterAdr - self->uint16HeadOfs, self->uint8PtrSpi+1, SFCB_FLASH_TOPO_ADR_BYTE);   // serialize address into bytes, +1 first byte is instruction
 }
 
 
 
 /**
- *  sfcb_init
- *    initializes handle
+ *  @brief header decode
+ *
+ *  copies element header from read data of #sfcb_spi_get_head. The compact header
+ *  is extended to magic number and 32-bit ID with the sector summary
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[out]     *dst                decoded header, magic number differs from queue if not of this queue
+ *  @return         void
+ *  @since          October 18, 2026
  */
-int sfcb_init (t_sfcb *self, void *cb, uint8_t cbLen, void *spi, uint16_t spiLen)
+static void sfcb_spi_head_dec (t_sfcb *self, spi_flash_cb_elem_head *dst)
 {
-    /* Function call message */
-    sfcb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
-    /* check if provided flash type is valid */
-    if ( 0 == (sizeof(SFCB_FLASH_NAME) - 1) ) {
-        sfcb_printf("  ERROR:%s: no flash type selected\n", __FUNCTION__);
-        return SFCB_E_NO_FLASH; // no flash type selected, use proper compile switch
+    /** Variables **/
+    const t_sfcb_cb         *ptrCb = &((self->ptrCbs)[self->uint8IterCb]);
+    const uint8_t           *src = self->uint8PtrSpi + SFCB_FLASH_TOPO_ADR_BYTE + 1;    // +1: IST
+    spi_flash_cb_sect_sum   sum;
+    uint16_t                uint16Hash;
+    uint16_t                uint16Seq;
+
+    if ( SFCB_FMT_COMPACT != ptrCb->uint8Fmt ) {
+        memcpy(dst, src, sizeof(*dst));
+        return;
     }
-    sfcb_printf("  INFO:%s: flash '%s' selected\n", __FUNCTION__, SFCB_FLASH_NAME);
-    /* set up list of flash circular buffers */
-    self->uint8NumCbs = cbLen;
-    self->uint16SpiLen = 0;
-    self->uint8Busy = 0;
-    self->cmd = SFCB_CMD_IDLE;  // free for request
-    self->stage = SFCB_STG00;
-    self->ptrCbs = (t_sfcb_cb*) cb;     // circular buffer element array
-    self->uint8PtrSpi = (uint8_t*) spi; // uint8 array
-    self->uint16SpiMax = spiLen;        // max array length
-    self->error = SFCB_E_NOERO;
-    self->ptrCbElemPl = NULL;
-    self->uint16CbElemPlSize = 0;
-    /* memory addresses */
-    sfcb_printf("  INFO:%s:sfcb:spi_p            = %p\n", __FUNCTION__, self->uint8PtrSpi); // spi buffer
-    /* SPI buffer needs at least space for one page and address and instruction */
-    if ( (SFCB_FLASH_TOPO_PAGE_SIZE + SFCB_FLASH_TOPO_ADR_BYTE + 1) > self->uint16SpiMax ) {
-        sfcb_printf("  ERROR:%s: spi buffer to small, is=%d byte, req=%d byte\n", __FUNCTION__, self->uint16SpiMax, SFCB_FLASH_TOPO_PAGE_SIZE + SFCB_FLASH_TOPO_ADR_BYTE + 1);
-        return SFCB_E_MEM;  // not enough SPI buffer to write at least one complete page to flash
+    /* sector summary read ahead */
+    if ( 0 != self->uint16HeadOfs ) {
+        memcpy(&sum, src, sizeof(sum));
+        self->uint8SumValid = (uint8_t) (sum.uint32MagicNum == ptrCb->uint32MagicNum);
+        self->uint32SumBase = sum.uint32IdBase;
+        src += self->uint16HeadOfs;
     }
-    /* init circular buffer handles */
-    for ( uint8_t i = 0; i < (self->uint8NumCbs); i++ ) {
-        (self->ptrCbs[i]).uint8Used = 0;
-        (self->ptrCbs[i]).uint8MgmtValid = 0;
-        sfcb_printf("  INFO:%s:ptrCbs[%i]_p           = %p\n", __FUNCTION__, i, (&self->ptrCbs[i]));                    // unit test output
-        sfcb_printf("  INFO:%s:ptrCbs[%i].uint8Used_p = %p\n", __FUNCTION__, i, &((self->ptrCbs[i]).uint8Used));        // output address
-        sfcb_printf("  INFO:%s:ptrCbs[%i].uint8Init_p = %p\n", __FUNCTION__, i, &((self->ptrCbs[i]).uint8MgmtValid));   // output address
+    memcpy(&uint16Hash, src, sizeof(uint16Hash));
+    memcpy(&uint16Seq, src+sizeof(uint16Hash), sizeof(uint16Seq));
+    if ( (0 != self->uint8SumValid) && (sfcb_magic_hash(ptrCb->uint32MagicNum) == uint16Hash) ) {
+        dst->uint32MagicNum = ptrCb->uint32MagicNum;
+        uint16Seq = (uint16_t) (uint16Seq - (uint16_t) self->uint32SumBase);   // distance to base
+        if ( uint16Seq < 0x8000 ) {
+            dst->uint32IdNum = self->uint32SumBase + uint16Seq;
+        } else {
+            dst->uint32IdNum = self->uint32SumBase - (uint32_t) (0x10000 - (uint32_t) uint16Seq);
+        }
+    } else {
+        dst->uint32MagicNum = ~(ptrCb->uint32MagicNum);
+        dst->uint32IdNum = uint16Seq;
     }
-    /* normal end */
-    return SFCB_OK;
 }
 
 
 
 /**
- *  spi_flash_cb_worker
- *    executes request from ...
+ *  @brief header encode
+ *
+ *  serializes #t_sfcb.head in the element format of the selected queue
+ *
+ *  @param[in]      self                handle, #t_sfcb
+ *  @param[out]     *dst                destination, f. e. SPI packet
+ *  @return         uint16_t            number of written bytes
+ *  @since          October 18, 2026
  */
-void sfcb_worker (t_sfcb *self)
+static uint16_t sfcb_head_enc (const t_sfcb *self, uint8_t *dst)
 {
     /** Variables **/
-    uint8_t     uint8Good;              // check was good
-    uint16_t    uint16PagesBytesAvail;  // number of used page bytes
-    uint16_t    uint16CpyLen;           // number of Bytes to copy
-    uint32_t    uint32Temp;             // temporary 32bit variable
+    uint16_t    uint16Hash;
+    uint16_t    uint16Seq;
 
-    /* Function call message */
-    sfcb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
-    sfcb_printf("  INFO:%s:sfcb_p            = %p\n", __FUNCTION__, self);
-    sfcb_printf("  INFO:%s:sfcb:spi_p        = %p\n", __FUNCTION__, self->uint8PtrSpi); // spi buffer
-    /* select part of FSM */
-    switch (self->cmd) {
-        /*
-         *
-         * nothing to do
-         *
-         */
-        case SFCB_CMD_IDLE:
-            sfcb_printf("  INFO:%s:IDLE\n", __FUNCTION__);
-            return;
-        /*
-         *
-         * Allocate Next Free Element for Circular Buffers
-         *
-         */
-        case SFCB_CMD_MKCB:
-            /* select execution state, allows break & cont */
-            switch (self->stage) {
-                /* check for WIP */
-                case SFCB_STG00:
-                    /* Debug message */
-                    sfcb_printf("  INFO:%s:MKCB:STG0: check for WIP, request first header\n", __FUNCTION__);
-                    /* WIP Check */
-                    if ( 0 != sfcb_spi_wip_poll(self) ) return;
-                    /* Request first header of circular buffer element */
-                    self->uint32IterAdr = sfcb_flash_adr_head(self, self->uint16Iter);  // calculate physical flash address of first header of circular buffer queue
-                    sfcb_spi_get_head(self);    // assemble SPI packet
-                    /* debug message */
-                    sfcb_printf("  INFO:%s:MKCB:STG0:FLASH: adr=0x%x, len=%i", __FUNCTION__, self->uint32IterAdr, (uint32_t) sizeof(spi_flash_cb_elem_head));
-                    /* build overview of circular buffer queue */
-                    self->stage = SFCB_STG01;   // Go one with search for Free Segment
-                    return;
-                /* check header, find empty page for new element */
-                case SFCB_STG01:
-                    /* Check header of CBQ element */
-                    sfcb_printf("  INFO:%s:MKCB:STG1: check header, request footer of queue element, find empty start page for new element\n", __FUNCTION__);
-                    sfcb_printf("  INFO:%s:MKCB:STG1:SPI: ", __FUNCTION__);
-                    for ( uint8_t i = 0; i < (uint8_t) (sizeof(spi_flash_cb_elem_head) + SFCB_FLASH_TOPO_ADR_BYTE + 1); i++ ) { // +1: SPI Flash IST
-                        sfcb_printf("0x%x ", self->uint8PtrSpi[i]);
-                    }
-                    sfcb_printf("\n");
-                    /* copy head from SPI packet*/
-                    memcpy(&(self->head), self->uint8PtrSpi+SFCB_FLASH_TOPO_ADR_BYTE+1, sizeof(self->head));  // ensure alignment to processor architecture
-                    sfcb_printf("  INFO:%s:MKCB:STG1: RDHEAD,magicnum=0x%x\n", __FUNCTION__, (self->head).uint32MagicNum);
-                    /* Flash Area is used by circular buffer, check magic number
-                     *   +4: Read instruction + 32bit address
-                     */
-                    if ( (self->head).uint32MagicNum == ((self->ptrCbs)[self->uint8IterCb]).uint32MagicNum ) {
-                        /* Debug Message */
-                        sfcb_printf("  INFO:%s:MKCB:STG1: Valid Entry Found\n", __FUNCTION__);
-                        /* count available elements */
-                        (((self->ptrCbs)[self->uint8IterCb]).uint16NumEntries)++;
-                        /* get highest number of numbered circular buffer elements, needed for next entry */
-                        if ( (self->head).uint32IdNum > ((self->ptrCbs)[self->uint8IterCb]).uint32IdNumMax ) {
-                            /* save new highest number in circular buffer */
-                            ((self->ptrCbs)[self->uint8IterCb]).uint32IdNumMax = (self->head).uint32IdNum;
-                            self->uint32LastElemAdr = self->uint32IterAdr;      // store temporary, footer check pending, needed by sfcb_get_last
-                            self->uint32LastElemNum = (self->head).uint32IdNum; // store temporary
-                        }
-                        /* get lowest number of circular buffer, needed for erase sector, and start get function */
-                        if ( (self->head).uint32IdNum < ((self->ptrCbs)[self->uint8IterCb]).uint32IdNumMin ) {
-                            ((self->ptrCbs)[self->uint8IterCb]).uint32IdNumMin = (self->head).uint32IdNum;
-                            ((self->ptrCbs)[self->uint8IterCb]).uint32StartPageIdMin = self->uint32IterAdr; // needed by Sector-Erase
-                        }
-                    } else {
-                        /* check for unused header
-                         * first unused pages is allocated, iterate over all elements to get all IDs
-                         */
-                        if ( 0 == ((self->ptrCbs)[self->uint8IterCb]).uint8MgmtValid ) {
-                            uint8Good = 1;
-                            for ( uint8_t i = SFCB_FLASH_TOPO_ADR_BYTE + 1; i < SFCB_FLASH_TOPO_ADR_BYTE + 1 + sizeof(spi_flash_cb_elem_head); i++ ) {  // +1: IST
-                                /* corrupted empty page found, leave as it is */
-                                if ( 0xFF != self->uint8PtrSpi[i] ) {
-                                    uint8Good = 0;  // try to find next free clean page
-                                    sfcb_printf ("  ERROR:%s:MKCB:STG1: corrupted empty page found at 0x%0x\n", __FUNCTION__, self->uint32IterAdr);
-                                    break;
-                                }
-                            }
-                            /* save page number for next circular buffer entry */
-                            if ( 0 != uint8Good ) {
-                                ((self->ptrCbs)[self->uint8IterCb]).uint32StartPageWrite = self->uint32IterAdr;
-                                ((self->ptrCbs)[self->uint8IterCb]).uint8MgmtValid = 1; // prepared for writing next element
-                            }
-                        }
-                    }
-                    /* Current Status Message */
-                    sfcb_printf ( "  INFO:%s:MKCB:STG1: cb=%d, elem=%d, flashadr=0x%x, idIs=0x%x, idMin=0x%x, idMax=0x%x\n",
-                                  __FUNCTION__,
-                                  self->uint8IterCb,
-                                  self->uint16Iter,
-                                  self->uint32IterAdr,
-                                  (self->head).uint32IdNum,
-                                  ((self->ptrCbs)[self->uint8IterCb]).uint32IdNumMin,
-                                  ((self->ptrCbs)[self->uint8IterCb]).uint32IdNumMax
-                                );
-                    /* assemble footer request of circular buffer element
-                     *   +1: head from the next queue element touches footer from the current queue element
-                     *       therefore going for the next head and subtract the head will lead to the flash address
-                     *       of the footer in the current queue element
-                     */
-                    self->uint32IterAdr = sfcb_flash_adr_head(self, (uint16_t) ((self->uint16Iter) + 1)) - (uint32_t) sizeof(spi_flash_cb_elem_head);
-                    sfcb_spi_get_head(self);
-                    /* go on with footer evaluation and requesting next header */
-                    self->stage = SFCB_STG02;
-                    /* debug message */
-                    sfcb_printf("  INFO:%s:MKCB:STG1:FLASH: adr=0x%x, len=%i\n", __FUNCTION__, self->uint32IterAdr, (uint32_t) sizeof(spi_flash_cb_elem_head));
-                    return;
-                /* check footer, needed to ensure that #sfcb_get_last will get an complete circular buffer queue element */
-                case SFCB_STG02:
-                    /* Debug Message */
-                    sfcb_printf("  INFO:%s:MKCB:STG2: check footer, request header of next queue element\n", __FUNCTION__);
-                    sfcb_printf("  INFO:%s:MKCB:STG2:SPI: ", __FUNCTION__);
-                    for ( uint8_t i = 0; i < (uint8_t) (sizeof(spi_flash_cb_elem_head) + SFCB_FLASH_TOPO_ADR_BYTE + 1); i++ ) { // +1: SPI Flash IST
-                        sfcb_printf("0x%x ", self->uint8PtrSpi[i]);
-                    }
-                    sfcb_printf("\n");
-                    /* copy from SPI packet */
-                    memcpy(&(self->foot), self->uint8PtrSpi+SFCB_FLASH_TOPO_ADR_BYTE+1, sizeof(self->foot));
-                    /* header = footer? if yes, cb element completely written */
-                    if (    (0 == memcmp(&(self->foot), &(self->head), sizeof(self->head)))
-                         && (self->foot).uint32MagicNum == ((self->ptrCbs)[self->uint8IterCb]).uint32MagicNum
-                    ) {
-                        sfcb_printf (   "  INFO:%s:MKCB:STG2:head/foot: compare pass, successful last written element is at flash adr=0x%x\n",
-                                        __FUNCTION__, self->uint32LastElemAdr
-                                    );
-                        ((self->ptrCbs)[self->uint8IterCb]).uint32StartPageIdMax = self->uint32LastElemAdr; // needed by sfcb_get_last
-                        ((self->ptrCbs)[self->uint8IterCb]).uint32ElemIdLastCpl  = self->uint32LastElemNum; // needed by sfcb_get_last
-                    }
-                    /* request next header of circular buffer */
-                    self->uint32IterAdr = sfcb_flash_adr_head(self, (uint16_t) ((self->uint16Iter) + 1));
-                    sfcb_spi_get_head(self);    // assemble SPI packet for request next head
-                    /* debug message */
-                    sfcb_printf("  INFO:%s:MKCB:STG2:FLASH: adr=0x%x, len=%i\n", __FUNCTION__, self->uint32IterAdr, (uint32_t) sizeof(spi_flash_cb_elem_head));
-                    /* prepare iterator for next */
-                    if ( self->uint16Iter < (((self->ptrCbs)[self->uint8IterCb]).uint16NumEntriesMax-1) ) {
-                        /* next element in current queue */
-                        (self->uint16Iter)++;
-                        self->stage = SFCB_STG01;   // process next header
-                    } else {
-                        /* Free Page Found */
-                        if ( 0 != ((self->ptrCbs)[self->uint8IterCb]).uint8MgmtValid) {
-                            /* prepare for next queue */
-                            self->uint16Iter = 0;   // reset element counter
-                            (self->uint8IterCb)++;      // process next queue
-                            /* look ahead if service of some queue can skipped */
-                            for ( uint8_t i=self->uint8IterCb; i<self->uint8NumCbs; i++ ) {
-                                /* all active circular buffer queues processed? */
-                                if ( 0 == ((self->ptrCbs)[i]).uint8Used ) {
-                                    self->uint16SpiLen = 0;
-                                    self->cmd = SFCB_CMD_IDLE;
-                                    self->stage = SFCB_STG00;
-                                    self->uint8Busy = 0;
-                                    return;
-                                /* active queue found */
-                                } else {
-                                    if ( 0 == ((self->ptrCbs)[i]).uint8MgmtValid ) {
-                                        self->uint8IterCb = i;  // search for uninitialized queue, in case of only on circular buffer needes to rebuild
-                                        break;
-                                    }
-                                }
-                            }
-                            /* all available queues processed, go in idle */
-                            if ( !(self->uint8IterCb < self->uint8NumCbs) ) {
-                                self->uint16SpiLen = 0;
-                                self->cmd = SFCB_CMD_IDLE;
-                                self->stage = SFCB_STG00;
-                                self->uint8Busy = 0;
-                                return;
-                            }
-                        /* Go on with sector erase */
-                        } else {
-                            self->uint8PtrSpi[0] = SFCB_FLASH_IST_WR_ENA;   // enable write
-                            self->uint16SpiLen = 1;
-                            self->stage = SFCB_STG03;
-                        }
-                    }
-                    return; // DONE or SPI transfer is require
-                /* Assemble Command for Sector ERASE */
-                case SFCB_STG03:
-                    sfcb_printf( "  INFO:%s:MKCB:STG3: Assemble Command for Sector ERASE\n", __FUNCTION__);
-                    sfcb_printf( "  INFO:%s:MKCB:STG3: cb=%d, uint32StartPageIdMin=0x%x\n",
-                                 __FUNCTION__,
-                                 self->uint8IterCb,
-                                 ((self->ptrCbs)[self->uint8IterCb]).uint32StartPageIdMin
-                                );
-                    uint32Temp = (self->ptrCbs[self->uint8IterCb]).uint32StartPageIdMin;        // get startpage of oldest entry, prepare for delete
-                    uint32Temp = (uint32Temp & (uint32_t) ~(SFCB_FLASH_TOPO_SECTOR_SIZE - 1));  // align to sub sector address
-                    self->uint8PtrSpi[0] = SFCB_FLASH_IST_ERASE_SECTOR;
-                    sfcb_adr32_uint8(uint32Temp, self->uint8PtrSpi+1, SFCB_FLASH_TOPO_ADR_BYTE);    // +1 first byte is instruction
-                    self->uint16SpiLen = SFCB_FLASH_TOPO_ADR_BYTE + 1;  // address + instruction
-                    self->stage = SFCB_STG04;
-                    return; // DONE or SPI transfer is required
-                /* Wait for Sector Erase */
-                case SFCB_STG04:
-                    sfcb_printf("  INFO:%s:MKCB:STG4: Wait for Sector Erase\n", __FUNCTION__);
-                    /* Start at zero Element with search for free page */
-                    self->uint16Iter = 0;
-                    /* Assemble command for WIP */
-                    self->uint8PtrSpi[0] = SFCB_FLASH_IST_RD_STATE_REG;
-                    self->uint8PtrSpi[1] = 0;
-                    self->uint16SpiLen = 2;
-                    self->stage = SFCB_STG00;   // wait for erase, and search for free page for next element
-                    return; // DONE or SPI transfer is required
-                /* something strange happened */
-                default:
-                    sfcb_printf("  ERROR:%s:MKCB: unexpected use of default path\n", __FUNCTION__);
-                    self->error = SFCB_E_UNKBEH;
-                    break;
-            }
-            return;
-        /*
-         *
-         * Add New Element to Circular Buffer
-         *
-         */
-        case SFCB_CMD_ADD:
-            switch (self->stage) {
-                /* check for WIP */
+    if ( SFCB_FMT_COMPACT != ((self->ptrCbs)[self->uint8IterCb]).uint8Fmt ) {
+        memcpy(dst, &(self->head), sizeof(self->head));
+        return (uint16_t) sizeof(self->head);
+    }
+    uint16Hash = sfcb_magic_hash((self->head).uint32MagicNum);
+    uint16Seq = (uint16_t) (self->head).uint32IdNum;
+    memcpy(dst, &uint16Hash, sizeof(uint16Hash));
+    memcpy(dst+sizeof(uint16Hash), &uint16Seq, sizeof(uint16Seq));
+    return (uint16_t) (sizeof(uint16Hash) + sizeof(uint16Seq));
+}
+
+
+
+/**
+ *  @brief first programmed byte
+ *
+ *  searches forward for the first non erased byte in a memory segment,
+ *  compares erased pattern word-wide and resolves only the hit word bytewise
+ *
+ *  @param[in]      *mem                memory segment, f. e. flash read data in SPI buffer
+ *  @param[in]      len                 number of bytes in *mem
+ *  @return         int32_t             index of first programmed byte
+ *  @retval         -1                  complete segment is erased
+ *  @since          October 18, 2026
+ */
+static int32_t sfcb_mem_first_used (const uint8_t *mem, uint16_t len)
+{
+    /** Variables **/
+    uint32_t    uint32Word; // word wide compare
+    uint16_t    i = 0;      // byte iterator
+
+    /* word wide check */
+    while ( (len - i) >= (int) sizeof(uint32Word) ) {
+        memcpy(&uint32Word, mem + i, sizeof(uint32Word));  // ensure alignment to processor architecture
+        if ( UINT32_MAX != uint32Word ) {
+            break;
+        }
+        i = (uint16_t) (i + sizeof(uint32Word));
+    }
+    /* resolve programmed byte in word, unaligned tail */
+    for ( ; i < len; i++ ) {
+        if ( 0xFF != mem[i] ) {
+            return (int32_t) i;
+        }
+    }
+    return -1;
+}
+
+
+
+/**
+ *  @brief last programmed byte
+ *
+ *  searches backwards for the last non erased byte in a memory segment,
+ *  compares erased pattern word-wide and resolves only the hit word bytewise
+ *
+ *  @param[in]      *mem                memory segment, f. e. flash read data in SPI buffer
+ *  @param[in]      len                 number of bytes in *mem
+ *  @return         int32_t             index of last programmed byte
+ *  @retval         -1                  complete segment is erased
+ *  @since          October 18, 2026
+ */
+static int32_t sfcb_mem_last_used (const uint8_t *mem, uint16_t len)
+{
+    /** Variables **/
+    uint32_t    uint32Word; // word wide compare
+    uint16_t    i = len;    // byte iterator
+
+    /* unaligned tail, check bytewise */
+    while ( 0 != (i % sizeof(uint32Word)) ) {
+        i--;
+        if ( 0xFF != mem[i] ) {
+            return (int32_t) i;
+        }
+    }
+    /* word wide check */
+    while ( i >= sizeof(uint32Word) ) {
+        memcpy(&uint32Word, mem + i - sizeof(uint32Word), sizeof(uint32Word));  // ensure alignment to processor architecture
+        if ( UINT32_MAX != uint32Word ) {
+            break;
+        }
+        i = (uint16_t) (i - sizeof(uint32Word));
+    }
+    /* resolve programmed byte in word */
+    while ( i > 0 ) {
+        i--;
+        if ( 0xFF != mem[i] ) {
+            return (int32_t) i;
+        }
+    }
+    return -1;
+}
+
+
+
+/**
+ *  @brief SPI packet payload gather
+ *
+ *  appends the next payload bytes from the fragment list of #sfcb_addv
+ *  to the SPI packet, completed or empty fragments are skipped
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[in]      len                 number of payload bytes to append
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void sfcb_spi_cpy_iov (t_sfcb *self, uint16_t len)
+{
+    /** Variables **/
+    uint16_t    uint16FragLen;  // number of Bytes from payload fragment
+
+    while ( 0 != len ) {
+        /* skip complete or empty fragment */
+        if ( self->uint16IovOfs == (self->ptrIov)[self->uint8IovIdx].len ) {
+            (self->uint8IovIdx)++;
+            self->uint16IovOfs = 0;
+            continue;
+        }
+        uint16FragLen = (uint16_t) sfcb_min(len, (uint16_t) ((self->ptrIov)[self->uint8IovIdx].len - self->uint16IovOfs));
+        memcpy((self->uint8PtrSpi+self->uint16SpiLen), ((uint8_t*) (self->ptrIov)[self->uint8IovIdx].ptr) + self->uint16IovOfs, uint16FragLen);
+        self->uint16SpiLen = (uint16_t) (self->uint16SpiLen + uint16FragLen);
+        self->uint16IovOfs = (uint16_t) (self->uint16IovOfs + uint16FragLen);
+        len = (uint16_t) (len - uint16FragLen);
+    }
+}
+
+
+
+/**
+ *  @brief payload transform start
+ *
+ *  resets all transform stages of the queue for a new element
+ *
+ *  @param[in]      cb                  queue, #t_sfcb_cb
+ *  @param[in]      id                  element ID
+ *  @param[in]      dir                 add or get path, #t_sfcb_xfrm_dir
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void sfcb_xfrm_start (const t_sfcb_cb *cb, uint32_t id, t_sfcb_xfrm_dir dir)
+{
+    for ( uint8_t i = 0; i < cb->uint8XfrmNum; i++ ) {
+        (cb->ptrXfrm)[i].start((cb->ptrXfrm)[i].ctx, id, dir);
+    }
+}
+
+
+
+/**
+ *  @brief payload transform chunk
+ *
+ *  transforms payload chunk in place, add path in stage order,
+ *  get path in reverse order
+ *
+ *  @param[in]      cb                  queue, #t_sfcb_cb
+ *  @param[in,out]  *data               payload chunk
+ *  @param[in]      len                 bytes in chunk
+ *  @param[in]      dir                 add or get path, #t_sfcb_xfrm_dir
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void sfcb_xfrm_chunk (const t_sfcb_cb *cb, uint8_t *data, uint16_t len, t_sfcb_xfrm_dir dir)
+{
+    /** Variables **/
+    uint8_t uint8Stage; // stage in process
+
+    for ( uint8_t i = 0; i < cb->uint8XfrmNum; i++ ) {
+        uint8Stage = (SFCB_XFRM_ENC == dir) ? i : (uint8_t) (cb->uint8XfrmNum - 1 - i);
+        (cb->ptrXfrm)[uint8Stage].chunk((cb->ptrXfrm)[uint8Stage].ctx, data, len, dir);
+    }
+}
+
+
+
+/**
+ *  @brief payload transform end
+ *
+ *  add path writes the metadata of all stages, get path checks them
+ *
+ *  @param[in]      cb                  queue, #t_sfcb_cb
+ *  @param[in,out]  *meta               metadata of all stages, in stage order
+ *  @param[in]      dir                 add or get path, #t_sfcb_xfrm_dir
+ *  @return         int                 state
+ *  @retval         0                   metadata accepted
+ *  @retval         -1                  stage rejects element
+ *  @since          October 18, 2026
+ */
+static int sfcb_xfrm_end (const t_sfcb_cb *cb, uint8_t *meta, t_sfcb_xfrm_dir dir)
+{
+    /** Variables **/
+    int ret = 0;
+
+    for ( uint8_t i = 0; i < cb->uint8XfrmNum; i++ ) {
+        if ( 0 != (cb->ptrXfrm)[i].end((cb->ptrXfrm)[i].ctx, meta, dir) ) {
+            ret = -1;
+        }
+        meta += (cb->ptrXfrm)[i].metaLen;
+    }
+    return ret;
+}
+
+
+
+#if !defined(SFCB_FLASH_TYPE_NOERASE)
+/**
+ *  @brief reclaim size
+ *
+ *  erase size for the oldest element of the selected queue. Block erase
+ *  if the element starts an aligned block inside of the queue, otherwise
+ *  sector erase up to the next block boundary
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         uint32_t            erase size in bytes
+ *  @since          October 18, 2026
+ */
+static uint32_t sfcb_reclaim_size (t_sfcb *self)
+{
+    /** Variables **/
+    t_sfcb_cb   *ptrCb = &((self->ptrCbs)[self->uint8IterCb]);  // selected queue
+
+    if (    (ptrCb->uint32ReclaimSize > SFCB_FLASH_TOPO_SECTOR_SIZE)
+         && (0 == (ptrCb->uint32StartPageIdMin % ptrCb->uint32ReclaimSize))
+         && ((ptrCb->uint32StartPageIdMin + ptrCb->uint32ReclaimSize) <= ((ptrCb->uint32StopSector + 1) * SFCB_FLASH_TOPO_SECTOR_SIZE))
+    ) {
+        return ptrCb->uint32ReclaimSize;
+    }
+    return SFCB_FLASH_TOPO_SECTOR_SIZE;
+}
+#endif
+
+
+
+/**
+ *  @brief pinned erase
+ *
+ *  checks the pending erase of the oldest element against the range
+ *  pinned by a reader. Policy #SFCB_PIN_BLOCK keeps the scanned queue
+ *  readable but without free element for write
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         uint8_t             erase state
+ *  @retval         0                   erase
+ *  @retval         1                   erase blocked by pin
+ *  @since          October 18, 2026
+ */
+static uint8_t sfcb_pin_erase (t_sfcb *self)
+{
+    /** Variables **/
+    t_sfcb_cb   *ptrCb = &((self->ptrCbs)[self->uint8IterCb]);  // selected queue
+    uint32_t    uint32Adr;  // erase start
+    uint32_t    uint32Len;  // erase size
+
+    if ( 0 == ptrCb->uint8Pin ) {
+        return 0;
+    }
+#if defined(SFCB_FLASH_TYPE_NOERASE)
+    uint32Adr = ptrCb->uint32StartPageIdMin;    // oldest element is filled
+    uint32Len = ptrCb->uint32SlotSize;
+#else
+    uint32Len = sfcb_reclaim_size(self);
+    uint32Adr = ptrCb->uint32StartPageIdMin & (uint32_t) ~(uint32Len - 1);
+#endif
+    if ( !((uint32Adr < ptrCb->uint32PinStop) && (ptrCb->uint32PinStart < uint32Adr + uint32Len)) ) {
+        return 0;
+    }
+    (ptrCb->uint32PinConflicts)++;
+    ptrCb->uint8PinHit = 1;
+    if ( SFCB_PIN_DROP == ptrCb->uint8PinPol ) {
+        sfcb_printf("  INFO:%s: cb=%d, erase adr=0x%x drops pinned data\n", __FUNCTION__, self->uint8IterCb, uint32Adr);
+        return 0;
+    }
+    sfcb_printf("  INFO:%s: cb=%d, erase adr=0x%x blocked by pin\n", __FUNCTION__, self->uint8IterCb, uint32Adr);
+    ptrCb->uint8PinFull = 1;
+    ptrCb->uint8MgmtValid = 1;  // scan is complete, queue is readable
+    return 1;
+}
+
+
+
+/**
+ *  @brief MKCB queue finish
+ *
+ *  circular buffer queue scan is complete. In case of allocated free element
+ *  go on with next queue or finish job, otherwise start erase sequence
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void sfcb_mkcb_next_cb (t_sfcb *self)
+{
+    /* Free Page Found, or erase blocked by reader pin */
+    if ( (0 != ((self->ptrCbs)[self->uint8IterCb]).uint8MgmtValid) || (0 != sfcb_pin_erase(self)) ) {
+        /* prepare for next queue */
+        self->uint16Iter = 0;   // reset element counter
+        (self->uint8IterCb)++;      // process next queue
+        /* look ahead if service of some queue can skipped */
+        for ( uint8_t i=self->uint8IterCb; i<self->uint8NumCbs; i++ ) {
+            /* all active circular buffer queues processed? */
+            if ( 0 == ((self->ptrCbs)[i]).uint8Used ) {
+                self->uint16SpiLen = 0;
+                self->cmd = SFCB_CMD_IDLE;
+                self->stage = SFCB_STG00;
+                self->uint8Busy = 0;
+                return;
+            /* active queue found */
+            } else {
+                if ( 0 == ((self->ptrCbs)[i]).uint8MgmtValid ) {
+                    self->uint8IterCb = i;  // search for uninitialized queue, in case of only on circular buffer needes to rebuild
+                    break;
+                }
+            }
+        }
+        /* all available queues processed, go in idle */
+        if ( !(self->uint8IterCb < self->uint8NumCbs) ) {
+            self->uint16SpiLen = 0;
+            self->cmd = SFCB_CMD_IDLE;
+            self->stage = SFCB_STG00;
+            self->uint8Busy = 0;
+            return;
+        }
+        /* request WIP for next queue */
+        self->uint16SpiLen = 0;
+        self->stage = SFCB_STG00;
+    /* Go on with sector erase */
+    } else {
+#if defined(SFCB_FLASH_TYPE_NOERASE)
+        self->uint32IterAdr = ((self->ptrCbs)[self->uint8IterCb]).uint32StartPageIdMin;    // fill starts at oldest element
+#endif
+        self->uint16SpiLen = 0;
+        self->ptrUcode = g_sfcbUcodeErase;  // run by stage switch, returns to queue scan
+        self->uint8UcPc = 0;
+    }
+}
+
+
+
+/**
+ *  @brief element commit
+ *
+ *  footer of queue element is written, tracks new element in management data.
+ *  Keeps #sfcb_queue_stats up to date without rescan of the queue
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void sfcb_cb_commit (t_sfcb *self)
+{
+    /** Variables **/
+    t_sfcb_cb   *ptrCb = &((self->ptrCbs)[self->uint8IterCb]);  // selected queue
+
+    if ( 0 == ptrCb->uint16NumEntries ) {
+        ptrCb->uint32IdNumMin = (self->head).uint32IdNum;
+        ptrCb->uint32StartPageIdMin = ptrCb->uint32StartPageWrite;
+    }
+    if ( ptrCb->uint16NumEntries < ptrCb->uint16NumEntriesMax ) {
+        (ptrCb->uint16NumEntries)++;
+    }
+    ptrCb->uint32IdNumMax = (self->head).uint32IdNum;
+    ptrCb->uint32ElemIdLastCpl = (self->head).uint32IdNum;
+    ptrCb->uint32StartPageIdMax = ptrCb->uint32StartPageWrite;
+    sfcb_printf("  INFO:%s: cb=%d, id=%d, entries=%d\n", __FUNCTION__, self->uint8IterCb, ptrCb->uint32IdNumMax, ptrCb->uint16NumEntries);
+}
+
+
+
+/**
+ *  @brief deferred burst done
+ *
+ *  releases the records of the written burst from the RAM ring. The next slot
+ *  is allocated without #sfcb_mkcb if it is in the sector of the written element,
+ *  the sector is erased since the first element in it
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void sfcb_defer_done (t_sfcb *self)
+{
+    /** Variables **/
+    t_sfcb_cb   *ptrCb = &((self->ptrCbs)[self->uint8IterCb]);  // deferred queue
+#if !defined(SFCB_FLASH_TYPE_NOERASE)
+    uint32_t    uint32Next = ptrCb->uint32StartPageWrite + ptrCb->uint32SlotSize;  // next slot
+#endif
+
+    ptrCb->uint16DefFirst = (uint16_t) ((ptrCb->uint16DefFirst + ptrCb->uint16DefBurst) % ptrCb->uint16DefRecs);
+    ptrCb->uint16DefCnt = (uint16_t) (ptrCb->uint16DefCnt - ptrCb->uint16DefBurst);
+    ptrCb->uint16DefBurst = 0;
+    if ( 0 == ptrCb->uint16DefCnt ) {
+        ptrCb->uint8DefForce = 0;
+    }
+#if !defined(SFCB_FLASH_TYPE_NOERASE)
+    if ( ((uint32Next + ptrCb->uint32SlotSize - 1) / SFCB_FLASH_TOPO_SECTOR_SIZE) == (ptrCb->uint32StartPageWrite / SFCB_FLASH_TOPO_SECTOR_SIZE) ) {
+        ptrCb->uint32StartPageWrite = uint32Next;
+        ptrCb->uint16PlFlashOfs = 0;
+        ptrCb->uint8MgmtValid = 1;
+    }
+#endif
+    sfcb_printf("  INFO:%s: cb=%d, records left=%d, valid=%d\n", __FUNCTION__, self->uint8IterCb, ptrCb->uint16DefCnt, ptrCb->uint8MgmtValid);
+}
+
+
+
+/**
+ *  @brief posted write scheduler
+ *
+ *  deficit round robin over queues with posted element writes. Every page program
+ *  consumes one credit, a queue gets #uint8Weight credits at the start of its turn.
+ *  Header, payload and footer of an element are kept in order, so a interrupted
+ *  element is recovered like an #sfcb_add without #sfcb_add_done.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         int                 state
+ *  @retval         0                   all posted writes done
+ *  @retval         1                   queue #uint8IterCb selected for next program
+ *  @since          October 18, 2026
+ */
+static int sfcb_sched (t_sfcb *self)
+{
+    /** Variables **/
+    t_sfcb_cb   *ptrCb = &((self->ptrCbs)[self->uint8IterCb]);  // queue of last program
+    uint8_t     uint8Cb;                                        // queue iterator
+    uint8_t     uint8Keep = 0;                                  // turn kept, page in write
+
+    /* save progress of last served queue */
+    if ( 0 != ptrCb->uint8PostPend ) {
+        ptrCb->uint16PostIter = self->uint16Iter;
+        /* footer written, element complete */
+        if ( ptrCb->uint16PlFlashOfs == (ptrCb->uint16PlSize + ptrCb->uint8HeadLen + 1) ) {
+            sfcb_cb_commit(self);
+            ptrCb->uint8PostPend = 0;
+            if ( 0 != ptrCb->uint16DefBurst ) {
+                sfcb_defer_done(self);  // deferred records written
+            }
+        }
+    }
+#if defined(SFCB_FLASH_TYPE_NAND)
+    /* staged page in write, switch would program it partially and the rest later into the same ECC sectors */
+    uint8Keep = (uint8_t) ((0 != ptrCb->uint8PostPend) && (0 != ptrCb->uint8PostSrv) && (0 != (self->uint32IterAdr % SFCB_FLASH_TOPO_PAGE_SIZE)));
+#endif
+    /* credits used, next queue in round */
+    if ( (0 == uint8Keep) && ((0 == ptrCb->uint8PostPend) || (0 == ptrCb->uint8Deficit)) ) {
+        for ( uint8_t i = 1; i <= self->uint8NumCbs; i++ ) {
+            uint8Cb = (uint8_t) ((self->uint8IterCb + i) % self->uint8NumCbs);
+            if ( 0 != ((self->ptrCbs)[uint8Cb]).uint8PostPend ) {
+                self->uint8IterCb = uint8Cb;
+                ((self->ptrCbs)[uint8Cb]).uint8Deficit = ((self->ptrCbs)[uint8Cb]).uint8Weight;
+                break;
+            }
+        }
+        ptrCb = &((self->ptrCbs)[self->uint8IterCb]);
+        if ( 0 == ptrCb->uint8PostPend ) {
+            return 0;   // all done
+        }
+    }
+    /* queueing delay */
+    if ( 0 == ptrCb->uint8PostSrv ) {
+        ptrCb->uint8PostSrv = 1;
+        ptrCb->uint32DelayLast = self->uint32WkrCalls - ptrCb->uint32PostTick;
+        ptrCb->uint32DelayMax = sfcb_max(ptrCb->uint32DelayMax, ptrCb->uint32DelayLast);
+    }
+    /* restore context */
+    self->uint32IterAdr = ptrCb->uint32StartPageWrite + ptrCb->uint16PlFlashOfs;
+    self->uint16CbElemPlSize = ptrCb->uint16PostLen;
+    self->uint16Iter = ptrCb->uint16PostIter;
+    (self->iov).ptr = (void*) ptrCb->ptrPostPl;
+    (self->iov).len = ptrCb->uint16PostLen;
+    self->ptrIov = &(self->iov);
+    self->uint8IovCnt = 1;
+    self->uint8IovIdx = 0;
+    self->uint16IovOfs = ptrCb->uint16PostIter;
+    /* payload written, request footer */
+    if ( (0 != ptrCb->uint16PlFlashOfs) && (self->uint16Iter == self->uint16CbElemPlSize) && (ptrCb->uint16PlFlashOfs < (ptrCb->uint16PlSize + ptrCb->uint8HeadLen)) ) {
+        ptrCb->uint16PlFlashOfs = (uint16_t) (ptrCb->uint16PlSize + ptrCb->uint8HeadLen);
+    }
+    if ( 0 != ptrCb->uint8Deficit ) {
+        (ptrCb->uint8Deficit)--;
+    }
+    sfcb_printf("  INFO:%s: cb=%d, plofs=%d, credits=%d\n", __FUNCTION__, self->uint8IterCb, ptrCb->uint16PlFlashOfs, ptrCb->uint8Deficit);
+    return 1;
+}
+
+
+
+/**
+ *  @brief SPI packet payload tail request
+ *
+ *  assembles SPI packet to request the next payload chunk of the incomplete element
+ *  at #uint32LastElemAdr. The payload is read from the end to the start, #uint16Iter
+ *  holds the payload offset of the requested chunk.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void sfcb_spi_get_pl_tail (t_sfcb *self)
+{
+    /** Variables **/
+    uint16_t    uint16Len;  // chunk size
+    uint32_t    uint32End;  // flash address after chunk
+
+    /* limit to SPI buffer and page start */
+    uint32End = (uint32_t) (self->uint32LastElemAdr + ((self->ptrCbs)[self->uint8IterCb]).uint8HeadLen + self->uint16Iter);
+    uint16Len = (uint16_t) sfcb_min((uint16_t) (self->uint16SpiMax - SFCB_FLASH_TOPO_ADR_BYTE - 1), self->uint16Iter);  // -1: IST
+    uint16Len = (uint16_t) sfcb_min((uint32_t) uint16Len, ((uint32End - 1) % SFCB_FLASH_TOPO_PAGE_SIZE) + 1);
+    self->uint16Iter = (uint16_t) (self->uint16Iter - uint16Len);
+    self->uint32IterAdr = (uint32_t) (self->uint32LastElemAdr + ((self->ptrCbs)[self->uint8IterCb]).uint8HeadLen + self->uint16Iter);
+    /* assemble packet */
+    self->uint16SpiLen = (uint16_t) (uint16Len + SFCB_FLASH_TOPO_ADR_BYTE + 1);
+    memset(self->uint8PtrSpi, 0, self->uint16SpiLen);
+    self->uint8PtrSpi[0] = SFCB_FLASH_IST_RD_DATA;
+    sfcb_adr32_uint8(self->uint32IterAdr, self->uint8PtrSpi+1, SFCB_FLASH_TOPO_ADR_BYTE);   // +1 first byte is instruction
+    sfcb_printf("  INFO:%s:FLASH: adr=0x%x, len=%i\n", __FUNCTION__, self->uint32IterAdr, uint16Len);
+}
+
+
+
+#if defined(SFCB_FLASH_TYPE_NAND)
+/**
+ *  @brief NAND address extraction
+ *
+ *  converts address bytes of an SPI packet back to an 32bit flash address,
+ *  inverse of #sfcb_adr32_uint8
+ *
+ *  @param[in]      *spi            SPI buffer, address bytes
+ *  @param[in]      adrBytes        Number of bytes for address
+ *  @return         uint32_t        flash address
+ *  @since          October 18, 2026
+ */
+static uint32_t sfcb_uint8_adr32 (const uint8_t *spi, uint8_t adrBytes)
+{
+    /** Variables **/
+    uint32_t    adr = 0;
+
+    /* on lowest index is highest byte placed */
+    for ( uint8_t i = 0; i < adrBytes; i++ ) {
+        adr = (adr << 8) | spi[i];
+    }
+    return adr;
+}
+
+
+
+/**
+ *  @brief NAND page address
+ *
+ *  translates linear flash byte address into NAND page address,
+ *  registered bad blocks are skipped
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[in]      adr                 linear flash byte address
+ *  @return         uint32_t            NAND page address
+ *  @since          October 18, 2026
+ */
+static uint32_t sfcb_nand_page (t_sfcb *self, uint32_t adr)
+{
+    /** Variables **/
+    uint32_t    uint32Blk = adr / SFCB_FLASH_TOPO_SECTOR_SIZE;  // logical block
+
+    /* skip bad blocks, list is ascending */
+    for ( uint16_t i = 0; i < self->uint16NandBbtLen; i++ ) {
+        if ( (self->ptrNandBbt)[i] <= uint32Blk ) {
+            uint32Blk++;
+        }
+    }
+    return uint32Blk * (SFCB_FLASH_TOPO_SECTOR_SIZE / SFCB_FLASH_TOPO_PAGE_SIZE) + (adr % SFCB_FLASH_TOPO_SECTOR_SIZE) / SFCB_FLASH_TOPO_PAGE_SIZE;
+}
+
+
+
+/**
+ *  @brief SPI packet NAND buffer read
+ *
+ *  assembles SPI packet to read the requested bytes from the NAND page buffer
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void sfcb_nand_spi_rd_buf (t_sfcb *self)
+{
+    self->uint16SpiLen = (uint16_t) (self->uint16NandLen - SFCB_FLASH_TOPO_ADR_BYTE + 2 + SFCB_FLASH_TOPO_NAND_RD_DUMMY);  // IST + column address + dummy
+    memset(self->uint8PtrSpi, 0, self->uint16SpiLen);
+    self->uint8PtrSpi[0] = SFCB_FLASH_IST_RD_DATA;
+    sfcb_adr32_uint8(self->uint32NandAdr % SFCB_FLASH_TOPO_PAGE_SIZE, self->uint8PtrSpi+1, 2);
+    self->nand = SFCB_NAND_CACHE_RD;
+}
+
+
+
+/**
+ *  @brief SPI packet NAND program load
+ *
+ *  assembles SPI packet to load the program data into the NAND page buffer.
+ *  First load of page clears the buffer, further loads keep the staged data.
+ *  The program is executed at page change or by #SFCB_UOP_FLUSH at job end
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void sfcb_nand_spi_prg_load (t_sfcb *self)
+{
+    /* first load of page clears buffer, random load keeps staged data */
+    self->uint8PtrSpi[0] = (UINT32_MAX == self->uint32NandStage) ? SFCB_FLASH_IST_WR_PAGE : SFCB_FLASH_IST_NAND_PRG_RND;
+    memmove(self->uint8PtrSpi+3, self->uint8PtrSpi+SFCB_FLASH_TOPO_ADR_BYTE+1, (size_t) (self->uint16NandLen - SFCB_FLASH_TOPO_ADR_BYTE - 1));  // +3: IST + column address
+    sfcb_adr32_uint8(self->uint32NandAdr % SFCB_FLASH_TOPO_PAGE_SIZE, self->uint8PtrSpi+1, 2);
+    self->uint16SpiLen = (uint16_t) (self->uint16NandLen - SFCB_FLASH_TOPO_ADR_BYTE + 2);
+    self->uint32NandStage = self->uint32NandAdr - (self->uint32NandAdr % SFCB_FLASH_TOPO_PAGE_SIZE);
+    self->uint8NandStageCb = self->uint8IterCb;
+    self->nand = SFCB_NAND_PRG_LOAD;
+}
+
+
+
+/**
+ *  @brief SPI packet NAND program execute
+ *
+ *  assembles SPI packet to program the staged page into the array,
+ *  every ECC sector of the page is loaded only once before
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void sfcb_nand_spi_prg_exe (t_sfcb *self)
+{
+    sfcb_printf("  INFO:%s:NAND: program execute, page=0x%x, cb=%d\n", __FUNCTION__, sfcb_nand_page(self, self->uint32NandStage), self->uint8NandStageCb);
+    /* execute */
+    self->uint8PtrSpi[0] = SFCB_FLASH_IST_NAND_PRG_EXE;
+    self->uint8PtrSpi[1] = 0;   // dummy
+    sfcb_adr32_uint8(sfcb_nand_page(self, self->uint32NandStage), self->uint8PtrSpi+2, 2);
+    self->uint16SpiLen = 4;
+    self->uint32NandStage = UINT32_MAX;
+    self->nand = SFCB_NAND_PRG_EXE;
+}
+
+
+
+/**
+ *  @brief NAND packet response
+ *
+ *  processes response of the translated NAND instruction sequence
+ *  and issues the next packet of the sequence. At sequence end is the
+ *  response restored to the NOR flash format expected by the worker.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         int                 sequence state
+ *  @retval         0                   sequence done, worker can process response
+ *  @retval         -1                  NAND packet pending
+ *  @since          October 18, 2026
+ */
+static int sfcb_nand_rsp (t_sfcb *self)
+{
+    switch ( self->nand ) {
+        /* status register, restore NOR response */
+        case SFCB_NAND_SR:
+            self->uint8PtrSpi[1] = self->uint8PtrSpi[2];
+            self->uint16SpiLen = 2;
+            self->nand = SFCB_NAND_IDLE;
+            return 0;
+        /* page read issued, poll busy */
+        case SFCB_NAND_PAGE_RD:
+            self->uint8PtrSpi[0] = SFCB_FLASH_IST_RD_STATE_REG;
+            self->uint8PtrSpi[1] = SFCB_FLASH_TOPO_NAND_SR_ADR;
+            self->uint8PtrSpi[2] = 0;
+            self->uint16SpiLen = 3;
+            self->nand = SFCB_NAND_PAGE_WIP;
+            return -1;
+        /* page in buffer? if yes read from buffer */
+        case SFCB_NAND_PAGE_WIP:
+            if ( 0 != (self->uint8PtrSpi[2] & SFCB_FLASH_MNG_WIP_MSK) ) {
+                self->uint8PtrSpi[0] = SFCB_FLASH_IST_RD_STATE_REG;
+                self->uint8PtrSpi[1] = SFCB_FLASH_TOPO_NAND_SR_ADR;
+                self->uint8PtrSpi[2] = 0;
+                self->uint16SpiLen = 3;
+                return -1;
+            }
+            sfcb_nand_spi_rd_buf(self);
+            return -1;
+        /* read from buffer done, restore NOR response */
+        case SFCB_NAND_CACHE_RD:
+            memmove(self->uint8PtrSpi+SFCB_FLASH_TOPO_ADR_BYTE+1, self->uint8PtrSpi+3+SFCB_FLASH_TOPO_NAND_RD_DUMMY, (size_t) (self->uint16NandLen - SFCB_FLASH_TOPO_ADR_BYTE - 1));
+            self->uint8PtrSpi[0] = SFCB_FLASH_IST_RD_DATA;
+            sfcb_adr32_uint8(self->uint32NandAdr, self->uint8PtrSpi+1, SFCB_FLASH_TOPO_ADR_BYTE);
+            self->uint16SpiLen = self->uint16NandLen;
+            self->nand = SFCB_NAND_IDLE;
+            return 0;
+        /* page buffer loaded, program is executed at page change or by #SFCB_UOP_FLUSH */
+        case SFCB_NAND_PRG_LOAD:
+            self->uint16SpiLen = self->uint16NandLen;
+            self->nand = SFCB_NAND_IDLE;
+            return 0;
+        /* staged page in program, poll busy */
+        case SFCB_NAND_PRG_EXE:
+            self->uint8PtrSpi[0] = SFCB_FLASH_IST_RD_STATE_REG;
+            self->uint8PtrSpi[1] = SFCB_FLASH_TOPO_NAND_SR_ADR;
+            self->uint8PtrSpi[2] = 0;
+            self->uint16SpiLen = 3;
+            self->nand = SFCB_NAND_PRG_WIP;
+            return -1;
+        /* program done? flush done or load next page */
+        case SFCB_NAND_PRG_WIP:
+            if ( 0 != (self->uint8PtrSpi[2] & SFCB_FLASH_MNG_WIP_MSK) ) {
+                self->uint8PtrSpi[0] = SFCB_FLASH_IST_RD_STATE_REG;
+                self->uint8PtrSpi[1] = SFCB_FLASH_TOPO_NAND_SR_ADR;
+                self->uint8PtrSpi[2] = 0;
+                self->uint16SpiLen = 3;
+                return -1;
+            }
+            if ( 0 == self->uint16NandLen ) {
+                self->uint16SpiLen = 0;
+                self->nand = SFCB_NAND_IDLE;
+                return 0;
+            }
+            self->uint8PtrSpi[0] = SFCB_FLASH_IST_WR_ENA;   // program execute cleared write enable
+            self->uint16SpiLen = 1;
+            self->nand = SFCB_NAND_PRG_WREN;
+            return -1;
+        /* load next page, data behind address is kept by the execute and poll packets */
+        case SFCB_NAND_PRG_WREN:
+            sfcb_nand_spi_prg_load(self);
+            return -1;
+        /* no sequence pending */
+        default:
+            return 0;
+    }
+}
+
+
+
+/**
+ *  @brief NAND packet request
+ *
+ *  translates the NOR flash packet from the worker into the NAND instruction
+ *  sequence. Reads are served via page buffer, programs are splitted into
+ *  program load and program execute.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void sfcb_nand_req (t_sfcb *self)
+{
+    /** Variables **/
+    uint32_t    uint32Page;     // NAND page address
+
+    /* nothing to translate */
+    if ( 0 == self->uint16SpiLen ) {
+        return;
+    }
+    /* translate instruction */
+    switch ( self->uint8PtrSpi[0] ) {
+        /* status register, needs register address */
+        case SFCB_FLASH_IST_RD_STATE_REG:
+            self->uint8PtrSpi[1] = SFCB_FLASH_TOPO_NAND_SR_ADR;
+            self->uint8PtrSpi[2] = 0;
+            self->uint16SpiLen = 3;
+            self->nand = SFCB_NAND_SR;
+            return;
+        /* read, fetch page into buffer if not present */
+        case SFCB_FLASH_IST_RD_DATA:
+            self->uint16NandLen = self->uint16SpiLen;
+            self->uint32NandAdr = sfcb_uint8_adr32(self->uint8PtrSpi+1, SFCB_FLASH_TOPO_ADR_BYTE);  // +1: IST
+            uint32Page = sfcb_nand_page(self, self->uint32NandAdr);
+            /* page buffer hit */
+            if ( uint32Page == self->uint32NandPage ) {
+                sfcb_nand_spi_rd_buf(self);
+                return;
+            }
+            sfcb_printf("  INFO:%s:NAND: page read, page=0x%x\n", __FUNCTION__, uint32Page);
+            self->uint8PtrSpi[0] = SFCB_FLASH_IST_NAND_PAGE_RD;
+            self->uint8PtrSpi[1] = 0;   // dummy
+            sfcb_adr32_uint8(uint32Page, self->uint8PtrSpi+2, 2);
+            self->uint16SpiLen = 4;
+            self->uint32NandPage = uint32Page;
+            self->nand = SFCB_NAND_PAGE_RD;
+            return;
+        /* program, stage in page buffer, other staged page is programmed first */
+        case SFCB_FLASH_IST_WR_PAGE:
+            self->uint16NandLen = self->uint16SpiLen;
+            self->uint32NandAdr = sfcb_uint8_adr32(self->uint8PtrSpi+1, SFCB_FLASH_TOPO_ADR_BYTE);  // +1: IST
+            self->uint32NandPage = UINT32_MAX;  // page buffer overwritten by load
+            if ( (UINT32_MAX != self->uint32NandStage) && ((self->uint32NandStage / SFCB_FLASH_TOPO_PAGE_SIZE) != (self->uint32NandAdr / SFCB_FLASH_TOPO_PAGE_SIZE)) ) {
+                sfcb_nand_spi_prg_exe(self);
+                return;
+            }
+            sfcb_nand_spi_prg_load(self);
+            return;
+        /* program staged page, #SFCB_UOP_FLUSH */
+        case SFCB_FLASH_IST_NAND_PRG_EXE:
+            self->uint16NandLen = 0;    // no load pending
+            sfcb_nand_spi_prg_exe(self);
+            return;
+        /* block erase */
+        case SFCB_FLASH_IST_ERASE_SECTOR:
+            uint32Page = sfcb_nand_page(self, sfcb_uint8_adr32(self->uint8PtrSpi+1, SFCB_FLASH_TOPO_ADR_BYTE));   // +1: IST
+            sfcb_printf("  INFO:%s:NAND: block erase, page=0x%x\n", __FUNCTION__, uint32Page);
+            self->uint8PtrSpi[1] = 0;   // dummy
+            sfcb_adr32_uint8(uint32Page, self->uint8PtrSpi+2, 2);
+            self->uint16SpiLen = 4;
+            self->uint32NandPage = UINT32_MAX;
+            return;
+        /* no translation required, f. e. write enable */
+        default:
+            return;
+    }
+}
+
+
+
+#endif
+
+
+
+/**
+ *  @brief CRC-16
+ *
+ *  CRC-16/CCITT-FALSE, bitwise, for small data
+ *
+ *  @param[in]      crc                 start value, 0xFFFF for new calculation
+ *  @param[in]      *data               data
+ *  @param[in]      len                 number of bytes in *data
+ *  @return         uint16_t            crc
+ *  @since          October 18, 2026
+ */
+static uint16_t sfcb_crc16 (uint16_t crc, const void *data, uint16_t len)
+{
+    for ( uint16_t i = 0; i < len; i++ ) {
+        crc = (uint16_t) (crc ^ (((const uint8_t*) data)[i] << 8));
+        for ( uint8_t j = 0; j < 8; j++ ) {
+            if ( 0 != (crc & 0x8000) ) {
+                crc = (uint16_t) ((crc << 1) ^ 0x1021);
+            } else {
+                crc = (uint16_t) (crc << 1);
+            }
+        }
+    }
+    return crc;
+}
+
+
+
+/**
+ *  @brief varint
+ *
+ *  unsigned LEB128 encoding, seven bits per byte, lowest first
+ *
+ *  @param[out]     *dst                encoded number, up to five bytes
+ *  @param[in]      val                 number
+ *  @return         uint8_t             number of bytes in *dst
+ *  @since          October 18, 2026
+ */
+static uint8_t sfcb_varint (uint8_t *dst, uint32_t val)
+{
+    /** Variables **/
+    uint8_t     uint8Len = 0;
+
+    while ( val > 0x7F ) {
+        dst[uint8Len++] = (uint8_t) (0x80 | (val & 0x7F));
+        val = val >> 7;
+    }
+    dst[uint8Len++] = (uint8_t) val;
+    return uint8Len;
+}
+
+
+
+/**
+ *  @brief export container part
+ *
+ *  assembles container header or trailer in export buffer, closes
+ *  the part with CRC-16
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void sfcb_exp_part (t_sfcb *self)
+{
+    /** Variables **/
+    const t_sfcb_cb *ptrCb = &((self->ptrCbs)[self->uint8ExpCb]);
+    uint8_t         *buf = self->ptrExpBuf;
+    uint16_t        uint16Len = 0;
+
+    if ( SFCB_EXP_HEAD == self->uint8ExpState ) {
+        memcpy(buf, SFCB_EXP_MAGIC, 4);
+        buf[4] = SFCB_EXP_VER;
+        for ( uint8_t i = 0; i < 4; i++ ) {
+            buf[5+i] = (uint8_t) (ptrCb->uint32MagicNum >> (8*i));
+        }
+        buf[9] = (uint8_t) ptrCb->uint16PlSize;
+        buf[10] = (uint8_t) (ptrCb->uint16PlSize >> 8);
+        uint16Len = (uint16_t) (SFCB_EXP_HEAD_LEN - 2);
+        self->uint16ExpCrc = sfcb_crc16(0xFFFF, buf, uint16Len);
+        buf[uint16Len++] = (uint8_t) self->uint16ExpCrc;
+        buf[uint16Len++] = (uint8_t) (self->uint16ExpCrc >> 8);
+        self->uint16ExpCrc = sfcb_crc16(0xFFFF, buf, uint16Len);  // container CRC starts
+        self->uint8ExpState = SFCB_EXP_ELEM;
+    } else {
+        buf[uint16Len++] = 0;   // zero ID delta
+        uint16Len = (uint16_t) (uint16Len + sfcb_varint(buf+uint16Len, self->uint32ExpCnt));
+        uint16Len = (uint16_t) (uint16Len + sfcb_varint(buf+uint16Len, self->uint32ExpPrevId));
+        self->uint16ExpCrc = sfcb_crc16(self->uint16ExpCrc, buf, uint16Len);
+        buf[uint16Len++] = (uint8_t) self->uint16ExpCrc;
+        buf[uint16Len++] = (uint8_t) (self->uint16ExpCrc >> 8);
+        self->uint8ExpState = SFCB_EXP_DONE;
+    }
+    *(self->ptrExpUsed) = uint16Len;
+}
+
+
+
+/**
+ *  @brief export element
+ *
+ *  payload of element is read behind #SFCB_EXP_ELEM_PRE into the export
+ *  buffer. Adds ID delta and length in front of the payload and CRC-16
+ *  behind. The written length is not stored in flash, the complete payload
+ *  is exported, trailing 0xFF bytes can be written data
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void sfcb_exp_elem (t_sfcb *self)
+{
+    /** Variables **/
+    uint8_t     *buf = self->ptrExpBuf;
+    uint8_t     uint8Pre[SFCB_EXP_ELEM_PRE];    // ID delta and length
+    uint8_t     uint8PreLen;
+    uint16_t    uint16PlLen;                    // payload
+    uint16_t    uint16Crc;
+
+    uint16PlLen = ((self->ptrCbs)[self->uint8ExpCb]).uint16PlSize;
+    uint8PreLen = sfcb_varint(uint8Pre, (self->head).uint32IdNum - self->uint32ExpPrevId);
+    uint8PreLen = (uint8_t) (uint8PreLen + sfcb_varint(uint8Pre+uint8PreLen, uint16PlLen));
+    memmove(buf+uint8PreLen, buf+SFCB_EXP_ELEM_PRE, uint16PlLen);
+    memcpy(buf, uint8Pre, uint8PreLen);
+    uint16PlLen = (uint16_t) (uint16PlLen + uint8PreLen);
+    uint16Crc = sfcb_crc16(0xFFFF, buf, uint16PlLen);
+    buf[uint16PlLen++] = (uint8_t) uint16Crc;
+    buf[uint16PlLen++] = (uint8_t) (uint16Crc >> 8);
+    self->uint16ExpCrc = sfcb_crc16(self->uint16ExpCrc, buf, uint16PlLen);
+    self->uint32ExpPrevId = (self->head).uint32IdNum;
+    (self->uint32ExpCnt)++;
+    *(self->ptrExpUsed) = uint16PlLen;
+}
+
+
+
+/**
+ *  @brief queue entry CRC
+ *
+ *  CRC over queue layout or queue management data. Layout is defined by #sfcb_new_cb
+ *  and stays unchanged, the management data changes with every job.
+ *
+ *  @param[in]      *cb                 queue entry, #t_sfcb_cb
+ *  @param[in]      state               0: layout, 1: management data with generation stamp
+ *  @return         uint16_t            crc
+ *  @since          October 18, 2026
+ */
+static uint16_t sfcb_cb_crc (const t_sfcb_cb *cb, uint8_t state)
+{
+    /** Variables **/
+    uint16_t    crc = 0xFFFF;
+
+    if ( 0 == state ) {
+        crc = sfcb_crc16(crc, &(cb->uint8Used), sizeof(cb->uint8Used));
+        if ( 0 == cb->uint8Used ) {
+            return crc; // remaining layout undefined
+        }
+        crc = sfcb_crc16(crc, &(cb->uint32MagicNum), sizeof(cb->uint32MagicNum));
+        crc = sfcb_crc16(crc, &(cb->uint32StartSector), sizeof(cb->uint32StartSector));
+        crc = sfcb_crc16(crc, &(cb->uint32StopSector), sizeof(cb->uint32StopSector));
+        crc = sfcb_crc16(crc, &(cb->uint32SlotSize), sizeof(cb->uint32SlotSize));
+        crc = sfcb_crc16(crc, &(cb->uint16NumPagesPerElem), sizeof(cb->uint16NumPagesPerElem));
+        crc = sfcb_crc16(crc, &(cb->uint16NumEntriesMax), sizeof(cb->uint16NumEntriesMax));
+        crc = sfcb_crc16(crc, &(cb->uint16PlSize), sizeof(cb->uint16PlSize));
+        crc = sfcb_crc16(crc, &(cb->uint8Fmt), sizeof(cb->uint8Fmt));
+        crc = sfcb_crc16(crc, &(cb->uint8HeadLen), sizeof(cb->uint8HeadLen));
+        return crc;
+    }
+    crc = sfcb_crc16(crc, &(cb->uint8MgmtValid), sizeof(cb->uint8MgmtValid));
+    crc = sfcb_crc16(crc, &(cb->uint32IdNumMax), sizeof(cb->uint32IdNumMax));
+    crc = sfcb_crc16(crc, &(cb->uint32IdNumMin), sizeof(cb->uint32IdNumMin));
+    crc = sfcb_crc16(crc, &(cb->uint32StartPageWrite), sizeof(cb->uint32StartPageWrite));
+    crc = sfcb_crc16(crc, &(cb->uint32StartPageIdMin), sizeof(cb->uint32StartPageIdMin));
+    crc = sfcb_crc16(crc, &(cb->uint32StartPageIdMax), sizeof(cb->uint32StartPageIdMax));
+    crc = sfcb_crc16(crc, &(cb->uint32ElemIdLastCpl), sizeof(cb->uint32ElemIdLastCpl));
+    crc = sfcb_crc16(crc, &(cb->uint16NumEntries), sizeof(cb->uint16NumEntries));
+    crc = sfcb_crc16(crc, &(cb->uint16PlFlashOfs), sizeof(cb->uint16PlFlashOfs));
+    crc = sfcb_crc16(crc, &(cb->uint32Gen), sizeof(cb->uint32Gen));
+    return crc;
+}
+
+
+
+/**
+ *  @brief management data seal
+ *
+ *  job is done, stamps management data of all queues with next generation.
+ *  Enables #sfcb_init_warm to reuse the data after reset
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void sfcb_cb_seal (t_sfcb *self)
+{
+    (self->uint32Gen)++;
+    for ( uint8_t i = 0; i < (self->uint8NumCbs); i++ ) {
+        if ( 0 == (self->ptrCbs[i]).uint8Used ) {
+            break;
+        }
+        (self->ptrCbs[i]).uint32Gen = self->uint32Gen;
+        (self->ptrCbs[i]).uint16CrcState = sfcb_cb_crc(&(self->ptrCbs[i]), 1);
+    }
+}
+
+
+
+/**
+ *  @brief VFY next queue
+ *
+ *  requests header of free element of next queue with valid retained management data.
+ *  If all queues are checked, rebuilds remaining queues with #sfcb_mkcb or finishes job
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void sfcb_vfy_next (t_sfcb *self)
+{
+    /* next queue with retained management data */
+    for ( ; self->uint8IterCb < self->uint8NumCbs; (self->uint8IterCb)++ ) {
+        if ( 0 == ((self->ptrCbs)[self->uint8IterCb]).uint8Used ) {
+            break;
+        }
+        if ( 0 != ((self->ptrCbs)[self->uint8IterCb]).uint8MgmtValid ) {
+            self->uint8SumValid = 1;    // compact header decode near newest ID
+            self->uint32SumBase = ((self->ptrCbs)[self->uint8IterCb]).uint32IdNumMax;
+            self->uint32IterAdr = ((self->ptrCbs)[self->uint8IterCb]).uint32StartPageWrite;
+            sfcb_spi_get_head(self);
+            self->stage = SFCB_STG01;
+            return;
+        }
+    }
+    /* all checked */
+    self->uint16SpiLen = 0;
+    self->cmd = SFCB_CMD_IDLE;
+    self->stage = SFCB_STG00;
+    self->uint8Busy = 0;
+    /* rebuild invalid queues */
+    for ( uint8_t i = 0; i < self->uint8NumCbs; i++ ) {
+        if ( 0 == ((self->ptrCbs)[i]).uint8Used ) {
+            break;
+        }
+        if ( 0 == ((self->ptrCbs)[i]).uint8MgmtValid ) {
+            sfcb_printf("  INFO:%s: cb=%d needs rebuild\n", __FUNCTION__, i);
+            (void) sfcb_mkcb(self);
+            return;
+        }
+    }
+}
+
+
+
+/**
+ *  @brief scrub next element
+ *
+ *  advances background scrub to the next element, after the last element
+ *  of a queue the walk goes on with the next queue
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void sfcb_scrub_next (t_sfcb *self)
+{
+    self->uint8ScrubFoot = 0;
+    (self->uint16ScrubElem)++;
+    if ( self->uint16ScrubElem < ((self->ptrCbs)[self->uint8ScrubCb]).uint16NumEntriesMax ) {
+        return;
+    }
+    (((self->ptrCbs)[self->uint8ScrubCb]).uint32ScrubPasses)++;
+    self->uint16ScrubElem = 0;
+    (self->uint8ScrubCb)++;
+    if ( !(self->uint8ScrubCb < self->uint8NumCbs) || (0 == ((self->ptrCbs)[self->uint8ScrubCb]).uint8Used) ) {
+        self->uint8ScrubCb = 0;
+    }
+}
+
+
+
+/**
+ *  @brief scrub step
+ *
+ *  idle worker: evaluates the read of the last call and requests the next
+ *  header or footer while SPI packets of the current tick are left.
+ *  Erased slots and the element in write are skipped
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void sfcb_scrub_step (t_sfcb *self)
+{
+    /** Variables **/
+    t_sfcb_cb   *ptrCb;         // queue in check
+    uint32_t    uint32Temp;     // commit word
+
+    /* evaluate read */
+    if ( 0 != self->uint8ScrubPend ) {
+        self->uint8ScrubPend = 0;
+        self->uint16SpiLen = 0;
+        self->uint8IterCb = self->uint8ScrubCb;
+        ptrCb = &((self->ptrCbs)[self->uint8ScrubCb]);
+        if ( 0 == self->uint8ScrubFoot ) {
+            sfcb_spi_head_dec(self, &(self->head));
+            if ( (self->head).uint32MagicNum != ptrCb->uint32MagicNum ) {
+                if ( 0 <= sfcb_mem_last_used(self->uint8PtrSpi+SFCB_FLASH_TOPO_ADR_BYTE+1+self->uint16HeadOfs, ptrCb->uint8HeadLen) ) {
+                    sfcb_printf("  ERROR:%s: cb=%d, damaged header at adr=0x%x\n", __FUNCTION__, self->uint8ScrubCb, self->uint32IterAdr);
+                    (ptrCb->uint32ScrubErrs)++;
+                }
+                sfcb_scrub_next(self);
+            } else if ( (self->head).uint32IdNum > ptrCb->uint32ElemIdLastCpl ) {
+                sfcb_scrub_next(self);  // element in write
+            } else if ( SFCB_FMT_COMMIT == ptrCb->uint8Fmt ) {
+                memcpy(&uint32Temp, self->uint8PtrSpi+SFCB_FLASH_TOPO_ADR_BYTE+1+sizeof(self->head), sizeof(uint32Temp));
+                (ptrCb->uint32ScrubElems)++;
+                if ( SFCB_COMMIT_WORD != uint32Temp ) {
+                    (ptrCb->uint32ScrubErrs)++;
+                }
+                sfcb_scrub_next(self);
+            } else {
+                self->uint8ScrubFoot = 1;
+            }
+        } else {
+            sfcb_spi_head_dec(self, &(self->foot));
+            (ptrCb->uint32ScrubElems)++;
+            if ( 0 != memcmp(&(self->foot), &(self->head), sizeof(self->head)) ) {
+                sfcb_printf("  ERROR:%s: cb=%d, id=%d, footer mismatch\n", __FUNCTION__, self->uint8ScrubCb, (self->head).uint32IdNum);
+                (ptrCb->uint32ScrubErrs)++;
+            }
+            sfcb_scrub_next(self);
+        }
+    }
+    /* refill budget */
+    if ( (self->uint32WkrCalls - self->uint32ScrubTick) >= self->uint32ScrubCalls ) {
+        self->uint32ScrubTick = self->uint32WkrCalls;
+        self->uint16ScrubCredit = self->uint16ScrubPkts;
+    }
+    if ( (0 == self->uint16ScrubCredit) || !(self->uint8ScrubCb < self->uint8NumCbs) ) {
+        return;
+    }
+    /* queue with valid management data */
+    ptrCb = &((self->ptrCbs)[self->uint8ScrubCb]);
+    if ( (0 == ptrCb->uint8Used) || (0 == ptrCb->uint8MgmtValid) ) {
+        self->uint16ScrubElem = 0;
+        self->uint8ScrubFoot = 0;
+        (self->uint8ScrubCb)++;
+        if ( !(self->uint8ScrubCb < self->uint8NumCbs) || (0 == ((self->ptrCbs)[self->uint8ScrubCb]).uint8Used) ) {
+            self->uint8ScrubCb = 0;
+        }
+        return;
+    }
+    /* request header or footer */
+    self->uint8IterCb = self->uint8ScrubCb;
+    self->uint32IterAdr = sfcb_flash_adr_head(self, self->uint16ScrubElem);
+    if ( 0 == self->uint8ScrubFoot ) {
+        self->uint8SumValid = 1;    // compact header decode near newest ID
+        self->uint32SumBase = ptrCb->uint32IdNumMax;
+    } else {
+        self->uint32IterAdr = self->uint32IterAdr + ptrCb->uint32SlotSize - ptrCb->uint8HeadLen;
+    }
+    sfcb_spi_get_head(self);
+    (self->uint16ScrubCredit)--;
+    self->uint8ScrubPend = 1;
+}
+
+
+
+/**
+ *  @brief deferred burst start
+ *
+ *  idle worker: posts the consecutive records of every deferred queue with
+ *  reached threshold, age or flush request. A queue without allocated slot
+ *  is prepared first by #sfcb_add_done or #sfcb_mkcb
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void sfcb_defer_flush (t_sfcb *self)
+{
+    /** Variables **/
+    t_sfcb_cb   *ptrCb;         // deferred queue
+    uint16_t    uint16Recs;     // records in burst
+
+    for ( uint8_t i = 0; i < self->uint8NumCbs; i++ ) {
+        ptrCb = &((self->ptrCbs)[i]);
+        if ( 0 == ptrCb->uint8Used ) {
+            break;
+        }
+        /* burst due? records stay in ring while erase is blocked by pin */
+        if (    (NULL == ptrCb->ptrDefRing) || (0 == ptrCb->uint16DefCnt) || (0 != ptrCb->uint8PostPend) || (0 != ptrCb->uint8PinFull)
+             || (    (ptrCb->uint16DefCnt < ptrCb->uint16DefThr)
+                  && (0 == ptrCb->uint8DefForce)
+                  && ((0 == ptrCb->uint32DefAge) || ((self->uint32WkrCalls - ptrCb->uint32DefTick) < ptrCb->uint32DefAge))
+                )
+        ) {
+            continue;
+        }
+        /* no free slot, prepare queue if no burst is started */
+        if ( (0 == ptrCb->uint8MgmtValid) || (0 != ptrCb->uint16PlFlashOfs) ) {
+            if ( 0 != self->uint8Busy ) {
+                continue;
+            }
+            sfcb_printf("  INFO:%s: cb=%d, prepare queue for burst\n", __FUNCTION__, i);
+            if ( (0 != ptrCb->uint8MgmtValid) && (ptrCb->uint16PlFlashOfs <= (ptrCb->uint16PlSize + ptrCb->uint8HeadLen)) ) {
+                (void) sfcb_add_done(self, i);  // close element of #sfcb_add
+            } else {
+                ptrCb->uint8MgmtValid = 0;
+                (void) sfcb_mkcb(self);
+            }
+            return;
+        }
+        /* consecutive records up to ring end, fits into one element */
+        uint16Recs = (uint16_t) sfcb_min(ptrCb->uint16DefCnt, (uint16_t) (ptrCb->uint16DefRecs - ptrCb->uint16DefFirst));
+        uint16Recs = (uint16_t) sfcb_min(uint16Recs, (uint16_t) (ptrCb->uint16PlSize / ptrCb->uint16DefRecLen));
+        if ( SFCB_OK == sfcb_add_post(self, i, ptrCb->ptrDefRing + (uint32_t) ptrCb->uint16DefFirst * ptrCb->uint16DefRecLen, (uint16_t) (uint16Recs * ptrCb->uint16DefRecLen)) ) {
+            ptrCb->uint16DefBurst = uint16Recs;
+            sfcb_printf("  INFO:%s: cb=%d, burst of %d records\n", __FUNCTION__, i, uint16Recs);
+        }
+    }
+}
+
+
+
+/**
+ *  @brief read request scheduler
+ *
+ *  starts read of oldest pending request, merged with all pending requests
+ *  of adjacent or overlapping flash ranges as long as the read fits into
+ *  the SPI buffer
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void sfcb_read_sched (t_sfcb *self)
+{
+    /** Variables **/
+    t_sfcb_rd   *ptrRd;         // request in check
+    uint32_t    uint32Lo;       // start of merged read
+    uint32_t    uint32Hi;       // end of merged read
+    uint32_t    uint32Lo2;      // start with request
+    uint32_t    uint32Hi2;      // end with request
+    uint8_t     uint8Merged;    // read range extended
+    uint8_t     uint8First;     // first pending request
+
+    /* idle required */
+    if ( (NULL == self->ptrRdQ) || (0 != self->uint8Busy) || (SFCB_CMD_IDLE != self->cmd) ) {
+        return;
+    }
+    for ( uint8First = 0; uint8First < self->uint8RdQLen; uint8First++ ) {
+        if ( SFCB_RD_PEND == (self->ptrRdQ)[uint8First].state ) {
+            break;
+        }
+    }
+    if ( uint8First == self->uint8RdQLen ) {
+        return;
+    }
+    uint32Lo = (self->ptrRdQ)[uint8First].adr;
+    uint32Hi = uint32Lo + (self->ptrRdQ)[uint8First].len;
+    (self->ptrRdQ)[uint8First].state = SFCB_RD_XFER;
+    /* merge until no further request fits, extended range can touch skipped requests */
+    do {
+        uint8Merged = 0;
+        for ( uint8_t i = 0; i < self->uint8RdQLen; i++ ) {
+            ptrRd = &((self->ptrRdQ)[i]);
+            if ( (SFCB_RD_PEND != ptrRd->state) || (ptrRd->adr > uint32Hi) || (ptrRd->adr + ptrRd->len < uint32Lo) ) {
+                continue;
+            }
+            uint32Lo2 = sfcb_min(uint32Lo, ptrRd->adr);
+            uint32Hi2 = sfcb_max(uint32Hi, ptrRd->adr + ptrRd->len);
+            if ( (uint32Hi2 - uint32Lo2) > (uint32_t) (self->uint16SpiMax - SFCB_FLASH_TOPO_ADR_BYTE - 1) ) {  // -1: IST
+                continue;
+            }
+#if defined(SFCB_FLASH_TYPE_NAND)
+            /* NAND reads through page buffer */
+            if ( (uint32Lo2 / SFCB_FLASH_TOPO_PAGE_SIZE) != ((uint32Hi2 - 1) / SFCB_FLASH_TOPO_PAGE_SIZE) ) {
+                continue;
+            }
+#endif
+            uint32Lo = uint32Lo2;
+            uint32Hi = uint32Hi2;
+            ptrRd->state = SFCB_RD_XFER;
+            uint8Merged = 1;
+        }
+    } while ( 0 != uint8Merged );
+    sfcb_printf("  INFO:%s: merged read, adr=0x%x, len=%d\n", __FUNCTION__, uint32Lo, uint32Hi - uint32Lo);
+    /* Setup new Job */
+    self->uint32IterAdr = uint32Lo;
+    self->uint16CbElemPlSize = (uint16_t) (uint32Hi - uint32Lo);
+    (self->uint32RdXfers)++;
+    self->uint8Busy = 1;
+    self->cmd = SFCB_CMD_RDQ;
+    self->stage = SFCB_STG00;
+    self->ptrUcode = g_sfcbUcodeRdq;
+    self->uint8UcPc = 0;
+    self->error = SFCB_E_NOERO;
+}
+
+
+
+/**
+ *  @brief deep power-down release
+ *
+ *  releases the flash from deep power-down if a job or background scrub
+ *  is pending and waits the wake-up time
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         int                 state
+ *  @retval         0                   flash powered up, process request
+ *  @retval         1                   SPI packet assembled or wait
+ *  @since          October 18, 2026
+ */
+static int sfcb_dpd_wake (t_sfcb *self)
+{
+    switch (self->dpd) {
+        /* release if required */
+        case SFCB_DPD_SLEEP:
+            if ( (SFCB_CMD_IDLE == self->cmd) && (0 == self->uint16ScrubPkts) ) {
+                self->uint16SpiLen = 0;
+                return 1;
+            }
+            sfcb_printf("  INFO:%s: release from deep power-down\n", __FUNCTION__);
+            self->uint8PtrSpi[0] = SFCB_FLASH_IST_PWR_UP;
+            self->uint16SpiLen = 1;
+            self->uint32DpdTick = self->uint32WkrCalls;
+            self->dpd = SFCB_DPD_WAKE;
+            return 1;
+        /* wake-up time */
+        case SFCB_DPD_WAKE:
+            self->uint16SpiLen = 0;
+            if ( (self->uint32WkrCalls - self->uint32DpdTick) <= self->uint32DpdWake ) {
+                return 1;
+            }
+            self->dpd = SFCB_DPD_AWAKE;
+            return 0;
+        /* powered up */
+        default:
+            return 0;
+    }
+}
+
+
+
+/**
+ *  @brief handle init
+ *
+ *  initializes handle without circular buffer queue list
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[in,out]  *cb                 pointer to circular buffer list
+ *  @param[in]      cbLen               number of maximum allowed circular buffers
+ *  @param[in,out]  *spi                pointer to uint8_t SPI interaction buffer
+ *  @param[in]      spiLen              maximum number of elements in buffer => size in byte
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            OKAY
+ *  @retval         #SFCB_E_NO_FLASH    Invalid Flash Type
+ *  @retval         #SFCB_E_MEM         SPI buffer too small
+ *  @since          October 18, 2026
+ */
+static int sfcb_init_hdl (t_sfcb *self, void *cb, uint8_t cbLen, void *spi, uint16_t spiLen)
+{
+    /* check if provided flash type is valid */
+    if ( 0 == (sizeof(SFCB_FLASH_NAME) - 1) ) {
+        sfcb_printf("  ERROR:%s: no flash type selected\n", __FUNCTION__);
+        return SFCB_E_NO_FLASH; // no flash type selected, use proper compile switch
+    }
+    sfcb_printf("  INFO:%s: flash '%s' selected\n", __FUNCTION__, SFCB_FLASH_NAME);
+    /* set up list of flash circular buffers */
+    self->uint8NumCbs = cbLen;
+    self->uint16SpiLen = 0;
+    self->uint8Busy = 0;
+    self->cmd = SFCB_CMD_IDLE;  // free for request
+    self->stage = SFCB_STG00;
+    self->ptrCbs = (t_sfcb_cb*) cb;     // circular buffer element array
+    self->uint8PtrSpi = (uint8_t*) spi; // uint8 array
+    self->uint16SpiMax = spiLen;        // max array length
+    self->error = SFCB_E_NOERO;
+    self->ptrCbElemPl = NULL;
+    self->uint16CbElemPlSize = 0;
+    self->ptrIov = NULL;
+    self->uint8IovCnt = 0;
+    self->nand = SFCB_NAND_IDLE;
+    self->uint32NandPage = UINT32_MAX;  // page buffer invalid
+    self->uint32NandStage = UINT32_MAX; // no program staged
+    self->uint8NandStageCb = 0;
+    self->ptrNandBbt = NULL;
+    self->uint16NandBbtLen = 0;
+    self->uint8Sched = 0;
+    self->uint32WkrCalls = 0;
+    self->uint32Gen = 0;
+    self->uint16ScrubPkts = 0;  // background scrub disabled
+    self->uint32ScrubCalls = 1;
+    self->uint16ScrubCredit = 0;
+    self->uint32ScrubTick = 0;
+    self->uint8ScrubCb = 0;
+    self->uint16ScrubElem = 0;
+    self->uint8ScrubFoot = 0;
+    self->uint8ScrubPend = 0;
+    self->uint8DpdEna = 0;      // deep power-down disabled
+    self->uint32DpdWake = 0;
+    self->dpd = SFCB_DPD_AWAKE;
+    self->uint32DpdTick = 0;
+    self->uint8Quad = 0;        // single lane page program
+    self->uint8Sr2 = 0;
+    self->ptrRdQ = NULL;        // no read requests
+    self->uint8RdQLen = 0;
+    self->uint32RdXfers = 0;
+    self->uint32BlankLen = 0;
+    self->ptrBlankAdr = NULL;
+    self->uint8ExpState = SFCB_EXP_IDLE;   // no export
+    self->ptrUcode = NULL;
+    self->uint8UcPc = 0;
+    /* memory addresses */
+    sfcb_printf("  INFO:%s:sfcb:spi_p            = %p\n", __FUNCTION__, self->uint8PtrSpi); // spi buffer
+    /* SPI buffer needs at least space for one page and address and instruction */
+    if ( (SFCB_FLASH_TOPO_PAGE_SIZE + SFCB_FLASH_TOPO_ADR_BYTE + 1) > self->uint16SpiMax ) {
+        sfcb_printf("  ERROR:%s: spi buffer to small, is=%d byte, req=%d byte\n", __FUNCTION__, self->uint16SpiMax, SFCB_FLASH_TOPO_PAGE_SIZE + SFCB_FLASH_TOPO_ADR_BYTE + 1);
+        return SFCB_E_MEM;  // not enough SPI buffer to write at least one complete page to flash
+    }
+    return SFCB_OK;
+}
+
+
+
+/**
+ *  sfcb_init
+ *    initializes handle
+ */
+int sfcb_init (t_sfcb *self, void *cb, uint8_t cbLen, void *spi, uint16_t spiLen)
+{
+    /** Variables **/
+    int     ero;    // handle init state
+
+    /* Function call message */
+    sfcb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* handle */
+    ero = sfcb_init_hdl(self, cb, cbLen, spi, spiLen);
+    if ( SFCB_OK != ero ) {
+        return ero;
+    }
+    /* init circular buffer handles */
+    for ( uint8_t i = 0; i < (self->uint8NumCbs); i++ ) {
+        (self->ptrCbs[i]).uint8Used = 0;
+        (self->ptrCbs[i]).uint8MgmtValid = 0;
+        (self->ptrCbs[i]).uint8PostPend = 0;
+        (self->ptrCbs[i]).ptrDefRing = NULL;
+        (self->ptrCbs[i]).uint16DefCnt = 0;
+        (self->ptrCbs[i]).ptrXfrm = NULL;
+        (self->ptrCbs[i]).uint8XfrmNum = 0;
+        (self->ptrCbs[i]).uint8XfrmMeta = 0;
+        (self->ptrCbs[i]).uint8Pin = 0;
+        (self->ptrCbs[i]).uint8PinFull = 0;
+        (self->ptrCbs[i]).uint16CrcLayout = sfcb_cb_crc(&(self->ptrCbs[i]), 0);  // unused entry is part of layout
+        sfcb_printf("  INFO:%s:ptrCbs[%i]_p           = %p\n", __FUNCTION__, i, (&self->ptrCbs[i]));                    // unit test output
+        sfcb_printf("  INFO:%s:ptrCbs[%i].uint8Used_p = %p\n", __FUNCTION__, i, &((self->ptrCbs[i]).uint8Used));        // output address
+        sfcb_printf("  INFO:%s:ptrCbs[%i].uint8Init_p = %p\n", __FUNCTION__, i, &((self->ptrCbs[i]).uint8MgmtValid));   // output address
+    }
+    /* normal end */
+    return SFCB_OK;
+}
+
+
+
+/**
+ *  sfcb_init_warm
+ *    initializes flash circular buffer with retained management data
+ */
+int sfcb_init_warm (t_sfcb *self, void *cb, uint8_t cbLen, void *spi, uint16_t spiLen)
+{
+    /** Variables **/
+    int         ero;            // handle init state
+    uint8_t     uint8Last = 0;  // previous entry used
+    uint32_t    uint32Gen = 0;  // newest generation stamp
+
+    /* Function call message */
+    sfcb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* handle */
+    ero = sfcb_init_hdl(self, cb, cbLen, spi, spiLen);
+    if ( SFCB_OK != ero ) {
+        return ero;
+    }
+    /* check layout, used queues are allocated from first entry */
+    for ( uint8_t i = 0; i < (self->uint8NumCbs); i++ ) {
+        if (    ((self->ptrCbs[i]).uint16CrcLayout != sfcb_cb_crc(&(self->ptrCbs[i]), 0))
+             || ((0 != (self->ptrCbs[i]).uint8Used) && (0 != i) && (0 == uint8Last))
+        ) {
+            sfcb_printf("  ERROR:%s: layout of cb=%d invalid, cold start required\n", __FUNCTION__, i);
+            for ( uint8_t j = 0; j < (self->uint8NumCbs); j++ ) {
+                (self->ptrCbs[j]).uint8Used = 0;
+                (self->ptrCbs[j]).uint8MgmtValid = 0;
+                (self->ptrCbs[j]).uint8PostPend = 0;
+                (self->ptrCbs[j]).ptrDefRing = NULL;
+                (self->ptrCbs[j]).uint16DefCnt = 0;
+                (self->ptrCbs[j]).ptrXfrm = NULL;
+                (self->ptrCbs[j]).uint8XfrmNum = 0;
+                (self->ptrCbs[j]).uint8XfrmMeta = 0;
+                (self->ptrCbs[j]).uint8Pin = 0;
+                (self->ptrCbs[j]).uint8PinFull = 0;
+                (self->ptrCbs[j]).uint16CrcLayout = sfcb_cb_crc(&(self->ptrCbs[j]), 0);
+            }
+            return SFCB_E_WKR_REQ;
+        }
+        uint8Last = (self->ptrCbs[i]).uint8Used;
+        if ( (0 != (self->ptrCbs[i]).uint8Used) && ((int32_t) ((self->ptrCbs[i]).uint32Gen - uint32Gen) > 0) ) {
+            uint32Gen = (self->ptrCbs[i]).uint32Gen;
+        }
+    }
+    self->uint32Gen = uint32Gen;
+    /* check management data, interrupted job or stale seal requires rebuild */
+    for ( uint8_t i = 0; i < (self->uint8NumCbs); i++ ) {
+        (self->ptrCbs[i]).uint8PostPend = 0;    // posted writes lost with reset
+        (self->ptrCbs[i]).ptrDefRing = NULL;    // deferred records lost with reset
+        (self->ptrCbs[i]).uint16DefCnt = 0;
+        (self->ptrCbs[i]).ptrXfrm = NULL;       // transform stages registered again by application
+        (self->ptrCbs[i]).uint8XfrmNum = 0;
+        (self->ptrCbs[i]).uint8XfrmMeta = 0;
+        (self->ptrCbs[i]).uint8Pin = 0;         // readers pin again
+        if (    ((self->ptrCbs[i]).uint16CrcState != sfcb_cb_crc(&(self->ptrCbs[i]), 1))
+             || ((self->ptrCbs[i]).uint32Gen != uint32Gen)
+             || (0 != (self->ptrCbs[i]).uint8PinFull)   // blocked erase, no free element
+        ) {
+            (self->ptrCbs[i]).uint8PinFull = 0;
+            (self->ptrCbs[i]).uint8MgmtValid = 0;
+        }
+        sfcb_printf("  INFO:%s: cb=%d, used=%d, valid=%d, gen=%d\n", __FUNCTION__, i, (self->ptrCbs[i]).uint8Used, (self->ptrCbs[i]).uint8MgmtValid, (self->ptrCbs[i]).uint32Gen);
+    }
+    /* Setup new Job */
+    self->uint8IterCb = 0;
+    self->cmd = SFCB_CMD_VFY;
+    self->stage = SFCB_STG00;
+    self->error = SFCB_E_NOERO;
+    self->uint8Busy = 1;
+    return SFCB_OK;
+}
+
+
+
+/**
+ *  @brief erase step
+ *
+ *  assembles erase of the oldest queue element, the erase unit is selected
+ *  by #sfcb_reclaim_size. Erase-less flashes overwrite the oldest element
+ *  with erased pattern, one chunk of the SPI buffer per packet
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         int                 erase state
+ *  @retval         0                   last packet
+ *  @retval         -1                  further packets pending
+ *  @since          October 18, 2026
+ */
+static int sfcb_erase_step (t_sfcb *self)
+{
+    /** Variables **/
+    uint32_t    uint32Temp;     // temporary 32bit variable
+#if defined(SFCB_FLASH_TYPE_NOERASE)
+    uint16_t    uint16CpyLen;   // fill chunk length
+#endif
+
+    /* rescan of queue starts at first element */
+    self->uint16Iter = 0;
+#if defined(SFCB_FLASH_TYPE_NOERASE)
+    /* erase-less, overwrite oldest element with erased pattern */
+    uint32Temp = ((self->ptrCbs)[self->uint8IterCb]).uint32StartPageIdMin + ((self->ptrCbs)[self->uint8IterCb]).uint32SlotSize;   // end of oldest element
+    uint16CpyLen = (uint16_t) sfcb_min((uint32_t) (self->uint16SpiMax - SFCB_FLASH_TOPO_ADR_BYTE - 1), uint32Temp - self->uint32IterAdr);   // -1: IST
+    sfcb_printf("  INFO:%s: Fill oldest element, adr=0x%x, len=%d\n", __FUNCTION__, self->uint32IterAdr, uint16CpyLen);
+    self->uint8PtrSpi[0] = SFCB_FLASH_IST_WR_PAGE;
+    sfcb_adr32_uint8(self->uint32IterAdr, self->uint8PtrSpi+1, SFCB_FLASH_TOPO_ADR_BYTE);   // +1 first byte is instruction
+    memset(self->uint8PtrSpi+SFCB_FLASH_TOPO_ADR_BYTE+1, 0xFF, uint16CpyLen);
+    self->uint16SpiLen = (uint16_t) (uint16CpyLen + SFCB_FLASH_TOPO_ADR_BYTE + 1);
+    self->uint32IterAdr = self->uint32IterAdr + uint16CpyLen;
+    /* fill pending */
+    if ( self->uint32IterAdr < uint32Temp ) {
+        return -1;
+    }
+    return 0;
+#else
+    sfcb_printf( "  INFO:%s: cb=%d, erase uint32StartPageIdMin=0x%x\n",
+                 __FUNCTION__,
+                 self->uint8IterCb,
+                 ((self->ptrCbs)[self->uint8IterCb]).uint32StartPageIdMin
+                );
+    uint32Temp = sfcb_reclaim_size(self);   // sector or block
+    self->uint8PtrSpi[0] = (32768 == uint32Temp) ? SFCB_FLASH_IST_ERASE_BLK32 : ((65536 == uint32Temp) ? SFCB_FLASH_IST_ERASE_BLK64 : SFCB_FLASH_IST_ERASE_SECTOR);
+    uint32Temp = ((self->ptrCbs[self->uint8IterCb]).uint32StartPageIdMin & (uint32_t) ~(uint32Temp - 1));  // startpage of oldest entry, align to erase unit
+    sfcb_adr32_uint8(uint32Temp, self->uint8PtrSpi+1, SFCB_FLASH_TOPO_ADR_BYTE);    // +1 first byte is instruction
+    self->uint16SpiLen = SFCB_FLASH_TOPO_ADR_BYTE + 1;  // address + instruction
+    return 0;
+#endif
+}
+
+
+
+/**
+ *  @brief header/footer program
+ *
+ *  checks if next program of the element in write is header or footer
+ *
+ *  @param[in]      self                handle, #t_sfcb
+ *  @return         uint8_t             program
+ *  @retval         0                   payload
+ *  @retval         1                   header or footer
+ *  @since          October 18, 2026
+ */
+static uint8_t sfcb_add_head_foot (const t_sfcb *self)
+{
+    return (uint8_t) (    (self->uint32IterAdr == ((self->ptrCbs)[self->uint8IterCb]).uint32StartPageWrite)   // Start of Circular Buffer Write
+                       || (((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs == (((self->ptrCbs)[self->uint8IterCb]).uint16PlSize + ((self->ptrCbs)[self->uint8IterCb]).uint8HeadLen))  // End of Circular Buffer Write
+                     );
+}
+
+
+
+/**
+ *  @brief next program
+ *
+ *  selects queue of posted writes and checks for pending program of the
+ *  element. Written footer completes the element in management data
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         int                 state
+ *  @retval         0                   program pending
+ *  @retval         -1                  element written or no posted write
+ *  @since          October 18, 2026
+ */
+static int sfcb_add_next (t_sfcb *self)
+{
+    /* posted writes, select queue for next page program */
+    if ( (0 != self->uint8Sched) && (0 == sfcb_sched(self)) ) {
+        self->uint8Sched = 0;
+        return -1;
+    }
+#if defined(SFCB_FLASH_TYPE_NAND)
+    /* payload written, footer in same job, element is programmed once */
+    if (    (0 != ((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs)
+         && (self->uint16Iter == self->uint16CbElemPlSize)
+         && (((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs < (((self->ptrCbs)[self->uint8IterCb]).uint16PlSize + ((self->ptrCbs)[self->uint8IterCb]).uint8HeadLen))
+    ) {
+        ((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs = (uint16_t) (((self->ptrCbs)[self->uint8IterCb]).uint16PlSize + ((self->ptrCbs)[self->uint8IterCb]).uint8HeadLen);
+    }
+#endif
+    /* Header/Footer or Payload */
+    if ( (0 != sfcb_add_head_foot(self)) || (self->uint16Iter < self->uint16CbElemPlSize) ) {
+        return 0;
+    }
+    /* footer written, element is complete, update queue statistic */
+    if ( ((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs == (((self->ptrCbs)[self->uint8IterCb]).uint16PlSize + ((self->ptrCbs)[self->uint8IterCb]).uint8HeadLen + 1) ) {
+        sfcb_cb_commit(self);
+    }
+    return -1;
+}
+
+
+
+/**
+ *  @brief program
+ *
+ *  assembles page program of header, footer or payload chunk selected
+ *  by #sfcb_add_next, write enable is issued before
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void sfcb_add_prog (t_sfcb *self)
+{
+    /** Variables **/
+    uint16_t    uint16PagesBytesAvail;  // number of used page bytes
+    uint16_t    uint16CpyLen;           // number of Bytes to copy
+    uint32_t    uint32Temp;             // temporary 32bit variable
+
+    /* Page Write of Payload */
+    if ( 0 == sfcb_add_head_foot(self) ) {
+        sfcb_printf("  INFO:%s:ADD: Page Write to Circular Buffer, adr=0x%x, payload,len=%d\n", __FUNCTION__, self->uint32IterAdr, self->uint16CbElemPlSize);
+        /* assemble Flash Instruction packet */
+        self->uint8PtrSpi[0] = sfcb_ist_wr_page(self);  // write page
+        sfcb_adr32_uint8(self->uint32IterAdr, self->uint8PtrSpi+1, SFCB_FLASH_TOPO_ADR_BYTE);   // +1 first byte is instruction
+        self->uint16SpiLen = SFCB_FLASH_TOPO_ADR_BYTE + 1;  // +1: IST
+        /* get available bytes in page */
+#if defined(SFCB_FLASH_TYPE_NOERASE)
+        uint16PagesBytesAvail = (uint16_t) (self->uint16SpiMax - SFCB_FLASH_TOPO_ADR_BYTE - 1);    // no pages, limited by SPI buffer
+#else
+        uint16PagesBytesAvail = (uint16_t) (SFCB_FLASH_TOPO_PAGE_SIZE - (self->uint32IterAdr % SFCB_FLASH_TOPO_PAGE_SIZE));
+#endif
+        /* determine number of bytes to copy */
+        if ( (self->uint16CbElemPlSize - self->uint16Iter) > uint16PagesBytesAvail ) {
+            uint16CpyLen = uint16PagesBytesAvail;
+        } else {
+            uint16CpyLen = (uint16_t) (self->uint16CbElemPlSize - self->uint16Iter);
+        }
+        self->uint16Iter = (uint16_t) (self->uint16Iter + uint16CpyLen);
+        /* assemble packet, gather fragments */
+        sfcb_spi_cpy_iov(self, uint16CpyLen);
+        sfcb_xfrm_chunk(&((self->ptrCbs)[self->uint8IterCb]), self->uint8PtrSpi+self->uint16SpiLen-uint16CpyLen, uint16CpyLen, SFCB_XFRM_ENC);
+        /* increment iterators */
+        ((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs = (uint16_t) (((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs + self->uint16SpiLen - SFCB_FLASH_TOPO_ADR_BYTE - 1);   // payload internal flash offset
+        self->uint32IterAdr = self->uint32IterAdr + self->uint16SpiLen - SFCB_FLASH_TOPO_ADR_BYTE - 1;  // inc flash address by written data, reduced by SPI Flash instruction
+        return;
+    }
+    /* Page Write of Header/Footer */
+    sfcb_printf("  INFO:%s:ADD: Write Header/Footer to Flash, adr=0x%x, payload,len=%d\n", __FUNCTION__, self->uint32IterAdr, (uint32_t) sizeof(self->head));
+    /* assemble Header/ Footer */
+    memset(&(self->head), 0, sizeof(self->head)); // make empty
+    (self->head).uint32MagicNum = ((self->ptrCbs)[self->uint8IterCb]).uint32MagicNum;
+    (self->head).uint32IdNum = ((self->ptrCbs)[self->uint8IterCb]).uint32IdNumMax + 1;
+    /* Page Write */
+    self->uint8PtrSpi[0] = sfcb_ist_wr_page(self);
+    self->uint16SpiLen = 1;
+#if defined(SFCB_FLASH_TYPE_NOERASE)
+    /* complete element fits into SPI buffer, write header, payload and footer in one transaction */
+    if (    (0 == ((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs)
+         && (SFCB_FMT_HEAD_FOOT == ((self->ptrCbs)[self->uint8IterCb]).uint8Fmt)
+         && (0 == ((self->ptrCbs)[self->uint8IterCb]).uint8XfrmNum)
+         && (self->uint16CbElemPlSize == ((self->ptrCbs)[self->uint8IterCb]).uint16PlSize)
+         && ((uint32_t) (self->uint16CbElemPlSize + 2*sizeof(self->head) + SFCB_FLASH_TOPO_ADR_BYTE + 1) <= self->uint16SpiMax)
+    ) {
+        sfcb_adr32_uint8(self->uint32IterAdr, self->uint8PtrSpi+self->uint16SpiLen, SFCB_FLASH_TOPO_ADR_BYTE);
+        self->uint16SpiLen = (uint16_t) (self->uint16SpiLen + SFCB_FLASH_TOPO_ADR_BYTE);
+        memcpy((self->uint8PtrSpi+self->uint16SpiLen), &(self->head), sizeof(self->head));
+        self->uint16SpiLen = (uint16_t) (self->uint16SpiLen + sizeof(self->head));
+        sfcb_spi_cpy_iov(self, self->uint16CbElemPlSize);
+        memcpy((self->uint8PtrSpi+self->uint16SpiLen), &(self->head), sizeof(self->head));   // footer
+        self->uint16SpiLen = (uint16_t) (self->uint16SpiLen + sizeof(self->head));
+        /* update iterators, same state as after footer write */
+        self->uint16Iter = self->uint16CbElemPlSize;
+        ((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs = (uint16_t) (self->uint16CbElemPlSize + sizeof(self->head) + 1);
+        self->uint32IterAdr = self->uint32IterAdr + ((self->ptrCbs)[self->uint8IterCb]).uint32SlotSize;
+        return;
+    }
+#endif
+    /* commit word format: header with first payload chunk, commit by program of commit word */
+    if ( SFCB_FMT_COMMIT == ((self->ptrCbs)[self->uint8IterCb]).uint8Fmt ) {
+        if ( ((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs == (((self->ptrCbs)[self->uint8IterCb]).uint16PlSize + ((self->ptrCbs)[self->uint8IterCb]).uint8HeadLen) ) {
+            uint32Temp = SFCB_COMMIT_WORD;
+            sfcb_adr32_uint8(((self->ptrCbs)[self->uint8IterCb]).uint32StartPageWrite + (uint32_t) sizeof(self->head), self->uint8PtrSpi+self->uint16SpiLen, SFCB_FLASH_TOPO_ADR_BYTE);
+            self->uint16SpiLen = (uint16_t) (self->uint16SpiLen + SFCB_FLASH_TOPO_ADR_BYTE);
+            memcpy((self->uint8PtrSpi+self->uint16SpiLen), &uint32Temp, sizeof(uint32Temp));
+            self->uint16SpiLen = (uint16_t) (self->uint16SpiLen + sizeof(uint32Temp));
+            ++(((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs);   // commit is only entered one time
+        } else {
+            sfcb_adr32_uint8(self->uint32IterAdr, self->uint8PtrSpi+self->uint16SpiLen, SFCB_FLASH_TOPO_ADR_BYTE);
+            self->uint16SpiLen = (uint16_t) (self->uint16SpiLen + SFCB_FLASH_TOPO_ADR_BYTE);
+            memcpy((self->uint8PtrSpi+self->uint16SpiLen), &(self->head), sizeof(self->head));
+            self->uint16SpiLen = (uint16_t) (self->uint16SpiLen + sizeof(self->head));
+            memset((self->uint8PtrSpi+self->uint16SpiLen), 0xFF, sizeof(uint32_t));  // commit word stays erased
+            self->uint16SpiLen = (uint16_t) (self->uint16SpiLen + sizeof(uint32_t));
+            /* first payload chunk up to page end, untransformed, #sfcb_xfrm rejects format */
+#if defined(SFCB_FLASH_TYPE_NOERASE)
+            uint16PagesBytesAvail = (uint16_t) (self->uint16SpiMax - self->uint16SpiLen);
+#else
+            uint16PagesBytesAvail = (uint16_t) (SFCB_FLASH_TOPO_PAGE_SIZE - ((self->uint32IterAdr + ((self->ptrCbs)[self->uint8IterCb]).uint8HeadLen) % SFCB_FLASH_TOPO_PAGE_SIZE));
+#endif
+            uint16CpyLen = (uint16_t) sfcb_min(uint16PagesBytesAvail, (uint16_t) (self->uint16CbElemPlSize - self->uint16Iter));
+            self->uint16Iter = (uint16_t) (self->uint16Iter + uint16CpyLen);
+            sfcb_spi_cpy_iov(self, uint16CpyLen);
+            ((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs = (uint16_t) (((self->ptrCbs)[self->uint8IterCb]).uint8HeadLen + uint16CpyLen);
+            self->uint32IterAdr = self->uint32IterAdr + ((self->ptrCbs)[self->uint8IterCb]).uint8HeadLen + uint16CpyLen;
+        }
+        return;
+    }
+    /* Footer? */
+    if ( ((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs == (((self->ptrCbs)[self->uint8IterCb]).uint16PlSize + ((self->ptrCbs)[self->uint8IterCb]).uint8HeadLen) ) {
+        self->uint32IterAdr =   ((self->ptrCbs)[self->uint8IterCb]).uint32StartPageWrite
+                              + ((self->ptrCbs)[self->uint8IterCb]).uint32SlotSize
+                              - ((self->ptrCbs)[self->uint8IterCb]).uint8HeadLen
+                              - ((self->ptrCbs)[self->uint8IterCb]).uint8XfrmMeta;  // transform metadata in front of footer
+        ++(((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs);   // footer write is only entered one time
+    } else {    // Header
+        ((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs = (uint16_t) (((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs + ((self->ptrCbs)[self->uint8IterCb]).uint8HeadLen);
+        sfcb_xfrm_start(&((self->ptrCbs)[self->uint8IterCb]), (self->head).uint32IdNum, SFCB_XFRM_ENC);
+    }
+    /* compact: first element of sector, sector summary in same program */
+    if ( (0 != sfcb_sum_ahead(&((self->ptrCbs)[self->uint8IterCb]), self->uint32IterAdr)) && (self->uint32IterAdr == ((self->ptrCbs)[self->uint8IterCb]).uint32StartPageWrite) ) {
+        sfcb_adr32_uint8(self->uint32IterAdr - ((self->ptrCbs)[self->uint8IterCb]).uint32SlotSize, self->uint8PtrSpi+self->uint16SpiLen, SFCB_FLASH_TOPO_ADR_BYTE);
+        self->uint16SpiLen = (uint16_t) (self->uint16SpiLen + SFCB_FLASH_TOPO_ADR_BYTE);
+        memcpy((self->uint8PtrSpi+self->uint16SpiLen), &(self->head), sizeof(self->head));  // magic and ID base
+        memset((self->uint8PtrSpi+self->uint16SpiLen+sizeof(self->head)), 0xFF, ((self->ptrCbs)[self->uint8IterCb]).uint32SlotSize - sizeof(self->head));
+        self->uint16SpiLen = (uint16_t) (self->uint16SpiLen + ((self->ptrCbs)[self->uint8IterCb]).uint32SlotSize);
+    } else {
+        /* SPI Packet: Set address */
+        sfcb_adr32_uint8(self->uint32IterAdr, self->uint8PtrSpi+self->uint16SpiLen, SFCB_FLASH_TOPO_ADR_BYTE);
+        (self->uint16SpiLen) = (uint16_t) ((self->uint16SpiLen) + SFCB_FLASH_TOPO_ADR_BYTE);
+    }
+    /* SPI Packet: transform metadata with footer */
+    if ( (0 != ((self->ptrCbs)[self->uint8IterCb]).uint8XfrmMeta) && (((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs == (((self->ptrCbs)[self->uint8IterCb]).uint16PlSize + ((self->ptrCbs)[self->uint8IterCb]).uint8HeadLen + 1)) ) {
+        (void) sfcb_xfrm_end(&((self->ptrCbs)[self->uint8IterCb]), self->uint8PtrSpi+self->uint16SpiLen, SFCB_XFRM_ENC);
+        (self->uint16SpiLen) = (uint16_t) ((self->uint16SpiLen) + ((self->ptrCbs)[self->uint8IterCb]).uint8XfrmMeta);
+        (self->uint32IterAdr) += ((self->ptrCbs)[self->uint8IterCb]).uint8XfrmMeta;
+    }
+    /* SPI Packet: Copy Payload*/
+    (self->uint16SpiLen) = (uint16_t) ((self->uint16SpiLen) + sfcb_head_enc(self, self->uint8PtrSpi+self->uint16SpiLen));
+    /* Update Flash Address Counter */
+    (self->uint32IterAdr) += ((self->ptrCbs)[self->uint8IterCb]).uint8HeadLen;
+}
+
+
+
+/**
+ *  @brief blank step
+ *
+ *  checks read chunk for programmed bytes and requests next chunk
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         int                 state
+ *  @retval         0                   range checked
+ *  @retval         -1                  chunk requested
+ *  @since          October 18, 2026
+ */
+static int sfcb_blank_step (t_sfcb *self)
+{
+    /** Variables **/
+    uint16_t    uint16CpyLen;   // chunk length
+    uint32_t    uint32Temp;     // first programmed byte
+
+    /* check read chunk */
+    if ( 0 != self->uint16SpiLen ) {
+        uint16CpyLen = (uint16_t) (self->uint16SpiLen - SFCB_FLASH_TOPO_ADR_BYTE - 1);  // -1: for instruction
+        uint32Temp = (uint32_t) sfcb_mem_first_used(self->uint8PtrSpi + SFCB_FLASH_TOPO_ADR_BYTE + 1, uint16CpyLen);
+        if ( UINT32_MAX != uint32Temp ) {
+            sfcb_printf("  INFO:%s: programmed byte at adr=0x%x\n", __FUNCTION__, self->uint32IterAdr + uint32Temp);
+            *(self->ptrBlankAdr) = self->uint32IterAdr + uint32Temp;
+            self->uint32BlankLen = 0;
+        } else {
+            self->uint32IterAdr = self->uint32IterAdr + uint16CpyLen;
+            self->uint32BlankLen = self->uint32BlankLen - uint16CpyLen;
+        }
+    }
+    /* request next chunk */
+    if ( 0 != self->uint32BlankLen ) {
+        uint16CpyLen = (uint16_t) sfcb_min(self->uint32BlankLen, (uint32_t) (self->uint16SpiMax - SFCB_FLASH_TOPO_ADR_BYTE - 1));    // -1: IST
+#if defined(SFCB_FLASH_TYPE_NAND)
+        uint16CpyLen = (uint16_t) sfcb_min(uint16CpyLen, SFCB_FLASH_TOPO_PAGE_SIZE - (self->uint32IterAdr % SFCB_FLASH_TOPO_PAGE_SIZE));  // read through page buffer
+#endif
+        self->uint16SpiLen = (uint16_t) (uint16CpyLen + SFCB_FLASH_TOPO_ADR_BYTE + 1);  // +1: for instruction
+        memset(self->uint8PtrSpi, 0, self->uint16SpiLen);
+        self->uint8PtrSpi[0] = SFCB_FLASH_IST_RD_DATA;
+        sfcb_adr32_uint8(self->uint32IterAdr, self->uint8PtrSpi+1, SFCB_FLASH_TOPO_ADR_BYTE);   // +1 first byte is instruction
+        return -1;
+    }
+    sfcb_printf("  INFO:%s: done\n", __FUNCTION__);
+    self->uint16SpiLen = 0;
+    return 0;
+}
+
+
+
+/**
+ *  @brief microcode interpreter
+ *
+ *  executes steps of table driven command until a step issues an SPI
+ *  packet or the job ends. The response of the packet is processed
+ *  by the next step in the following worker call
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void sfcb_ucode_run (t_sfcb *self)
+{
+    /** Variables **/
+    const t_sfcb_uop    *ptrOp;     // current step
+
+    while ( 1 ) {
+        ptrOp = &(self->ptrUcode[self->uint8UcPc]);
+        sfcb_printf("  INFO:%s: cmd=%d, pc=%d, op=%d\n", __FUNCTION__, self->cmd, self->uint8UcPc, ptrOp->uint8Op);
+        switch (ptrOp->uint8Op) {
+            /* write-in-progress */
+            case SFCB_UOP_POLL:
+                if ( 0 != sfcb_spi_wip_poll(self) ) return;
+                break;
+            /* write enable */
+            case SFCB_UOP_WREN:
+                self->uint8PtrSpi[0] = SFCB_FLASH_IST_WR_ENA;
+                self->uint16SpiLen = 1;
+                (self->uint8UcPc)++;
+                return;
+            /* read data */
+            case SFCB_UOP_RD:
+                if ( self->uint16SpiMax < (self->uint16CbElemPlSize + SFCB_FLASH_TOPO_ADR_BYTE + 1) ) { // IST (+1) + ADR_BYTE: caused by read instruction
+                    sfcb_printf("  ERROR:%s: SPI buffer too small\n", __FUNCTION__);
+                    self->error = SFCB_E_BUFSIZE;
+                    self->uint8UcPc = 0;
+                    while ( SFCB_UOP_END != self->ptrUcode[self->uint8UcPc].uint8Op ) {
+                        (self->uint8UcPc)++;
+                    }
+                    continue;
+                }
+                self->uint16SpiLen = (uint16_t) (self->uint16CbElemPlSize + SFCB_FLASH_TOPO_ADR_BYTE + 1);  // +1: for instruction
+                memset(self->uint8PtrSpi, 0, self->uint16SpiLen);
+                self->uint8PtrSpi[0] = SFCB_FLASH_IST_RD_DATA;
+                sfcb_adr32_uint8(self->uint32IterAdr, self->uint8PtrSpi+1, SFCB_FLASH_TOPO_ADR_BYTE);   // +1 first byte is instruction
+                (self->uint8UcPc)++;
+                return;
+            /* read response to job buffer */
+            case SFCB_UOP_CPY:
+                memcpy(self->ptrCbElemPl, self->uint8PtrSpi+SFCB_FLASH_TOPO_ADR_BYTE+1, self->uint16CbElemPlSize);   // skip header from answer of read instruction
+                self->uint16SpiLen = 0;
+                break;
+            /* read status register 2 */
+            case SFCB_UOP_RDSR2:
+                self->uint8PtrSpi[0] = SFCB_FLASH_IST_RD_STATE_REG2;
+                self->uint8PtrSpi[1] = 0;
+                self->uint16SpiLen = 2;
+                (self->uint8UcPc)++;
+                return;
+            /* quad enable bit, first read sets bit, read back after write is final */
+            case SFCB_UOP_QE:
+                self->uint8Sr2 = self->uint8PtrSpi[1];
+                self->uint16SpiLen = 0;
+                sfcb_printf("  INFO:%s: sr2=0x%x\n", __FUNCTION__, self->uint8Sr2);
+                if ( (0 != (self->uint8Sr2 & SFCB_FLASH_MNG_QE_MSK)) || (0 != self->uint16Iter) ) {
+                    if ( 0 != (self->uint8Sr2 & SFCB_FLASH_MNG_QE_MSK) ) {
+                        self->uint8Quad = 1;
+                    } else {
+                        sfcb_printf("  ERROR:%s: quad enable not set\n", __FUNCTION__);
+                        self->error = SFCB_E_UNKBEH;
+                    }
+                    self->uint8UcPc = ptrOp->uint8Arg;
+                    continue;
+                }
+                self->uint8Sr2 = (uint8_t) (self->uint8Sr2 | SFCB_FLASH_MNG_QE_MSK);
+                break;
+            /* write status register 2 */
+            case SFCB_UOP_WRSR2:
+                self->uint8PtrSpi[0] = SFCB_FLASH_IST_WR_STATE_REG2;
+                self->uint8PtrSpi[1] = self->uint8Sr2;
+                self->uint16SpiLen = 2;
+                self->uint16Iter = 1;   // written, next read back is final
+                (self->uint8UcPc)++;
+                return;
+            /* jump, poll starts with new request */
+            case SFCB_UOP_JMP:
+                self->uint16SpiLen = 0;
+                self->uint8UcPc = ptrOp->uint8Arg;
+                continue;
+            /* erase oldest element, erase-less flash jumps after last chunk */
+            case SFCB_UOP_ERASE:
+                if ( 0 == sfcb_erase_step(self) ) {
+                    self->uint8UcPc = ptrOp->uint8Arg;
+                    return;
+                }
+                (self->uint8UcPc)++;
+                return;
+            /* select next program */
+            case SFCB_UOP_NEXT:
+                if ( 0 != sfcb_add_next(self) ) {
+                    self->uint8UcPc = ptrOp->uint8Arg;
+                    continue;
+                }
+                break;
+            /* program header, footer or payload */
+            case SFCB_UOP_PROG:
+                sfcb_add_prog(self);
+                (self->uint8UcPc)++;
+                return;
+            /* program staged page, only SPI NAND stages */
+            case SFCB_UOP_FLUSH:
+                self->uint16SpiLen = 0;
+#if defined(SFCB_FLASH_TYPE_NAND)
+                if ( UINT32_MAX != self->uint32NandStage ) {
+                    self->uint8PtrSpi[0] = SFCB_FLASH_IST_NAND_PRG_EXE;
+                    self->uint16SpiLen = 1;
+                    (self->uint8UcPc)++;
+                    return;
+                }
+#endif
+                break;
+            /* blank check, stays until range is checked */
+            case SFCB_UOP_BLANK:
+                if ( 0 != sfcb_blank_step(self) ) return;
+                break;
+            /* scatter merged read to requesters */
+            case SFCB_UOP_SCAT:
+                for ( uint8_t i = 0; i < self->uint8RdQLen; i++ ) {
+                    if ( SFCB_RD_XFER == (self->ptrRdQ)[i].state ) {
+                        memcpy((self->ptrRdQ)[i].ptr, self->uint8PtrSpi+SFCB_FLASH_TOPO_ADR_BYTE+1+((self->ptrRdQ)[i].adr - self->uint32IterAdr), (self->ptrRdQ)[i].len);
+                        (self->ptrRdQ)[i].state = SFCB_RD_DONE;
+                    }
+                }
+                sfcb_printf("  INFO:%s: scattered, adr=0x%x, len=%d\n", __FUNCTION__, self->uint32IterAdr, self->uint16CbElemPlSize);
+                self->uint16SpiLen = 0;
+                break;
+            /* sub-sequence done, stage switch goes on */
+            case SFCB_UOP_RET:
+                self->uint16SpiLen = 0;
+                self->stage = (t_sfcb_stage) ptrOp->uint8Arg;
+                self->ptrUcode = NULL;
+                self->uint8UcPc = 0;
+                return;
+            /* job done */
+            case SFCB_UOP_END:
+                self->uint16SpiLen = 0;
+                self->cmd = SFCB_CMD_IDLE;
+                self->stage = SFCB_STG00;
+                self->ptrUcode = NULL;
+                self->uint8UcPc = 0;
+                self->uint8Busy = 0;
+                return;
+            /* something strange happend */
+            default:
+                sfcb_printf("  ERROR:%s: unexpected microcode step\n", __FUNCTION__);
+                self->error = SFCB_E_UNKBEH;
+                return;
+        }
+        (self->uint8UcPc)++;    // step without packet, go on
+    }
+}
+
+
+
+/**
+ *  @brief command worker
+ *
+ *  executes request from #sfcb_mkcb, #sfcb_add, #sfcb_get_last and #sfcb_flash_read,
+ *  the SPI packets are in NOR flash format. RAW, QE, ADD, RDQ and BLANK are
+ *  table driven and run by #sfcb_ucode_run. MKCB queue scan, GET, VFY and EXP
+ *  run by stage switch, the MKCB erase is a sub-sequence returning to the scan
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         void
+ *  @since          July 27, 2022
+ *  @author         Andreas Kaeberlein
+ */
+static void sfcb_worker_cmd (t_sfcb *self)
+{
+    /** Variables **/
+    uint8_t     uint8Good;              // check was good
+    uint16_t    uint16CpyLen;           // number of Bytes to copy
+    uint32_t    uint32Temp;             // temporary 32bit variable
+
+    /* Function call message */
+    sfcb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    sfcb_printf("  INFO:%s:sfcb_p            = %p\n", __FUNCTION__, self);
+    sfcb_printf("  INFO:%s:sfcb:spi_p        = %p\n", __FUNCTION__, self->uint8PtrSpi); // spi buffer
+    /* table driven command, or sub-sequence of stage switch */
+    if ( NULL != self->ptrUcode ) {
+        sfcb_ucode_run(self);
+        if ( (NULL != self->ptrUcode) || (SFCB_CMD_IDLE == self->cmd) ) return; // SPI transfer or done
+    }
+    /* select part of FSM */
+    switch (self->cmd) {
+        /*
+         *
+         * nothing to do
+         *
+         */
+        case SFCB_CMD_IDLE:
+            sfcb_printf("  INFO:%s:IDLE\n", __FUNCTION__);
+            return;
+        /*
+         *
+         * Allocate Next Free Element for Circular Buffers
+         *
+         */
+        case SFCB_CMD_MKCB:
+            /* select execution state, allows break & cont */
+            switch (self->stage) {
+                /* check for WIP */
                 case SFCB_STG00:
-                    sfcb_printf("  INFO:%s:ADD:STG0: check for WIP\n", __FUNCTION__);
+                    /* Debug message */
+                    sfcb_printf("  INFO:%s:MKCB:STG0: check for WIP, request first header\n", __FUNCTION__);
                     /* WIP Check */
                     if ( 0 != sfcb_spi_wip_poll(self) ) return;
-                    /* free for new request */
-                    self->stage = SFCB_STG01;   // go on with enable write
-                    FALL_THROUGH;               // no SPI request required, therefore go on
-                /* Circular Buffer written, if not write enable */
+                    /* (re)start queue scan, f. e. after sector erase, counts from scratch */
+                    ((self->ptrCbs)[self->uint8IterCb]).uint16NumEntries = 0;
+                    ((self->ptrCbs)[self->uint8IterCb]).uint32IdNumMax = 0;
+                    ((self->ptrCbs)[self->uint8IterCb]).uint32IdNumMin = UINT32_MAX;
+                    ((self->ptrCbs)[self->uint8IterCb]).uint32ElemIdLastCpl = 0;
+                    /* Request first header of circular buffer element */
+                    self->uint32IterAdr = sfcb_flash_adr_head(self, self->uint16Iter);  // calculate physical flash address of first header of circular buffer queue
+                    sfcb_spi_get_head(self);    // assemble SPI packet
+                    /* debug message */
+                    sfcb_printf("  INFO:%s:MKCB:STG0:FLASH: adr=0x%x, len=%i", __FUNCTION__, self->uint32IterAdr, (uint32_t) sizeof(spi_flash_cb_elem_head));
+                    /* build overview of circular buffer queue */
+                    self->stage = SFCB_STG01;   // Go one with search for Free Segment
+                    return;
+                /* check header, find empty page for new element */
                 case SFCB_STG01:
-                    sfcb_printf("  INFO:%s:ADD:STG1: Circular Buffer completly written, if not write enable\n", __FUNCTION__);
-                    /* Speculative expect Write, Enable Write Latch */
-                    self->uint8PtrSpi[0] = SFCB_FLASH_IST_WR_ENA;   // uint8FlashIstWrEnable
-                    self->uint16SpiLen = 1;
-                    /* Header/Footer write required */
-                    if (    (self->uint32IterAdr == ((self->ptrCbs)[self->uint8IterCb]).uint32StartPageWrite)   // Start of Circular Buffer Write
-                         || (((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs == (((self->ptrCbs)[self->uint8IterCb]).uint16PlSize + sizeof(spi_flash_cb_elem_head)))   // End of Circular Buffer Write
-                    ) {
-                        self->stage = SFCB_STG02;   // Write Header/Footer
-                        return;
-                    /* Page Requested to program or footer write */
-                    } else if ( (self->uint16Iter < self->uint16CbElemPlSize) ) {
-                        self->stage = SFCB_STG03;   // Write Payload as next
-                        return;
-                    /* circular buffer written */
+                    /* Check header of CBQ element */
+                    sfcb_printf("  INFO:%s:MKCB:STG1: check header, request footer of queue element, find empty start page for new element\n", __FUNCTION__);
+                    sfcb_printf("  INFO:%s:MKCB:STG1:SPI: ", __FUNCTION__);
+                    for ( uint8_t i = 0; i < (uint8_t) (sizeof(spi_flash_cb_elem_head) + SFCB_FLASH_TOPO_ADR_BYTE + 1); i++ ) { // +1: SPI Flash IST
+                        sfcb_printf("0x%x ", self->uint8PtrSpi[i]);
+                    }
+                    sfcb_printf("\n");
+                    /* copy head from SPI packet*/
+                    sfcb_spi_head_dec(self, &(self->head)); // ensure alignment to processor architecture
+                    sfcb_printf("  INFO:%s:MKCB:STG1: RDHEAD,magicnum=0x%x\n", __FUNCTION__, (self->head).uint32MagicNum);
+                    /* Flash Area is used by circular buffer, check magic number
+                     *   +4: Read instruction + 32bit address
+                     */
+                    if ( (self->head).uint32MagicNum == ((self->ptrCbs)[self->uint8IterCb]).uint32MagicNum ) {
+                        /* Debug Message */
+                        sfcb_printf("  INFO:%s:MKCB:STG1: Valid Entry Found\n", __FUNCTION__);
+                        /* count available elements */
+                        (((self->ptrCbs)[self->uint8IterCb]).uint16NumEntries)++;
+                        /* get highest number of numbered circular buffer elements, needed for next entry */
+                        if ( (self->head).uint32IdNum > ((self->ptrCbs)[self->uint8IterCb]).uint32IdNumMax ) {
+                            /* save new highest number in circular buffer */
+                            ((self->ptrCbs)[self->uint8IterCb]).uint32IdNumMax = (self->head).uint32IdNum;
+                            self->uint32LastElemAdr = self->uint32IterAdr;      // store temporary, footer check pending, needed by sfcb_get_last
+                            self->uint32LastElemNum = (self->head).uint32IdNum; // store temporary
+                        }
+                        /* get lowest number of circular buffer, needed for erase sector, and start get function */
+                        if ( (self->head).uint32IdNum < ((self->ptrCbs)[self->uint8IterCb]).uint32IdNumMin ) {
+                            ((self->ptrCbs)[self->uint8IterCb]).uint32IdNumMin = (self->head).uint32IdNum;
+                            ((self->ptrCbs)[self->uint8IterCb]).uint32StartPageIdMin = self->uint32IterAdr; // needed by Sector-Erase
+                        }
                     } else {
-                        self->uint16SpiLen = 0;
-                        self->cmd = SFCB_CMD_IDLE;
-                        self->stage = SFCB_STG00;
-                        self->uint8Busy = 0;
+                        /* check for unused header
+                         * first unused pages is allocated, iterate over all elements to get all IDs
+                         */
+                        if ( 0 == ((self->ptrCbs)[self->uint8IterCb]).uint8MgmtValid ) {
+                            uint8Good = (uint8_t) (0 > sfcb_mem_first_used(self->uint8PtrSpi+SFCB_FLASH_TOPO_ADR_BYTE+1+self->uint16HeadOfs, (uint16_t) (self->uint16SpiLen - SFCB_FLASH_TOPO_ADR_BYTE - 1 - self->uint16HeadOfs)));  // +1: IST
+                            /* corrupted empty page found, leave as it is, try to find next free clean page */
+                            if ( 0 == uint8Good ) {
+                                sfcb_printf ("  ERROR:%s:MKCB:STG1: corrupted empty page found at 0x%0x\n", __FUNCTION__, self->uint32IterAdr);
+                            }
+                            /* save page number for next circular buffer entry */
+                            if ( 0 != uint8Good ) {
+                                ((self->ptrCbs)[self->uint8IterCb]).uint32StartPageWrite = self->uint32IterAdr;
+                                ((self->ptrCbs)[self->uint8IterCb]).uint8MgmtValid = 1; // prepared for writing next element
+                            }
+                        }
+                    }
+                    /* Current Status Message */
+                    sfcb_printf ( "  INFO:%s:MKCB:STG1: cb=%d, elem=%d, flashadr=0x%x, idIs=0x%x, idMin=0x%x, idMax=0x%x\n",
+                                  __FUNCTION__,
+                                  self->uint8IterCb,
+                                  self->uint16Iter,
+                                  self->uint32IterAdr,
+                                  (self->head).uint32IdNum,
+                                  ((self->ptrCbs)[self->uint8IterCb]).uint32IdNumMin,
+                                  ((self->ptrCbs)[self->uint8IterCb]).uint32IdNumMax
+                                );
+                    /* go on with footer evaluation and requesting next header */
+                    self->stage = SFCB_STG02;
+                    /* assemble footer request of circular buffer element
+                     *   footer takes place at the end of the current queue element slot
+                     *   commit word format: completion is part of the header read, no footer request
+                     */
+                    if ( SFCB_FMT_HEAD_FOOT == ((self->ptrCbs)[self->uint8IterCb]).uint8Fmt ) {
+                        self->uint32IterAdr =   sfcb_flash_adr_head(self, self->uint16Iter)
+                                              + ((self->ptrCbs)[self->uint8IterCb]).uint32SlotSize
+                                              - (uint32_t) sizeof(spi_flash_cb_elem_head);
+                        sfcb_spi_get_head(self);
+                        /* debug message */
+                        sfcb_printf("  INFO:%s:MKCB:STG1:FLASH: adr=0x%x, len=%i\n", __FUNCTION__, self->uint32IterAdr, (uint32_t) sizeof(spi_flash_cb_elem_head));
                         return;
                     }
-                    break;
-                /* Page Write to Circular Buffer */
+                    FALL_THROUGH;
+                /* check footer, needed to ensure that #sfcb_get_last will get an complete circular buffer queue element */
                 case SFCB_STG02:
-                    sfcb_printf("  INFO:%s:ADD:STG2: Write Header/Footer to Flash, adr=0x%x, payload,len=%d\n", __FUNCTION__, self->uint32IterAdr, (uint32_t) sizeof(self->head));
-                    /* assemble Header/ Footer */
-                    memset(&(self->head), 0, sizeof(self->head)); // make empty
-                    (self->head).uint32MagicNum = ((self->ptrCbs)[self->uint8IterCb]).uint32MagicNum;
-                    (self->head).uint32IdNum = ((self->ptrCbs)[self->uint8IterCb]).uint32IdNumMax + 1;
-                    /* Page Write */
-                    self->uint8PtrSpi[0] = SFCB_FLASH_IST_WR_PAGE;
-                    self->uint16SpiLen = 1;
-                    /* Footer? */
-                    if ( ((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs == (((self->ptrCbs)[self->uint8IterCb]).uint16PlSize + sizeof(spi_flash_cb_elem_head)) ) {
-                        self->uint32IterAdr =   ((self->ptrCbs)[self->uint8IterCb]).uint32StartPageWrite
-                                              + ((self->ptrCbs)[self->uint8IterCb]).uint16NumPagesPerElem * (uint32_t) SFCB_FLASH_TOPO_PAGE_SIZE
-                                              - (uint32_t) sizeof(self->head);
-                        ++(((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs);   // footer write is only entered one time
-                    } else {    // Header
-                        ((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs = (uint16_t) (((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs + sizeof(self->head));
+                    /* Debug Message */
+                    sfcb_printf("  INFO:%s:MKCB:STG2: check footer, request header of next queue element\n", __FUNCTION__);
+                    sfcb_printf("  INFO:%s:MKCB:STG2:SPI: ", __FUNCTION__);
+                    for ( uint8_t i = 0; i < (uint8_t) (sizeof(spi_flash_cb_elem_head) + SFCB_FLASH_TOPO_ADR_BYTE + 1); i++ ) { // +1: SPI Flash IST
+                        sfcb_printf("0x%x ", self->uint8PtrSpi[i]);
                     }
-                    /* SPI Packet: Set address */
-                    sfcb_adr32_uint8(self->uint32IterAdr, self->uint8PtrSpi+self->uint16SpiLen, SFCB_FLASH_TOPO_ADR_BYTE);
-                    (self->uint16SpiLen) = (uint16_t) ((self->uint16SpiLen) + SFCB_FLASH_TOPO_ADR_BYTE);
-                    /* SPI Packet: Copy Payload*/
-                    memcpy((self->uint8PtrSpi+self->uint16SpiLen), &(self->head), sizeof(self->head));
-                    (self->uint16SpiLen) = (uint16_t) ((self->uint16SpiLen) + sizeof(self->head));
-                    /* Update Flash Address Counter */
-                    (self->uint32IterAdr) += (uint32_t) sizeof(self->head);
-                    /* Go to wait for WIP */
-                    self->stage = SFCB_STG04;
-                    return;
-                /* Page Write to Circular Buffer */
-                case SFCB_STG03:
-                    sfcb_printf("  INFO:%s:ADD:STG3: Page Write to Circular Buffer, adr=0x%x, payload,len=%d\n", __FUNCTION__, self->uint32IterAdr, self->uint16CbElemPlSize);
-                    /* assemble Flash Instruction packet */
-                    self->uint8PtrSpi[0] = SFCB_FLASH_IST_WR_PAGE;  // write page
-                    sfcb_adr32_uint8(self->uint32IterAdr, self->uint8PtrSpi+1, SFCB_FLASH_TOPO_ADR_BYTE);   // +1 first byte is instruction
-                    self->uint16SpiLen = SFCB_FLASH_TOPO_ADR_BYTE + 1;  // +1: IST
-                    /* get available bytes in page */
-                    uint16PagesBytesAvail = (uint16_t) (SFCB_FLASH_TOPO_PAGE_SIZE - (self->uint32IterAdr % SFCB_FLASH_TOPO_PAGE_SIZE));
-                    /* determine number of bytes to copy */
-                    if ( (self->uint16CbElemPlSize - self->uint16Iter) > uint16PagesBytesAvail ) {
-                        uint16CpyLen = uint16PagesBytesAvail;
-                    } else {
-                        uint16CpyLen = (uint16_t) (self->uint16CbElemPlSize - self->uint16Iter);
+                    sfcb_printf("\n");
+                    /* copy from SPI packet */
+                    sfcb_spi_head_dec(self, &(self->foot));
+                    /* commit word format: header counts as footer if commit word is programmed */
+                    if ( SFCB_FMT_COMMIT == ((self->ptrCbs)[self->uint8IterCb]).uint8Fmt ) {
+                        memcpy(&uint32Temp, self->uint8PtrSpi+SFCB_FLASH_TOPO_ADR_BYTE+1+sizeof(self->head), sizeof(uint32Temp));
+                        if ( SFCB_COMMIT_WORD != uint32Temp ) {
+                            memset(&(self->foot), 0xFF, sizeof(self->foot));
+                        }
+                    }
+                    /* header = footer? if yes, cb element completely written */
+                    if (    (0 == memcmp(&(self->foot), &(self->head), sizeof(self->head)))
+                         && ((self->foot).uint32MagicNum == ((self->ptrCbs)[self->uint8IterCb]).uint32MagicNum)
+                         && ((self->foot).uint32IdNum == self->uint32LastElemNum)   // only the newest element is of interest
+                    ) {
+                        sfcb_printf (   "  INFO:%s:MKCB:STG2:head/foot: compare pass, successful last written element is at flash adr=0x%x\n",
+                                        __FUNCTION__, self->uint32LastElemAdr
+                                    );
+                        ((self->ptrCbs)[self->uint8IterCb]).uint32StartPageIdMax = self->uint32LastElemAdr; // needed by sfcb_get_last
+                        ((self->ptrCbs)[self->uint8IterCb]).uint32ElemIdLastCpl  = self->uint32LastElemNum; // needed by sfcb_get_last
+                    }
+                    /* request next header of circular buffer */
+                    self->uint32IterAdr = sfcb_flash_adr_head(self, (uint16_t) ((self->uint16Iter) + 1));
+                    sfcb_spi_get_head(self);    // assemble SPI packet for request next head
+                    /* debug message */
+                    sfcb_printf("  INFO:%s:MKCB:STG2:FLASH: adr=0x%x, len=%i\n", __FUNCTION__, self->uint32IterAdr, (uint32_t) sizeof(spi_flash_cb_elem_head));
+                    /* prepare iterator for next */
+                    if ( self->uint16Iter < (((self->ptrCbs)[self->uint8IterCb]).uint16NumEntriesMax-1) ) {
+                        /* next element in current queue */
+                        (self->uint16Iter)++;
+                        self->stage = SFCB_STG01;   // process next header
+                        return;
+                    }
+                    /* newest element without footer? if yes recover payload write offset, SPI NAND: ECC sectors are programmed once, element is abandoned */
+#if !defined(SFCB_FLASH_TYPE_NAND)
+                    if (    (0 != ((self->ptrCbs)[self->uint8IterCb]).uint16NumEntries)
+                         && (((self->ptrCbs)[self->uint8IterCb]).uint32ElemIdLastCpl != ((self->ptrCbs)[self->uint8IterCb]).uint32IdNumMax)
+                    ) {
+                        sfcb_printf("  INFO:%s:MKCB:STG2: element id=%d at adr=0x%x without footer, recover write offset\n", __FUNCTION__, self->uint32LastElemNum, self->uint32LastElemAdr);
+                        self->uint16Iter = ((self->ptrCbs)[self->uint8IterCb]).uint16PlSize;  // payload scan starts at the end
+                        sfcb_spi_get_pl_tail(self);
+                        self->stage = SFCB_STG05;
+                        return;
+                    }
+#endif
+                    /* queue done */
+                    sfcb_mkcb_next_cb(self);
+                    break;  // DONE, SPI transfer or erase is required
+                /* check payload chunk of incomplete element for last programmed byte */
+                case SFCB_STG05:
+                    sfcb_printf("  INFO:%s:MKCB:STG5: check payload chunk for erased tail\n", __FUNCTION__);
+                    uint16CpyLen = (uint16_t) (self->uint16SpiLen - SFCB_FLASH_TOPO_ADR_BYTE - 1);  // -1: IST
+                    uint32Temp = (uint32_t) (sfcb_mem_last_used(self->uint8PtrSpi + SFCB_FLASH_TOPO_ADR_BYTE + 1, uint16CpyLen) + 1);  // number of used bytes in chunk
+                    /* erased chunk, go on with previous */
+                    if ( (0 == uint32Temp) && (0 != self->uint16Iter) ) {
+                        sfcb_spi_get_pl_tail(self);
+                        return;
                     }
-                    /* assemble packet */
-                    memcpy((self->uint8PtrSpi+self->uint16SpiLen), (self->ptrCbElemPl+self->uint16Iter), uint16CpyLen);
-                    self->uint16SpiLen = (uint16_t) (self->uint16SpiLen + uint16CpyLen);
-                    self->uint16Iter = (uint16_t) (self->uint16Iter + uint16CpyLen);
-                    /* increment iterators */
-                    ((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs = (uint16_t) (((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs + self->uint16SpiLen - SFCB_FLASH_TOPO_ADR_BYTE - 1);   // payload internal flash offset
-                    self->uint32IterAdr = self->uint32IterAdr + self->uint16SpiLen - SFCB_FLASH_TOPO_ADR_BYTE - 1;  // inc flash address by written data, reduced by SPI Flash instruction
-                    /* Go to wait WIP */
-                    self->stage = SFCB_STG04;
-                    return;
-                /* check for WIP, #sfcb_spi_wip_poll works only for spiLen=0, therefore additional state necessary */
-                case SFCB_STG04:
-                    self->uint16SpiLen = 0; // needed for WIP poll packet generation in STG00
-                    self->stage = SFCB_STG00;
-                    return;
-                /* something strange happend */
+                    /* reopen element for append */
+                    ((self->ptrCbs)[self->uint8IterCb]).uint32StartPageWrite = self->uint32LastElemAdr;
+                    ((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs = (uint16_t) (((self->ptrCbs)[self->uint8IterCb]).uint8HeadLen + self->uint16Iter + uint32Temp);
+                    ((self->ptrCbs)[self->uint8IterCb]).uint32IdNumMax = self->uint32LastElemNum - 1;  // element is in write, same state like after #sfcb_add
+                    (((self->ptrCbs)[self->uint8IterCb]).uint16NumEntries)--;
+                    ((self->ptrCbs)[self->uint8IterCb]).uint8MgmtValid = 1;
+                    sfcb_printf("  INFO:%s:MKCB:STG5: cb=%d, reopened at adr=0x%x, plofs=%d\n", __FUNCTION__, self->uint8IterCb, self->uint32LastElemAdr, ((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs);
+                    sfcb_mkcb_next_cb(self);
+                    break;  // DONE, SPI transfer or erase is required
+                /* something strange happened */
                 default:
-                    sfcb_printf("  ERROR:%s:ADD: default, something strange happend\n", __FUNCTION__);
+                    sfcb_printf("  ERROR:%s:MKCB: unexpected use of default path\n", __FUNCTION__);
                     self->error = SFCB_E_UNKBEH;
                     break;
             }
+            /* erase of oldest element, returns to queue scan */
+            if ( NULL != self->ptrUcode ) {
+                sfcb_ucode_run(self);
+            }
             return;
         /*
          *
@@ -613,6 +2703,7 @@ void sfcb_worker (t_sfcb *self)
                         sfcb_printf("  INFO:%s:GET:STG1: Copy bytes in payload buffer\n", __FUNCTION__);
                         uint16CpyLen = (uint16_t) (self->uint16SpiLen - SFCB_FLASH_TOPO_ADR_BYTE - 1);  // -1: for instruction
                         memcpy(self->ptrCbElemPl+self->uint16Iter, self->uint8PtrSpi + SFCB_FLASH_TOPO_ADR_BYTE + 1, uint16CpyLen);
+                        sfcb_xfrm_chunk(&((self->ptrCbs)[self->uint8IterCb]), (uint8_t*) self->ptrCbElemPl+self->uint16Iter, uint16CpyLen, SFCB_XFRM_DEC);
                         self->uint16Iter = (uint16_t) (self->uint16Iter + uint16CpyLen);        // payload byte counter
                         self->uint32IterAdr = (uint32_t) (self->uint32IterAdr + uint16CpyLen);  // flash address byte counter
                     }
@@ -624,7 +2715,7 @@ void sfcb_worker (t_sfcb *self)
                     /* Request next segment for read */
                     if ( self->uint16Iter < self->uint16CbElemPlSize ) {
                         /* Prepare Package for request */
-                        uint16CpyLen = (uint16_t) sfcb_min(SFCB_FLASH_TOPO_PAGE_SIZE, self->uint16CbElemPlSize - self->uint16Iter); // pending bytes, or max page size
+                        uint16CpyLen = (uint16_t) sfcb_min(SFCB_FLASH_TOPO_PAGE_SIZE - (self->uint32IterAdr % SFCB_FLASH_TOPO_PAGE_SIZE), (uint32_t) (self->uint16CbElemPlSize - self->uint16Iter));  // pending bytes, or up to page end
                         self->uint16SpiLen = (uint16_t) (uint16CpyLen + SFCB_FLASH_TOPO_ADR_BYTE + 1);  // +1: for instruction
                         memset(self->uint8PtrSpi, 0, self->uint16SpiLen);   // written data is zero
                         /* Flash instruction */
@@ -634,6 +2725,13 @@ void sfcb_worker (t_sfcb *self)
                         sfcb_printf("  INFO:%s:GET:STG2: Request next segment from Flash, adr=0x%x, len=%d\n", __FUNCTION__, self->uint32IterAdr, self->uint16SpiLen);
                         /* wait for HW */
                         self->stage = SFCB_STG01;   // Copy read data back
+                    /* complete element, read transform metadata */
+                    } else if ( (0 != ((self->ptrCbs)[self->uint8IterCb]).uint8XfrmMeta) && (self->uint16Iter == ((self->ptrCbs)[self->uint8IterCb]).uint16PlSize) ) {
+                        self->uint16SpiLen = (uint16_t) (((self->ptrCbs)[self->uint8IterCb]).uint8XfrmMeta + SFCB_FLASH_TOPO_ADR_BYTE + 1);  // +1: for instruction
+                        memset(self->uint8PtrSpi, 0, self->uint16SpiLen);
+                        self->uint8PtrSpi[0] = SFCB_FLASH_IST_RD_DATA;
+                        sfcb_adr32_uint8(((self->ptrCbs)[self->uint8IterCb]).uint32StartPageIdMax + ((self->ptrCbs)[self->uint8IterCb]).uint32SlotSize - ((self->ptrCbs)[self->uint8IterCb]).uint8HeadLen - ((self->ptrCbs)[self->uint8IterCb]).uint8XfrmMeta, self->uint8PtrSpi+1, SFCB_FLASH_TOPO_ADR_BYTE);
+                        self->stage = SFCB_STG03;   // check metadata
                     /* CB Element Read complete */
                     } else {
                         /* User Message */
@@ -645,6 +2743,17 @@ void sfcb_worker (t_sfcb *self)
                         self->uint8Busy = 0;
                     }
                     return; // Wait for SPI
+                /* check transform metadata */
+                case SFCB_STG03:
+                    if ( 0 != sfcb_xfrm_end(&((self->ptrCbs)[self->uint8IterCb]), self->uint8PtrSpi+SFCB_FLASH_TOPO_ADR_BYTE+1, SFCB_XFRM_DEC) ) {
+                        sfcb_printf("  ERROR:%s:GET:STG3: transform rejects element\n", __FUNCTION__);
+                        self->error = SFCB_E_XFRM;
+                    }
+                    self->uint16SpiLen = 0;
+                    self->cmd = SFCB_CMD_IDLE;
+                    self->stage = SFCB_STG00;
+                    self->uint8Busy = 0;
+                    return;
                 /* something strange happend */
                 default:
                     sfcb_printf("  ERROR:%s:RAW: unexpected use of default path\n", __FUNCTION__);
@@ -654,42 +2763,137 @@ void sfcb_worker (t_sfcb *self)
             return;
         /*
          *
-         * Raw Flash Read
+         * Verify retained management data
          *
          */
-        case SFCB_CMD_RAW:
+        case SFCB_CMD_VFY:
             switch (self->stage) {
                 /* check for WIP */
                 case SFCB_STG00:
-                    sfcb_printf("  INFO:%s:RAW:STG0: check for WIP\n", __FUNCTION__);
-                    /* WIP Check */
+                    sfcb_printf("  INFO:%s:VFY:STG0: check for WIP\n", __FUNCTION__);
                     if ( 0 != sfcb_spi_wip_poll(self) ) return;
-                    /* free for new request */
-                    self->stage = SFCB_STG01;   // Go one with search for Free Segment
-                    FALL_THROUGH;               // Go one with stage
-                /* Prepare raw read */
+                    sfcb_vfy_next(self);
+                    return;
+                /* free element needs to be erased, reopened element starts with next ID */
                 case SFCB_STG01:
-                    sfcb_printf("  INFO:%s:RAW:STG1: Prepare RAW read\n", __FUNCTION__);
-                    /* check for enough spi buf */
-                    if ( self->uint16SpiMax < (self->uint16CbElemPlSize + SFCB_FLASH_TOPO_ADR_BYTE + 1) ) { // IST (+1) + ADR_BYTE: caused by read instruction
-                        self->uint8Busy = 0;
-                        self->cmd = SFCB_CMD_IDLE;  // go in idle
-                        self->stage = SFCB_STG00;
-                        self->error = SFCB_E_BUFSIZE;   // requested operation ends with an error
+                    sfcb_spi_head_dec(self, &(self->head));
+                    if ( 0 == ((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs ) {
+                        uint8Good = (uint8_t) (0 > sfcb_mem_last_used(self->uint8PtrSpi+SFCB_FLASH_TOPO_ADR_BYTE+1+self->uint16HeadOfs, ((self->ptrCbs)[self->uint8IterCb]).uint8HeadLen));
+                    } else {
+                        uint8Good = (uint8_t) (    ((self->head).uint32MagicNum == ((self->ptrCbs)[self->uint8IterCb]).uint32MagicNum)
+                                                && ((self->head).uint32IdNum == ((self->ptrCbs)[self->uint8IterCb]).uint32IdNumMax + 1) );
+                    }
+                    sfcb_printf("  INFO:%s:VFY:STG1: cb=%d, free element adr=0x%x, good=%d\n", __FUNCTION__, self->uint8IterCb, self->uint32IterAdr, uint8Good);
+                    /* newest complete element */
+                    if ( (0 != uint8Good) && (0 != ((self->ptrCbs)[self->uint8IterCb]).uint32ElemIdLastCpl) ) {
+                        self->uint32IterAdr = ((self->ptrCbs)[self->uint8IterCb]).uint32StartPageIdMax;
+                        sfcb_spi_get_head(self);
+                        self->stage = SFCB_STG02;
+                        return;
+                    }
+                    if ( 0 == uint8Good ) {
+                        ((self->ptrCbs)[self->uint8IterCb]).uint8MgmtValid = 0;
+                    }
+                    (self->uint8IterCb)++;
+                    sfcb_vfy_next(self);
+                    return;
+                /* newest complete element carries expected ID */
+                case SFCB_STG02:
+                    sfcb_spi_head_dec(self, &(self->head));
+                    memcpy(&uint32Temp, self->uint8PtrSpi+SFCB_FLASH_TOPO_ADR_BYTE+1+sizeof(self->head), sizeof(uint32Temp));
+                    if (    ((self->head).uint32MagicNum != ((self->ptrCbs)[self->uint8IterCb]).uint32MagicNum)
+                         || ((self->head).uint32IdNum != ((self->ptrCbs)[self->uint8IterCb]).uint32ElemIdLastCpl)
+                         || ((SFCB_FMT_COMMIT == ((self->ptrCbs)[self->uint8IterCb]).uint8Fmt) && (SFCB_COMMIT_WORD != uint32Temp))
+                    ) {
+                        sfcb_printf("  INFO:%s:VFY:STG2: cb=%d, newest element mismatch, id=%d\n", __FUNCTION__, self->uint8IterCb, (self->head).uint32IdNum);
+                        ((self->ptrCbs)[self->uint8IterCb]).uint8MgmtValid = 0;
+                    }
+                    (self->uint8IterCb)++;
+                    sfcb_vfy_next(self);
+                    return;
+                /* something strange happend */
+                default:
+                    sfcb_printf("  ERROR:%s:VFY: unexpected use of default path\n", __FUNCTION__);
+                    self->error = SFCB_E_UNKBEH;
+                    break;
+            }
+            return;
+
+        /*
+         *
+         * Export queue as container
+         *
+         */
+        case SFCB_CMD_EXP:
+            switch (self->stage) {
+                /* check for WIP, select container part */
+                case SFCB_STG00:
+                    sfcb_printf("  INFO:%s:EXP:STG0: check for WIP\n", __FUNCTION__);
+                    if ( 0 != sfcb_spi_wip_poll(self) ) return;
+                    /* all elements exported */
+                    if (    (SFCB_EXP_ELEM == self->uint8ExpState)
+                         && ((0 == self->uint16ExpSlots) || (self->uint32ExpCnt == ((self->ptrCbs)[self->uint8IterCb]).uint16NumEntries))
+                    ) {
+                        self->uint8ExpState = SFCB_EXP_TAIL;
+                    }
+                    /* request header of next element */
+                    if ( SFCB_EXP_ELEM == self->uint8ExpState ) {
+                        self->uint32IterAdr = sfcb_flash_adr_head(self, self->uint16ExpIdx);
+                        self->uint16ExpIdx = (uint16_t) ((self->uint16ExpIdx + 1) % ((self->ptrCbs)[self->uint8IterCb]).uint16NumEntriesMax);
+                        (self->uint16ExpSlots)--;
+                        sfcb_spi_get_head(self);
+                        self->stage = SFCB_STG01;
+                        return;
                     }
-                    /* SPI package is zero */
-                    self->uint16SpiLen = (uint16_t) (self->uint16CbElemPlSize + SFCB_FLASH_TOPO_ADR_BYTE + 1);  // +1: for instruction
-                    memset(self->uint8PtrSpi, 0, self->uint16SpiLen);   // written data is zero
-                    /* Flash instruction */
-                    self->uint8PtrSpi[0] = SFCB_FLASH_IST_RD_DATA;  // read data
-                    sfcb_adr32_uint8(self->uint32IterAdr, self->uint8PtrSpi+1, SFCB_FLASH_TOPO_ADR_BYTE);   // +1 first byte is instruction
-                    /* go on with next stage */
-                    self->stage = SFCB_STG02;   // now wait for transfer
+                    /* container header or trailer */
+                    sfcb_exp_part(self);
+                    sfcb_printf("  INFO:%s:EXP:STG0: container part, len=%d\n", __FUNCTION__, *(self->ptrExpUsed));
+                    self->uint16SpiLen = 0;
+                    self->cmd = SFCB_CMD_IDLE;
+                    self->stage = SFCB_STG00;
+                    self->uint8Busy = 0;
                     return;
-                /* copy data from SPI back */
+                /* check header, skip erased or incomplete element */
+                case SFCB_STG01:
+                    sfcb_spi_head_dec(self, &(self->head));
+                    if (    ((self->head).uint32MagicNum != ((self->ptrCbs)[self->uint8IterCb]).uint32MagicNum)
+                         || ((int32_t) ((self->head).uint32IdNum - ((self->ptrCbs)[self->uint8IterCb]).uint32ElemIdLastCpl) > 0)
+                         || ((0 != self->uint32ExpCnt) && ((int32_t) ((self->head).uint32IdNum - self->uint32ExpPrevId) <= 0))
+                    ) {
+                        sfcb_printf("  INFO:%s:EXP:STG1: skip slot at adr=0x%x\n", __FUNCTION__, self->uint32IterAdr);
+                        self->uint16SpiLen = 0;
+                        self->stage = SFCB_STG00;
+                        return;
+                    }
+                    self->uint32IterAdr = self->uint32IterAdr + ((self->ptrCbs)[self->uint8IterCb]).uint8HeadLen;    // payload
+                    self->uint16Iter = 0;
+                    self->uint16SpiLen = 0;
+                    self->stage = SFCB_STG02;
+                    FALL_THROUGH;
+                /* copy payload chunk behind space for ID delta and length */
                 case SFCB_STG02:
-                    sfcb_printf("  INFO:%s:RAW:STG2: copy data from SPI back\n", __FUNCTION__);
-                    memcpy(self->ptrCbElemPl, self->uint8PtrSpi+SFCB_FLASH_TOPO_ADR_BYTE+1, self->uint16CbElemPlSize);  // skip header from answer of read instruction
+                    if ( 0 != self->uint16SpiLen ) {
+                        uint16CpyLen = (uint16_t) (self->uint16SpiLen - SFCB_FLASH_TOPO_ADR_BYTE - 1);  // -1: for instruction
+                        memcpy(self->ptrExpBuf+SFCB_EXP_ELEM_PRE+self->uint16Iter, self->uint8PtrSpi+SFCB_FLASH_TOPO_ADR_BYTE+1, uint16CpyLen);
+                        self->uint16Iter = (uint16_t) (self->uint16Iter + uint16CpyLen);
+                        self->uint32IterAdr = self->uint32IterAdr + uint16CpyLen;
+                    }
+                    self->stage = SFCB_STG03;
+                    FALL_THROUGH;
+                /* request next chunk, or close element */
+                case SFCB_STG03:
+                    if ( self->uint16Iter < ((self->ptrCbs)[self->uint8IterCb]).uint16PlSize ) {
+                        uint16CpyLen = (uint16_t) sfcb_min(SFCB_FLASH_TOPO_PAGE_SIZE - (self->uint32IterAdr % SFCB_FLASH_TOPO_PAGE_SIZE), (uint32_t) (((self->ptrCbs)[self->uint8IterCb]).uint16PlSize - self->uint16Iter));  // pending bytes, or up to page end
+                        uint16CpyLen = (uint16_t) sfcb_min(uint16CpyLen, (uint32_t) (self->uint16SpiMax - SFCB_FLASH_TOPO_ADR_BYTE - 1));
+                        self->uint16SpiLen = (uint16_t) (uint16CpyLen + SFCB_FLASH_TOPO_ADR_BYTE + 1);  // +1: for instruction
+                        memset(self->uint8PtrSpi, 0, self->uint16SpiLen);
+                        self->uint8PtrSpi[0] = SFCB_FLASH_IST_RD_DATA;
+                        sfcb_adr32_uint8(self->uint32IterAdr, self->uint8PtrSpi+1, SFCB_FLASH_TOPO_ADR_BYTE);   // +1 first byte is instruction
+                        self->stage = SFCB_STG02;
+                        return;
+                    }
+                    sfcb_exp_elem(self);
+                    sfcb_printf("  INFO:%s:EXP:STG3: element id=%d, len=%d\n", __FUNCTION__, (self->head).uint32IdNum, *(self->ptrExpUsed));
                     self->uint16SpiLen = 0;
                     self->cmd = SFCB_CMD_IDLE;
                     self->stage = SFCB_STG00;
@@ -697,258 +2901,906 @@ void sfcb_worker (t_sfcb *self)
                     return;
                 /* something strange happend */
                 default:
-                    sfcb_printf("  ERROR:%s:RAW: unexpected use of default path\n", __FUNCTION__);
+                    sfcb_printf("  ERROR:%s:EXP: unexpected use of default path\n", __FUNCTION__);
                     self->error = SFCB_E_UNKBEH;
                     break;
             }
             return;
 
-        /* something strange happened */
-        default:
-            return;
+        /* something strange happened */
+        default:
+            return;
+    }
+}
+
+
+
+/**
+ *  sfcb_worker
+ *    executes request from ...
+ */
+void sfcb_worker (t_sfcb *self)
+{
+    /** Variables **/
+    const uint8_t   uint8Busy = self->uint8Busy;    // job state before processing
+
+    (self->uint32WkrCalls)++;   // time base for queueing delay
+#if defined(SFCB_FLASH_TYPE_NAND)
+    /* NAND sequence pending */
+    if ( 0 != sfcb_nand_rsp(self) ) return;
+#endif
+    /* scrub read is void, job started meanwhile */
+    if ( (0 != self->uint8ScrubPend) && (SFCB_CMD_IDLE != self->cmd) ) {
+        self->uint8ScrubPend = 0;
+        self->uint16SpiLen = 0;
+    }
+    /* read requests first, deferred writes, start burst */
+    if ( (0 == self->uint8Busy) && (0 == self->uint8ScrubPend) ) {
+        sfcb_read_sched(self);
+        sfcb_defer_flush(self);
+    }
+    /* deep power-down, release for request */
+    if ( 0 != sfcb_dpd_wake(self) ) return;
+    /* process request */
+    if ( (0 == uint8Busy) && (SFCB_CMD_IDLE == self->cmd) && (0 != (self->uint16ScrubPkts | self->uint8ScrubPend)) ) {
+        sfcb_scrub_step(self);  // idle, background scrub
+    } else {
+        sfcb_worker_cmd(self);
+    }
+#if defined(SFCB_FLASH_TYPE_NAND)
+    /* translate into NAND sequence */
+    sfcb_nand_req(self);
+#endif
+    /* job done, seal management data for warm start */
+    if ( (0 != uint8Busy) && (0 == self->uint8Busy) ) {
+        sfcb_cb_seal(self);
+    }
+    /* idle, enter deep power-down */
+    if (    (0 != self->uint8DpdEna) && (SFCB_DPD_AWAKE == self->dpd) && (0 == self->uint8Busy) && (SFCB_CMD_IDLE == self->cmd)
+         && (0 == self->uint16ScrubPkts) && (0 == self->uint8ScrubPend)
+    ) {
+        sfcb_printf("  INFO:%s: enter deep power-down\n", __FUNCTION__);
+        self->uint8PtrSpi[0] = SFCB_FLASH_IST_PWR_DOWN;
+        self->uint16SpiLen = 1;
+        self->dpd = SFCB_DPD_SLEEP;
+    }
+}
+
+
+
+/**
+ *  sfcb_flash_size
+ *    total flashsize
+ */
+uint32_t sfcb_flash_size (void)
+{
+    return (uint32_t) SFCB_FLASH_TOPO_FLASH_SIZE;
+}
+
+
+
+/**
+ *  sfcb_new_cb
+ *    creates new circular buffer entry
+ */
+int sfcb_new_cb (t_sfcb *self, uint32_t magicNum, uint16_t elemSizeByte, uint16_t numElems, uint8_t *cbID)
+{
+    return sfcb_new_cb_fmt(self, magicNum, elemSizeByte, numElems, SFCB_FMT_HEAD_FOOT, cbID);
+}
+
+
+
+/**
+ *  sfcb_new_cb_fmt
+ *    creates new circular buffer entry with element format
+ */
+int sfcb_new_cb_fmt (t_sfcb *self, uint32_t magicNum, uint16_t elemSizeByte, uint16_t numElems, t_sfcb_fmt fmt, uint8_t *cbID)
+{
+    /** help variables **/
+#if !defined(SFCB_FLASH_TYPE_NOERASE)
+    const uint8_t   uint8PagesPerSector = (uint8_t) (SFCB_FLASH_TOPO_SECTOR_SIZE / SFCB_FLASH_TOPO_PAGE_SIZE);
+#endif
+    const uint8_t   uint8HeadLen = (uint8_t) ((SFCB_FMT_COMPACT == fmt) ? 2*sizeof(uint16_t) : (sizeof(spi_flash_cb_elem_head) + ((SFCB_FMT_COMMIT == fmt) ? sizeof(uint32_t) : 0)));  // header, commit word
+    const uint16_t  elemTotalSize = (uint16_t) (elemSizeByte + uint8HeadLen + ((SFCB_FMT_COMMIT == fmt) ? 0 : uint8HeadLen));   // payload size + header/footer size
+    uint8_t         cbNew;              // queue of circular buffer new entry number
+    uint32_t        uint32StartSector;
+    uint16_t        uint16NumSectors;
+#if !defined(SFCB_FLASH_TYPE_NAND) && !defined(SFCB_FLASH_TYPE_NOERASE)
+    uint32_t        uint32SlotCmp = sizeof(spi_flash_cb_sect_sum);  // compact slot size
+    uint16_t        uint16ElemPerSec;   // compact elements per sector
+#endif
+
+    /* Function call message */
+    sfcb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    sfcb_printf("  INFO:%s:sfcb_p = %p\n", __FUNCTION__, self);
+    /* check for free Slot number */
+    uint32StartSector = 0;
+    for ( cbNew = 0; cbNew < (self->uint8NumCbs); cbNew++ ) {
+        if ( 0 != (self->ptrCbs[cbNew]).uint8Used ) {   // queue is used
+            uint32StartSector = (self->ptrCbs[cbNew]).uint32StopSector + 1; // calculate start address of next queue
+        } else {
+            break;  // empty queue found
+        }
+    }
+    if ( cbNew == (self->uint8NumCbs) ) {
+        sfcb_printf("  ERROR:%s:sfcb_cb exceeded total available number of %i cbs\n", __FUNCTION__, (self->uint8NumCbs));
+        return SFCB_E_MEM;  // no free circular buffer slots, allocate more memory in #t_sfcb_cb table
+    }
+#if defined(SFCB_FLASH_TYPE_NAND)
+    /* commit word programs the ECC sector of the header a second time */
+    if ( SFCB_FMT_COMMIT == fmt ) {
+        sfcb_printf("  ERROR:%s:commit word format requires flash with partial program\n", __FUNCTION__);
+        return SFCB_E_NO_FLASH;
+    }
+#endif
+    /* compact format: power of two slot, slot with sector summary ahead of first element fits in page and SPI buffer */
+    if ( SFCB_FMT_COMPACT == fmt ) {
+#if defined(SFCB_FLASH_TYPE_NAND) || defined(SFCB_FLASH_TYPE_NOERASE)
+        sfcb_printf("  ERROR:%s:compact format requires sector erase flash with page program\n", __FUNCTION__);
+        return SFCB_E_NO_FLASH;
+#else
+        while ( uint32SlotCmp < elemTotalSize ) {
+            uint32SlotCmp = uint32SlotCmp << 1;
+        }
+        if ( (uint32SlotCmp > SFCB_FLASH_TOPO_PAGE_SIZE / 2) || ((uint32_t) self->uint16SpiMax < (SFCB_FLASH_TOPO_ADR_BYTE + 1 + uint32SlotCmp + uint8HeadLen)) ) {
+            sfcb_printf("  ERROR:%s:compact format slot=%d exceeds half page or SPI buffer\n", __FUNCTION__, uint32SlotCmp);
+            return SFCB_E_MEM;
+        }
+#endif
+    }
+    /* prepare slot */
+    (self->ptrCbs[cbNew]).uint8Used = 1;        // occupied
+    (self->ptrCbs[cbNew]).uint32IdNumMax = 0;   // in case of uninitialized memory
+    (self->ptrCbs[cbNew]).uint32IdNumMin = __UINT32_MAX__;  // assign highest number
+    (self->ptrCbs[cbNew]).uint32MagicNum = magicNum;        // used magic number for the circular buffer
+    (self->ptrCbs[cbNew]).uint16NumPagesPerElem = (uint16_t) sfcb_ceildivide_uint32(elemTotalSize, SFCB_FLASH_TOPO_PAGE_SIZE);  // calculate in multiple of pages
+    (self->ptrCbs[cbNew]).uint32SlotSize = (self->ptrCbs[cbNew]).uint16NumPagesPerElem * (uint32_t) SFCB_FLASH_TOPO_PAGE_SIZE;
+    (self->ptrCbs[cbNew]).uint32StartSector = uint32StartSector;
+#if defined(SFCB_FLASH_TYPE_NOERASE)
+    /* byte granular, one additional element for overwrite of the oldest */
+    (self->ptrCbs[cbNew]).uint32SlotSize = elemTotalSize;
+    uint16NumSectors = (uint16_t) sfcb_ceildivide_uint32((uint32_t) (numElems+1) * elemTotalSize, SFCB_FLASH_TOPO_SECTOR_SIZE);
+    (self->ptrCbs[cbNew]).uint32StopSector = (self->ptrCbs[cbNew]).uint32StartSector+uint16NumSectors-1;
+    (self->ptrCbs[cbNew]).uint16NumEntriesMax = (uint16_t) ((uint32_t) (uint16NumSectors * SFCB_FLASH_TOPO_SECTOR_SIZE) / elemTotalSize);
+#elif defined(SFCB_FLASH_TYPE_NAND)
+    /* elements not crossing blocks, see #sfcb_flash_adr_head */
+    uint16NumSectors = (uint16_t) sfcb_max(2, (uint16_t) sfcb_ceildivide_uint32(numElems, (uint32_t) (uint8PagesPerSector / (self->ptrCbs[cbNew]).uint16NumPagesPerElem)));
+    (self->ptrCbs[cbNew]).uint32StopSector = (self->ptrCbs[cbNew]).uint32StartSector+uint16NumSectors-1;
+    (self->ptrCbs[cbNew]).uint16NumEntriesMax = (uint16_t) (uint16NumSectors * (uint8PagesPerSector / (self->ptrCbs[cbNew]).uint16NumPagesPerElem));
+#else
+    if ( SFCB_FMT_COMPACT == fmt ) {
+        /* packed slots, first slot of every sector is the sector summary */
+        uint16ElemPerSec = (uint16_t) (SFCB_FLASH_TOPO_SECTOR_SIZE / uint32SlotCmp - 1);
+        (self->ptrCbs[cbNew]).uint32SlotSize = uint32SlotCmp;
+        uint16NumSectors = (uint16_t) sfcb_max(2, (uint16_t) sfcb_ceildivide_uint32(numElems, uint16ElemPerSec));
+        (self->ptrCbs[cbNew]).uint32StopSector = (self->ptrCbs[cbNew]).uint32StartSector+uint16NumSectors-1;
+        (self->ptrCbs[cbNew]).uint16NumEntriesMax = (uint16_t) (uint16NumSectors * uint16ElemPerSec);
+    } else {
+        uint16NumSectors = (uint16_t) sfcb_max(2, (uint16_t) sfcb_ceildivide_uint32((uint32_t) (numElems*((self->ptrCbs[cbNew]).uint16NumPagesPerElem)), uint8PagesPerSector));
+        (self->ptrCbs[cbNew]).uint32StopSector = (self->ptrCbs[cbNew]).uint32StartSector+uint16NumSectors-1;
+        (self->ptrCbs[cbNew]).uint16NumEntriesMax = (uint16_t) (uint16NumSectors*uint8PagesPerSector) / (self->ptrCbs[cbNew]).uint16NumPagesPerElem;
+    }
+#endif
+    (self->ptrCbs[cbNew]).uint16NumEntries = 0;
+    (self->ptrCbs[cbNew]).uint32ElemIdLastCpl = 0;  // no complete element
+    (self->ptrCbs[cbNew]).uint16PlFlashOfs = 0;     // no element in write
+    (self->ptrCbs[cbNew]).uint16PlSize = elemSizeByte;  // element size, needed to determine footer write
+    (self->ptrCbs[cbNew]).uint8Fmt = (uint8_t) fmt;
+    (self->ptrCbs[cbNew]).uint8HeadLen = uint8HeadLen;
+    (self->ptrCbs[cbNew]).uint8PostPend = 0;    // no posted write
+    (self->ptrCbs[cbNew]).uint8Weight = 1;      // one page program per scheduling round
+    (self->ptrCbs[cbNew]).uint32DelayLast = 0;
+    (self->ptrCbs[cbNew]).uint32DelayMax = 0;
+    (self->ptrCbs[cbNew]).uint32ScrubElems = 0;
+    (self->ptrCbs[cbNew]).uint32ScrubErrs = 0;
+    (self->ptrCbs[cbNew]).uint32ScrubPasses = 0;
+    (self->ptrCbs[cbNew]).ptrDefRing = NULL;    // no deferred writes
+    (self->ptrCbs[cbNew]).uint16DefCnt = 0;
+    (self->ptrCbs[cbNew]).uint16DefBurst = 0;
+    (self->ptrCbs[cbNew]).ptrXfrm = NULL;       // no payload transform
+    (self->ptrCbs[cbNew]).uint8XfrmNum = 0;
+    (self->ptrCbs[cbNew]).uint8XfrmMeta = 0;
+    (self->ptrCbs[cbNew]).uint8Pin = 0;         // no reader pin
+    (self->ptrCbs[cbNew]).uint8PinFull = 0;
+    (self->ptrCbs[cbNew]).uint8PinHit = 0;
+    (self->ptrCbs[cbNew]).uint32PinConflicts = 0;
+    (self->ptrCbs[cbNew]).uint32ReclaimSize = SFCB_FLASH_TOPO_SECTOR_SIZE;  // reclaim sector by sector
+    *cbID = cbNew;
+    /* check if stop sector is in total size */
+#if defined(SFCB_FLASH_TYPE_NAND)
+    if ( ((self->ptrCbs[cbNew]).uint32StopSector+1) > (uint32_t) (SFCB_FLASH_TOPO_FLASH_SIZE / SFCB_FLASH_TOPO_SECTOR_SIZE - self->uint16NandBbtLen) ) { // bad blocks are skipped
+#else
+    if ( ((self->ptrCbs[cbNew]).uint32StopSector+1) * SFCB_FLASH_TOPO_SECTOR_SIZE > SFCB_FLASH_TOPO_FLASH_SIZE ) {
+#endif
+        sfcb_printf("  ERROR:%s flash size exceeded\n", __FUNCTION__);
+        return SFCB_E_FLASH_FULL;   // Flash capacity exceeded
+    }
+    /* print slot config */
+    sfcb_printf("  INFO:%s:ptrCbs[%i]_p                     = %p\n",   __FUNCTION__, cbNew, (&self->ptrCbs[cbNew]));
+    sfcb_printf("  INFO:%s:ptrCbs[%i].uint8Used             = %d\n",   __FUNCTION__, cbNew, (self->ptrCbs[cbNew]).uint8Used);
+    sfcb_printf("  INFO:%s:ptrCbs[%i].uint16NumPagesPerElem = %d\n",   __FUNCTION__, cbNew, (self->ptrCbs[cbNew]).uint16NumPagesPerElem);
+    sfcb_printf("  INFO:%s:ptrCbs[%i].uint32SlotSize        = %d\n",   __FUNCTION__, cbNew, (self->ptrCbs[cbNew]).uint32SlotSize);
+    sfcb_printf("  INFO:%s:ptrCbs[%i].uint32StartSector     = 0x%x\n", __FUNCTION__, cbNew, (self->ptrCbs[cbNew]).uint32StartSector);
+    sfcb_printf("  INFO:%s:ptrCbs[%i].uint32StopSector      = 0x%x\n", __FUNCTION__, cbNew, (self->ptrCbs[cbNew]).uint32StopSector);
+    sfcb_printf("  INFO:%s:ptrCbs[%i].uint16NumEntriesMax   = %d\n",   __FUNCTION__, cbNew, (self->ptrCbs[cbNew]).uint16NumEntriesMax);
+    /* seal layout for warm start */
+    (self->ptrCbs[cbNew]).uint16CrcLayout = sfcb_cb_crc(&(self->ptrCbs[cbNew]), 0);
+    /* succesfull */
+    return SFCB_OK;
+}
+
+
+
+/**
+ *  sfcb_nand_bbt
+ *    registers bad blocks of NAND flash
+ */
+int sfcb_nand_bbt (t_sfcb *self, const uint16_t *bad, uint16_t num)
+{
+    /* Function call message */
+    sfcb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* no jobs pending */
+    if ( 0 != self->uint8Busy ) {
+        sfcb_printf("  ERROR:%s: Worker is busy\n", __FUNCTION__);
+        return SFCB_E_WKR_BSY;  // busy
+    }
+    /* check list */
+    for ( uint16_t i = 0; i < num; i++ ) {
+        if ( (bad[i] >= (SFCB_FLASH_TOPO_FLASH_SIZE / SFCB_FLASH_TOPO_SECTOR_SIZE)) || ((0 != i) && (bad[i] <= bad[i-1])) ) {
+            sfcb_printf("  ERROR:%s: bad block list invalid at index %d\n", __FUNCTION__, i);
+            return SFCB_E_MEM;  // not ascending or out of flash
+        }
+    }
+    /* register */
+    self->ptrNandBbt = bad;
+    self->uint16NandBbtLen = num;
+    self->uint32NandPage = UINT32_MAX;  // mapping changed
+    sfcb_printf("  INFO:%s: %d bad blocks\n", __FUNCTION__, num);
+    return SFCB_OK;
+}
+
+
+
+/**
+ *  sfcb_busy
+ *    checks if #sfcb_worker is free for new requests
+ */
+int sfcb_busy (t_sfcb *self)
+{
+    if ( 0 != self->uint8Busy ) {
+        return -1;  // busy
+    }
+    return 0;
+}
+
+
+
+/**
+ *  sfcb_idle_work
+ *    checks for work started by the idle worker
+ */
+int sfcb_idle_work (t_sfcb *self)
+{
+    /* background scrub */
+    if ( 0 != (self->uint16ScrubPkts | self->uint8ScrubPend) ) {
+        return -1;
+    }
+    /* deep power-down entry */
+    if ( (0 != self->uint8DpdEna) && (SFCB_DPD_AWAKE == self->dpd) ) {
+        return -1;
+    }
+    /* read requests */
+    for ( uint8_t i = 0; (NULL != self->ptrRdQ) && (i < self->uint8RdQLen); i++ ) {
+        if ( SFCB_RD_PEND == (self->ptrRdQ)[i].state ) {
+            return -1;
+        }
+    }
+    /* deferred records */
+    for ( uint8_t i = 0; i < self->uint8NumCbs; i++ ) {
+        if ( 0 == ((self->ptrCbs)[i]).uint8Used ) {
+            break;
+        }
+        if ( (NULL != ((self->ptrCbs)[i]).ptrDefRing) && (0 != ((self->ptrCbs)[i]).uint16DefCnt) ) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+
+
+/**
+ *  sfcb_spi_len
+ *    gets length of next spi packet
+ */
+uint16_t sfcb_spi_len (t_sfcb *self)
+{
+    return self->uint16SpiLen;
+}
+
+
+
+/**
+ *  sfcb_spi_lanes
+ *    data lanes of next spi packet
+ */
+uint8_t sfcb_spi_lanes (t_sfcb *self)
+{
+    if ( (0 != self->uint16SpiLen) && (0 != SFCB_FLASH_IST_WR_PAGE_QUAD) && (SFCB_FLASH_IST_WR_PAGE_QUAD == self->uint8PtrSpi[0]) ) {
+        return 4;
+    }
+    return 1;
+}
+
+
+
+/**
+ *  sfcb_mkcb
+ *    build up queues with circular buffer
+ */
+int sfcb_mkcb (t_sfcb *self)
+{
+    /* Function call message */
+    sfcb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    sfcb_printf("  INFO:%s:sfcb_p = %p\n", __FUNCTION__, self);
+    /* no jobs pending */
+    if ( 0 != self->uint8Busy ) {
+        sfcb_printf("  ERROR:%s: Worker is busy\n", __FUNCTION__);
+        return SFCB_E_WKR_BSY;  // busy
+    }
+    /* check for at least one active queue */
+    if ( 0 == ((self->ptrCbs)[0]).uint8Used ) {
+        sfcb_printf("  ERROR:%s: Circular buffer queue not active or present\n", __FUNCTION__);
+        return SFCB_E_NO_CB_Q;  // circular buffer queue not active
+    }
+    /* Find first queue which needs an build */
+    self->uint8IterCb = 0;
+    for ( uint8_t i = 0; i < self->uint8NumCbs; i++ ) {
+        if ( (0 == ((self->ptrCbs)[i]).uint8Used) || (0 == ((self->ptrCbs)[i]).uint8MgmtValid) ) {
+            break;
+        }
+        self->uint8IterCb = i;  // search for queue with uninitialized or invalid managment data, in case of only on circular buffer needes to rebuild
+    }
+    /* reset idmin/idmax counter to enable select of correct page to erase */
+    for ( uint8_t i = self->uint8IterCb; i < (self->uint8NumCbs); i++ ) {
+        /* not used, leave */
+        if ( 0 == ((self->ptrCbs)[i]).uint8Used ) {
+            break;
+        }
+        /* dirty buffer, needs to rebuild absoulte idmin/idmax for next write, otherwise will the last written element deleted */
+        if ( 0 == ((self->ptrCbs)[i]).uint8MgmtValid ) {
+            (self->ptrCbs[i]).uint32IdNumMax = 0;               // in case of uninitialized memory
+            (self->ptrCbs[i]).uint32IdNumMin = __UINT32_MAX__;  // assign highest number
+            (self->ptrCbs[i]).uint16PlFlashOfs = 0;             // reset payload offset counter
+        }
     }
+    /* Setup new Job */
+    self->cmd = SFCB_CMD_MKCB;
+    self->uint16Iter = 0;       // start with first element on lowest
+    self->stage = SFCB_STG00;
+    self->error = SFCB_E_NOERO;
+    self->uint8Busy = 1;
+    /* fine */
+    return SFCB_OK;
 }
 
 
 
 /**
- *  sfcb_flash_size
- *    total flashsize
+ *  sfcb_add
+ *    inserts element into circular buffer in multiple writes
+ *    in case of prematurely finish circular buffer element run #sfcb_add_done
  */
-uint32_t sfcb_flash_size (void)
+int sfcb_add (t_sfcb *self, uint8_t cbID, void *data, uint16_t len)
 {
-    return (uint32_t) SFCB_FLASH_TOPO_FLASH_SIZE;
+    /* Function call message */
+    sfcb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* no jobs pending, fragment list of job is in use */
+    if ( 0 != self->uint8Busy ) {
+        sfcb_printf("  ERROR:%s: Worker is busy\n", __FUNCTION__);
+        return SFCB_E_WKR_BSY;  // Worker is busy, wait for processing last job
+    }
+    /* single fragment */
+    (self->iov).ptr = data;
+    (self->iov).len = len;
+    return sfcb_addv(self, cbID, &(self->iov), 1);
 }
 
 
 
 /**
- *  sfcb_new_cb
- *    creates new circular buffer entry
+ *  sfcb_add_chk
+ *    checks if add request is accepted, no job is started
  */
-int sfcb_new_cb (t_sfcb *self, uint32_t magicNum, uint16_t elemSizeByte, uint16_t numElems, uint8_t *cbID)
+int sfcb_add_chk (t_sfcb *self, uint8_t cbID, uint32_t len)
 {
-    /** help variables **/
-    const uint8_t   uint8PagesPerSector = (uint8_t) (SFCB_FLASH_TOPO_SECTOR_SIZE / SFCB_FLASH_TOPO_PAGE_SIZE);
-    const uint16_t  elemTotalSize = (uint16_t) (elemSizeByte + 2*sizeof(spi_flash_cb_elem_head));   // payload size + header/footer size
-    uint8_t         cbNew;              // queue of circular buffer new entry number
-    uint32_t        uint32StartSector;
-    uint16_t        uint16NumSectors;
+    /** Variables **/
+    uint32_t    uint32Len = len;    // payload in flash after request
+
+    /* no jobs pending */
+    if ( 0 != self->uint8Busy ) {
+        sfcb_printf("  ERROR:%s: Worker is busy\n", __FUNCTION__);
+        return SFCB_E_WKR_BSY;  // Worker is busy, wait for processing last job
+    }
+    /* check if requested circular buffer queue exist */
+    if ( !(cbID < self->uint8NumCbs) ) {
+        sfcb_printf("  ERROR:%s: Circular buffer queue not active or present\n", __FUNCTION__);
+        return SFCB_E_NO_CB_Q;  // circular buffer queue not present
+    }
+    /* erase blocked by reader pin, no free element */
+    if ( 0 != ((self->ptrCbs)[cbID]).uint8PinFull ) {
+        sfcb_printf("  ERROR:%s: Erase blocked by pin\n", __FUNCTION__);
+        return SFCB_E_PIN;
+    }
+#if defined(SFCB_FLASH_TYPE_NAND)
+    /* element is programmed once, append would program ECC sectors of the page in write again */
+    if ( (0 != ((self->ptrCbs)[cbID]).uint8Used) && (0 != ((self->ptrCbs)[cbID]).uint16PlFlashOfs) ) {
+        sfcb_printf("  ERROR:%s: SPI NAND element already programmed, append rejected\n", __FUNCTION__);
+        return SFCB_E_NOP;
+    }
+#endif
+    /* check if CB is init for request */
+    if (    (0 == ((self->ptrCbs)[cbID]).uint8Used)
+         || ( ((self->ptrCbs)[cbID]).uint16PlFlashOfs >= (((self->ptrCbs)[cbID]).uint16PlSize + ((self->ptrCbs)[cbID]).uint8HeadLen) )
+    ) {
+        sfcb_printf("  ERROR:%s: Circular Buffer is not prepared for request\n", __FUNCTION__);
+        return SFCB_E_WKR_REQ;  // Circular Buffer is not prepared for adding new element, run #sfcb_worker
+    }
+    if ( uint32Len > UINT16_MAX ) {
+        sfcb_printf("  ERROR:%s: gathered payload exceeds 16bit length\n", __FUNCTION__);
+        return SFCB_E_MEM;  // not representable as element payload
+    }
+    /* check for match into element payload, footer and next slot stay untouched */
+    if ( 0 != ((self->ptrCbs)[cbID]).uint16PlFlashOfs ) {
+        uint32Len += (uint32_t) (((self->ptrCbs)[cbID]).uint16PlFlashOfs - ((self->ptrCbs)[cbID]).uint8HeadLen);   // payload already in flash
+    }
+    if ( uint32Len > ((self->ptrCbs)[cbID]).uint16PlSize ) {
+        sfcb_printf("  ERROR:%s: data segement is larger then reserved circular buffer space\n", __FUNCTION__);
+        return SFCB_E_MEM;  // data segement is larger then reserved circular buffer space
+    }
+    /* fine */
+    return SFCB_OK;
+}
+
+
+
+/**
+ *  sfcb_addv
+ *    inserts element into circular buffer, payload is gathered from fragments
+ */
+int sfcb_addv (t_sfcb *self, uint8_t cbID, const t_sfcb_iov *iov, uint8_t iovcnt)
+{
+    /** Variables **/
+    int         ret;            // return value
+    uint32_t    uint32Len = 0;  // total payload length
 
     /* Function call message */
     sfcb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
-    sfcb_printf("  INFO:%s:sfcb_p = %p\n", __FUNCTION__, self);
-    /* check for free Slot number */
-    uint32StartSector = 0;
-    for ( cbNew = 0; cbNew < (self->uint8NumCbs); cbNew++ ) {
-        if ( 0 != (self->ptrCbs[cbNew]).uint8Used ) {   // queue is used
-            uint32StartSector = (self->ptrCbs[cbNew]).uint32StopSector + 1; // calculate start address of next queue
-        } else {
-            break;  // empty queue found
-        }
+    /* total payload size */
+    for ( uint8_t i = 0; i < iovcnt; i++ ) {
+        uint32Len += iov[i].len;
     }
-    if ( cbNew == (self->uint8NumCbs) ) {
-        sfcb_printf("  ERROR:%s:sfcb_cb exceeded total available number of %i cbs\n", __FUNCTION__, (self->uint8NumCbs));
-        return SFCB_E_MEM;  // no free circular buffer slots, allocate more memory in #t_sfcb_cb table
+    /* request fits into queue */
+    ret = sfcb_add_chk(self, cbID, uint32Len);
+    if ( SFCB_OK != ret ) {
+        return ret;
     }
-    /* prepare slot */
-    (self->ptrCbs[cbNew]).uint8Used = 1;        // occupied
-    (self->ptrCbs[cbNew]).uint32IdNumMax = 0;   // in case of uninitialized memory
-    (self->ptrCbs[cbNew]).uint32IdNumMin = __UINT32_MAX__;  // assign highest number
-    (self->ptrCbs[cbNew]).uint32MagicNum = magicNum;        // used magic number for the circular buffer
-    (self->ptrCbs[cbNew]).uint16NumPagesPerElem = (uint16_t) sfcb_ceildivide_uint32(elemTotalSize, SFCB_FLASH_TOPO_PAGE_SIZE);  // calculate in multiple of pages
-    (self->ptrCbs[cbNew]).uint32StartSector = uint32StartSector;
-    uint16NumSectors = (uint16_t) sfcb_max(2, (uint16_t) sfcb_ceildivide_uint32((uint32_t) (numElems*((self->ptrCbs[cbNew]).uint16NumPagesPerElem)), uint8PagesPerSector));
-    (self->ptrCbs[cbNew]).uint32StopSector = (self->ptrCbs[cbNew]).uint32StartSector+uint16NumSectors-1;
-    (self->ptrCbs[cbNew]).uint16NumEntriesMax = (uint16_t) (uint16NumSectors*uint8PagesPerSector) / (self->ptrCbs[cbNew]).uint16NumPagesPerElem;
-    (self->ptrCbs[cbNew]).uint16NumEntries = 0;
-    (self->ptrCbs[cbNew]).uint16PlSize = elemSizeByte;  // element size, needed to determine footer write
-    *cbID = cbNew;
-    /* check if stop sector is in total size */
-    if ( ((self->ptrCbs[cbNew]).uint32StopSector+1) * SFCB_FLASH_TOPO_SECTOR_SIZE > SFCB_FLASH_TOPO_FLASH_SIZE ) {
-        sfcb_printf("  ERROR:%s flash size exceeded\n", __FUNCTION__);
-        return SFCB_E_FLASH_FULL;   // Flash capacity exceeded
+    /* store information for insertion */
+    self->uint8IterCb = cbID;   // used as pointer to queue
+    ((self->ptrCbs)[self->uint8IterCb]).uint8MgmtValid = 0; // mark queue as dirty, for next write run #sfcb_mkcb
+    self->uint32IterAdr = ((self->ptrCbs)[self->uint8IterCb]).uint32StartPageWrite + ((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs;  // select page for write
+    self->ptrCbElemPl = NULL;
+    self->uint16CbElemPlSize = (uint16_t) uint32Len;
+    self->uint16Iter = 0;   // number of written payload bytes
+    self->ptrIov = iov;
+    self->uint8IovCnt = iovcnt;
+    self->uint8IovIdx = 0;
+    self->uint16IovOfs = 0;
+    /* Setup new Job */
+    self->uint8Busy = 1;
+    self->cmd = SFCB_CMD_ADD;
+    self->stage = SFCB_STG00;
+    self->ptrUcode = g_sfcbUcodeAdd;
+    self->uint8UcPc = 0;
+    self->error = SFCB_E_NOERO;
+    /* fine */
+    return 0;
+}
+
+
+
+/**
+ *  sfcb_add_done
+ *    force footer write into flash if at leat one payload byte is written
+ *    and the nominal payload size isn't reached
+ */
+int sfcb_add_done (t_sfcb *self, uint8_t cbID)
+{
+    /* Function call message */
+    sfcb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* no jobs pending */
+    if ( 0 != self->uint8Busy ) {
+        sfcb_printf("  ERROR:%s: Worker is busy\n", __FUNCTION__);
+        return SFCB_E_WKR_BSY;  // Worker is busy, wait for processing last job
     }
-    /* print slot config */
-    sfcb_printf("  INFO:%s:ptrCbs[%i]_p                     = %p\n",   __FUNCTION__, cbNew, (&self->ptrCbs[cbNew]));
-    sfcb_printf("  INFO:%s:ptrCbs[%i].uint8Used             = %d\n",   __FUNCTION__, cbNew, (self->ptrCbs[cbNew]).uint8Used);
-    sfcb_printf("  INFO:%s:ptrCbs[%i].uint16NumPagesPerElem = %d\n",   __FUNCTION__, cbNew, (self->ptrCbs[cbNew]).uint16NumPagesPerElem);
-    sfcb_printf("  INFO:%s:ptrCbs[%i].uint32StartSector     = 0x%x\n", __FUNCTION__, cbNew, (self->ptrCbs[cbNew]).uint32StartSector);
-    sfcb_printf("  INFO:%s:ptrCbs[%i].uint32StopSector      = 0x%x\n", __FUNCTION__, cbNew, (self->ptrCbs[cbNew]).uint32StopSector);
-    sfcb_printf("  INFO:%s:ptrCbs[%i].uint16NumEntriesMax   = %d\n",   __FUNCTION__, cbNew, (self->ptrCbs[cbNew]).uint16NumEntriesMax);
-    /* succesfull */
+    if ( !(cbID < self->uint8NumCbs) ) {
+        sfcb_printf("  ERROR:%s: Circular buffer queue not active or present\n", __FUNCTION__);
+        return SFCB_E_NO_CB_Q;  // circular buffer queue not present
+    }
+    /* Footer still written? */
+    if ( ((self->ptrCbs)[cbID]).uint16PlFlashOfs > (((self->ptrCbs)[cbID]).uint16PlSize + ((self->ptrCbs)[cbID]).uint8HeadLen) ) {
+        return SFCB_OK; // footer is still written, nothing to do
+    }
+    /* check if CB is init for request, element reopened by #sfcb_mkcb is in write */
+    if ( (0 != ((self->ptrCbs)[cbID]).uint8Used) && (0 != ((self->ptrCbs)[cbID]).uint8MgmtValid) && (0 == ((self->ptrCbs)[cbID]).uint16PlFlashOfs) ) {
+        sfcb_printf("  ERROR:%s: Circular buffer queue existent, but no payload bytes are present\n", __FUNCTION__);
+        return SFCB_E_CB_Q_MTY;  // Circular Buffer is not prepared for adding new element, run #sfcb_worker
+    }
+    /* store information for insertion */
+    self->uint8IterCb = cbID;   // used as pointer to queue
+    self->uint32IterAdr = ((self->ptrCbs)[self->uint8IterCb]).uint32StartPageWrite + ((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs;  // select page for write
+    self->ptrCbElemPl = NULL;
+    self->uint16CbElemPlSize = 0;
+    self->uint16Iter = 0;   // used as ptrCbElemPl written pointer
+    self->ptrIov = NULL;
+    self->uint8IovCnt = 0;
+    ((self->ptrCbs)[self->uint8IterCb]).uint8MgmtValid = 0; // mark queue as dirty, also if reopened element is finished without append
+    ((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs = (uint16_t) (((self->ptrCbs)[self->uint8IterCb]).uint16PlSize + ((self->ptrCbs)[self->uint8IterCb]).uint8HeadLen);  // force condition for footer writer, #sfcb_worker
+    /* Setup new Job */
+    self->uint8Busy = 1;
+    self->cmd = SFCB_CMD_ADD;
+    self->stage = SFCB_STG00;
+    self->ptrUcode = g_sfcbUcodeAdd;
+    self->uint8UcPc = 0;
+    self->error = SFCB_E_NOERO;
+    /* fine */
+    return 0;
+}
+
+
+
+/**
+ *  sfcb_add_post
+ *    posts complete element write
+ */
+int sfcb_add_post (t_sfcb *self, uint8_t cbID, const void *data, uint16_t len)
+{
+    /* Function call message */
+    sfcb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* worker idle or serves posted writes */
+    if ( (0 != self->uint8Busy) && (0 == self->uint8Sched) ) {
+        sfcb_printf("  ERROR:%s: Worker is busy\n", __FUNCTION__);
+        return SFCB_E_WKR_BSY;
+    }
+    if ( !(cbID < self->uint8NumCbs) || (0 == ((self->ptrCbs)[cbID]).uint8Used) ) {
+        sfcb_printf("  ERROR:%s: Circular buffer queue not active or present\n", __FUNCTION__);
+        return SFCB_E_NO_CB_Q;
+    }
+    if ( 0 != ((self->ptrCbs)[cbID]).uint8PostPend ) {
+        sfcb_printf("  ERROR:%s: Write to queue is pending\n", __FUNCTION__);
+        return SFCB_E_WKR_BSY;
+    }
+    if ( 0 != ((self->ptrCbs)[cbID]).uint8PinFull ) {
+        sfcb_printf("  ERROR:%s: Erase blocked by pin\n", __FUNCTION__);
+        return SFCB_E_PIN;
+    }
+    /* free slot allocated and no element in write */
+    if ( (0 == ((self->ptrCbs)[cbID]).uint8MgmtValid) || (0 != ((self->ptrCbs)[cbID]).uint16PlFlashOfs) ) {
+        sfcb_printf("  ERROR:%s: Circular Buffer is not prepared for request\n", __FUNCTION__);
+        return SFCB_E_WKR_REQ;
+    }
+    if ( len > ((self->ptrCbs)[cbID]).uint16PlSize ) {
+        sfcb_printf("  ERROR:%s: data segement is larger then reserved circular buffer space\n", __FUNCTION__);
+        return SFCB_E_MEM;
+    }
+    /* enqueue */
+    ((self->ptrCbs)[cbID]).uint8MgmtValid = 0;  // mark queue as dirty, for next write run #sfcb_mkcb
+    ((self->ptrCbs)[cbID]).ptrPostPl = data;
+    ((self->ptrCbs)[cbID]).uint16PostLen = len;
+    ((self->ptrCbs)[cbID]).uint16PostIter = 0;
+    ((self->ptrCbs)[cbID]).uint8PostSrv = 0;
+    ((self->ptrCbs)[cbID]).uint8Deficit = 0;
+    ((self->ptrCbs)[cbID]).uint32PostTick = self->uint32WkrCalls;
+    ((self->ptrCbs)[cbID]).uint8PostPend = 1;
+    /* scheduler runs */
+    if ( 0 != self->uint8Sched ) {
+        return SFCB_OK;
+    }
+    /* Setup new Job */
+    self->uint8IterCb = cbID;
+    self->uint16Iter = 0;
+    self->uint8Sched = 1;
+    self->uint8Busy = 1;
+    self->cmd = SFCB_CMD_ADD;
+    self->stage = SFCB_STG00;
+    self->ptrUcode = g_sfcbUcodeAdd;
+    self->uint8UcPc = 0;
+    self->error = SFCB_E_NOERO;
     return SFCB_OK;
 }
 
 
 
 /**
- *  sfcb_busy
- *    checks if #sfcb_worker is free for new requests
+ *  sfcb_defer
+ *    deferred writes of queue through RAM ring
  */
-int sfcb_busy (t_sfcb *self)
+int sfcb_defer (t_sfcb *self, uint8_t cbID, void *ring, uint16_t ringLen, uint16_t recLen, uint16_t thr, uint32_t age)
 {
-    if ( 0 != self->uint8Busy ) {
-        return -1;  // busy
+    /* Function call message */
+    sfcb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    if ( !(cbID < self->uint8NumCbs) || (0 == ((self->ptrCbs)[cbID]).uint8Used) ) {
+        sfcb_printf("  ERROR:%s: Circular buffer queue not active or present\n", __FUNCTION__);
+        return SFCB_E_NO_CB_Q;
+    }
+    if ( 0 != ((self->ptrCbs)[cbID]).uint16DefCnt ) {
+        sfcb_printf("  ERROR:%s: Records waiting in ring\n", __FUNCTION__);
+        return SFCB_E_WKR_BSY;
+    }
+    /* disable */
+    if ( NULL == ring ) {
+        ((self->ptrCbs)[cbID]).ptrDefRing = NULL;
+        return SFCB_OK;
+    }
+    if ( (0 == recLen) || (ringLen < recLen) || (recLen > ((self->ptrCbs)[cbID]).uint16PlSize) ) {
+        sfcb_printf("  ERROR:%s: record of %d bytes exceeds ring or element\n", __FUNCTION__, recLen);
+        return SFCB_E_MEM;
+    }
+    /* ring in multiple of records, burst limited to one element */
+    ((self->ptrCbs)[cbID]).ptrDefRing = (uint8_t*) ring;
+    ((self->ptrCbs)[cbID]).uint16DefRecLen = recLen;
+    ((self->ptrCbs)[cbID]).uint16DefRecs = (uint16_t) (ringLen / recLen);
+    ((self->ptrCbs)[cbID]).uint16DefFirst = 0;
+    ((self->ptrCbs)[cbID]).uint16DefBurst = 0;
+    ((self->ptrCbs)[cbID]).uint16DefThr = (uint16_t) sfcb_min(sfcb_max(thr, (uint16_t) 1), (uint16_t) sfcb_min(((self->ptrCbs)[cbID]).uint16DefRecs, (uint16_t) (((self->ptrCbs)[cbID]).uint16PlSize / recLen)));
+    ((self->ptrCbs)[cbID]).uint32DefAge = age;
+    ((self->ptrCbs)[cbID]).uint8DefForce = 0;
+    sfcb_printf("  INFO:%s: cb=%d, records=%d, thr=%d\n", __FUNCTION__, cbID, ((self->ptrCbs)[cbID]).uint16DefRecs, ((self->ptrCbs)[cbID]).uint16DefThr);
+    return SFCB_OK;
+}
+
+
+
+/**
+ *  sfcb_add_defer
+ *    copies record into RAM ring
+ */
+int sfcb_add_defer (t_sfcb *self, uint8_t cbID, const void *data)
+{
+    /** Variables **/
+    t_sfcb_cb   *ptrCb; // deferred queue
+
+    if ( !(cbID < self->uint8NumCbs) || (NULL == ((self->ptrCbs)[cbID]).ptrDefRing) ) {
+        sfcb_printf("  ERROR:%s: Circular buffer queue not present or not deferred\n", __FUNCTION__);
+        return SFCB_E_NO_CB_Q;
+    }
+    ptrCb = &((self->ptrCbs)[cbID]);
+    if ( ptrCb->uint16DefCnt == ptrCb->uint16DefRecs ) {
+        sfcb_printf("  ERROR:%s: Ring full\n", __FUNCTION__);
+        return SFCB_E_MEM;
+    }
+    if ( 0 == ptrCb->uint16DefCnt ) {
+        ptrCb->uint32DefTick = self->uint32WkrCalls;    // age of oldest record
+    }
+    memcpy(ptrCb->ptrDefRing + (uint32_t) ((ptrCb->uint16DefFirst + ptrCb->uint16DefCnt) % ptrCb->uint16DefRecs) * ptrCb->uint16DefRecLen, data, ptrCb->uint16DefRecLen);
+    (ptrCb->uint16DefCnt)++;
+    return SFCB_OK;
+}
+
+
+
+/**
+ *  sfcb_flush
+ *    writes all deferred records
+ */
+int sfcb_flush (t_sfcb *self)
+{
+    for ( uint8_t i = 0; i < self->uint8NumCbs; i++ ) {
+        if ( 0 == ((self->ptrCbs)[i]).uint8Used ) {
+            break;
+        }
+        if ( 0 != ((self->ptrCbs)[i]).uint16DefCnt ) {
+            ((self->ptrCbs)[i]).uint8DefForce = 1;
+        }
     }
-    return 0;
+    return SFCB_OK;
 }
 
 
 
 /**
- *  sfcb_spi_len
- *    gets length of next spi packet
+ *  sfcb_deep_pd
+ *    deep power-down of idle flash
  */
-uint16_t sfcb_spi_len (t_sfcb *self)
+int sfcb_deep_pd (t_sfcb *self, uint8_t ena, uint32_t wake)
 {
-    return self->uint16SpiLen;
+    if ( 0 == SFCB_FLASH_IST_PWR_DOWN ) {
+        sfcb_printf("  ERROR:%s: flash without deep power-down\n", __FUNCTION__);
+        return SFCB_E_NO_FLASH;
+    }
+    self->uint8DpdEna = ena;
+    self->uint32DpdWake = wake;
+    return SFCB_OK;
 }
 
 
 
 /**
- *  sfcb_mkcb
- *    build up queues with circular buffer
+ *  sfcb_quad
+ *    quad input page program
  */
-int sfcb_mkcb (t_sfcb *self)
+int sfcb_quad (t_sfcb *self, uint8_t ena)
 {
     /* Function call message */
     sfcb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
-    sfcb_printf("  INFO:%s:sfcb_p = %p\n", __FUNCTION__, self);
+    /* check flash */
+    if ( 0 == SFCB_FLASH_IST_WR_PAGE_QUAD ) {
+        sfcb_printf("  ERROR:%s: flash without quad page program\n", __FUNCTION__);
+        return SFCB_E_NO_FLASH;
+    }
     /* no jobs pending */
     if ( 0 != self->uint8Busy ) {
-        sfcb_printf("  ERROR:%s: Worker is busy\n", __FUNCTION__);
-        return SFCB_E_WKR_BSY;  // busy
-    }
-    /* check for at least one active queue */
-    if ( 0 == ((self->ptrCbs)[0]).uint8Used ) {
-        sfcb_printf("  ERROR:%s: Circular buffer queue not active or present\n", __FUNCTION__);
-        return SFCB_E_NO_CB_Q;  // circular buffer queue not active
-    }
-    /* Find first queue which needs an build */
-    self->uint8IterCb = 0;
-    for ( uint8_t i = 0; i < self->uint8NumCbs; i++ ) {
-        if ( (0 == ((self->ptrCbs)[i]).uint8Used) || (0 == ((self->ptrCbs)[i]).uint8MgmtValid) ) {
-            break;
-        }
-        self->uint8IterCb = i;  // search for queue with uninitialized or invalid managment data, in case of only on circular buffer needes to rebuild
+        sfcb_printf("  ERROR:%s: worker busy\n", __FUNCTION__);
+        return SFCB_E_WKR_BSY;
     }
-    /* reset idmin/idmax counter to enable select of correct page to erase */
-    for ( uint8_t i = self->uint8IterCb; i < (self->uint8NumCbs); i++ ) {
-        /* not used, leave */
-        if ( 0 == ((self->ptrCbs)[i]).uint8Used ) {
-            break;
-        }
-        /* dirty buffer, needs to rebuild absoulte idmin/idmax for next write, otherwise will the last written element deleted */
-        if ( 0 == ((self->ptrCbs)[i]).uint8MgmtValid ) {
-            (self->ptrCbs[i]).uint32IdNumMax = 0;               // in case of uninitialized memory
-            (self->ptrCbs[i]).uint32IdNumMin = __UINT32_MAX__;  // assign highest number
-            (self->ptrCbs[i]).uint16PlFlashOfs = 0;             // reset payload offset counter
-        }
+    /* single lane */
+    if ( 0 == ena ) {
+        self->uint8Quad = 0;
+        return SFCB_OK;
     }
     /* Setup new Job */
-    self->cmd = SFCB_CMD_MKCB;
-    self->uint16Iter = 0;       // start with first element on lowest
+    self->uint16Iter = 0;
+    self->cmd = SFCB_CMD_QE;
     self->stage = SFCB_STG00;
+    self->ptrUcode = g_sfcbUcodeQe;
+    self->uint8UcPc = 0;
     self->error = SFCB_E_NOERO;
     self->uint8Busy = 1;
-    /* fine */
     return SFCB_OK;
 }
 
 
 
 /**
- *  sfcb_add
- *    inserts element into circular buffer in multiple writes
- *    in case of prematurely finish circular buffer element run #sfcb_add_done
+ *  sfcb_xfrm
+ *    payload transform stages of queue
  */
-int sfcb_add (t_sfcb *self, uint8_t cbID, void *data, uint16_t len)
+int sfcb_xfrm (t_sfcb *self, uint8_t cbID, const t_sfcb_xfrm *chain, uint8_t num)
 {
-    /* Function call message */
-    sfcb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
-    /* no jobs pending */
+    /** Variables **/
+    uint32_t    uint32Meta = 0; // metadata of all stages
+
+    if ( !(cbID < self->uint8NumCbs) || (0 == ((self->ptrCbs)[cbID]).uint8Used) ) {
+        return SFCB_E_NO_CB_Q;
+    }
     if ( 0 != self->uint8Busy ) {
-        sfcb_printf("  ERROR:%s: Worker is busy\n", __FUNCTION__);
-        return SFCB_E_WKR_BSY;  // Worker is busy, wait for processing last job
+        return SFCB_E_WKR_BSY;
     }
-    /* check if requested circular buffer queue exist */
-    if ( !(cbID < self->uint8NumCbs) ) {
-        sfcb_printf("  ERROR:%s: Circular buffer queue not active or present\n", __FUNCTION__);
-        return SFCB_E_NO_CB_Q;  // circular buffer queue not present
+    if ( NULL == chain ) {
+        num = 0;
     }
-    /* check if CB is init for request */
-    if (    (0 == ((self->ptrCbs)[cbID]).uint8Used)
-         || ( ((self->ptrCbs)[cbID]).uint16PlFlashOfs >= (((self->ptrCbs)[cbID]).uint16PlSize + sizeof(spi_flash_cb_elem_head)) )
+    for ( uint8_t i = 0; i < num; i++ ) {
+        uint32Meta += chain[i].metaLen;
+    }
+    /* formats without footer write first payload chunk with header */
+    if ( (0 != num) && (SFCB_FMT_HEAD_FOOT != ((self->ptrCbs)[cbID]).uint8Fmt) ) {
+        sfcb_printf("  ERROR:%s: cb=%d, element format without payload transform\n", __FUNCTION__, cbID);
+        return SFCB_E_FMT;
+    }
+    /* metadata between payload and footer, footer and metadata in one page program */
+    if (    (0 != num)
+         && (    ((uint32_t) (2*((self->ptrCbs)[cbID]).uint8HeadLen + ((self->ptrCbs)[cbID]).uint16PlSize) + uint32Meta > ((self->ptrCbs)[cbID]).uint32SlotSize)
+              || (((self->ptrCbs)[cbID]).uint8HeadLen + uint32Meta > SFCB_FLASH_TOPO_PAGE_SIZE)
+              || (uint32Meta > UINT8_MAX)
+            )
     ) {
-        sfcb_printf("  ERROR:%s: Circular Buffer is not prepared for request\n", __FUNCTION__);
-        return SFCB_E_WKR_REQ;  // Circular Buffer is not prepared for adding new element, run #sfcb_worker
+        sfcb_printf("  ERROR:%s: cb=%d, no space for %d byte metadata\n", __FUNCTION__, cbID, uint32Meta);
+        return SFCB_E_MEM;
     }
-    /* check for match into circular buffer size */
-    if ( (len + ((self->ptrCbs)[cbID]).uint16PlFlashOfs) > (((self->ptrCbs)[cbID]).uint16NumPagesPerElem * SFCB_FLASH_TOPO_PAGE_SIZE) ) {
-        sfcb_printf("  ERROR:%s: data segement is larger then reserved circular buffer space\n", __FUNCTION__);
-        return SFCB_E_MEM;  // data segement is larger then reserved circular buffer space
+    ((self->ptrCbs)[cbID]).ptrXfrm = (0 == num) ? NULL : chain;
+    ((self->ptrCbs)[cbID]).uint8XfrmNum = num;
+    ((self->ptrCbs)[cbID]).uint8XfrmMeta = (uint8_t) uint32Meta;
+    return SFCB_OK;
+}
+
+
+
+/**
+ *  sfcb_reclaim
+ *    erase granularity of queue
+ */
+int sfcb_reclaim (t_sfcb *self, uint8_t cbID, uint32_t blkSize)
+{
+    if ( !(cbID < self->uint8NumCbs) || (0 == ((self->ptrCbs)[cbID]).uint8Used) ) {
+        return SFCB_E_NO_CB_Q;
     }
-    /* store information for insertion */
-    self->uint8IterCb = cbID;   // used as pointer to queue
-    ((self->ptrCbs)[self->uint8IterCb]).uint8MgmtValid = 0; // mark queue as dirty, for next write run #sfcb_mkcb
-    self->uint32IterAdr = ((self->ptrCbs)[self->uint8IterCb]).uint32StartPageWrite + ((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs;  // select page for write
-    self->ptrCbElemPl = data;
-    self->uint16CbElemPlSize = len;
-    self->uint16Iter = 0;   // used as ptrCbElemPl written pointer
-    /* Setup new Job */
-    self->uint8Busy = 1;
-    self->cmd = SFCB_CMD_ADD;
-    self->stage = SFCB_STG00;
-    self->error = SFCB_E_NOERO;
-    /* fine */
-    return 0;
+    if ( 0 != self->uint8Busy ) {
+        return SFCB_E_WKR_BSY;
+    }
+    if (    (SFCB_FLASH_TOPO_SECTOR_SIZE != blkSize)
+         && !((32768 == blkSize) && (0 != SFCB_FLASH_IST_ERASE_BLK32) && (blkSize > SFCB_FLASH_TOPO_SECTOR_SIZE))
+         && !((65536 == blkSize) && (0 != SFCB_FLASH_IST_ERASE_BLK64) && (blkSize > SFCB_FLASH_TOPO_SECTOR_SIZE))
+    ) {
+        sfcb_printf("  ERROR:%s: cb=%d, block erase of %d byte not supported\n", __FUNCTION__, cbID, blkSize);
+        return SFCB_E_NO_FLASH;
+    }
+    ((self->ptrCbs)[cbID]).uint32ReclaimSize = blkSize;
+    return SFCB_OK;
 }
 
 
 
 /**
- *  sfcb_add_done
- *    force footer write into flash if at leat one payload byte is written
- *    and the nominal payload size isn't reached
+ *  sfcb_pin
+ *    pins flash range of queue for long running reader
  */
-int sfcb_add_done (t_sfcb *self, uint8_t cbID)
+int sfcb_pin (t_sfcb *self, uint8_t cbID, uint32_t adr, uint32_t len, t_sfcb_pin_pol pol)
 {
-    /* Function call message */
-    sfcb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
-    /* Footer still written? */
-    if ( ((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs > (((self->ptrCbs)[self->uint8IterCb]).uint16PlSize + sizeof(spi_flash_cb_elem_head)) ) {
-        return SFCB_OK; // footer is still written, nothing to do
+    /** Variables **/
+    t_sfcb_cb   *ptrCb;     // selected queue
+
+    if ( !(cbID < self->uint8NumCbs) || (0 == ((self->ptrCbs)[cbID]).uint8Used) ) {
+        return SFCB_E_NO_CB_Q;
     }
-    /* no jobs pending */
     if ( 0 != self->uint8Busy ) {
-        sfcb_printf("  ERROR:%s: Worker is busy\n", __FUNCTION__);
-        return SFCB_E_WKR_BSY;  // Worker is busy, wait for processing last job
+        return SFCB_E_WKR_BSY;
     }
-    if ( !(cbID < self->uint8NumCbs) ) {
-        sfcb_printf("  ERROR:%s: Circular buffer queue not active or present\n", __FUNCTION__);
-        return SFCB_E_NO_CB_Q;  // circular buffer queue not present
+    ptrCb = &((self->ptrCbs)[cbID]);
+    if (    (0 != len)
+         && (    (adr < ptrCb->uint32StartSector * SFCB_FLASH_TOPO_SECTOR_SIZE)
+              || (adr + len > (ptrCb->uint32StopSector + 1) * SFCB_FLASH_TOPO_SECTOR_SIZE)
+              || (adr + len < adr)
+            )
+    ) {
+        sfcb_printf("  ERROR:%s: cb=%d, range adr=0x%x, len=%d outside of queue\n", __FUNCTION__, cbID, adr, len);
+        return SFCB_E_MEM;
     }
-    /* check if CB is init for request */
-    if ( (0 != ((self->ptrCbs)[cbID]).uint8Used) && (0 != ((self->ptrCbs)[cbID]).uint8MgmtValid) ) {
-        sfcb_printf("  ERROR:%s: Circular buffer queue existent, but no payload bytes are present\n", __FUNCTION__);
-        return SFCB_E_CB_Q_MTY;  // Circular Buffer is not prepared for adding new element, run #sfcb_worker
+    /* new pin, conflicts are reported again */
+    if ( 0 == ptrCb->uint8Pin ) {
+        ptrCb->uint8PinHit = 0;
     }
-    /* store information for insertion */
-    self->uint8IterCb = cbID;   // used as pointer to queue
-    self->uint32IterAdr = ((self->ptrCbs)[self->uint8IterCb]).uint32StartPageWrite + ((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs;  // select page for write
-    self->ptrCbElemPl = NULL;
-    self->uint16CbElemPlSize = 0;
-    self->uint16Iter = 0;   // used as ptrCbElemPl written pointer
-    ((self->ptrCbs)[self->uint8IterCb]).uint16PlFlashOfs = (uint16_t) (((self->ptrCbs)[self->uint8IterCb]).uint16PlSize + sizeof(spi_flash_cb_elem_head));   // force condition for footer writer, #sfcb_worker
-    /* Setup new Job */
-    self->uint8Busy = 1;
-    self->cmd = SFCB_CMD_ADD;
-    self->stage = SFCB_STG00;
-    self->error = SFCB_E_NOERO;
-    /* fine */
-    return 0;
+    /* blocked erase is evaluated again by #sfcb_mkcb */
+    if ( 0 != ptrCb->uint8PinFull ) {
+        ptrCb->uint8PinFull = 0;
+        ptrCb->uint8MgmtValid = 0;
+    }
+    ptrCb->uint32PinStart = adr;
+    ptrCb->uint32PinStop = adr + len;
+    ptrCb->uint8PinPol = (uint8_t) pol;
+    ptrCb->uint8Pin = (uint8_t) (0 != len);
+    return SFCB_OK;
+}
+
+
+
+/**
+ *  sfcb_pin_state
+ *    pin conflicts since pin
+ */
+int sfcb_pin_state (t_sfcb *self, uint8_t cbID)
+{
+    if ( !(cbID < self->uint8NumCbs) || (0 == ((self->ptrCbs)[cbID]).uint8Used) ) {
+        return SFCB_E_NO_CB_Q;
+    }
+    if ( 0 != ((self->ptrCbs)[cbID]).uint8PinHit ) {
+        return SFCB_E_PIN;
+    }
+    return SFCB_OK;
+}
+
+
+
+/**
+ *  sfcb_weight
+ *    page programs per scheduling round
+ */
+int sfcb_weight (t_sfcb *self, uint8_t cbID, uint8_t weight)
+{
+    if ( !(cbID < self->uint8NumCbs) || (0 == ((self->ptrCbs)[cbID]).uint8Used) ) {
+        return SFCB_E_NO_CB_Q;
+    }
+    ((self->ptrCbs)[cbID]).uint8Weight = (uint8_t) sfcb_max(weight, 1);
+    return SFCB_OK;
 }
 
 
@@ -962,7 +3814,7 @@ uint16_t sfcb_get_pl_wrcnt (t_sfcb *self, uint8_t cbID)
 {
     if ( 0 == ((self->ptrCbs)[cbID]).uint16PlFlashOfs ) // exception in case of no write is done before, counter is equal zero
         return 0;
-    return (uint16_t) (((self->ptrCbs)[cbID]).uint16PlFlashOfs - sizeof(spi_flash_cb_elem_head));   // header is not part of the payload data
+    return (uint16_t) (((self->ptrCbs)[cbID]).uint16PlFlashOfs - ((self->ptrCbs)[cbID]).uint8HeadLen);  // header is not part of the payload data
 }
 
 
@@ -996,8 +3848,13 @@ int sfcb_get_last (t_sfcb *self, uint8_t cbID, void *data, uint16_t len, uint32_
         return SFCB_E_CB_Q_MTY;
     }
     /* limit to size of last circular buffer element */
-    if ( (len + sizeof(spi_flash_cb_elem_head)) > ((self->ptrCbs[cbID]).uint16NumPagesPerElem * SFCB_FLASH_TOPO_PAGE_SIZE) ) {
-        len = (uint16_t) (((self->ptrCbs[cbID]).uint16NumPagesPerElem * (uint16_t) SFCB_FLASH_TOPO_PAGE_SIZE) - (uint16_t) sizeof(spi_flash_cb_elem_head));
+    if ( (uint32_t) (len + (self->ptrCbs[cbID]).uint8HeadLen) > (self->ptrCbs[cbID]).uint32SlotSize ) {
+        len = (uint16_t) ((self->ptrCbs[cbID]).uint32SlotSize - (self->ptrCbs[cbID]).uint8HeadLen);
+    }
+    /* transformed payload, metadata is not part of payload */
+    if ( 0 != (self->ptrCbs[cbID]).uint8XfrmNum ) {
+        len = (uint16_t) sfcb_min(len, (self->ptrCbs[cbID]).uint16PlSize);
+        sfcb_xfrm_start(&(self->ptrCbs[cbID]), (self->ptrCbs[cbID]).uint32ElemIdLastCpl, SFCB_XFRM_DEC);  // ID of read element, like on encode
     }
     /* Debug message */
     sfcb_printf (  "  INFO:%s: read from flash adr=%x\n",
@@ -1007,8 +3864,9 @@ int sfcb_get_last (t_sfcb *self, uint8_t cbID, void *data, uint16_t len, uint32_
     /* prepare job */
     self->ptrCbElemPl = data;
     self->uint16CbElemPlSize = len; // read number of requested bytes, but limited to last element size
-    self->uint32IterAdr = (uint32_t) (((self->ptrCbs)[cbID]).uint32StartPageIdMax + sizeof(spi_flash_cb_elem_head));    // Start address of last written element, newest circular buffer entry, header is not part of payload
+    self->uint32IterAdr = (uint32_t) (((self->ptrCbs)[cbID]).uint32StartPageIdMax + ((self->ptrCbs)[cbID]).uint8HeadLen);    // Start address of last written element, newest circular buffer entry, header is not part of payload
     self->uint16Iter = 0;   // used as ptrCbElemPl written pointer
+    self->uint8IterCb = cbID;   // transform stages of queue
     /* Setup new Job */
     self->uint8Busy = 1;
     self->cmd = SFCB_CMD_GET;   // read last element in queue from flash
@@ -1032,6 +3890,12 @@ int sfcb_flash_read (t_sfcb *self, uint32_t adr, void *data, uint16_t len)
     if ( 0 != self->uint8Busy ) {
         return SFCB_E_WKR_BSY;  // Worker is busy, wait for processing last job
     }
+#if defined(SFCB_FLASH_TYPE_NAND)
+    /* NAND reads through page buffer */
+    if ( (adr % SFCB_FLASH_TOPO_PAGE_SIZE) + len > SFCB_FLASH_TOPO_PAGE_SIZE ) {
+        return SFCB_E_MEM;  // read crosses page boundary
+    }
+#endif
     /* prepare job */
     self->ptrCbElemPl = data;
     self->uint16CbElemPlSize = len;
@@ -1040,6 +3904,8 @@ int sfcb_flash_read (t_sfcb *self, uint32_t adr, void *data, uint16_t len)
     self->uint8Busy = 1;
     self->cmd = SFCB_CMD_RAW;   // RAW read from Flash
     self->stage = SFCB_STG00;
+    self->ptrUcode = g_sfcbUcodeRaw;
+    self->uint8UcPc = 0;
     self->error = SFCB_E_NOERO;
     /* fine */
     return 0;
@@ -1047,6 +3913,164 @@ int sfcb_flash_read (t_sfcb *self, uint32_t adr, void *data, uint16_t len)
 
 
 
+/**
+ *  sfcb_export
+ *    streams queue as compact container
+ */
+int sfcb_export (t_sfcb *self, uint8_t cbID, void *buf, uint16_t len, uint16_t *used)
+{
+    /* no jobs pending */
+    if ( 0 != self->uint8Busy ) {
+        return SFCB_E_WKR_BSY;  // Worker is busy, wait for processing last job
+    }
+    /* check if CB queue is available */
+    if ( !(cbID < self->uint8NumCbs) || (0 == ((self->ptrCbs)[cbID]).uint8Used) ) {
+        return SFCB_E_NO_CB_Q;
+    }
+    if ( 0 == ((self->ptrCbs)[cbID]).uint8MgmtValid ) {
+        return SFCB_E_WKR_REQ;  // oldest element unknown, run #sfcb_mkcb
+    }
+    if (    (SFCB_FMT_COMPACT == ((self->ptrCbs)[cbID]).uint8Fmt)
+         || ((uint32_t) len < (uint32_t) ((self->ptrCbs)[cbID]).uint16PlSize + SFCB_EXP_ELEM_OVH)
+         || (len < SFCB_EXP_HEAD_LEN)
+    ) {
+        return SFCB_E_MEM;
+    }
+    /* container complete */
+    if ( (SFCB_EXP_DONE == self->uint8ExpState) && (cbID == self->uint8ExpCb) ) {
+        self->uint8ExpState = SFCB_EXP_IDLE;
+        return SFCB_E_CB_Q_MTY;
+    }
+    self->uint8IterCb = cbID;
+    /* new export, starts at slot of oldest element */
+    if ( (SFCB_EXP_IDLE == self->uint8ExpState) || (SFCB_EXP_DONE == self->uint8ExpState) || (cbID != self->uint8ExpCb) ) {
+        self->uint8ExpState = SFCB_EXP_HEAD;
+        self->uint8ExpCb = cbID;
+        self->uint16ExpIdx = 0;
+        for ( uint16_t i = 0; i < ((self->ptrCbs)[cbID]).uint16NumEntriesMax; i++ ) {
+            if ( sfcb_flash_adr_head(self, i) == ((self->ptrCbs)[cbID]).uint32StartPageIdMin ) {
+                self->uint16ExpIdx = i;
+                break;
+            }
+        }
+        self->uint16ExpSlots = ((self->ptrCbs)[cbID]).uint16NumEntriesMax;
+        self->uint32ExpPrevId = 0;
+        self->uint32ExpCnt = 0;
+    }
+    /* prepare job */
+    self->ptrExpBuf = buf;
+    self->ptrExpUsed = used;
+    *used = 0;
+    /* Setup new Job */
+    self->uint8Busy = 1;
+    self->cmd = SFCB_CMD_EXP;
+    self->stage = SFCB_STG00;
+    self->error = SFCB_E_NOERO;
+    return SFCB_OK;
+}
+
+
+
+/**
+ *  sfcb_blank_check
+ *    check flash region for erased state
+ */
+int sfcb_blank_check (t_sfcb *self, uint32_t adr, uint32_t len, uint32_t *usedAdr)
+{
+    /* no jobs pending */
+    if ( 0 != self->uint8Busy ) {
+        return SFCB_E_WKR_BSY;  // Worker is busy, wait for processing last job
+    }
+    /* in flash */
+    if ( (adr > SFCB_FLASH_TOPO_FLASH_SIZE) || (len > SFCB_FLASH_TOPO_FLASH_SIZE - adr) ) {
+        return SFCB_E_MEM;
+    }
+    /* prepare job */
+    *usedAdr = UINT32_MAX;  // erased
+    self->ptrBlankAdr = usedAdr;
+    self->uint32BlankLen = len;
+    self->uint32IterAdr = adr;
+    /* Setup new Job */
+    self->uint8Busy = 1;
+    self->cmd = SFCB_CMD_BLANK;
+    self->stage = SFCB_STG00;
+    self->ptrUcode = g_sfcbUcodeBlank;
+    self->uint8UcPc = 0;
+    self->error = SFCB_E_NOERO;
+    return SFCB_OK;
+}
+
+
+
+/**
+ *  sfcb_read_q
+ *    table for coalesced read requests
+ */
+int sfcb_read_q (t_sfcb *self, t_sfcb_rd *req, uint8_t num)
+{
+    /* requests of old table in transfer */
+    if ( (0 != self->uint8Busy) && (SFCB_CMD_RDQ == self->cmd) ) {
+        return SFCB_E_WKR_BSY;
+    }
+    self->ptrRdQ = req;
+    self->uint8RdQLen = (NULL == req) ? 0 : num;
+    for ( uint8_t i = 0; i < self->uint8RdQLen; i++ ) {
+        (self->ptrRdQ)[i].state = SFCB_RD_FREE;
+    }
+    return SFCB_OK;
+}
+
+
+
+/**
+ *  sfcb_read_req
+ *    queue read request
+ */
+int sfcb_read_req (t_sfcb *self, uint32_t adr, void *data, uint16_t len, uint8_t *reqID)
+{
+    /* fits into one transaction */
+    if ( (0 == len) || (len > (self->uint16SpiMax - SFCB_FLASH_TOPO_ADR_BYTE - 1)) ) { // -1: IST
+        return SFCB_E_MEM;
+    }
+#if defined(SFCB_FLASH_TYPE_NAND)
+    /* NAND reads through page buffer */
+    if ( (adr % SFCB_FLASH_TOPO_PAGE_SIZE) + len > SFCB_FLASH_TOPO_PAGE_SIZE ) {
+        return SFCB_E_MEM;  // read crosses page boundary
+    }
+#endif
+    for ( uint8_t i = 0; i < self->uint8RdQLen; i++ ) {
+        if ( SFCB_RD_FREE == (self->ptrRdQ)[i].state ) {
+            (self->ptrRdQ)[i].adr = adr;
+            (self->ptrRdQ)[i].ptr = data;
+            (self->ptrRdQ)[i].len = len;
+            (self->ptrRdQ)[i].state = SFCB_RD_PEND;
+            *reqID = i;
+            return SFCB_OK;
+        }
+    }
+    return SFCB_E_MEM;
+}
+
+
+
+/**
+ *  sfcb_read_done
+ *    check for delivered read data
+ */
+int sfcb_read_done (t_sfcb *self, uint8_t reqID)
+{
+    if ( !(reqID < self->uint8RdQLen) || (SFCB_RD_FREE == (self->ptrRdQ)[reqID].state) ) {
+        return SFCB_E_MEM;
+    }
+    if ( SFCB_RD_DONE != (self->ptrRdQ)[reqID].state ) {
+        return SFCB_E_WKR_REQ;
+    }
+    (self->ptrRdQ)[reqID].state = SFCB_RD_FREE;
+    return SFCB_OK;
+}
+
+
+
 /**
  *  sfcb_idmax
  *    get maximum id in selected circular buffer queue
@@ -1062,6 +4086,75 @@ uint32_t sfcb_idmax (t_sfcb *self, uint8_t cbID)
 
 
 
+/**
+ *  sfcb_queue_stats
+ *    occupancy of queue from management data
+ */
+int sfcb_queue_stats (t_sfcb *self, uint8_t cbID, t_sfcb_stats *st)
+{
+    /** Variables **/
+    t_sfcb_cb   *ptrCb;     // selected queue
+    uint16_t    uint16Open; // element in write occupies slot
+
+    /* check if selected queue is used */
+    if ( !(cbID < self->uint8NumCbs) || (0 == ((self->ptrCbs)[cbID]).uint8Used) ) {
+        return SFCB_E_NO_CB_Q;
+    }
+    ptrCb = &((self->ptrCbs)[cbID]);
+    /* element in write, footer pending */
+    uint16Open = 0;
+    if ( (0 != ptrCb->uint16PlFlashOfs) && (ptrCb->uint16PlFlashOfs <= (ptrCb->uint16PlSize + ptrCb->uint8HeadLen)) ) {
+        uint16Open = 1;
+    }
+    /* fill, padding included for compare of snapshots */
+    memset(st, 0, sizeof(*st));
+    st->uint16Entries = ptrCb->uint16NumEntries;
+    st->uint16EntriesMax = ptrCb->uint16NumEntriesMax;
+    st->uint32IdNewest = ptrCb->uint32IdNumMax;
+    st->uint32IdLastCpl = ptrCb->uint32ElemIdLastCpl;
+    st->uint32IdOldest = 0;
+    if ( 0 != ptrCb->uint16NumEntries ) {
+        st->uint32IdOldest = ptrCb->uint32IdNumMin;
+    }
+    st->uint16SlotsFree = 0;
+    if ( ptrCb->uint16NumEntriesMax > (ptrCb->uint16NumEntries + uint16Open) ) {
+        st->uint16SlotsFree = (uint16_t) (ptrCb->uint16NumEntriesMax - ptrCb->uint16NumEntries - uint16Open);
+    }
+    st->uint32DelayLast = ptrCb->uint32DelayLast;
+    st->uint32DelayMax = ptrCb->uint32DelayMax;
+    st->uint16PlWrCnt = 0;
+    if ( 0 != uint16Open ) {
+        st->uint16PlWrCnt = (uint16_t) (ptrCb->uint16PlFlashOfs - ptrCb->uint8HeadLen);
+    }
+    st->uint32ScrubElems = ptrCb->uint32ScrubElems;
+    st->uint32ScrubErrs = ptrCb->uint32ScrubErrs;
+    st->uint32ScrubPasses = ptrCb->uint32ScrubPasses;
+    st->uint16DefRecs = ptrCb->uint16DefCnt;
+    return SFCB_OK;
+}
+
+
+
+/**
+ *  sfcb_scrub
+ *    background scrub budget
+ */
+int sfcb_scrub (t_sfcb *self, uint16_t pkts, uint32_t calls)
+{
+    /* read of last idle call is dropped */
+    if ( 0 != self->uint8ScrubPend ) {
+        self->uint8ScrubPend = 0;
+        self->uint16SpiLen = 0;
+    }
+    self->uint16ScrubPkts = pkts;
+    self->uint32ScrubCalls = sfcb_max((uint32_t) 1, calls);
+    self->uint16ScrubCredit = 0;
+    self->uint32ScrubTick = self->uint32WkrCalls - self->uint32ScrubCalls;  // refill with next idle call
+    return SFCB_OK;
+}
+
+
+
 /**
  *  sfcb_isero
  *    error happend in last interaction
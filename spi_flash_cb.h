@@ -35,10 +35,31 @@
 #define SFCB_E_NO_CB_Q      (1<<4)  /**< circular buffer queue not active or present */
 #define SFCB_E_WKR_REQ      (1<<5)  /**< Circular Buffer is not prepared for request, run #sfcb_worker */
 #define SFCB_E_CB_Q_MTY     (1<<6)  /**< Cirular buffer queue has no valid entries */
+#define SFCB_E_PIN          (1<<7)  /**< Erase of range pinned by reader blocked writes or erased pinned data, #sfcb_pin */
+#define SFCB_E_FMT          (1<<8)  /**< Request not supported by element format of queue, #t_sfcb_fmt */
+#define SFCB_E_NOP          (1<<9)  /**< SPI NAND: element already programmed by #sfcb_add, append rejected, run #sfcb_mkcb */
+#define SFCB_E_MIRROR       (1<<10) /**< Mirror copies diverged by more than one element, rebuild lagging chip */
 /** @} */   // SFCB_E
 
 
 
+/**
+ *  @defgroup SFCB_EXP
+ *  export container, see #sfcb_export. All numbers little endian
+ *    header:   magic "SFCX", version, queue magic (4 byte), payload size (2 byte), CRC-16 of header
+ *    element:  varint ID delta to previous element, varint payload length, payload, CRC-16 of element
+ *    trailer:  zero ID delta, varint number of elements, varint last ID, CRC-16 of complete container
+ *  @{
+ */
+#define SFCB_EXP_MAGIC      "SFCX"  /**< Container start */
+#define SFCB_EXP_VER        (1)     /**< Container format version */
+#define SFCB_EXP_HEAD_LEN   (13)    /**< Container header size in bytes */
+#define SFCB_EXP_ELEM_PRE   (8)     /**< Maximum bytes of element in front of payload, varint ID delta and length */
+#define SFCB_EXP_ELEM_OVH   (10)    /**< Maximum bytes of element in addition to payload */
+/** @} */   // SFCB_EXP
+
+
+
 /* C++ compatibility */
 #ifdef __cplusplus
 extern "C"
@@ -63,7 +84,12 @@ typedef enum
     SFCB_CMD_MKCB,  /**<  Make Circular Buffers */
     SFCB_CMD_ADD,   /**<  Add Element into Circular Buffer */
     SFCB_CMD_GET,   /**<  Get Data from Element of Circular buffer, there is no pop from the stack after get */
-    SFCB_CMD_RAW    /**<  Read Raw Data from flash */
+    SFCB_CMD_RAW,   /**<  Read Raw Data from flash */
+    SFCB_CMD_VFY,   /**<  Verify retained management data against flash, #sfcb_init_warm */
+    SFCB_CMD_QE,    /**<  Set quad enable bit in status register, #sfcb_quad */
+    SFCB_CMD_RDQ,   /**<  Coalesced read of pending read requests, #sfcb_read_req */
+    SFCB_CMD_BLANK, /**<  Check flash region for erased state, #sfcb_blank_check */
+    SFCB_CMD_EXP    /**<  Export queue as compact container, #sfcb_export */
 } t_sfcb_cmd;
 
 
@@ -88,11 +114,186 @@ typedef enum
     SFCB_STG01, /**<  Stage 1, different meanings based on executed command */
     SFCB_STG02, /**<  Stage 2, different meanings based on executed command */
     SFCB_STG03, /**<  Stage 3, different meanings based on executed command */
-    SFCB_STG04  /**<  Stage 4, different meanings based on executed command */
+    SFCB_STG04, /**<  Stage 4, different meanings based on executed command */
+    SFCB_STG05  /**<  Stage 5, different meanings based on executed command */
 } t_sfcb_stage;
 
 
 
+/**
+ *  @typedef t_sfcb_uop_code
+ *
+ *  @brief  microcode step
+ *
+ *  Primitive flash steps of table driven commands. Steps marked
+ *  with packet end the worker call with an SPI packet, the
+ *  others are executed in the same call. Stage switch commands
+ *  run fixed sequences as sub-sequence, ended by #SFCB_UOP_RET
+ *
+ *  @since  2026-10-18
+ */
+typedef enum
+{
+    SFCB_UOP_END,   /**<  Job done, worker idle */
+    SFCB_UOP_POLL,  /**<  Packet: read status register until write-in-progress cleared */
+    SFCB_UOP_WREN,  /**<  Packet: write enable */
+    SFCB_UOP_RD,    /**<  Packet: read data at iteration address */
+    SFCB_UOP_CPY,   /**<  Copy read data to job buffer */
+    SFCB_UOP_RDSR2, /**<  Packet: read status register 2 */
+    SFCB_UOP_QE,    /**<  Check quad enable bit, jump to argument if set or written */
+    SFCB_UOP_WRSR2, /**<  Packet: write status register 2 */
+    SFCB_UOP_JMP,   /**<  Jump to argument with new status poll */
+    SFCB_UOP_ERASE, /**<  Packet: erase oldest element, erase-less flash fills chunk, jump to argument after last packet */
+    SFCB_UOP_NEXT,  /**<  Select next program of element, jump to argument if element is written */
+    SFCB_UOP_PROG,  /**<  Packet: program header, footer or payload chunk */
+    SFCB_UOP_BLANK, /**<  Packet: check read chunk, read next chunk until range is checked */
+    SFCB_UOP_SCAT,  /**<  Scatter read data to read requests */
+    SFCB_UOP_FLUSH, /**<  Packet: SPI NAND program execute of staged page, no-op otherwise */
+    SFCB_UOP_RET    /**<  Return to stage switch at stage of argument, switch requests status poll */
+} t_sfcb_uop_code;
+
+
+
+/**
+ *  @typedef t_sfcb_uop
+ *
+ *  @brief  microcode
+ *
+ *  One step of a table driven command
+ *
+ *  @since  2026-10-18
+ */
+typedef struct t_sfcb_uop
+{
+    uint8_t     uint8Op;    /**< Step, #t_sfcb_uop_code */
+    uint8_t     uint8Arg;   /**< Step argument, f.e. jump target */
+} t_sfcb_uop;
+
+
+
+/**
+ *  @typedef t_sfcb_nand
+ *
+ *  @brief  NAND translation step
+ *
+ *  SPI NAND flashes need for read and program an
+ *  additional transfer between flash array and the
+ *  internal page buffer. The packets of #sfcb_worker
+ *  are translated into this sequence, the step tracks
+ *  the progress of the sequence. Programs of one page
+ *  are collected in the page buffer and executed once
+ *  at page change or job end.
+ *
+ *  @since  2026-10-18
+ */
+typedef enum
+{
+    SFCB_NAND_IDLE,     /**<  No translation pending */
+    SFCB_NAND_SR,       /**<  Status register read, response needs realignment */
+    SFCB_NAND_PAGE_RD,  /**<  Page data read into buffer issued */
+    SFCB_NAND_PAGE_WIP, /**<  Wait for page data read */
+    SFCB_NAND_CACHE_RD, /**<  Read from page buffer, response needs realignment */
+    SFCB_NAND_PRG_LOAD, /**<  Program data loaded into page buffer */
+    SFCB_NAND_PRG_EXE,  /**<  Program execute of staged page issued */
+    SFCB_NAND_PRG_WIP,  /**<  Wait for program of staged page */
+    SFCB_NAND_PRG_WREN  /**<  Write enable for load of next page issued */
+} t_sfcb_nand;
+
+
+
+/**
+ *  @typedef t_sfcb_dpd
+ *
+ *  @brief  deep power-down state
+ *
+ *  The idle flash is put into deep power-down, a job releases
+ *  the flash and waits the wake-up time, see #sfcb_deep_pd
+ *
+ *  @since  2026-10-18
+ */
+typedef enum
+{
+    SFCB_DPD_AWAKE, /**<  Flash is powered up */
+    SFCB_DPD_SLEEP, /**<  Flash is in deep power-down */
+    SFCB_DPD_WAKE   /**<  Release issued, wait for wake-up time */
+} t_sfcb_dpd;
+
+
+
+/**
+ *  @typedef t_sfcb_rd_state
+ *
+ *  @brief  read request state
+ *
+ *  State of read request slot, see #sfcb_read_req
+ *
+ *  @since  2026-10-18
+ */
+typedef enum
+{
+    SFCB_RD_FREE,   /**<  Slot unused */
+    SFCB_RD_PEND,   /**<  Request waits for transaction */
+    SFCB_RD_XFER,   /**<  Request is part of current transaction */
+    SFCB_RD_DONE    /**<  Data delivered, release with #sfcb_read_done */
+} t_sfcb_rd_state;
+
+
+
+/**
+ *  @typedef t_sfcb_exp_state
+ *
+ *  @brief  export state
+ *
+ *  Next emitted part of export container, see #sfcb_export
+ *
+ *  @since  2026-10-18
+ */
+typedef enum
+{
+    SFCB_EXP_IDLE,  /**<  No export, next call starts */
+    SFCB_EXP_HEAD,  /**<  Container header */
+    SFCB_EXP_ELEM,  /**<  Elements from oldest to newest */
+    SFCB_EXP_TAIL,  /**<  Container trailer */
+    SFCB_EXP_DONE   /**<  Container complete */
+} t_sfcb_exp_state;
+
+
+
+/**
+ *  @typedef t_sfcb_xfrm_dir
+ *
+ *  @brief  transform direction
+ *
+ *  Direction of payload transform stage, see #t_sfcb_xfrm
+ *
+ *  @since  2026-10-18
+ */
+typedef enum
+{
+    SFCB_XFRM_ENC,  /**<  Add path, caller data to flash */
+    SFCB_XFRM_DEC   /**<  Get path, flash to caller data */
+} t_sfcb_xfrm_dir;
+
+
+
+/**
+ *  @typedef t_sfcb_pin_pol
+ *
+ *  @brief  pin policy
+ *
+ *  Behavior of the write path if the next sector erase hits the flash
+ *  range pinned by a reader, see #sfcb_pin
+ *
+ *  @since  2026-10-18
+ */
+typedef enum
+{
+    SFCB_PIN_BLOCK, /**<  Backpressure, keep pinned data, add fails with #SFCB_E_PIN until pin moves */
+    SFCB_PIN_DROP   /**<  Erase oldest data anyway, reader is informed by #sfcb_pin_state */
+} t_sfcb_pin_pol;
+
+
+
 /**
  *  @typedef t_sfcb_error
  *
@@ -107,11 +308,48 @@ typedef enum
 {
     SFCB_E_NOERO,   /**<  No Error occurred */
     SFCB_E_BUFSIZE, /**<  Buffer too small for operation */
-    SFCB_E_UNKBEH   /**<  Unknown behavior observed */
+    SFCB_E_UNKBEH,  /**<  Unknown behavior observed */
+    SFCB_E_XFRM     /**<  Payload transform rejected element, f. e. checksum mismatch, #sfcb_xfrm */
 } t_sfcb_error;
 
 
 
+/**
+ *  @typedef t_sfcb_fmt
+ *
+ *  @brief  queue element format
+ *
+ *  Selects how an element is marked as completely written, see #sfcb_new_cb_fmt
+ *
+ *  @since  2026-10-18
+ */
+typedef enum
+{
+    SFCB_FMT_HEAD_FOOT, /**<  Header before and copy of header as footer after payload */
+    SFCB_FMT_COMMIT,    /**<  Header with erased commit word, word is programmed to zero when element is complete, no payload transform */
+    SFCB_FMT_COMPACT    /**<  4-byte header/footer with magic hash and 16-bit sequence, packed slots, queue magic and base ID in sector summary, #spi_flash_cb_sect_sum, no payload transform */
+} t_sfcb_fmt;
+
+
+
+/**
+ *  @typedef spi_flash_cb_sect_sum
+ *
+ *  @brief  sector summary
+ *
+ *  #SFCB_FMT_COMPACT: first slot of every sector, written together with the
+ *  header of the first element in the sector
+ *
+ *  @since  2026-10-18
+ */
+typedef struct spi_flash_cb_sect_sum
+{
+    uint32_t    uint32MagicNum; /**<  Magic Number of queue */
+    uint32_t    uint32IdBase;   /**<  ID of first element in sector, extends 16-bit sequence of compact header */
+} spi_flash_cb_sect_sum;
+
+
+
 /**
  *  @typedef spi_flash_cb_elem_head
  *
@@ -131,6 +369,93 @@ typedef struct spi_flash_cb_elem_head
 
 
 
+/**
+ *  @typedef t_sfcb_iov
+ *
+ *  @brief  payload fragment
+ *
+ *  Describes one fragment of an gathered write, see #sfcb_addv
+ *
+ *  @since  2026-10-18
+ */
+typedef struct t_sfcb_iov
+{
+    void*       ptr;    /**< Pointer to fragment data */
+    uint16_t    len;    /**< Size of fragment in bytes */
+} t_sfcb_iov;
+
+
+
+/**
+ *  @typedef t_sfcb_rd
+ *
+ *  @brief  read request
+ *
+ *  Slot of read request table, see #sfcb_read_q
+ *
+ *  @since  2026-10-18
+ */
+typedef struct t_sfcb_rd
+{
+    uint32_t        adr;    /**< Flash address */
+    void*           ptr;    /**< Destination of read data */
+    uint16_t        len;    /**< Size of read in bytes */
+    t_sfcb_rd_state state;  /**< Request state, #t_sfcb_rd_state */
+} t_sfcb_rd;
+
+
+
+/**
+ *  @typedef t_sfcb_xfrm
+ *
+ *  @brief  payload transform stage
+ *
+ *  Length preserving transform of the payload, f. e. checksum, stream
+ *  cipher or delta coding, see #sfcb_xfrm. The stage works in place on
+ *  one chunk up to a page and keeps its state in _ctx_. The metadata of
+ *  all stages is stored in front of the element footer.
+ *
+ *  @since  2026-10-18
+ */
+typedef struct t_sfcb_xfrm
+{
+    void    (*start)(void *ctx, uint32_t elemID, t_sfcb_xfrm_dir dir);      /**< Element start, resets stage state */
+    void    (*chunk)(void *ctx, uint8_t *data, uint16_t len, t_sfcb_xfrm_dir dir);  /**< Transforms next payload chunk in place */
+    int     (*end)(void *ctx, uint8_t *meta, t_sfcb_xfrm_dir dir);          /**< Element end, writes or checks _meta_, non-zero rejects element */
+    void*   ctx;        /**< Stage state, owned by application */
+    uint8_t metaLen;    /**< Metadata bytes of stage in element */
+} t_sfcb_xfrm;
+
+
+
+/**
+ *  @typedef t_sfcb_stats
+ *
+ *  @brief  queue statistics
+ *
+ *  Snapshot of circular buffer queue occupancy, see #sfcb_queue_stats
+ *
+ *  @since  2026-10-18
+ */
+typedef struct t_sfcb_stats
+{
+    uint32_t    uint32IdOldest;     /**< ID of oldest element in queue, zero if empty */
+    uint32_t    uint32IdNewest;     /**< ID of newest element in queue */
+    uint32_t    uint32IdLastCpl;    /**< ID of last element with footer */
+    uint16_t    uint16Entries;      /**< Number of elements in queue */
+    uint16_t    uint16EntriesMax;   /**< Maximum number of elements in queue */
+    uint16_t    uint16SlotsFree;    /**< Empty element slots up to next forced sector erase */
+    uint16_t    uint16PlWrCnt;      /**< Payload bytes written in open element */
+    uint32_t    uint32DelayLast;    /**< Queueing delay of last posted element in worker calls */
+    uint32_t    uint32DelayMax;     /**< Maximum queueing delay of posted elements in worker calls */
+    uint32_t    uint32ScrubElems;   /**< Elements checked by background scrub, #sfcb_scrub */
+    uint32_t    uint32ScrubErrs;    /**< Elements with damaged header or footer found by scrub */
+    uint32_t    uint32ScrubPasses;  /**< Completed scrub walks over queue */
+    uint16_t    uint16DefRecs;      /**< Records in RAM ring of deferred writes, #sfcb_add_defer */
+} t_sfcb_stats;
+
+
+
 /**
  *  @typedef t_sfcb_cb
  *
@@ -156,11 +481,51 @@ typedef struct t_sfcb_cb
     uint32_t    uint32StartPageIdMin;       /**< Start page of Circular buffer entry with lowest number, used for sector erase */
     uint32_t    uint32StartPageIdMax;       /**< Start page of Circular buffer entry with highest number, used for #sfcb_get_last */
     uint32_t    uint32ElemIdLastCpl;        /**< Element Id of last complete written element, used for #sfcb_get_last */
+    uint32_t    uint32SlotSize;             /**< Flash bytes per element including header/footer. Multiple of pages, byte granular for erase-less memories */
     uint16_t    uint16NumPagesPerElem;      /**< Number of pages per element */
     uint16_t    uint16NumEntriesMax;        /**< Maximal Number of entries in circular buffer caused by partition table */
     uint16_t    uint16NumEntries;           /**< Number of entries in circular buffer */
-    uint16_t    uint16PlFlashOfs;           /**< Stores offset in flash payload, enables splitted append operations */
+    uint16_t    uint16PlFlashOfs;           /**< Stores offset in flash payload, enables splitted append operations. Recovered by #sfcb_mkcb in case of an element without footer */
     uint16_t    uint16PlSize;               /**< Size of Payload stored in the circular buffer, needed for footer write */
+    uint8_t     uint8Fmt;                   /**< Element format, #t_sfcb_fmt */
+    uint8_t     uint8HeadLen;               /**< Flash bytes in front of payload, header and commit word */
+    const void* ptrPostPl;                  /**< Payload of posted element write, #sfcb_add_post */
+    uint16_t    uint16PostLen;              /**< Payload size of posted element write */
+    uint16_t    uint16PostIter;             /**< Written payload bytes of posted element */
+    uint8_t     uint8PostPend;              /**< Posted element write pending */
+    uint8_t     uint8PostSrv;               /**< Posted element write in service, queueing delay captured */
+    uint8_t     uint8Weight;                /**< Page programs per scheduling round, #sfcb_weight */
+    uint8_t     uint8Deficit;               /**< Remaining page programs in current scheduling round */
+    uint32_t    uint32PostTick;             /**< Worker call count at post */
+    uint32_t    uint32DelayLast;            /**< Queueing delay of last posted element in worker calls */
+    uint32_t    uint32DelayMax;             /**< Maximum queueing delay of posted elements in worker calls */
+    uint32_t    uint32Gen;                  /**< Generation stamp of last management data seal, #sfcb_init_warm */
+    uint16_t    uint16CrcLayout;            /**< CRC of queue layout, sealed by #sfcb_new_cb */
+    uint16_t    uint16CrcState;             /**< CRC of management data and #uint32Gen, sealed with every job end */
+    uint32_t    uint32ScrubElems;           /**< Elements checked by background scrub */
+    uint32_t    uint32ScrubErrs;            /**< Damaged elements found by background scrub */
+    uint32_t    uint32ScrubPasses;          /**< Completed background scrub walks */
+    uint8_t*    ptrDefRing;                 /**< Deferred writes: RAM ring of records, NULL if disabled, #sfcb_defer */
+    uint16_t    uint16DefRecLen;            /**< Deferred writes: record size in bytes */
+    uint16_t    uint16DefRecs;              /**< Deferred writes: ring capacity in records */
+    uint16_t    uint16DefFirst;             /**< Deferred writes: ring index of oldest record */
+    uint16_t    uint16DefCnt;               /**< Deferred writes: records in ring, includes burst in write */
+    uint16_t    uint16DefBurst;             /**< Deferred writes: records of burst in write */
+    uint16_t    uint16DefThr;               /**< Deferred writes: records in ring which start burst */
+    uint32_t    uint32DefAge;               /**< Deferred writes: age of oldest record in worker calls which starts burst, zero disables */
+    uint32_t    uint32DefTick;              /**< Deferred writes: worker call count at oldest record */
+    uint8_t     uint8DefForce;              /**< Deferred writes: burst requested by #sfcb_flush */
+    const t_sfcb_xfrm* ptrXfrm;             /**< Payload transform stages, NULL if disabled, #sfcb_xfrm */
+    uint8_t     uint8XfrmNum;               /**< Payload transform: number of stages */
+    uint8_t     uint8XfrmMeta;              /**< Payload transform: metadata bytes of all stages in front of footer */
+    uint32_t    uint32PinStart;             /**< Reader pin: first pinned flash address */
+    uint32_t    uint32PinStop;              /**< Reader pin: first flash address behind pinned range */
+    uint8_t     uint8Pin;                   /**< Reader pin: range active */
+    uint8_t     uint8PinPol;                /**< Reader pin: policy, #t_sfcb_pin_pol */
+    uint8_t     uint8PinFull;               /**< Reader pin: erase blocked, no free element for write */
+    uint8_t     uint8PinHit;                /**< Reader pin: erase hit pinned range since #sfcb_pin */
+    uint32_t    uint32PinConflicts;         /**< Reader pin: number of erases which hit pinned range */
+    uint32_t    uint32ReclaimSize;          /**< Reclaim: erase size in bytes, sector or block, #sfcb_reclaim */
 } t_sfcb_cb;
 
 
@@ -191,10 +556,59 @@ typedef struct t_sfcb
     t_sfcb_error            error;              /**< Error code if something strange happened, #t_sfcb_error */
     void*                   ptrCbElemPl;        /**< Pointer to Payload data of CB Element */
     uint16_t                uint16CbElemPlSize; /**< Size of payload data in bytes */
+    const t_sfcb_iov*       ptrIov;             /**< Fragment list of add request, #sfcb_addv */
+    t_sfcb_iov              iov;                /**< Single fragment list for #sfcb_add */
+    uint8_t                 uint8IovCnt;        /**< Number of fragments in #ptrIov */
+    uint8_t                 uint8IovIdx;        /**< Fragment in write */
+    uint16_t                uint16IovOfs;       /**< Written bytes of fragment #uint8IovIdx */
     spi_flash_cb_elem_head  head;               /**< Circular buffer queue elements inter transaction buffer */
     spi_flash_cb_elem_head  foot;               /**< Circular buffer queue elements inter transaction buffer, #sfcb_get_last element complete write check */
     uint32_t                uint32LastElemAdr;  /**< Temporary variable to store start address of successful written element */
     uint32_t                uint32LastElemNum;  /**< Temporary variable to store queue element id of last successful written element */
+    t_sfcb_nand             nand;               /**< NAND translation step, #t_sfcb_nand */
+    uint32_t                uint32NandAdr;      /**< NAND: Flash address of translated packet */
+    uint16_t                uint16NandLen;      /**< NAND: Length of translated packet */
+    uint32_t                uint32NandPage;     /**< NAND: Page in flash page buffer, UINT32_MAX if invalid */
+    uint32_t                uint32NandStage;    /**< NAND: Flash address of page with loaded and not executed program, UINT32_MAX if none */
+    uint8_t                 uint8NandStageCb;   /**< NAND: Queue of staged page */
+    const uint16_t*         ptrNandBbt;         /**< NAND: Ascending list of bad blocks, #sfcb_nand_bbt */
+    uint16_t                uint16NandBbtLen;   /**< NAND: Number of entries in #ptrNandBbt */
+    uint8_t                 uint8Sched;         /**< Add job serves posted element writes of several queues, #sfcb_add_post */
+    uint32_t                uint32WkrCalls;     /**< Number of #sfcb_worker calls, time base for queueing delay */
+    uint32_t                uint32Gen;          /**< Generation stamp of management data seal */
+    uint16_t                uint16HeadOfs;      /**< Offset of element header in read data, sector summary read ahead, #SFCB_FMT_COMPACT */
+    uint8_t                 uint8SumValid;      /**< Sector summary of last read belongs to queue */
+    uint32_t                uint32SumBase;      /**< Element ID base of compact header decode */
+    uint16_t                uint16ScrubPkts;    /**< Background scrub: SPI packets per tick, zero disables, #sfcb_scrub */
+    uint32_t                uint32ScrubCalls;   /**< Background scrub: worker calls per tick */
+    uint16_t                uint16ScrubCredit;  /**< Background scrub: remaining SPI packets in current tick */
+    uint32_t                uint32ScrubTick;    /**< Background scrub: worker call count at last refill */
+    uint8_t                 uint8ScrubCb;       /**< Background scrub: queue in check */
+    uint16_t                uint16ScrubElem;    /**< Background scrub: element in check */
+    uint8_t                 uint8ScrubFoot;     /**< Background scrub: footer read of element is next */
+    uint8_t                 uint8ScrubPend;     /**< Background scrub: read issued in last worker call */
+    uint8_t                 uint8DpdEna;        /**< Deep power-down: enter if idle, #sfcb_deep_pd */
+    uint32_t                uint32DpdWake;      /**< Deep power-down: worker calls without packet after release */
+    t_sfcb_dpd              dpd;                /**< Deep power-down: state, #t_sfcb_dpd */
+    uint32_t                uint32DpdTick;      /**< Deep power-down: worker call count at release */
+    uint8_t                 uint8Quad;          /**< Page programs with quad data lanes, #sfcb_quad */
+    uint8_t                 uint8Sr2;           /**< Quad enable: status register 2 read back */
+    t_sfcb_rd*              ptrRdQ;             /**< Read requests: request table, #sfcb_read_q */
+    uint8_t                 uint8RdQLen;        /**< Read requests: slots in #ptrRdQ */
+    uint32_t                uint32RdXfers;      /**< Read requests: coalesced read transactions */
+    uint32_t                uint32BlankLen;     /**< Blank check: remaining bytes */
+    uint32_t*               ptrBlankAdr;        /**< Blank check: result, first programmed address, #sfcb_blank_check */
+    uint8_t*                ptrExpBuf;          /**< Export: container output buffer, #sfcb_export */
+    uint16_t*               ptrExpUsed;         /**< Export: container bytes in output buffer at job end */
+    uint8_t                 uint8ExpState;      /**< Export: next container part, #t_sfcb_exp_state */
+    uint8_t                 uint8ExpCb;         /**< Export: exported queue */
+    uint16_t                uint16ExpIdx;       /**< Export: slot of next element */
+    uint16_t                uint16ExpSlots;     /**< Export: slots left to visit */
+    uint16_t                uint16ExpCrc;       /**< Export: CRC-16 of emitted container */
+    uint32_t                uint32ExpPrevId;    /**< Export: ID of last exported element, base of ID delta */
+    uint32_t                uint32ExpCnt;       /**< Export: number of exported elements */
+    const t_sfcb_uop*       ptrUcode;           /**< Microcode: steps of table driven command, #t_sfcb_uop */
+    uint8_t                 uint8UcPc;          /**< Microcode: current step */
 } t_sfcb;
 
 
@@ -219,6 +633,32 @@ int sfcb_init (t_sfcb *self, void *cb, uint8_t cbLen, void *spi, uint16_t spiLen
 
 
 
+/**
+ *  @brief init warm
+ *
+ *  initializes flash circular buffer with retained management data, f. e.
+ *  after watchdog reset. The layout CRC of every entry in *cb is checked,
+ *  queues with valid management data and current generation stamp are
+ *  confirmed by reading the header of the free and the newest element.
+ *  Other queues are rebuild by #sfcb_mkcb. Run #sfcb_worker until idle.
+ *  In case of invalid layout the table is cleared like with #sfcb_init.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[in,out]  *cb                 pointer to retained circular buffer list, see #t_sfcb_cb
+ *  @param[in]      cbLen               number of maximum allowed circular buffers
+ *  @param[in,out]  *spi                pointer to uint8_t SPI interaction buffer, buffer between SPI core and flash driver
+ *  @param[in]      spiLen              maximum number of elements in buffer => size in byte
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            Retained data accepted, verify job started
+ *  @retval         #SFCB_E_NO_FLASH    Invalid Flash Type
+ *  @retval         #SFCB_E_MEM         SPI buffer too small
+ *  @retval         #SFCB_E_WKR_REQ     Layout invalid, cold start with #sfcb_new_cb and #sfcb_mkcb
+ *  @since          2026-10-18
+ */
+int sfcb_init_warm (t_sfcb *self, void *cb, uint8_t cbLen, void *spi, uint16_t spiLen);
+
+
+
 /**
  *  @brief worker
  *
@@ -267,6 +707,53 @@ int sfcb_new_cb (t_sfcb *self, uint32_t magicNum, uint16_t elemSizeByte, uint16_
 
 
 
+/**
+ *  @brief new_cb_fmt
+ *
+ *  creates new circular buffer entry with selected element format. #SFCB_FMT_COMMIT
+ *  writes the header with the first payload chunk and marks the element complete
+ *  with a single program of the commit word, the queue build reads only the header.
+ *  #SFCB_FMT_COMPACT packs small elements into power of two slots below the page size,
+ *  only available for sector erase NOR flashes.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[in]      magicNum            Magic Number for marking entries valid, should differ between different Circular buffer entries
+ *  @param[in]      elemSizeByte        Size of one element in the circular buffer in byte
+ *  @param[in]      numElems            minimal number of elements in the circular buffer
+ *  @param[in]      fmt                 element format, #t_sfcb_fmt
+ *  @param[in,out]  *cbID               Circular buffer number
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            OKAY
+ *  @retval         #SFCB_E_MEM         No free circular buffer slots, or #SFCB_FMT_COMPACT element/SPI buffer too large/small
+ *  @retval         #SFCB_E_FLASH_FULL  Flash capacity exceeded
+ *  @retval         #SFCB_E_NO_FLASH    #SFCB_FMT_COMPACT or SPI NAND #SFCB_FMT_COMMIT not supported by flash type
+ *  @since          2026-10-18
+ */
+int sfcb_new_cb_fmt (t_sfcb *self, uint32_t magicNum, uint16_t elemSizeByte, uint16_t numElems, t_sfcb_fmt fmt, uint8_t *cbID);
+
+
+
+/**
+ *  @brief NAND bad block table
+ *
+ *  registers bad blocks of an SPI NAND flash. Bad blocks are skipped by the
+ *  sector mapping of the circular buffer queues and reduce the usable flash
+ *  capacity. Call before #sfcb_new_cb, the list needs to stay valid while the
+ *  handle is in use. For NOR flashes is the table not evaluated.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[in]      *bad                ascending sorted list of bad block numbers
+ *  @param[in]      num                 number of entries in *bad
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            Table accepted
+ *  @retval         #SFCB_E_WKR_BSY     Worker is busy, wait for processing last job
+ *  @retval         #SFCB_E_MEM         List not ascending sorted or exceeds flash
+ *  @since          2026-10-18
+ */
+int sfcb_nand_bbt (t_sfcb *self, const uint16_t *bad, uint16_t num);
+
+
+
 /**
  *  @brief busy
  *
@@ -283,6 +770,24 @@ int sfcb_busy (t_sfcb *self);
 
 
 
+/**
+ *  @brief idle work
+ *
+ *  checks if #sfcb_worker has work without a job: deferred records,
+ *  read requests, background scrub or deep power-down entry. A caller
+ *  which runs the worker only while #sfcb_busy, f. e. the bus arbiter,
+ *  needs to run it also while idle work is pending
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         int                 state
+ *  @retval         0                   nothing to do
+ *  @retval         -1                  idle work pending
+ *  @since          2026-10-18
+ */
+int sfcb_idle_work (t_sfcb *self);
+
+
+
 /**
  *  @brief Spi Length
  *
@@ -297,10 +802,32 @@ uint16_t sfcb_spi_len (t_sfcb *self);
 
 
 
+/**
+ *  @brief Spi Lanes
+ *
+ *  data lanes of next spi packet, created by #sfcb_worker. Instruction
+ *  and address are always single lane, the program data of a quad page
+ *  program is transferred on four lanes, see #sfcb_quad
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         uint8_t             data lanes, one or four
+ *  @since          2026-10-18
+ */
+uint8_t sfcb_spi_lanes (t_sfcb *self);
+
+
+
 /**
  *  @brief build-up
  *
  *  Reads from Flash and builds-up queues with circular buffer structure
+ *  If the newest queue element has no footer, f. e. caused by an reset in a
+ *  splitted #sfcb_add sequence, the element is reopened and the payload write
+ *  offset restored from the flash content. Appending is continued with #sfcb_add,
+ *  the number of recovered bytes is available via #sfcb_get_pl_wrcnt.
+ *  The offset is the last programmed byte, trailing 0xFF bytes of the written
+ *  payload are not counted and overwritten by the next append. SPI NAND doesn't
+ *  reopen, the element without footer is skipped and the next slot is used.
  *
  *  @param[in,out]  self                handle, #t_sfcb
  *  @return         int                 state
@@ -321,7 +848,9 @@ int sfcb_mkcb (t_sfcb *self);
  *    1) append(1) -> write one byte to payload segment OFS=0
  *    2) append(1) -> write one byte to payload segment OFS=1
  *    and so on...
- *  in case of prematurely finish circular buffer element run #sfcb_add_done
+ *  in case of prematurely finish circular buffer element run #sfcb_add_done.
+ *  SPI NAND keeps the internal ECC enabled and programs every ECC sector once,
+ *  the element is completed with footer in the same job and can't be appended.
  *
  *  @param[in,out]  self                handle, #t_sfcb
  *  @param[in]      cbID                Logical Number of Circular Buffer queue
@@ -333,6 +862,7 @@ int sfcb_mkcb (t_sfcb *self);
  *  @retval         #SFCB_E_NO_CB_Q     Circular buffer queue not active or present.
  *  @retval         #SFCB_E_WKR_REQ     Circular Buffer is not prepared for request, run #sfcb_worker.
  *  @retval         #SFCB_E_MEM         Not enough memory to perform the desired interaction.
+ *  @retval         #SFCB_E_NOP         SPI NAND: element already programmed, append rejected, run #sfcb_mkcb
  *  @since          2023-09-13
  *  @author         Andreas Kaeberlein
  */
@@ -340,6 +870,54 @@ int sfcb_add (t_sfcb *self, uint8_t cbID, void *data, uint16_t len);
 
 
 
+/**
+ *  @brief add check
+ *
+ *  checks all preconditions of #sfcb_add and #sfcb_addv without starting
+ *  a job. Used to accept a request on several chips before any of them writes.
+ *
+ *  @param[in]      self                handle, #t_sfcb
+ *  @param[in]      cbID                Logical Number of Circular Buffer queue
+ *  @param[in]      len                 total payload length of request in bytes
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            Request would be accepted.
+ *  @retval         #SFCB_E_WKR_BSY     Worker is busy, wait for processing last job.
+ *  @retval         #SFCB_E_NO_CB_Q     Circular buffer queue not active or present.
+ *  @retval         #SFCB_E_PIN         Erase blocked by reader pin, #sfcb_pin
+ *  @retval         #SFCB_E_WKR_REQ     Circular Buffer is not prepared for request, run #sfcb_worker.
+ *  @retval         #SFCB_E_MEM         Request exceeds free element payload or 16bit length.
+ *  @retval         #SFCB_E_NOP         SPI NAND: element already programmed, append rejected, run #sfcb_mkcb
+ *  @since          2026-10-18
+ */
+int sfcb_add_chk (t_sfcb *self, uint8_t cbID, uint32_t len);
+
+
+
+/**
+ *  @brief add element gathered
+ *
+ *  same as #sfcb_add, but the payload is gathered from a list of fragments.
+ *  The fragments are directly copied into the page program packets, so that
+ *  the number of page programs depends only on the total length.
+ *  The fragment list and data needs to be valid until the job is finished.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[in]      cbID                Logical Number of Circular Buffer queue
+ *  @param[in]      *iov                list of payload fragments, see #t_sfcb_iov
+ *  @param[in]      iovcnt              number of fragments in *iov
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            Request accepted.
+ *  @retval         #SFCB_E_WKR_BSY     Worker is busy, wait for processing last job.
+ *  @retval         #SFCB_E_NO_CB_Q     Circular buffer queue not active or present.
+ *  @retval         #SFCB_E_WKR_REQ     Circular Buffer is not prepared for request, run #sfcb_worker.
+ *  @retval         #SFCB_E_MEM         Fragments exceed free element payload or 16bit length.
+ *  @retval         #SFCB_E_NOP         SPI NAND: element already programmed, append rejected, run #sfcb_mkcb
+ *  @since          2026-10-18
+ */
+int sfcb_addv (t_sfcb *self, uint8_t cbID, const t_sfcb_iov *iov, uint8_t iovcnt);
+
+
+
 /**
  *  @brief add append done
  *
@@ -360,6 +938,240 @@ int sfcb_add_done (t_sfcb *self, uint8_t cbID);
 
 
 
+/**
+ *  @brief Add Post
+ *
+ *  posts complete element write. Header, payload and footer are written
+ *  in one job. Posted writes of several queues are interleaved by the worker
+ *  with page program granularity, see #sfcb_weight. The payload buffer
+ *  needs to be valid until the worker is idle.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[in]      cbID                Logical Number of Circular Buffer queue
+ *  @param[in]      data                payload of element
+ *  @param[in]      len                 size of *data in bytes, up to queue element size
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            Request accepted
+ *  @retval         #SFCB_E_WKR_BSY     Worker is busy with other job or write to queue is posted
+ *  @retval         #SFCB_E_NO_CB_Q     Circular buffer queue not active or present
+ *  @retval         #SFCB_E_WKR_REQ     Circular Buffer is not prepared for request, run #sfcb_mkcb
+ *  @retval         #SFCB_E_MEM         Payload exceeds queue element size
+ *  @since          2026-10-18
+ */
+int sfcb_add_post (t_sfcb *self, uint8_t cbID, const void *data, uint16_t len);
+
+
+
+/**
+ *  @brief Defer
+ *
+ *  deferred writes of queue. Records are collected in the RAM ring and
+ *  written by the worker as one element with consecutive records, if
+ *  _thr_ records are collected, the oldest record reached the age of
+ *  _age_ worker calls or #sfcb_flush is called. The free slot for the
+ *  next burst is allocated by the worker without rescan of the queue
+ *  as long as the burst stays in the sector. Pass _ring_ NULL to disable.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[in]      cbID                Logical Number of Circular Buffer queue
+ *  @param[in,out]  ring                RAM ring of records, needs to be valid while enabled
+ *  @param[in]      ringLen             size of *ring in bytes
+ *  @param[in]      recLen              record size in bytes
+ *  @param[in]      thr                 records which start burst, limited to one element
+ *  @param[in]      age                 worker calls which start burst, zero disables
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            OKAY
+ *  @retval         #SFCB_E_NO_CB_Q     Circular buffer queue not present
+ *  @retval         #SFCB_E_WKR_BSY     Records of queue waiting in ring
+ *  @retval         #SFCB_E_MEM         Ring or queue element smaller than one record
+ *  @since          2026-10-18
+ */
+int sfcb_defer (t_sfcb *self, uint8_t cbID, void *ring, uint16_t ringLen, uint16_t recLen, uint16_t thr, uint32_t age);
+
+
+
+/**
+ *  @brief Add Defer
+ *
+ *  copies record into RAM ring of deferred queue, see #sfcb_defer.
+ *  Run #sfcb_worker to write the bursts.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[in]      cbID                Logical Number of Circular Buffer queue
+ *  @param[in]      data                record with configured record size
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            Record accepted
+ *  @retval         #SFCB_E_NO_CB_Q     Circular buffer queue not present or not deferred
+ *  @retval         #SFCB_E_MEM         RAM ring full
+ *  @since          2026-10-18
+ */
+int sfcb_add_defer (t_sfcb *self, uint8_t cbID, const void *data);
+
+
+
+/**
+ *  @brief Flush
+ *
+ *  writes all records of deferred queues regardless of threshold and age,
+ *  f. e. from brown-out detection. Run #sfcb_worker until idle.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            OKAY
+ *  @since          2026-10-18
+ */
+int sfcb_flush (t_sfcb *self);
+
+
+
+/**
+ *  @brief Deep power-down
+ *
+ *  puts the flash after every job into deep power-down. A new job
+ *  releases the flash, the worker waits _wake_ calls before the
+ *  first command. Background scrub keeps the flash powered up.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[in]      ena                 enter deep power-down if idle
+ *  @param[in]      wake                worker calls without packet after release
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            OKAY
+ *  @retval         #SFCB_E_NO_FLASH    Flash without deep power-down
+ *  @since          2026-10-18
+ */
+int sfcb_deep_pd (t_sfcb *self, uint8_t ena, uint32_t wake);
+
+
+
+/**
+ *  @brief Quad
+ *
+ *  writes pages with quad input page program. Enable starts a job
+ *  which sets the quad enable bit in status register 2, run
+ *  #sfcb_worker until idle. The SPI core follows #sfcb_spi_lanes.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[in]      ena                 use quad page program
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            OKAY
+ *  @retval         #SFCB_E_NO_FLASH    Flash without quad page program
+ *  @retval         #SFCB_E_WKR_BSY     Worker is busy
+ *  @since          2026-10-18
+ */
+int sfcb_quad (t_sfcb *self, uint8_t ena);
+
+
+
+/**
+ *  @brief Transform
+ *
+ *  assigns chain of payload transform stages to queue _cbID_. Add
+ *  passes every payload chunk through the stages in order, get in
+ *  reverse order. Requires element format #SFCB_FMT_HEAD_FOOT and
+ *  space for the metadata between payload and footer. The formats
+ *  #SFCB_FMT_COMMIT and #SFCB_FMT_COMPACT have no footer, the header
+ *  is written together with the first payload chunk untransformed.
+ *  The get of a complete element checks the metadata, mismatch sets
+ *  #SFCB_E_XFRM.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[in]      cbID                circular buffer queue
+ *  @param[in]      *chain              transform stages, _NULL_ disables
+ *  @param[in]      num                 number of stages
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            OKAY
+ *  @retval         #SFCB_E_NO_CB_Q     Circular buffer queue not present
+ *  @retval         #SFCB_E_WKR_BSY     Worker is busy
+ *  @retval         #SFCB_E_FMT         Element format without payload transform
+ *  @retval         #SFCB_E_MEM         Slot without space for metadata
+ *  @since          2026-10-18
+ */
+int sfcb_xfrm (t_sfcb *self, uint8_t cbID, const t_sfcb_xfrm *chain, uint8_t num);
+
+
+
+/**
+ *  @brief Reclaim
+ *
+ *  sets the erase granularity of queue _cbID_. If the oldest element
+ *  starts at an aligned block inside of the queue, is the complete
+ *  block erased with one instruction, otherwise sector by sector until
+ *  the next block boundary. Trades minimum retention for erase time.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[in]      cbID                circular buffer queue
+ *  @param[in]      blkSize             erase size in bytes, #SFCB_FLASH_TOPO_SECTOR_SIZE, 32768 or 65536
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            OKAY
+ *  @retval         #SFCB_E_NO_CB_Q     Circular buffer queue not present
+ *  @retval         #SFCB_E_WKR_BSY     Worker is busy
+ *  @retval         #SFCB_E_NO_FLASH    Block erase not supported by flash
+ *  @since          2026-10-18
+ */
+int sfcb_reclaim (t_sfcb *self, uint8_t cbID, uint32_t blkSize);
+
+
+
+/**
+ *  @brief Pin
+ *
+ *  pins flash range of queue _cbID_ for a long running reader, f. e.
+ *  export of complete queue. Adds go on in free elements, the sector
+ *  erase of #sfcb_mkcb which hits the range is blocked or performed
+ *  by policy. Move the pin with the reader progress, _len_ zero
+ *  releases the pin.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[in]      cbID                circular buffer queue
+ *  @param[in]      adr                 start address of pinned range
+ *  @param[in]      len                 size of pinned range in bytes, zero releases
+ *  @param[in]      pol                 policy on conflict, #t_sfcb_pin_pol
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            OKAY
+ *  @retval         #SFCB_E_NO_CB_Q     Circular buffer queue not present
+ *  @retval         #SFCB_E_WKR_BSY     Worker is busy
+ *  @retval         #SFCB_E_MEM         Range outside of queue
+ *  @since          2026-10-18
+ */
+int sfcb_pin (t_sfcb *self, uint8_t cbID, uint32_t adr, uint32_t len, t_sfcb_pin_pol pol);
+
+
+
+/**
+ *  @brief Pin state
+ *
+ *  reports pin conflicts of queue _cbID_ since the pin was set by
+ *  #sfcb_pin. The state is kept after release up to the next pin.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[in]      cbID                circular buffer queue
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            Pinned range unchanged
+ *  @retval         #SFCB_E_NO_CB_Q     Circular buffer queue not present
+ *  @retval         #SFCB_E_PIN         Erase hit pinned range, writes blocked or pinned data erased by policy
+ *  @since          2026-10-18
+ */
+int sfcb_pin_state (t_sfcb *self, uint8_t cbID);
+
+
+
+/**
+ *  @brief Weight
+ *
+ *  page programs of queue per scheduling round of posted writes, see #sfcb_add_post
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[in]      cbID                Logical Number of Circular Buffer queue
+ *  @param[in]      weight              page programs per round, at least one
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            OKAY
+ *  @retval         #SFCB_E_NO_CB_Q     Circular buffer queue not present
+ *  @since          2026-10-18
+ */
+int sfcb_weight (t_sfcb *self, uint8_t cbID, uint8_t weight);
+
+
+
 /**
  *  @brief written bytes
  *
@@ -388,6 +1200,7 @@ uint16_t sfcb_get_pl_wrcnt (t_sfcb *self, uint8_t cbID);
  *  @return         int                 state
  *  @retval         0                   Request accepted.
  *  @retval         1                   Worker is busy, wait for processing last job.
+ *  @retval         #SFCB_E_MEM         SPI NAND: read crosses page boundary
  *  @since          2023-01-05
  *  @author         Andreas Kaeberlein
  */
@@ -395,6 +1208,111 @@ int sfcb_flash_read (t_sfcb *self, uint32_t adr, void *data, uint16_t len);
 
 
 
+/**
+ *  @brief Export
+ *
+ *  streams queue _cbID_ as compact container, see #SFCB_EXP. Every
+ *  call starts a job which fills _buf_ with the next container part:
+ *  header, one element from oldest to newest or trailer. Elements
+ *  carry the complete payload, the payload is exported like stored
+ *  in flash. Run #sfcb_worker until idle, send _*used_
+ *  bytes and call again. Pin the queue with #sfcb_pin for consistent
+ *  exports during adds.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[in]      cbID                circular buffer queue
+ *  @param[out]     *buf                container output, at least payload size + #SFCB_EXP_ELEM_OVH
+ *  @param[in]      len                 size of _buf_ in bytes
+ *  @param[out]     *used               at job end number of container bytes in _buf_
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            Job started
+ *  @retval         #SFCB_E_WKR_BSY     Worker is busy, wait for processing last job
+ *  @retval         #SFCB_E_NO_CB_Q     Circular buffer queue not present
+ *  @retval         #SFCB_E_WKR_REQ     Circular Buffer is not prepared for request, run #sfcb_mkcb
+ *  @retval         #SFCB_E_MEM         _buf_ too small or #SFCB_FMT_COMPACT queue
+ *  @retval         #SFCB_E_CB_Q_MTY    Container complete, next call starts new export
+ *  @since          2026-10-18
+ */
+int sfcb_export (t_sfcb *self, uint8_t cbID, void *buf, uint16_t len, uint16_t *used);
+
+
+
+/**
+ *  @brief Blank check
+ *
+ *  checks flash region for erased state. The worker reads SPI buffer
+ *  sized chunks, compares word-wide and stops at the first programmed
+ *  byte. Run #sfcb_worker until idle.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[in]      adr                 start address of region
+ *  @param[in]      len                 size of region in bytes
+ *  @param[out]     *usedAdr            at job end address of first programmed byte, UINT32_MAX if erased
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            Request accepted
+ *  @retval         #SFCB_E_WKR_BSY     Worker is busy, wait for processing last job
+ *  @retval         #SFCB_E_MEM         Region exceeds flash
+ *  @since          2026-10-18
+ */
+int sfcb_blank_check (t_sfcb *self, uint32_t adr, uint32_t len, uint32_t *usedAdr);
+
+
+
+/**
+ *  @brief Read queue
+ *
+ *  assigns table for read requests. The worker merges pending requests
+ *  with adjacent or overlapping flash ranges into one read transaction
+ *  and scatters the data to the requesters.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[in,out]  *req                request table, _NULL_ disables
+ *  @param[in]      num                 slots in request table
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            OKAY
+ *  @retval         #SFCB_E_WKR_BSY     Requests of current table in process
+ *  @since          2026-10-18
+ */
+int sfcb_read_q (t_sfcb *self, t_sfcb_rd *req, uint8_t num);
+
+
+
+/**
+ *  @brief Read request
+ *
+ *  queues read of raw flash data, completion with #sfcb_read_done
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[in]      adr                 start address for read
+ *  @param[in,out]  *data               pointer to data array with read data
+ *  @param[in]      len                 size of *data in bytes
+ *  @param[out]     *reqID              slot of request
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            Request accepted
+ *  @retval         #SFCB_E_MEM         No free slot, or read exceeds SPI buffer or NAND page
+ *  @since          2026-10-18
+ */
+int sfcb_read_req (t_sfcb *self, uint32_t adr, void *data, uint16_t len, uint8_t *reqID);
+
+
+
+/**
+ *  @brief Read done
+ *
+ *  checks read request for delivered data and releases the slot
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[in]      reqID               slot of request
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            Data delivered
+ *  @retval         #SFCB_E_WKR_REQ     Read pending, run #sfcb_worker
+ *  @retval         #SFCB_E_MEM         Slot without request
+ *  @since          2026-10-18
+ */
+int sfcb_read_done (t_sfcb *self, uint8_t reqID);
+
+
+
 /**
  *  @brief Get Last
  *
@@ -433,6 +1351,42 @@ uint32_t sfcb_idmax (t_sfcb *self, uint8_t cbID);
 
 
 
+/**
+ *  @brief queue statistics
+ *
+ *  occupancy of selected circular buffer queue. Served from management data
+ *  without SPI traffic, the worker updates the data with every footer write
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[in]      cbID                Logical Number of Circular Buffer queue
+ *  @param[out]     *st                 queue statistics, #t_sfcb_stats
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            OKAY
+ *  @retval         #SFCB_E_NO_CB_Q     Circular buffer queue not present
+ *  @since          2026-10-18
+ */
+int sfcb_queue_stats (t_sfcb *self, uint8_t cbID, t_sfcb_stats *st);
+
+
+
+/**
+ *  @brief background scrub
+ *
+ *  re-reads header and footer of retained elements of all queues with valid management
+ *  data while the worker is idle. At most _pkts_ SPI packets are spent every _calls_ worker
+ *  calls. A started job discards a pending read. Findings are reported by #sfcb_queue_stats
+ *
+ *  @param[in,out]  self                handle, #t_sfcb
+ *  @param[in]      pkts                SPI packets per tick, zero disables scrubbing
+ *  @param[in]      calls               worker calls per tick, at least one
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            OKAY
+ *  @since          2026-10-18
+ */
+int sfcb_scrub (t_sfcb *self, uint16_t pkts, uint32_t calls);
+
+
+
 /**
  *  @brief check error
  *
@@ -0,0 +1,561 @@
+/***********************************************************************
+ @copyright     : Siemens AG
+ @license       : BSDv3
+ @author        : Andreas Kaeberlein
+ @address       : Clemens-Winkler-Strasse 3, 09116 Chemnitz
+
+ @maintainer    : Andreas Kaeberlein
+ @telephone     : +49 371 4810-2108
+ @email         : andreas.kaeberlein@siemens.com
+
+ @file          : spi_flash_cb_arb.c
+ @date          : October 18, 2026
+ @see           : https://github.com/andkae/SPI-Flash-Circular-Buffer
+
+ @brief         : SPI Flash Circular Buffer Bus Arbiter
+                  Schedules several SFCB handles on one SPI bus
+                  with a single exchange buffer
+***********************************************************************/
+
+
+
+/** Includes **/
+/* Standard libs */
+#include <stdint.h>     // defines fixed data types: int8_t...
+#include <stddef.h>     // various variable types and macros: size_t, offsetof, NULL, ...
+#include <string.h>     // string operation: memset, memcpy
+/* Self */
+#include "sfcb_flash_types.h"   // supported spi flashes
+#include "spi_flash_cb.h"       // circular buffer handle
+#include "spi_flash_cb_arb.h"   // function prototypes
+
+
+
+/**
+ *  @defgroup SFCB_PRINTF_EN
+ *
+ *  redirect sfcb_printf to printf
+ *
+ *  @{
+ */
+#ifdef SFCB_PRINTF_EN
+    #include <stdio.h>  // allow outputs in unit test
+    #define sfcb_printf(...) printf(__VA_ARGS__)
+#else
+    #define sfcb_printf(...)
+#endif
+/** @} */   // DEBUG
+
+
+
+/**
+ *  @brief device preference
+ *
+ *  compares two ready devices. Order: earliest deadline, job before
+ *  idle work, not waiting for WIP, highest priority
+ *
+ *  @param[in]      *a                  device, #t_sfcb_arb_dev
+ *  @param[in]      *b                  device, #t_sfcb_arb_dev
+ *  @return         int                 preference
+ *  @retval         0                   b is preferred or equal
+ *  @retval         1                   a is preferred
+ *  @since          October 18, 2026
+ */
+static int sfcb_arb_prefer (const t_sfcb_arb_dev *a, const t_sfcb_arb_dev *b)
+{
+    /* deadline */
+    if ( a->uint8DlEna != b->uint8DlEna ) {
+        return (0 != a->uint8DlEna);
+    }
+    if ( (0 != a->uint8DlEna) && (a->uint32Deadline != b->uint32Deadline) ) {
+        return ((int32_t) (a->uint32Deadline - b->uint32Deadline) < 0);   // wrap around safe
+    }
+    /* job, idle work only on free bus */
+    if ( sfcb_busy(a->sfcb) != sfcb_busy(b->sfcb) ) {
+        return (0 != sfcb_busy(a->sfcb));
+    }
+    /* not in WIP, has work for the bus */
+    if ( a->uint8Parked != b->uint8Parked ) {
+        return (0 == a->uint8Parked);
+    }
+    /* priority */
+    return (a->uint8Prio > b->uint8Prio);
+}
+
+
+
+/**
+ *  @brief device select
+ *
+ *  selects next device with pending job or idle work, see #sfcb_idle_work.
+ *  Equal devices are served round robin
+ *
+ *  @param[in,out]  self                handle, #t_sfcb_arb
+ *  @return         uint8_t             selected device, #SFCB_ARB_NONE if all idle
+ *  @since          October 18, 2026
+ */
+static uint8_t sfcb_arb_select (t_sfcb_arb *self)
+{
+    /** Variables **/
+    uint8_t uint8Sel = SFCB_ARB_NONE;   // best device
+    uint8_t uint8Dev;                   // device iterator
+
+    for ( uint8_t i = 1; i <= self->uint8NumDevs; i++ ) {
+        uint8Dev = (uint8_t) ((self->uint8Last + i) % self->uint8NumDevs);  // start after last served
+        if (    (NULL == ((self->ptrDevs)[uint8Dev]).sfcb)
+             || ((0 == sfcb_busy(((self->ptrDevs)[uint8Dev]).sfcb)) && (0 == sfcb_idle_work(((self->ptrDevs)[uint8Dev]).sfcb)))
+        ) {
+            continue;   // no work
+        }
+        if ( (SFCB_ARB_NONE == uint8Sel) || (0 != sfcb_arb_prefer(&((self->ptrDevs)[uint8Dev]), &((self->ptrDevs)[uint8Sel]))) ) {
+            uint8Sel = uint8Dev;
+        }
+    }
+    return uint8Sel;
+}
+
+
+
+/**
+ *  @brief device service
+ *
+ *  runs worker of device and takes over its SPI packet, the last packet
+ *  of a finished job, f. e. deep power-down, is forwarded too
+ *
+ *  @param[in,out]  self                handle, #t_sfcb_arb
+ *  @param[in]      dev                 device number
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void sfcb_arb_run (t_sfcb_arb *self, uint8_t dev)
+{
+    /** Variables **/
+    t_sfcb_arb_dev  *ptrDev = &((self->ptrDevs)[dev]);
+
+    sfcb_worker(ptrDev->sfcb);
+    /* job done */
+    if ( 0 == sfcb_busy(ptrDev->sfcb) ) {
+        if ( (0 != ptrDev->uint8DlEna) && ((int32_t) (self->uint32Ticks - ptrDev->uint32Deadline) > 0) ) {
+            sfcb_printf("  INFO:%s: dev=%d, deadline missed by %d ticks\n", __FUNCTION__, dev, self->uint32Ticks - ptrDev->uint32Deadline);
+            (self->uint32DlMiss)++;
+        }
+        ptrDev->uint8DlEna = 0;
+    }
+    /* device keeps bus until WIP or job done */
+    self->uint16SpiLen = sfcb_spi_len(ptrDev->sfcb);
+    self->uint8Owner = ((0 != sfcb_busy(ptrDev->sfcb)) || (0 != self->uint16SpiLen)) ? dev : SFCB_ARB_NONE;
+}
+
+
+
+/**
+ *  @brief mirror check
+ *
+ *  checks mirror of device and readiness of queue on both chips
+ *
+ *  @param[in,out]  self                handle, #t_sfcb_arb
+ *  @param[in]      devID               device number, one of the mirror
+ *  @param[in]      cbID                circular buffer queue
+ *  @param[in]      mgmt                request valid management data on both chips
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            both chips ready
+ *  @retval         #SFCB_E_NO_CB_Q     device not mirrored or queue not present
+ *  @retval         #SFCB_E_WKR_BSY     one chip is busy
+ *  @retval         #SFCB_E_WKR_REQ     one chip is not prepared
+ *  @since          October 18, 2026
+ */
+static int sfcb_arb_mirror_chk (t_sfcb_arb *self, uint8_t devID, uint8_t cbID, uint8_t mgmt)
+{
+    /** Variables **/
+    uint8_t uint8Dev[2];    // both chips
+    t_sfcb  *ptrSfcb;
+
+    if ( !(devID < self->uint8NumDevs) || (NULL == ((self->ptrDevs)[devID]).sfcb) || (SFCB_ARB_NONE == ((self->ptrDevs)[devID]).uint8Mirror) ) {
+        return SFCB_E_NO_CB_Q;
+    }
+    uint8Dev[0] = devID;
+    uint8Dev[1] = ((self->ptrDevs)[devID]).uint8Mirror;
+    for ( uint8_t i = 0; i < 2; i++ ) {
+        ptrSfcb = ((self->ptrDevs)[uint8Dev[i]]).sfcb;
+        if ( 0 != sfcb_busy(ptrSfcb) ) {
+            return SFCB_E_WKR_BSY;
+        }
+        if ( (0 != mgmt) && !(cbID < ptrSfcb->uint8NumCbs) ) {
+            return SFCB_E_NO_CB_Q;
+        }
+        if ( (0 != mgmt) && (0 == ((ptrSfcb->ptrCbs)[cbID]).uint8MgmtValid) ) {
+            return SFCB_E_WKR_REQ;
+        }
+    }
+    return SFCB_OK;
+}
+
+
+
+/**
+ *  sfcb_arb_init
+ *    initializes arbiter
+ */
+int sfcb_arb_init (t_sfcb_arb *self, void *dev, uint8_t devLen, void *spi, uint16_t spiLen)
+{
+    /* Function call message */
+    sfcb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* check args */
+    if ( (SFCB_ARB_NONE <= devLen) || ((SFCB_FLASH_TOPO_PAGE_SIZE + SFCB_FLASH_TOPO_ADR_BYTE + 1) > spiLen) ) {
+        sfcb_printf("  ERROR:%s: to many devices or spi buffer to small\n", __FUNCTION__);
+        return SFCB_E_MEM;
+    }
+    /* init */
+    self->ptrDevs = (t_sfcb_arb_dev*) dev;
+    self->uint8NumDevs = devLen;
+    self->uint8Owner = SFCB_ARB_NONE;
+    self->uint8Last = 0;
+    self->uint8PtrSpi = (uint8_t*) spi;
+    self->uint16SpiMax = spiLen;
+    self->uint16SpiLen = 0;
+    self->uint32Ticks = 0;
+    self->uint32TicksBusy = 0;
+    self->uint32Bytes = 0;
+    self->uint32DlMiss = 0;
+    for ( uint8_t i = 0; i < devLen; i++ ) {
+        memset(&((self->ptrDevs)[i]), 0, sizeof((self->ptrDevs)[i]));
+        ((self->ptrDevs)[i]).sfcb = NULL;   // free
+        ((self->ptrDevs)[i]).uint8Mirror = SFCB_ARB_NONE;
+    }
+    return SFCB_OK;
+}
+
+
+
+/**
+ *  sfcb_arb_add
+ *    registers device
+ */
+int sfcb_arb_add (t_sfcb_arb *self, t_sfcb *sfcb, uint8_t prio, uint8_t *devID)
+{
+    /* Function call message */
+    sfcb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* handle has no pending job */
+    if ( 0 != sfcb_busy(sfcb) ) {
+        sfcb_printf("  ERROR:%s: Worker is busy\n", __FUNCTION__);
+        return SFCB_E_WKR_BSY;
+    }
+    /* find free entry */
+    for ( uint8_t i = 0; i < self->uint8NumDevs; i++ ) {
+        if ( NULL == ((self->ptrDevs)[i]).sfcb ) {
+            memset(&((self->ptrDevs)[i]), 0, sizeof((self->ptrDevs)[i]));
+            ((self->ptrDevs)[i]).sfcb = sfcb;
+            ((self->ptrDevs)[i]).uint8Prio = prio;
+            ((self->ptrDevs)[i]).uint8Mirror = SFCB_ARB_NONE;
+            sfcb->uint8PtrSpi = self->uint8PtrSpi;      // shared exchange buffer
+            sfcb->uint16SpiMax = self->uint16SpiMax;
+            sfcb->uint16SpiLen = 0;
+            *devID = i;
+            sfcb_printf("  INFO:%s: dev=%d, prio=%d\n", __FUNCTION__, i, prio);
+            return SFCB_OK;
+        }
+    }
+    sfcb_printf("  ERROR:%s: no free device entry\n", __FUNCTION__);
+    return SFCB_E_MEM;
+}
+
+
+
+/**
+ *  sfcb_arb_deadline
+ *    sets job deadline
+ */
+int sfcb_arb_deadline (t_sfcb_arb *self, uint8_t devID, uint32_t ticks)
+{
+    if ( !(devID < self->uint8NumDevs) || (NULL == ((self->ptrDevs)[devID]).sfcb) ) {
+        return SFCB_E_NO_CB_Q;
+    }
+    ((self->ptrDevs)[devID]).uint32Deadline = self->uint32Ticks + ticks;
+    ((self->ptrDevs)[devID]).uint8DlEna = 1;
+    return SFCB_OK;
+}
+
+
+
+/**
+ *  sfcb_arb_mirror
+ *    pairs two devices
+ */
+int sfcb_arb_mirror (t_sfcb_arb *self, uint8_t devA, uint8_t devB)
+{
+    /* Function call message */
+    sfcb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* two present and unpaired devices */
+    if (    !(devA < self->uint8NumDevs) || !(devB < self->uint8NumDevs) || (devA == devB)
+         || (NULL == ((self->ptrDevs)[devA]).sfcb) || (NULL == ((self->ptrDevs)[devB]).sfcb)
+         || (SFCB_ARB_NONE != ((self->ptrDevs)[devA]).uint8Mirror) || (SFCB_ARB_NONE != ((self->ptrDevs)[devB]).uint8Mirror)
+         || (((self->ptrDevs)[devA]).sfcb->uint8NumCbs != ((self->ptrDevs)[devB]).sfcb->uint8NumCbs)
+    ) {
+        sfcb_printf("  ERROR:%s: devices not present, mirrored or different\n", __FUNCTION__);
+        return SFCB_E_NO_CB_Q;
+    }
+    ((self->ptrDevs)[devA]).uint8Mirror = devB;
+    ((self->ptrDevs)[devB]).uint8Mirror = devA;
+    sfcb_printf("  INFO:%s: dev=%d, mirror=%d\n", __FUNCTION__, devA, devB);
+    return SFCB_OK;
+}
+
+
+
+/**
+ *  sfcb_arb_mirror_mkcb
+ *    builds management data on both chips
+ */
+int sfcb_arb_mirror_mkcb (t_sfcb_arb *self, uint8_t devID)
+{
+    /** Variables **/
+    int ret;
+
+    ret = sfcb_arb_mirror_chk(self, devID, 0, 0);
+    if ( SFCB_OK != ret ) {
+        return ret;
+    }
+    ret = sfcb_mkcb(((self->ptrDevs)[devID]).sfcb);
+    if ( SFCB_OK != ret ) {
+        return ret;
+    }
+    return sfcb_mkcb(((self->ptrDevs)[((self->ptrDevs)[devID]).uint8Mirror]).sfcb);
+}
+
+
+
+/**
+ *  sfcb_arb_mirror_add
+ *    writes element to both chips
+ */
+int sfcb_arb_mirror_add (t_sfcb_arb *self, uint8_t devID, uint8_t cbID, void *data, uint16_t len)
+{
+    /** Variables **/
+    int ret;
+
+    /* both chips accept, otherwise copies diverge */
+    ret = sfcb_arb_mirror_chk(self, devID, cbID, 1);
+    if ( SFCB_OK != ret ) {
+        return ret;
+    }
+    ret = sfcb_add_chk(((self->ptrDevs)[devID]).sfcb, cbID, len);
+    if ( SFCB_OK != ret ) {
+        return ret;
+    }
+    ret = sfcb_add_chk(((self->ptrDevs)[((self->ptrDevs)[devID]).uint8Mirror]).sfcb, cbID, len);
+    if ( SFCB_OK != ret ) {
+        return ret;
+    }
+    ret = sfcb_add(((self->ptrDevs)[devID]).sfcb, cbID, data, len);
+    if ( SFCB_OK != ret ) {
+        return ret;
+    }
+    return sfcb_add(((self->ptrDevs)[((self->ptrDevs)[devID]).uint8Mirror]).sfcb, cbID, data, len);
+}
+
+
+
+/**
+ *  sfcb_arb_mirror_get_last
+ *    reads newest element from less loaded chip
+ */
+int sfcb_arb_mirror_get_last (t_sfcb_arb *self, uint8_t devID, uint8_t cbID, void *data, uint16_t len, uint32_t *elemID, uint8_t *rdDev)
+{
+    /** Variables **/
+    uint8_t         uint8Dev[2];            // both chips
+    uint8_t         uint8Sel = SFCB_ARB_NONE;
+    uint32_t        uint32IdNew = 0;        // newest element ID
+    uint8_t         uint8Valid = 0;         // chips with valid management data
+    t_sfcb_arb_dev  *ptrDev;
+
+    if ( !(devID < self->uint8NumDevs) || (NULL == ((self->ptrDevs)[devID]).sfcb) || (SFCB_ARB_NONE == ((self->ptrDevs)[devID]).uint8Mirror) ) {
+        return SFCB_E_NO_CB_Q;
+    }
+    if ( !(cbID < ((self->ptrDevs)[devID]).sfcb->uint8NumCbs) ) {
+        return SFCB_E_NO_CB_Q;
+    }
+    uint8Dev[0] = devID;
+    uint8Dev[1] = ((self->ptrDevs)[devID]).uint8Mirror;
+    /* newest copy */
+    for ( uint8_t i = 0; i < 2; i++ ) {
+        ptrDev = &((self->ptrDevs)[uint8Dev[i]]);
+        if ( 0 == ((ptrDev->sfcb->ptrCbs)[cbID]).uint8MgmtValid ) {
+            continue;
+        }
+        if ( (0 == uint8Valid) || ((int32_t) (((ptrDev->sfcb->ptrCbs)[cbID]).uint32ElemIdLastCpl - uint32IdNew) > 0) ) {
+            uint32IdNew = ((ptrDev->sfcb->ptrCbs)[cbID]).uint32ElemIdLastCpl;
+        }
+        uint8Valid++;
+    }
+    if ( 0 == uint8Valid ) {
+        return SFCB_E_WKR_REQ;
+    }
+    /* idle chip with newest copy and fewest packets */
+    for ( uint8_t i = 0; i < 2; i++ ) {
+        ptrDev = &((self->ptrDevs)[uint8Dev[i]]);
+        if (    (0 == ((ptrDev->sfcb->ptrCbs)[cbID]).uint8MgmtValid)
+             || (uint32IdNew != ((ptrDev->sfcb->ptrCbs)[cbID]).uint32ElemIdLastCpl)
+             || (0 != sfcb_busy(ptrDev->sfcb))
+        ) {
+            continue;
+        }
+        if ( (SFCB_ARB_NONE == uint8Sel) || (ptrDev->uint32Pkts < ((self->ptrDevs)[uint8Sel]).uint32Pkts) ) {
+            uint8Sel = uint8Dev[i];
+        }
+    }
+    if ( SFCB_ARB_NONE == uint8Sel ) {
+        return SFCB_E_WKR_BSY;
+    }
+    sfcb_printf("  INFO:%s: dev=%d serves id=%d\n", __FUNCTION__, uint8Sel, uint32IdNew);
+    *rdDev = uint8Sel;
+    return sfcb_get_last(((self->ptrDevs)[uint8Sel]).sfcb, cbID, data, len, elemID);
+}
+
+
+
+/**
+ *  sfcb_arb_mirror_sync
+ *    compares newest element of both copies
+ */
+int sfcb_arb_mirror_sync (t_sfcb_arb *self, uint8_t devID, uint8_t cbID, uint8_t *lagDev, uint32_t *lagNum)
+{
+    /** Variables **/
+    uint8_t     uint8Mirror;
+    int32_t     int32Diff;      // element ID difference
+    int         ret;
+
+    ret = sfcb_arb_mirror_chk(self, devID, cbID, 1);
+    if ( SFCB_OK != ret ) {
+        return ret;
+    }
+    uint8Mirror = ((self->ptrDevs)[devID]).uint8Mirror;
+    int32Diff = (int32_t) ((((self->ptrDevs)[devID]).sfcb->ptrCbs)[cbID].uint32ElemIdLastCpl - (((self->ptrDevs)[uint8Mirror]).sfcb->ptrCbs)[cbID].uint32ElemIdLastCpl);
+    *lagDev = SFCB_ARB_NONE;
+    *lagNum = 0;
+    if ( int32Diff > 0 ) {
+        *lagDev = uint8Mirror;
+        *lagNum = (uint32_t) int32Diff;
+    } else if ( int32Diff < 0 ) {
+        *lagDev = devID;
+        *lagNum = (uint32_t) (-int32Diff);
+    }
+    sfcb_printf("  INFO:%s: dev=%d, mirror=%d, lag=%d, missing=%d\n", __FUNCTION__, devID, uint8Mirror, *lagDev, *lagNum);
+    /* only newest element is restorable, older ones are not matched by ID */
+    if ( *lagNum > 1 ) {
+        sfcb_printf("  ERROR:%s: copies diverged by more then one element\n", __FUNCTION__);
+        return SFCB_E_MIRROR;
+    }
+    return SFCB_OK;
+}
+
+
+
+/**
+ *  sfcb_arb_worker
+ *    services devices on the bus
+ */
+void sfcb_arb_worker (t_sfcb_arb *self)
+{
+    /** Variables **/
+    uint8_t uint8Sel;   // selected device
+
+    /* Function call message */
+    sfcb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    (self->uint32Ticks)++;
+    /* response of last packet */
+    if ( SFCB_ARB_NONE != self->uint8Owner ) {
+        /* write in progress, park device at WIP poll and free bus */
+        if (    (2 == self->uint16SpiLen)
+             && (SFCB_FLASH_IST_RD_STATE_REG == self->uint8PtrSpi[0])
+             && (0 != (self->uint8PtrSpi[1] & SFCB_FLASH_MNG_WIP_MSK))
+        ) {
+            sfcb_printf("  INFO:%s: dev=%d parked, WIP\n", __FUNCTION__, self->uint8Owner);
+            ((self->ptrDevs)[self->uint8Owner]).uint8Parked = 1;
+            self->uint8Owner = SFCB_ARB_NONE;
+            self->uint16SpiLen = 0;
+        /* device goes on */
+        } else {
+            sfcb_arb_run(self, self->uint8Owner);
+        }
+    }
+    /* bus free, select next device */
+    if ( SFCB_ARB_NONE == self->uint8Owner ) {
+        uint8Sel = sfcb_arb_select(self);
+        if ( SFCB_ARB_NONE == uint8Sel ) {
+            return; // all idle
+        }
+        self->uint8Last = uint8Sel;
+        /* resume parked device, reissue WIP poll, response is processed by the device worker */
+        if ( 0 != ((self->ptrDevs)[uint8Sel]).uint8Parked ) {
+            ((self->ptrDevs)[uint8Sel]).uint8Parked = 0;
+            self->uint8PtrSpi[0] = SFCB_FLASH_IST_RD_STATE_REG;
+            self->uint8PtrSpi[1] = 0;
+            self->uint16SpiLen = 2;
+            self->uint8Owner = uint8Sel;
+        /* start job */
+        } else {
+            sfcb_arb_run(self, uint8Sel);
+        }
+    }
+    /* bus statistic */
+    if ( 0 != self->uint16SpiLen ) {
+        (self->uint32TicksBusy)++;
+        self->uint32Bytes += self->uint16SpiLen;
+        (((self->ptrDevs)[self->uint8Owner]).uint32Pkts)++;
+    }
+}
+
+
+
+/**
+ *  sfcb_arb_spi_len
+ *    length of SPI packet
+ */
+uint16_t sfcb_arb_spi_len (t_sfcb_arb *self)
+{
+    return self->uint16SpiLen;
+}
+
+
+
+/**
+ *  sfcb_arb_dev
+ *    device of SPI packet
+ */
+uint8_t sfcb_arb_dev (t_sfcb_arb *self)
+{
+    if ( 0 == self->uint16SpiLen ) {
+        return SFCB_ARB_NONE;
+    }
+    return self->uint8Owner;
+}
+
+
+
+/**
+ *  sfcb_arb_busy
+ *    any device with pending job
+ */
+int sfcb_arb_busy (t_sfcb_arb *self)
+{
+    for ( uint8_t i = 0; i < self->uint8NumDevs; i++ ) {
+        if ( (NULL != ((self->ptrDevs)[i]).sfcb) && (0 != sfcb_busy(((self->ptrDevs)[i]).sfcb)) ) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+
+
+/**
+ *  sfcb_arb_util
+ *    bus utilization
+ */
+uint8_t sfcb_arb_util (t_sfcb_arb *self)
+{
+    if ( 0 == self->uint32Ticks ) {
+        return 0;
+    }
+    return (uint8_t) (((uint64_t) self->uint32TicksBusy * 100) / self->uint32Ticks);
+}
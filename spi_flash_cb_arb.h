@@ -0,0 +1,343 @@
+/***********************************************************************
+ @copyright     : Siemens AG
+ @license       : BSDv3
+ @author        : Andreas Kaeberlein
+ @address       : Clemens-Winkler-Strasse 3, 09116 Chemnitz
+
+ @maintainer    : Andreas Kaeberlein
+ @telephone     : +49 371 4810-2108
+ @email         : andreas.kaeberlein@siemens.com
+
+ @file          : spi_flash_cb_arb.h
+ @date          : October 18, 2026
+ @see           : https://github.com/andkae/SPI-Flash-Circular-Buffer
+
+ @brief         : SPI Flash Circular Buffer Bus Arbiter
+                  Schedules several SFCB handles on one SPI bus
+                  with a single exchange buffer
+***********************************************************************/
+
+
+// Define Guard
+#ifndef __SPI_FLASH_CB_ARB_H
+#define __SPI_FLASH_CB_ARB_H
+
+
+/** Standard libs **/
+#include <stdint.h>         // fixed data types
+
+/** Self **/
+#include "spi_flash_cb.h"   // t_sfcb
+
+
+/* C++ compatibility */
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+
+
+/**
+ *  @defgroup SFCB_ARB_NONE
+ *  no device owns the bus
+ *  @{
+ */
+#define SFCB_ARB_NONE   (0xFF)  /**< No device selected */
+/** @} */   // SFCB_ARB_NONE
+
+
+
+/**
+ *  @typedef t_sfcb_arb_dev
+ *
+ *  @brief  arbiter device
+ *
+ *  One entry per SPI flash on the bus.
+ *  This structure is used in an array provided by the application
+ *
+ *  @since  2026-10-18
+ */
+typedef struct t_sfcb_arb_dev
+{
+    t_sfcb*     sfcb;               /**< SFCB handle of the flash, NULL if entry is free */
+    uint8_t     uint8Prio;          /**< Priority, higher value is served first */
+    uint8_t     uint8Parked;        /**< Device waits for WIP, bus is free for other devices */
+    uint8_t     uint8DlEna;         /**< Deadline #uint32Deadline is active */
+    uint32_t    uint32Deadline;     /**< Job needs to be finished until this arbiter tick */
+    uint32_t    uint32Pkts;         /**< Number of issued SPI packets */
+    uint8_t     uint8Mirror;        /**< Mirror partner, #sfcb_arb_mirror, #SFCB_ARB_NONE if not mirrored */
+} t_sfcb_arb_dev;
+
+
+
+/**
+ *  @typedef t_sfcb_arb
+ *
+ *  @brief  arbiter
+ *
+ *  Handle for the bus arbiter
+ *
+ *  @since  2026-10-18
+ */
+typedef struct t_sfcb_arb
+{
+    t_sfcb_arb_dev*     ptrDevs;            /**< List of devices on the bus, #t_sfcb_arb_dev */
+    uint8_t             uint8NumDevs;       /**< Number of entries in #ptrDevs */
+    uint8_t             uint8Owner;         /**< Device of current SPI packet, #SFCB_ARB_NONE if no packet */
+    uint8_t             uint8Last;          /**< Last served device, round robin start */
+    uint8_t*            uint8PtrSpi;        /**< SPI exchange buffer, shared by all devices */
+    uint16_t            uint16SpiMax;       /**< Size of #uint8PtrSpi in bytes */
+    uint16_t            uint16SpiLen;       /**< Length of current SPI packet */
+    uint32_t            uint32Ticks;        /**< Arbiter ticks, one tick per #sfcb_arb_worker call */
+    uint32_t            uint32TicksBusy;    /**< Ticks with SPI packet */
+    uint32_t            uint32Bytes;        /**< Transfered SPI bytes */
+    uint32_t            uint32DlMiss;       /**< Jobs finished after their deadline */
+} t_sfcb_arb;
+
+
+
+/**
+ *  @brief init
+ *
+ *  initializes arbiter
+ *
+ *  @param[in,out]  self                handle, #t_sfcb_arb
+ *  @param[in,out]  *dev                pointer to allocated memory for device list, see #t_sfcb_arb_dev
+ *  @param[in]      devLen              number of maximum devices
+ *  @param[in,out]  *spi                shared SPI exchange buffer, at least one page and address and instruction
+ *  @param[in]      spiLen              size of *spi in bytes
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            OKAY
+ *  @retval         #SFCB_E_MEM         devLen reaches #SFCB_ARB_NONE or spi buffer to small
+ *  @since          2026-10-18
+ */
+int sfcb_arb_init (t_sfcb_arb *self, void *dev, uint8_t devLen, void *spi, uint16_t spiLen);
+
+
+
+/**
+ *  @brief add device
+ *
+ *  registers initialized SFCB handle at the arbiter. The handle gets the shared
+ *  SPI exchange buffer assigned. The handle is serviced by #sfcb_arb_worker only,
+ *  do not call #sfcb_worker directly.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb_arb
+ *  @param[in,out]  *sfcb               initialized SFCB handle, #sfcb_init
+ *  @param[in]      prio                priority, higher value is served first
+ *  @param[out]     *devID              device number, selects the chip select of the SPI packet
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            OKAY
+ *  @retval         #SFCB_E_MEM         no free device entry
+ *  @retval         #SFCB_E_WKR_BSY     Arbiter is busy
+ *  @since          2026-10-18
+ */
+int sfcb_arb_add (t_sfcb_arb *self, t_sfcb *sfcb, uint8_t prio, uint8_t *devID);
+
+
+
+/**
+ *  @brief deadline
+ *
+ *  sets deadline for the pending job of a device, ready devices
+ *  with earliest deadline are served first
+ *
+ *  @param[in,out]  self                handle, #t_sfcb_arb
+ *  @param[in]      devID               device number
+ *  @param[in]      ticks               job needs to be finished in this number of arbiter ticks
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            OKAY
+ *  @retval         #SFCB_E_NO_CB_Q     device not present
+ *  @since          2026-10-18
+ */
+int sfcb_arb_deadline (t_sfcb_arb *self, uint8_t devID, uint32_t ticks);
+
+
+
+/**
+ *  @brief mirror
+ *
+ *  pairs two devices with same queue layout to mirror. Elements are
+ *  written to both chips, the page programs overlap in the WIP phase.
+ *  Reads are served by the less loaded chip with the newest element
+ *
+ *  @param[in,out]  self                handle, #t_sfcb_arb
+ *  @param[in]      devA                device number
+ *  @param[in]      devB                device number, mirror of devA
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            OKAY
+ *  @retval         #SFCB_E_NO_CB_Q     device not present, already mirrored or different number of queues
+ *  @since          2026-10-18
+ */
+int sfcb_arb_mirror (t_sfcb_arb *self, uint8_t devA, uint8_t devB);
+
+
+
+/**
+ *  @brief mirror build
+ *
+ *  starts #sfcb_mkcb on both chips of the mirror
+ *
+ *  @param[in,out]  self                handle, #t_sfcb_arb
+ *  @param[in]      devID               device number, one of the mirror
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            Jobs started
+ *  @retval         #SFCB_E_NO_CB_Q     device not mirrored
+ *  @retval         #SFCB_E_WKR_BSY     one chip is busy, no job started
+ *  @since          2026-10-18
+ */
+int sfcb_arb_mirror_mkcb (t_sfcb_arb *self, uint8_t devID);
+
+
+
+/**
+ *  @brief mirror add
+ *
+ *  starts #sfcb_add on both chips of the mirror. The arbiter
+ *  programs the second chip while the first one is in WIP.
+ *  Both chips are checked with #sfcb_add_chk before any of them starts.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb_arb
+ *  @param[in]      devID               device number, one of the mirror
+ *  @param[in]      cbID                circular buffer queue
+ *  @param[in]      *data               payload
+ *  @param[in]      len                 payload length
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            Jobs started
+ *  @retval         #SFCB_E_NO_CB_Q     device not mirrored or queue not present
+ *  @retval         #SFCB_E_WKR_BSY     one chip is busy, no job started
+ *  @retval         #SFCB_E_WKR_REQ     one chip is not prepared, run #sfcb_arb_mirror_mkcb, no job started
+ *  @retval         #SFCB_E_PIN         one chip has erase blocked by pin, no job started
+ *  @retval         #SFCB_E_MEM         payload exceeds element on one chip, no job started
+ *  @retval         #SFCB_E_NOP         SPI NAND: element already programmed on one chip, no job started
+ *  @since          2026-10-18
+ */
+int sfcb_arb_mirror_add (t_sfcb_arb *self, uint8_t devID, uint8_t cbID, void *data, uint16_t len);
+
+
+
+/**
+ *  @brief mirror get last
+ *
+ *  starts #sfcb_get_last on one chip of the mirror. Only chips with
+ *  the newest element ID serve, of these the idle chip with fewer
+ *  SPI packets
+ *
+ *  @param[in,out]  self                handle, #t_sfcb_arb
+ *  @param[in]      devID               device number, one of the mirror
+ *  @param[in]      cbID                circular buffer queue
+ *  @param[out]     *data               payload
+ *  @param[in]      len                 payload length
+ *  @param[out]     *elemID             element ID
+ *  @param[out]     *rdDev              serving device
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            Job started
+ *  @retval         #SFCB_E_NO_CB_Q     device not mirrored or queue not present
+ *  @retval         #SFCB_E_WKR_BSY     chips with newest element are busy
+ *  @retval         #SFCB_E_WKR_REQ     no chip prepared, run #sfcb_arb_mirror_mkcb
+ *  @since          2026-10-18
+ */
+int sfcb_arb_mirror_get_last (t_sfcb_arb *self, uint8_t devID, uint8_t cbID, void *data, uint16_t len, uint32_t *elemID, uint8_t *rdDev);
+
+
+
+/**
+ *  @brief mirror sync
+ *
+ *  compares after #sfcb_arb_mirror_mkcb the newest element ID of both
+ *  copies. An interrupted mirror add leaves one chip behind, the element
+ *  is restored with #sfcb_arb_mirror_get_last and #sfcb_add on _*lagDev_.
+ *  Older elements are not reconciled, a lag above one is rejected.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb_arb
+ *  @param[in]      devID               device number, one of the mirror
+ *  @param[in]      cbID                circular buffer queue
+ *  @param[out]     *lagDev             chip with older copy, #SFCB_ARB_NONE if in sync
+ *  @param[out]     *lagNum             number of elements missing on _*lagDev_
+ *  @return         int                 state
+ *  @retval         #SFCB_OK            Compared
+ *  @retval         #SFCB_E_NO_CB_Q     device not mirrored or queue not present
+ *  @retval         #SFCB_E_WKR_BSY     one chip is busy
+ *  @retval         #SFCB_E_WKR_REQ     one chip is not prepared, run #sfcb_arb_mirror_mkcb
+ *  @retval         #SFCB_E_MIRROR      more than one element missing, rebuild _*lagDev_
+ *  @since          2026-10-18
+ */
+int sfcb_arb_mirror_sync (t_sfcb_arb *self, uint8_t devID, uint8_t cbID, uint8_t *lagDev, uint32_t *lagNum);
+
+
+
+/**
+ *  @brief worker
+ *
+ *  Services all registered devices. Creates at most one SPI packet
+ *  in the shared buffer, #sfcb_arb_spi_len and #sfcb_arb_dev select
+ *  length and device of the packet. A device in write-in-progress
+ *  frees the bus for the other devices.
+ *
+ *  @param[in,out]  self                handle, #t_sfcb_arb
+ *  @return         void
+ *  @since          2026-10-18
+ */
+void sfcb_arb_worker (t_sfcb_arb *self);
+
+
+
+/**
+ *  @brief SPI packet length
+ *
+ *  @param[in,out]  self                handle, #t_sfcb_arb
+ *  @return         uint16_t            length of SPI packet in bytes
+ *  @since          2026-10-18
+ */
+uint16_t sfcb_arb_spi_len (t_sfcb_arb *self);
+
+
+
+/**
+ *  @brief SPI packet device
+ *
+ *  @param[in,out]  self                handle, #t_sfcb_arb
+ *  @return         uint8_t             device number of SPI packet, #SFCB_ARB_NONE if no packet
+ *  @since          2026-10-18
+ */
+uint8_t sfcb_arb_dev (t_sfcb_arb *self);
+
+
+
+/**
+ *  @brief busy
+ *
+ *  checks if any registered device has a pending job. Idle work of
+ *  the devices, see #sfcb_idle_work, is served by further calls of
+ *  #sfcb_arb_worker on a free bus
+ *
+ *  @param[in,out]  self                handle, #t_sfcb_arb
+ *  @return         int                 state
+ *  @retval         0                   All devices idle
+ *  @retval         -1                  At least one device busy
+ *  @since          2026-10-18
+ */
+int sfcb_arb_busy (t_sfcb_arb *self);
+
+
+
+/**
+ *  @brief utilization
+ *
+ *  aggregated bus utilization
+ *
+ *  @param[in,out]  self                handle, #t_sfcb_arb
+ *  @return         uint8_t             ticks with SPI packet in percent of all ticks
+ *  @since          2026-10-18
+ */
+uint8_t sfcb_arb_util (t_sfcb_arb *self);
+
+
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+
+#endif // __SPI_FLASH_CB_ARB_H
@@ -0,0 +1,234 @@
+/***********************************************************************
+ @copyright     : Siemens AG
+ @license       : BSDv3
+ @author        : Andreas Kaeberlein
+ @address       : Clemens-Winkler-Strasse 3, 09116 Chemnitz
+
+ @maintainer    : Andreas Kaeberlein
+ @telephone     : +49 371 4810-2108
+ @email         : andreas.kaeberlein@siemens.com
+
+ @file          : sfcb_bench.c
+ @date          : 2026-10-18
+ @see           : https://github.com/andkae/SPI-Flash-Circular-Buffer
+
+ @brief         : Worker microbenchmark
+                  CPU cost per worker stage, the flash model answers
+                  outside of the timed section as instant transport
+***********************************************************************/
+
+
+
+/** Standard libs **/
+#include <stdio.h>          // f.e. printf
+#include <stdlib.h>         // strtoul, free
+#include <stdint.h>         // defines fixed data types, like int8_t...
+#include <string.h>         // string handling functions
+#include <time.h>           // clock_gettime
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>  // __rdtsc
+#endif
+
+/** User Libs **/
+#include "spi_flash_model/spi_flash_model.h"    // spi flash model
+#include "sfcb_flash_types.h"                   // flash name
+#include "spi_flash_cb.h"
+
+
+
+/** Defines **/
+#define SFCB_BENCH_CMD_NUM      (SFCB_CMD_EXP + 1)      /**< number of worker commands */
+#define SFCB_BENCH_STG_NUM      (SFCB_STG05 + 1)        /**< number of worker stages */
+#define SFCB_BENCH_ELEM_SIZE    (200)                   /**< element payload size */
+#define SFCB_BENCH_ELEMS        (64)                    /**< elements in queue */
+#define SFCB_BENCH_ROUNDS       (1000)                  /**< default rounds, mkcb/add/get */
+#define SFCB_BENCH_CYCLE_OUT    (1000000)               /**< worker calls until job timeout */
+
+
+
+/**
+ *  @brief stage statistic
+ */
+typedef struct t_sfcb_bench
+{
+    uint64_t    uint64Calls;    /**< worker calls in stage */
+    uint64_t    uint64Ticks;    /**< summed time stamp counter ticks */
+    uint64_t    uint64Bytes;    /**< summed SPI bytes handled, larger of response and new packet */
+} t_sfcb_bench;
+
+
+
+/** Globals **/
+uint8_t         g_uint8Spi[266];                                        // SPI packet buffer, page + instruction + address
+t_sfcb_bench    g_bench[SFCB_BENCH_CMD_NUM][SFCB_BENCH_STG_NUM];        // statistic per command and stage
+const char*     g_charCmd[SFCB_BENCH_CMD_NUM] = {"IDLE", "MKCB", "ADD", "GET", "RAW", "VFY", "QE", "RDQ", "BLANK", "EXP"};
+
+
+
+/**
+ *  @brief time stamp
+ *
+ *  time stamp counter on x86, monotonic clock in ns otherwise
+ *
+ *  @return         uint64_t        ticks
+ *  @since          October 18, 2026
+ */
+static inline uint64_t sfcb_bench_ticks (void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+#endif
+}
+
+
+
+/**
+ *  @brief monotonic clock
+ *
+ *  @return         double          time in ns
+ *  @since          October 18, 2026
+ */
+static double sfcb_bench_ns (void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+
+
+/**
+ *  @brief run job
+ *
+ *  times every worker call and assigns it to the command and stage
+ *  active at entry, the flash model answers outside of the measurement
+ *
+ *  @param[in,out]  *sfcb           handle, #t_sfcb
+ *  @param[in,out]  *flash          flash model, #t_sfm
+ *  @param[in]      ovh             timer overhead in ticks
+ *  @return         int             state
+ *  @retval         0               job done
+ *  @retval         -1              flash model error, job error or timeout
+ *  @since          October 18, 2026
+ */
+static int sfcb_bench_run (t_sfcb *sfcb, t_sfm *flash, uint64_t ovh)
+{
+    /** Variables **/
+    uint64_t        uint64Start;
+    uint64_t        uint64Ticks;
+    uint16_t        uint16LenIn;
+    t_sfcb_bench*   ptrBench;
+
+    for ( uint32_t i = 0; i < SFCB_BENCH_CYCLE_OUT; i++ ) {
+        if ( 0 == sfcb_busy(sfcb) ) {
+            return (0 == sfcb_isero(sfcb)) ? 0 : -1;
+        }
+        ptrBench = &g_bench[((unsigned) sfcb->cmd < SFCB_BENCH_CMD_NUM) ? sfcb->cmd : SFCB_CMD_IDLE][((unsigned) sfcb->stage < SFCB_BENCH_STG_NUM) ? sfcb->stage : SFCB_STG00];
+        uint16LenIn = sfcb_spi_len(sfcb);
+        uint64Start = sfcb_bench_ticks();
+        sfcb_worker(sfcb);
+        uint64Ticks = sfcb_bench_ticks() - uint64Start;
+        ptrBench->uint64Calls++;
+        ptrBench->uint64Ticks += (uint64Ticks > ovh) ? (uint64Ticks - ovh) : 0;
+        ptrBench->uint64Bytes += (uint16LenIn > sfcb_spi_len(sfcb)) ? uint16LenIn : sfcb_spi_len(sfcb);
+        if ( 0 != sfm(flash, g_uint8Spi, sfcb_spi_len(sfcb)) ) {
+            printf("ERROR:%s: spi_flash_model, ist=0x%02x\n", __FUNCTION__, g_uint8Spi[0]);
+            return -1;
+        }
+    }
+    printf("ERROR:%s: timeout\n", __FUNCTION__);
+    return -1;
+}
+
+
+
+/**
+ *  Main
+ *  ----
+ */
+int main (int argc, char *argv[])
+{
+    /** Variables **/
+    t_sfcb      sfcb;                           // SPI Flash as circular buffer
+    t_sfcb_cb   sfcb_cb[1];                     // queue management
+    t_sfm       flash;                          // flash content
+    uint8_t     uint8Pl[SFCB_BENCH_ELEM_SIZE];  // element payload
+    uint8_t     uint8CbID;                      // assigned queue id
+    uint32_t    uint32Rounds = SFCB_BENCH_ROUNDS;
+    uint32_t    uint32ElemID;
+    uint64_t    uint64Ovh = UINT64_MAX;         // timer overhead
+    uint64_t    uint64Tick;
+    double      dblNs;
+    double      dblNsTick;                      // ns per tick
+    int         ret = 0;
+
+
+    /* parse arguments */
+    if ( 1 < argc ) {
+        uint32Rounds = (uint32_t) strtoul(argv[1], NULL, 0);
+    }
+    /* timer overhead and tick calibration */
+    for ( uint32_t i = 0; i < 1000; i++ ) {
+        uint64Tick = sfcb_bench_ticks();
+        uint64Tick = sfcb_bench_ticks() - uint64Tick;
+        uint64Ovh = (uint64Tick < uint64Ovh) ? uint64Tick : uint64Ovh;
+    }
+    dblNs = sfcb_bench_ns();
+    uint64Tick = sfcb_bench_ticks();
+    while ( (sfcb_bench_ns() - dblNs) < 1e8 ) {};   // 100ms
+    dblNsTick = (sfcb_bench_ns() - dblNs) / (double) (sfcb_bench_ticks() - uint64Tick);
+    /* prepare */
+    memset(g_bench, 0, sizeof(g_bench));
+    for ( uint16_t i = 0; i < sizeof(uint8Pl); i++ ) {
+        uint8Pl[i] = (uint8_t) i;
+    }
+    if ( 0 != sfm_init(&flash, SFCB_FLASH_NAME) ) {
+        printf("ERROR:%s:sfm_init\n", __FUNCTION__);
+        return EXIT_FAILURE;
+    }
+    sfcb_init(&sfcb, &sfcb_cb, 1, &g_uint8Spi, sizeof(g_uint8Spi)/sizeof(g_uint8Spi[0]));
+    if ( 0 != sfcb_new_cb(&sfcb, 0x47114711, SFCB_BENCH_ELEM_SIZE, SFCB_BENCH_ELEMS, &uint8CbID) ) {
+        printf("ERROR:%s:sfcb_new_cb\n", __FUNCTION__);
+        free(flash.uint8PtrMem);
+        return EXIT_FAILURE;
+    }
+    /* rounds: mount, append element, read back */
+    for ( uint32_t i = 0; (i < uint32Rounds) && (0 == ret); i++ ) {
+        ret |= sfcb_mkcb(&sfcb);
+        ret |= sfcb_bench_run(&sfcb, &flash, uint64Ovh);
+        ret |= sfcb_add(&sfcb, uint8CbID, uint8Pl, sizeof(uint8Pl));
+        ret |= sfcb_bench_run(&sfcb, &flash, uint64Ovh);
+        ret |= sfcb_mkcb(&sfcb);
+        ret |= sfcb_bench_run(&sfcb, &flash, uint64Ovh);
+        ret |= sfcb_get_last(&sfcb, uint8CbID, uint8Pl, sizeof(uint8Pl), &uint32ElemID);
+        ret |= sfcb_bench_run(&sfcb, &flash, uint64Ovh);
+    }
+    free(flash.uint8PtrMem);
+    if ( 0 != ret ) {
+        printf("ERROR:%s: job failed\n", __FUNCTION__);
+        return EXIT_FAILURE;
+    }
+    /* report */
+    printf("Flash '%s', SPI buffer %d byte, %d rounds, %.3f ns/tick, timer overhead %d ticks\n", SFCB_FLASH_NAME, (int) sizeof(g_uint8Spi), uint32Rounds, dblNsTick, (int) uint64Ovh);
+    printf("%-6s %-5s %12s %10s %10s %10s\n", "cmd", "stage", "calls", "ticks/call", "ns/call", "ns/byte");
+    for ( uint8_t i = 0; i < SFCB_BENCH_CMD_NUM; i++ ) {
+        for ( uint8_t j = 0; j < SFCB_BENCH_STG_NUM; j++ ) {
+            if ( 0 == g_bench[i][j].uint64Calls ) {
+                continue;
+            }
+            printf  (  "%-6s STG%02d %12llu %10.1f %10.1f %10.3f\n",
+                       g_charCmd[i],
+                       j,
+                       (unsigned long long) g_bench[i][j].uint64Calls,
+                       (double) g_bench[i][j].uint64Ticks / (double) g_bench[i][j].uint64Calls,
+                       (double) g_bench[i][j].uint64Ticks * dblNsTick / (double) g_bench[i][j].uint64Calls,
+                       (0 == g_bench[i][j].uint64Bytes) ? 0.0 : (double) g_bench[i][j].uint64Ticks * dblNsTick / (double) g_bench[i][j].uint64Bytes
+                    );
+        }
+    }
+    return EXIT_SUCCESS;
+}
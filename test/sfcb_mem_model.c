@@ -0,0 +1,450 @@
+/***********************************************************************
+ @copyright     : Siemens AG
+ @license       : BSDv3
+ @author        : Andreas Kaeberlein
+ @address       : Clemens-Winkler-Strasse 3, 09116 Chemnitz
+
+ @maintainer    : Andreas Kaeberlein
+ @telephone     : +49 371 4810-2108
+ @email         : andreas.kaeberlein@siemens.com
+
+ @file          : sfcb_mem_model.c
+ @date          : 2026-10-18
+ @see           : https://github.com/andkae/SPI-Flash-Circular-Buffer
+
+ @brief         : SPI memory model
+                  FRAM and SPI NAND memory model for flash types not
+                  covered by spi_flash_model, same interface
+***********************************************************************/
+
+
+
+/** Standard libs **/
+#include <stdio.h>          // f.e. printf
+#include <stdlib.h>         // malloc, free
+#include <stdint.h>         // defines fixed data types, like int8_t...
+#include <string.h>         // memset, memcpy
+
+/** User Libs **/
+#include "sfcb_mem_model.h" // function prototypes
+
+
+
+/** FM25V20A **/
+#define SFM_FRAM_SIZE       262144  // FM25V20A_Rev_L: p.1, 256K x 8
+#define SFM_FRAM_ADR_BYTE   3       // FM25V20A_Rev_L: p.8, Memory Operation
+#define SFM_FRAM_WEL_MSK    0x02    // FM25V20A_Rev_L: p.7, Write Enable Latch (WEL)
+static const uint8_t g_uint8FramId[] = {0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0xc2, 0x25, 0x08};    // FM25V20A_Rev_L: p.9, Read Device ID
+
+/** W25N01GV **/
+#define SFM_NAND_SIZE       134217728   // W25N01GV_Rev_L: p.8, 1024 blocks
+#define SFM_NAND_PAGE       2048        // W25N01GV_Rev_L: p.8, 2048 byte data buffer, spare area not modelled
+#define SFM_NAND_BLK_PAGES  64          // W25N01GV_Rev_L: p.8, 64 pages per block
+#define SFM_NAND_ECC_SEC    512         // W25N01GV_Rev_L: p.13, ECC protected sector of the main array
+#define SFM_NAND_SR3        0xc0        // W25N01GV_Rev_L: p.18, Status Register-3
+#define SFM_NAND_BUSY_MSK   0x01        // W25N01GV_Rev_L: p.20, Operation In Progress (BUSY)
+#define SFM_NAND_WEL_MSK    0x02        // W25N01GV_Rev_L: p.20, Write Enable Latch (WEL)
+#define SFM_NAND_BUSY_RDS   2           // status register reads until array operation is done
+static const uint8_t g_uint8NandId[] = {0xef, 0xaa, 0x21};  // W25N01GV_Rev_L: p.27, JEDEC ID (9Fh)
+
+
+
+/**
+ *  @brief address
+ *
+ *  extracts address from SPI packet, highest byte first
+ *
+ *  @param[in]      *spi            address bytes
+ *  @param[in]      adrBytes        number of address bytes
+ *  @return         uint32_t        address
+ *  @since          October 18, 2026
+ */
+static uint32_t sfm_adr (const uint8_t *spi, uint8_t adrBytes)
+{
+    /** Variables **/
+    uint32_t    adr = 0;
+
+    for ( uint8_t i = 0; i < adrBytes; i++ ) {
+        adr = (adr << 8) | spi[i];
+    }
+    return adr;
+}
+
+
+
+/**
+ *  @brief NAND bad block
+ *
+ *  checks if page is located in a bad block
+ *
+ *  @param[in]      self            handle, #t_sfm
+ *  @param[in]      page            page address
+ *  @return         int             state
+ *  @retval         0               good block
+ *  @retval         1               bad block
+ *  @since          October 18, 2026
+ */
+static int sfm_nand_bad (t_sfm *self, uint32_t page)
+{
+    for ( uint16_t i = 0; i < self->uint16BadLen; i++ ) {
+        if ( (self->ptrBad)[i] == page / SFM_NAND_BLK_PAGES ) {
+            printf("ERROR:sfm: access to bad block %d\n", (self->ptrBad)[i]);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+
+
+/**
+ *  @brief NAND
+ *
+ *  processes one SPI packet of the SPI NAND, array is accessed via page buffer
+ *
+ *  @param[in,out]  self            handle, #t_sfm
+ *  @param[in,out]  *spi            SPI packet, response is written into
+ *  @param[in]      len             packet length in bytes
+ *  @return         int             state
+ *  @retval         0               OK
+ *  @retval         <0              protocol violation
+ *  @since          October 18, 2026
+ */
+static int sfm_nand (t_sfm *self, uint8_t *spi, uint32_t len)
+{
+    /** Variables **/
+    uint32_t    uint32Adr;  // page or column address
+
+    /* array operation in progress, only status register is accessible */
+    if ( (0 != self->uint8Busy) && (0x0f != spi[0]) && (0x05 != spi[0]) ) {
+        printf("ERROR:%s: instruction 0x%02x while busy\n", __FUNCTION__, spi[0]);
+        return -2;
+    }
+    switch ( spi[0] ) {
+        /* write enable */
+        case 0x06:
+            self->uint8Wel = 1;
+            return 0;
+        /* write disable */
+        case 0x04:
+            self->uint8Wel = 0;
+            return 0;
+        /* status register, only SR3 with busy and write enable latch modelled */
+        case 0x0f:
+        case 0x05:
+            if ( len < 3 ) {
+                return -4;
+            }
+            spi[2] = 0;
+            if ( SFM_NAND_SR3 == spi[1] ) {
+                spi[2] = (uint8_t) (((0 != self->uint8Busy) ? SFM_NAND_BUSY_MSK : 0) | ((0 != self->uint8Wel) ? SFM_NAND_WEL_MSK : 0));
+                if ( 0 != self->uint8Busy ) {
+                    (self->uint8Busy)--;
+                }
+            }
+            return 0;
+        /* device ID, one dummy byte */
+        case 0x9f:
+            for ( uint32_t i = 2; i < len; i++ ) {
+                spi[i] = (i-2 < sizeof(g_uint8NandId)) ? g_uint8NandId[i-2] : 0;
+            }
+            return 0;
+        /* page data read, array to buffer */
+        case 0x13:
+            if ( 4 != len ) {
+                return -4;
+            }
+            uint32Adr = sfm_adr(spi+2, 2);  // +2: IST + dummy
+            if ( 0 != sfm_nand_bad(self, uint32Adr) ) {
+                return -7;
+            }
+            memcpy(self->uint8PtrBuf, self->uint8PtrMem+uint32Adr*SFM_NAND_PAGE, SFM_NAND_PAGE);
+            self->uint8Busy = SFM_NAND_BUSY_RDS;
+            return 0;
+        /* read from buffer, column address and one dummy byte */
+        case 0x03:
+            if ( len < 4 ) {
+                return -4;
+            }
+            uint32Adr = sfm_adr(spi+1, 2);
+            if ( uint32Adr + (len - 4) > SFM_NAND_PAGE ) {
+                return -5;
+            }
+            memcpy(spi+4, self->uint8PtrBuf+uint32Adr, len - 4);
+            return 0;
+        /* load program data, buffer is reset; random load keeps buffer */
+        case 0x02:
+        case 0x84:
+            if ( 0 == self->uint8Wel ) {
+                return -3;
+            }
+            if ( len < 3 ) {
+                return -4;
+            }
+            uint32Adr = sfm_adr(spi+1, 2);
+            if ( uint32Adr + (len - 3) > SFM_NAND_PAGE ) {
+                return -5;
+            }
+            if ( 0x02 == spi[0] ) {
+                memset(self->uint8PtrBuf, 0xff, SFM_NAND_PAGE);
+                self->uint8EccLd = 0;
+            }
+            memcpy(self->uint8PtrBuf+uint32Adr, spi+3, len - 3);
+            for ( uint32_t i = uint32Adr / SFM_NAND_ECC_SEC; (len > 3) && (i <= (uint32Adr + len - 4) / SFM_NAND_ECC_SEC); i++ ) {
+                self->uint8EccLd = (uint8_t) (self->uint8EccLd | (1 << i));
+            }
+            return 0;
+        /* program execute, buffer to array, ECC enabled: every ECC sector is programmed once */
+        case 0x10:
+            if ( 0 == self->uint8Wel ) {
+                return -3;
+            }
+            if ( 4 != len ) {
+                return -4;
+            }
+            uint32Adr = sfm_adr(spi+2, 2);
+            if ( 0 != sfm_nand_bad(self, uint32Adr) ) {
+                return -7;
+            }
+            if ( 0 != (self->uint8EccLd & self->uint8PtrEcc[uint32Adr]) ) {
+                printf("ERROR:%s: page 0x%x ECC sector mask 0x%x programmed twice\n", __FUNCTION__, uint32Adr, self->uint8EccLd & self->uint8PtrEcc[uint32Adr]);
+                return -8;
+            }
+            self->uint8PtrEcc[uint32Adr] = (uint8_t) (self->uint8PtrEcc[uint32Adr] | self->uint8EccLd);
+            (self->uint32Prgs)++;
+            for ( uint32_t i = 0; i < SFM_NAND_PAGE; i++ ) {
+                self->uint8PtrMem[uint32Adr*SFM_NAND_PAGE+i] &= self->uint8PtrBuf[i];   // program only clears bits
+            }
+            self->uint8Wel = 0;
+            self->uint8Busy = SFM_NAND_BUSY_RDS;
+            return 0;
+        /* 128KB block erase */
+        case 0xd8:
+            if ( 0 == self->uint8Wel ) {
+                return -3;
+            }
+            if ( 4 != len ) {
+                return -4;
+            }
+            uint32Adr = sfm_adr(spi+2, 2);
+            uint32Adr = uint32Adr - (uint32Adr % SFM_NAND_BLK_PAGES);
+            if ( 0 != sfm_nand_bad(self, uint32Adr) ) {
+                return -7;
+            }
+            memset(self->uint8PtrMem+uint32Adr*SFM_NAND_PAGE, 0xff, SFM_NAND_BLK_PAGES*SFM_NAND_PAGE);
+            memset(self->uint8PtrEcc+uint32Adr, 0, SFM_NAND_BLK_PAGES);
+            self->uint8Wel = 0;
+            self->uint8Busy = SFM_NAND_BUSY_RDS;
+            return 0;
+        /* unknown instruction */
+        default:
+            printf("ERROR:%s: unsupported instruction 0x%02x\n", __FUNCTION__, spi[0]);
+            return -9;
+    }
+}
+
+
+
+/**
+ *  sfm_init
+ *    allocates memory array and inits model
+ */
+int sfm_init (t_sfm *self, char *flash)
+{
+    /* supported memory */
+    if ( 0 == strcmp(flash, "FM25V20A") ) {
+        self->uint32Size = SFM_FRAM_SIZE;
+        self->uint8Nand = 0;
+    } else if ( 0 == strcmp(flash, "W25N01GV") ) {
+        self->uint32Size = SFM_NAND_SIZE;
+        self->uint8Nand = 1;
+    } else {
+        printf("ERROR:%s: memory '%s' not supported\n", __FUNCTION__, flash);
+        return -1;
+    }
+    /* memory array, NAND: page buffer and programmed ECC sectors behind */
+    self->uint8PtrMem = malloc(self->uint32Size + ((0 != self->uint8Nand) ? (SFM_NAND_PAGE + SFM_NAND_SIZE/SFM_NAND_PAGE) : 0));
+    if ( NULL == self->uint8PtrMem ) {
+        return -1;
+    }
+    memset(self->uint8PtrMem, 0xff, self->uint32Size);  // FRAM: no erased state, f.e. fresh device; NAND: erased
+    self->uint8PtrBuf = NULL;
+    self->uint8PtrEcc = NULL;
+    self->uint8EccLd = 0;
+    if ( 0 != self->uint8Nand ) {
+        self->uint8PtrBuf = self->uint8PtrMem + self->uint32Size;
+        self->uint8PtrEcc = self->uint8PtrBuf + SFM_NAND_PAGE;
+        memset(self->uint8PtrBuf, 0xff, SFM_NAND_PAGE);
+        memset(self->uint8PtrEcc, 0, SFM_NAND_SIZE/SFM_NAND_PAGE);
+    }
+    self->ptrBad = NULL;
+    self->uint16BadLen = 0;
+    self->uint32Prgs = 0;
+    self->uint8Wel = 0;
+    self->uint8Busy = 0;    // no write cycle time
+    self->uint8Dpd = 0;
+    self->uint8Sr2 = 0;
+    self->uint32Cmds = 0;
+    return 0;
+}
+
+
+
+/**
+ *  sfm
+ *    processes one SPI packet
+ */
+int sfm (t_sfm *self, uint8_t *spi, uint32_t len)
+{
+    /** Variables **/
+    uint32_t    uint32Adr;  // memory address
+
+    /* no packet */
+    if ( 0 == len ) {
+        return 0;
+    }
+    (self->uint32Cmds)++;
+    /* SPI NAND */
+    if ( 0 != self->uint8Nand ) {
+        return sfm_nand(self, spi, len);
+    }
+    /* sleep mode, chip select wakes up, opcode is ignored */
+    if ( 0 != self->uint8Dpd ) {
+        self->uint8Dpd = 0;
+        return 0;
+    }
+    /* process instruction */
+    switch ( spi[0] ) {
+        /* write enable */
+        case 0x06:
+            self->uint8Wel = 1;
+            return 0;
+        /* write disable */
+        case 0x04:
+            self->uint8Wel = 0;
+            return 0;
+        /* status register, no write in progress */
+        case 0x05:
+            for ( uint32_t i = 1; i < len; i++ ) {
+                spi[i] = (uint8_t) ((0 != self->uint8Wel) ? SFM_FRAM_WEL_MSK : 0);
+            }
+            return 0;
+        /* device ID */
+        case 0x9f:
+            for ( uint32_t i = 1; i < len; i++ ) {
+                spi[i] = (i-1 < sizeof(g_uint8FramId)) ? g_uint8FramId[i-1] : 0;
+            }
+            return 0;
+        /* sleep */
+        case 0xb9:
+            self->uint8Dpd = 1;
+            return 0;
+        /* read */
+        case 0x03:
+            if ( len < 1 + SFM_FRAM_ADR_BYTE ) {
+                return -4;  // incomplete address
+            }
+            uint32Adr = sfm_adr(spi+1, SFM_FRAM_ADR_BYTE);
+            if ( uint32Adr + (len - 1 - SFM_FRAM_ADR_BYTE) > self->uint32Size ) {
+                return -5;  // exceeds memory
+            }
+            memcpy(spi+1+SFM_FRAM_ADR_BYTE, self->uint8PtrMem+uint32Adr, len - 1 - SFM_FRAM_ADR_BYTE);
+            return 0;
+        /* write, byte granular overwrite */
+        case 0x02:
+            if ( 0 == self->uint8Wel ) {
+                return -3;  // write not enabled
+            }
+            if ( len < 1 + SFM_FRAM_ADR_BYTE ) {
+                return -4;
+            }
+            uint32Adr = sfm_adr(spi+1, SFM_FRAM_ADR_BYTE);
+            if ( uint32Adr + (len - 1 - SFM_FRAM_ADR_BYTE) > self->uint32Size ) {
+                return -5;
+            }
+            memcpy(self->uint8PtrMem+uint32Adr, spi+1+SFM_FRAM_ADR_BYTE, len - 1 - SFM_FRAM_ADR_BYTE);
+            self->uint8Wel = 0; // FM25V20A_Rev_L: p.8, WEL cleared with chip select rise
+            return 0;
+        /* unknown instruction */
+        default:
+            printf("ERROR:%s: unsupported instruction 0x%02x\n", __FUNCTION__, spi[0]);
+            return -9;
+    }
+}
+
+
+
+/**
+ *  sfm_dump
+ *    prints memory segment as ascii hex
+ */
+int sfm_dump (t_sfm *self, int32_t start, int32_t stop)
+{
+    for ( int32_t i = start; i < stop; i += 16 ) {
+        printf("  %08x:", i);
+        for ( int32_t j = i; (j < i+16) && (j < stop); j++ ) {
+            printf(" %02x", self->uint8PtrMem[j]);
+        }
+        printf("\n");
+    }
+    return 0;
+}
+
+
+
+/**
+ *  sfm_store
+ *    writes memory array as binary image
+ */
+int sfm_store (t_sfm *self, char *path)
+{
+    /** Variables **/
+    FILE    *fp;
+    int     ret = 0;
+
+    if ( NULL == self->uint8PtrMem ) {
+        return -1;
+    }
+    fp = fopen(path, "wb");
+    if ( NULL == fp ) {
+        return -1;
+    }
+    if ( self->uint32Size != fwrite(self->uint8PtrMem, 1, self->uint32Size, fp) ) {
+        ret = -1;
+    }
+    fclose(fp);
+    return ret;
+}
+
+
+
+/**
+ *  sfm_cmp
+ *    compares memory array with binary image
+ */
+int sfm_cmp (t_sfm *self, char *path)
+{
+    /** Variables **/
+    FILE        *fp;
+    uint8_t     uint8Buf[256];
+    size_t      len;
+    uint32_t    uint32Adr = 0;
+    int         ret = 0;
+
+    fp = fopen(path, "rb");
+    if ( NULL == fp ) {
+        return -1;
+    }
+    while ( 0 != (len = fread(uint8Buf, 1, sizeof(uint8Buf), fp)) ) {
+        if ( (uint32Adr + len > self->uint32Size) || (0 != memcmp(uint8Buf, self->uint8PtrMem+uint32Adr, len)) ) {
+            ret = -1;
+            break;
+        }
+        uint32Adr += (uint32_t) len;
+    }
+    if ( uint32Adr != self->uint32Size ) {
+        ret = -1;
+    }
+    fclose(fp);
+    return ret;
+}
@@ -0,0 +1,140 @@
+/***********************************************************************
+ @copyright     : Siemens AG
+ @license       : BSDv3
+ @author        : Andreas Kaeberlein
+ @address       : Clemens-Winkler-Strasse 3, 09116 Chemnitz
+
+ @maintainer    : Andreas Kaeberlein
+ @telephone     : +49 371 4810-2108
+ @email         : andreas.kaeberlein@siemens.com
+
+ @file          : sfcb_mem_model.h
+ @date          : 2026-10-18
+ @see           : https://github.com/andkae/SPI-Flash-Circular-Buffer
+
+ @brief         : SPI memory model
+                  FRAM and SPI NAND memory model for flash types not
+                  covered by spi_flash_model, same interface
+***********************************************************************/
+
+
+
+// Define Guard
+#ifndef __SFCB_MEM_MODEL_H
+#define __SFCB_MEM_MODEL_H
+
+
+
+/** Standard libs **/
+#include <stdint.h>     // defines fixed data types, like int8_t...
+
+
+
+/**
+ *  @typedef t_sfm
+ *
+ *  @brief  memory model handle
+ *
+ *  handle of the memory model, members in front are the same like in
+ *  spi_flash_model. NAND members are allocated with the memory array
+ *
+ *  @since  2026-10-18
+ */
+typedef struct t_sfm
+{
+    uint8_t*    uint8PtrMem;    /**< Memory array */
+    uint32_t    uint32Size;     /**< Memory size in bytes */
+    uint8_t     uint8Wel;       /**< Write enable latch */
+    uint8_t     uint8Busy;      /**< Busy, number of status register reads until ready */
+    uint8_t     uint8Dpd;       /**< Sleep mode */
+    uint8_t     uint8Sr2;       /**< Status register 2, not available */
+    uint32_t    uint32Cmds;     /**< Number of SPI packets */
+    uint8_t     uint8Nand;      /**< NAND, page buffer access with program load/execute */
+    uint8_t*    uint8PtrBuf;    /**< NAND: Page buffer */
+    uint8_t*    uint8PtrEcc;    /**< NAND: Programmed ECC sectors per page since erase, bit mask */
+    uint8_t     uint8EccLd;     /**< NAND: ECC sectors loaded into page buffer, bit mask */
+    const uint16_t* ptrBad;     /**< NAND: Bad blocks, access is rejected, set after #sfm_init */
+    uint16_t    uint16BadLen;   /**< NAND: Number of bad blocks in #ptrBad */
+    uint32_t    uint32Prgs;     /**< NAND: Number of program executes */
+} t_sfm;
+
+
+
+/**
+ *  @brief init
+ *
+ *  allocates memory array and inits model
+ *
+ *  @param[in,out]  self            handle, #t_sfm
+ *  @param[in]      *flash          memory name, "FM25V20A" or "W25N01GV"
+ *  @return         int             state
+ *  @retval         0               OK
+ *  @retval         -1              unsupported memory or no memory
+ *  @since          2026-10-18
+ */
+int sfm_init (t_sfm *self, char *flash);
+
+
+/**
+ *  @brief SPI packet
+ *
+ *  processes one SPI packet, chip select is active for the whole packet
+ *
+ *  @param[in,out]  self            handle, #t_sfm
+ *  @param[in,out]  *spi            SPI packet, response is written into
+ *  @param[in]      len             packet length in bytes
+ *  @return         int             state
+ *  @retval         0               OK
+ *  @retval         <0              protocol violation, f.e. write without write enable
+ *  @since          2026-10-18
+ */
+int sfm (t_sfm *self, uint8_t *spi, uint32_t len);
+
+
+/**
+ *  @brief dump
+ *
+ *  prints memory segment as ascii hex
+ *
+ *  @param[in,out]  self            handle, #t_sfm
+ *  @param[in]      start           start address
+ *  @param[in]      stop            stop address
+ *  @return         int             state
+ *  @retval         0               OK
+ *  @since          2026-10-18
+ */
+int sfm_dump (t_sfm *self, int32_t start, int32_t stop);
+
+
+/**
+ *  @brief store
+ *
+ *  writes memory array as binary image to file
+ *
+ *  @param[in,out]  self            handle, #t_sfm
+ *  @param[in]      *path           file path
+ *  @return         int             state
+ *  @retval         0               OK
+ *  @retval         -1              no memory allocated or file error
+ *  @since          2026-10-18
+ */
+int sfm_store (t_sfm *self, char *path);
+
+
+/**
+ *  @brief compare
+ *
+ *  compares memory array with binary image, see #sfm_store
+ *
+ *  @param[in,out]  self            handle, #t_sfm
+ *  @param[in]      *path           file path
+ *  @return         int             state
+ *  @retval         0               equal
+ *  @retval         -1              different or file error
+ *  @since          2026-10-18
+ */
+int sfm_cmp (t_sfm *self, char *path);
+
+
+
+#endif // __SFCB_MEM_MODEL_H
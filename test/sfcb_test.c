@@ -30,17 +30,55 @@
 #include <ctype.h>          // used for testing and mapping characters
 
 /** User Libs **/
-#include "spi_flash_model/spi_flash_model.h"    // spi flash model
+#include "sfcb_flash_types.h"                   // flash topology
+#if defined(SFCB_FLASH_TYPE_NOERASE) || defined(SFCB_FLASH_TYPE_NAND)
+    #include "sfcb_mem_model.h"                 // FRAM/NAND model, interface of spi flash model
+#else
+    #include "spi_flash_model/spi_flash_model.h"    // spi flash model
+#endif
 #include "spi_flash_cb.h"
+#include "spi_flash_cb_arb.h"                   // bus arbiter
+#include "tools/sfcb_trace.h"                   // SPI transaction recorder
 
 
 
 /** Globals **/
+#if defined(SFCB_FLASH_TYPE_NAND)
+const uint32_t  g_uint32SpiFlashCycleOut    = 100000;  // abort calling SPI flash, NAND read is page read, poll and buffer read
+#else
 const uint32_t  g_uint32SpiFlashCycleOut    = 1000;    // abort calling SPI flash
+#endif
 const uint16_t  g_uint16CbQ0Size            = 256 - 2*sizeof(spi_flash_cb_elem_head);   // CB Q0 Payload size
 const uint16_t  g_uint16CbQ0_elems          = 32;                                       // max elements in CB0
 const uint16_t  g_uint16CbQ1Size = 16384 - 2*sizeof(spi_flash_cb_elem_head);    // CB Q1 Payload size
-uint8_t         g_uint8Spi[266];    // SPI packet buffer
+uint8_t         g_uint8Spi[SFCB_FLASH_TOPO_PAGE_SIZE+10];   // SPI packet buffer, page program
+t_sfcb_trace    g_trace;            // SPI transaction trace
+uint8_t         g_uint8TraceEna = 0;    // record SPI transactions
+uint32_t        g_uint32SpiPkts = 0;    // number of SPI packets exchanged with flash model
+#if defined(SFCB_FLASH_TYPE_NAND)
+const uint16_t  g_uint16NandBad[]   = {1, 4};   // bad blocks, skipped by queues, rejected by model
+#endif
+
+
+
+/** Test fixture **/
+#define TEST_FIX_FLASH  0x01    // new erased flash model, otherwise flash content is kept like on reset
+#define TEST_FIX_MKCB   0x02    // build management data from flash
+
+
+
+/**
+ *  @brief test queue
+ *
+ *  queue of a test fixture, see #run_sfcb_setup
+ */
+typedef struct t_test_q
+{
+    uint32_t    uint32Magic;    // queue magic number
+    uint16_t    uint16PlSize;   // payload size
+    uint16_t    uint16NumElems; // number of elements
+    t_sfcb_fmt  fmt;            // element format
+} t_test_q;
 
 
 
@@ -141,6 +179,27 @@ static void print_raw_sfcb_cb (void* sfcb_cb, uint8_t num_sfcb_cb )
 
 
 
+/**
+ *  @brief run_sfcb_new_cbs
+ *
+ *  creates the circular buffer queues of the module test
+ *
+ *  @param[in,out]  sfcb                spi flash circular buffer handle, #t_sfcb
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void run_sfcb_new_cbs (t_sfcb* sfcb)
+{
+    /** Variables **/
+    uint8_t     uint8Temp;  // help variable
+
+    /* create queues */
+    sfcb_new_cb (sfcb, 0x47114711, g_uint16CbQ0Size, g_uint16CbQ0_elems, &uint8Temp);  // start-up counter with operation
+    sfcb_new_cb (sfcb, 0x08150815, g_uint16CbQ1Size, 16, &uint8Temp);  // error data collection 12KiB
+}
+
+
+
 /**
  *  @brief run_sfm_update
  *
@@ -167,8 +226,19 @@ static int run_sfm_update (t_sfm* flash, t_sfcb* sfcb)
     while ( (0 != sfcb_busy(sfcb)) && ((uint32Counter++) < g_uint32SpiFlashCycleOut) ) {
         /* SFCB Worker */
         sfcb_worker (sfcb);
+        /* record request */
+        if ( 0 != g_uint8TraceEna ) {
+            sfcb_trace_rec(&g_trace, SFCB_TRACE_MOSI, g_uint8Spi, sfcb_spi_len(sfcb));
+        }
         /* interact SPI Flash Model */
+        if ( 0 != sfcb_spi_len(sfcb) ) {
+            g_uint32SpiPkts++;
+        }
         sfm_state = sfm(flash, (uint8_t*) &g_uint8Spi, sfcb_spi_len(sfcb));
+        /* record response */
+        if ( 0 != g_uint8TraceEna ) {
+            sfcb_trace_rec(&g_trace, SFCB_TRACE_MISO, g_uint8Spi, sfcb_spi_len(sfcb));
+        }
         if ( 0 != sfm_state ) {
             printf("ERROR:%s:spi_flash_model ero=%d\n", __FUNCTION__, sfm_state);
             /* print spi packet */
@@ -190,6 +260,72 @@ static int run_sfm_update (t_sfm* flash, t_sfcb* sfcb)
 
 
 
+/**
+ *  @brief run_sfcb_setup
+ *
+ *  test fixture, inits handle with queues. Without #TEST_FIX_FLASH the flash
+ *  content is kept and the queue table is messed up before init, like a reset.
+ *  The flash model is released by the caller, also on error.
+ *
+ *  @param[in,out]  flash               spi flash model handle, #t_sfm
+ *  @param[in,out]  sfcb                spi flash circular buffer handle, #t_sfcb
+ *  @param[in,out]  sfcb_cb             queue table
+ *  @param[in]      cbLen               number of entries in sfcb_cb
+ *  @param[in]      q                   queues, #t_test_q
+ *  @param[in]      qLen                number of queues in q
+ *  @param[in]      flags               #TEST_FIX_FLASH, #TEST_FIX_MKCB
+ *  @return         int                 test state
+ *  @retval         0                   Success
+ *  @retval         -1                  Fail
+ *  @since          October 18, 2026
+ */
+static int run_sfcb_setup (t_sfm* flash, t_sfcb* sfcb, t_sfcb_cb* sfcb_cb, uint8_t cbLen, const t_test_q* q, uint8_t qLen, uint8_t flags)
+{
+    /** Variables **/
+    uint8_t     uint8Temp;  // help variable
+
+    /* entry message */
+    printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* new flash */
+    if ( 0 != (flags & TEST_FIX_FLASH) ) {
+        flash->uint8PtrMem = NULL;  // caller frees
+        if ( 0 != sfm_init(flash, SFCB_FLASH_NAME) ) {
+            printf("ERROR:%s:sfm_init\n", __FUNCTION__);
+            return -1;
+        }
+#if defined(SFCB_FLASH_TYPE_NAND)
+        flash->ptrBad = g_uint16NandBad;
+        flash->uint16BadLen = sizeof(g_uint16NandBad)/sizeof(g_uint16NandBad[0]);
+#endif
+    }
+    /* queues */
+    memset(sfcb_cb, 0xaf, cbLen*sizeof(t_sfcb_cb));
+    sfcb_init(sfcb, sfcb_cb, cbLen, &g_uint8Spi, sizeof(g_uint8Spi)/sizeof(g_uint8Spi[0]));
+#if defined(SFCB_FLASH_TYPE_NAND)
+    if ( 0 != sfcb_nand_bbt(sfcb, g_uint16NandBad, sizeof(g_uint16NandBad)/sizeof(g_uint16NandBad[0])) ) {
+        printf("ERROR:%s:sfcb_nand_bbt\n", __FUNCTION__);
+        return -1;
+    }
+#endif
+    for ( uint8_t i = 0; i < qLen; i++ ) {
+        if ( 0 != sfcb_new_cb_fmt(sfcb, q[i].uint32Magic, q[i].uint16PlSize, q[i].uint16NumElems, q[i].fmt, &uint8Temp) ) {
+            printf("ERROR:%s:sfcb_new_cb_fmt: q%d\n", __FUNCTION__, i);
+            return -1;
+        }
+    }
+    /* management data */
+    if ( 0 != (flags & TEST_FIX_MKCB) ) {
+        if ( (0 != sfcb_mkcb(sfcb)) || (0 != run_sfm_update(flash, sfcb)) ) {
+            printf("ERROR:%s:sfcb_mkcb\n", __FUNCTION__);
+            return -1;
+        }
+    }
+    /* all done */
+    return 0;
+}
+
+
+
 /**
  *  @brief run_sfcb_add
  *
@@ -551,187 +687,2722 @@ static int test_add_append (t_sfm* flash, t_sfcb* sfcb, uint8_t qNum, uint16_t q
 
 
 
-
 /**
- *  Main
- *  ----
+ *  @brief test_add_resume
+ *
+ *  writes first part of payload into queue element, simulates reset
+ *  by init of SFCB management data, rebuilds queue and completes element
+ *
+ *  @param[in,out]  flash               spi flash model handle, #t_sfm
+ *  @param[in,out]  sfcb                spi flash circular buffer handle, #t_sfcb
+ *  @param[in,out]  sfcb_cb             circular buffer queue management table
+ *  @param[in]      cbLen               number of entries in sfcb_cb
+ *  @param[in]      qNum                number of tested circular buffer queue
+ *  @param[in]      qSize               test data size for selected circular buffer queue
+ *  @param[in,out]  *elemID             queue element id of read queue element
+ *  @return         int                 test state
+ *  @retval         0                   Success
+ *  @retval         -1                  Fail
+ *  @since          October 18, 2026
  */
-int main ()
+static int test_add_resume (t_sfm* flash, t_sfcb* sfcb, t_sfcb_cb* sfcb_cb, uint8_t cbLen, uint8_t qNum, uint16_t qSize, uint32_t *elemID)
 {
     /** Variables **/
-    t_sfm           spiFlash;                           // SPI flash model
-    t_sfcb          sfcb;                               // SPI Flash as circular buffer
-    t_sfcb_cb       sfcb_cb[5];                         // five logical parts in SPI Flash
-    uint8_t         uint8Temp;                          // help variable
-    uint8_t         uint8FlashData[] = {0,1,2,3,4,5};   // SPI test data
-    uint8_t         uint8Buf[1024];                     // help buffer
-    uint32_t        uint32Temp;                         // help variable
-
+    uint8_t*    uint8PtrDat1 = NULL;    // temporary data buffer
+    uint8_t*    uint8PtrDat2 = NULL;    // temporary data buffer
+    uint16_t    uint16Part = qSize / 3; // bytes written before reset
+    uint32_t    uint32IdMax;            // highest id before reset
+    int         ret = -1;
 
     /* entry message */
-    printf("INFO:%s: unit test started\n", __FUNCTION__);
-
-
-    /* init flash model */
-    printf("INFO:%s: Init Flash model W25Q16JV\n", __FUNCTION__);
-    if ( 0 != sfm_init( &spiFlash, "W25Q16JV" ) ) {
-        printf("ERROR:%s:sfm_init\n", __FUNCTION__);
-        goto ERO_END;
+    printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* prepare data set */
+    uint8PtrDat1 = malloc(qSize);   // reference buffer
+    uint8PtrDat2 = malloc(qSize);   // data buffer
+    for ( uint16_t i = 0; i < qSize; i++ ) {
+        uint8PtrDat1[i] = (uint8_t) (i % 255);  // avoid erased pattern
     }
-
-
-    /* sfcb_init */
-    printf("INFO:%s:sfcb_init\n", __FUNCTION__);
-    printf("INFO:%s:uint8Spi_p      = %p\n",        __FUNCTION__, &g_uint8Spi);
-    printf("INFO:%s:sfcb_p          = %p\n",        __FUNCTION__, &sfcb);
-    printf("INFO:%s:sfcb_cb_p       = %p\n",        __FUNCTION__, &sfcb_cb);
-    printf("INFO:%s:sfcb_size       = %d byte\n",   __FUNCTION__, (int) sizeof(sfcb));
-    printf("INFO:%s:sfcb_cb[0]_size = %d byte\n",   __FUNCTION__, (int) sizeof(sfcb_cb[0]));
-    memset(sfcb_cb, 0xaf, sizeof(sfcb_cb)); // mess-up memory to check init
-    /* int sfcb_init (t_sfcb *self, void *cb, uint8_t cbLen, void *spi, uint16_t spiLen) */
-    sfcb_init (&sfcb, &sfcb_cb, sizeof(sfcb_cb)/sizeof(sfcb_cb[0]), &g_uint8Spi, sizeof(g_uint8Spi)/sizeof(g_uint8Spi[0]));
-    /* check for error */
-    for ( uint8_t i = 0; i < sizeof(sfcb_cb)/sizeof(sfcb_cb[0]); i++ ) {
-        /* check flags */
-        if ( 0 != (sfcb_cb[i]).uint8Used ) {
-            printf("ERROR:%s:sfcb_init:uint8Used", __FUNCTION__);
-            goto ERO_END;
-        }
-        if ( 0 != (sfcb_cb[i]).uint8MgmtValid) {
-            printf("ERROR:%s:sfcb_init:uint8MgmtValid", __FUNCTION__);
-            goto ERO_END;
-        }
+    uint32IdMax = sfcb_idmax(sfcb, qNum);
+    /* first part */
+        // run_sfcb_add_append (t_sfm* flash, t_sfcb* sfcb, uint8_t qNum, uint8_t* data, uint16_t len)
+    if ( 0 != run_sfcb_add_append(flash, sfcb, qNum, uint8PtrDat1, uint16Part) ) {
+        printf("ERROR:%s:run_sfcb_add_append failed\n", __FUNCTION__);
+        goto ERO_END;
     }
-    //print_raw_sfcb_cb(&sfcb_cb, sizeof(sfcb_cb)/sizeof(sfcb_cb[0]));  // raw dump
-
-
-    /* sfcb_new_cb
-     *   adds two new circular buffers to the SPI Flash
-    */
-    printf("INFO:%s:sfcb_new_cb\n", __FUNCTION__);
-    sfcb_new_cb (&sfcb, 0x47114711, g_uint16CbQ0Size, g_uint16CbQ0_elems, &uint8Temp);  // start-up counter with operation
-    sfcb_new_cb (&sfcb, 0x08150815, g_uint16CbQ1Size, 16, &uint8Temp);  // error data collection 12KiB
-    print_raw_sfcb_cb(&sfcb_cb, sizeof(sfcb_cb)/sizeof(sfcb_cb[0]));    // raw dump of handling info
-
-
-    /* sfcb_mkcb
-     *   access spi flash and build circular buffers
-     */
-    printf("*************************************************\n");
-    printf("INFO:%s:sfcb_mkcb\n", __FUNCTION__);
-    if ( 0 != sfcb_mkcb(&sfcb) ) {
-        printf("ERROR:%s:sfcb_mkcb failed to start", __FUNCTION__);
+    /* reset, all management data is lost */
+    memset(sfcb_cb, 0xaf, cbLen*sizeof(t_sfcb_cb));
+    sfcb_init (sfcb, sfcb_cb, cbLen, &g_uint8Spi, sizeof(g_uint8Spi)/sizeof(g_uint8Spi[0]));
+    run_sfcb_new_cbs(sfcb);
+    if ( 0 != sfcb_mkcb(sfcb) ) {
+        printf("ERROR:%s:sfcb_mkcb failed to start\n", __FUNCTION__);
         goto ERO_END;
     }
         // run_sfm_update (t_sfm* flash, t_sfcb* sfcb)
-    if ( 0 != run_sfm_update(&spiFlash, &sfcb) ) {
+    if ( 0 != run_sfm_update(flash, sfcb) ) {
         printf("ERROR:%s:run_sfm_update\n", __FUNCTION__);
         goto ERO_END;
     }
-    sfm_dump( &spiFlash, 0, 256 );  // dump SPI flash content
-
-
-
-    ////////////////////////////////////////////
-    //
-    //  Single Pages Payloads
-    //
-    ////////////////////////////////////////////
-
-    /* SFCB add, queue 0 */
-    printf("*************************************************\n");
-    for ( uint8_t i = 0; i < 63; i++ ) {
-        printf("INFO:%s:sfcb_add:i=%d:add\n", __FUNCTION__, i);
-        /* add element */
-            // run_sfcb_add (t_sfm* flash, t_sfcb* sfcb, uint8_t qNum, uint8_t* data, uint16_t len)
-        if ( 0 != run_sfcb_add(&spiFlash, &sfcb, 0, (uint8_t*) &uint8FlashData, sizeof(uint8FlashData)/sizeof(uint8FlashData[0])) ) {
-            printf("ERROR:%s:run_sfcb_add failed", __FUNCTION__);
-            return -1;
-        }
-    }
-    if ( 0 != sfm_cmp(&spiFlash, "./test/sfcb_flash_q0_i63.dif") ) {
-        printf("ERROR:%s:sfm_cmp:q0 Mismatch\n", __FUNCTION__);
-        goto ERO_END;
-    }
-    /* check highest id */
-    if ( 63 != sfcb_idmax(&sfcb, 0) ) {
-        printf("ERROR:%s:sfcb_idmax:q0 exp,idmax=63, is,idmax=%d\n", __FUNCTION__, sfcb_idmax(&sfcb, 0));
+    /* write offset recovered? */
+    if ( uint16Part != sfcb_get_pl_wrcnt(sfcb, qNum) ) {
+        printf("ERROR:%s:sfcb_get_pl_wrcnt: wrong recovered write count, exp=%i, is=%i\n", __FUNCTION__, uint16Part, sfcb_get_pl_wrcnt(sfcb, qNum));
         goto ERO_END;
     }
-
-
-    /* sfcb_flash_read
-     *   reads raw binary data from flash
-     */
-    printf("*************************************************\n");
-    printf("INFO:%s:sfcb_flash_read\n", __FUNCTION__);
-        // int sfcb_flash_read (t_sfcb *self, uint32_t adr, void *data, uint16_t len)
-    if ( 0 != sfcb_flash_read (&sfcb, 0, &uint8Buf, 256) ) {
-        printf("ERROR:%s:sfcb_flash_read failed to start", __FUNCTION__);
+    if ( uint32IdMax != sfcb_idmax(sfcb, qNum) ) {
+        printf("ERROR:%s:sfcb_idmax: exp=%i, is=%i\n", __FUNCTION__, uint32IdMax, sfcb_idmax(sfcb, qNum));
         goto ERO_END;
     }
-        // run_sfm_update (t_sfm* flash, t_sfcb* sfcb)
-    if ( 0 != run_sfm_update(&spiFlash, &sfcb) ) {
-        printf("ERROR:%s:run_sfm_update\n", __FUNCTION__);
+    /* second part and finish element */
+    if ( 0 != run_sfcb_add_append(flash, sfcb, qNum, uint8PtrDat1+uint16Part, (uint16_t) (qSize-uint16Part)) ) {
+        printf("ERROR:%s:run_sfcb_add_append failed\n", __FUNCTION__);
         goto ERO_END;
     }
-    /* compare data */
-    for ( uint32_t i = 0; i < 256; i++ ) {
-        if ( spiFlash.uint8PtrMem[i] != uint8Buf[i] ) {
-            printf("ERROR:%s:sfcb_flash_read: byte=%d, exp=0x%02x, is=0x%02x\n", __FUNCTION__, i, spiFlash.uint8PtrMem[i], uint8Buf[i]);
-            goto ERO_END;
-        }
-    }
-
-
-    /* sfcb_get_last
-     *   reads last written element back
-     *     test_get_last: performs the test, function adds one element with random data to the queue and reads back
-     */
-    printf("*************************************************\n");
-    printf("INFO:%s:sfcb_get_last:q0: payload size = %d bytes\n", __FUNCTION__, g_uint16CbQ0Size);
-        // static int test_get_last (t_sfm* flash, t_sfcb* sfcb, uint8_t qNum, uint16_t qSize, uint32_t *elemID)
-    if ( 0 != test_get_last(&spiFlash, &sfcb, 0, g_uint16CbQ0Size, &uint32Temp) ) {
+    if ( 0 != run_sfcb_add_done(flash, sfcb, qNum) ) {
+        printf("ERROR:%s:sfcb_add_done failed to exec\n", __FUNCTION__);
         goto ERO_END;
     }
-    if ( 64 != uint32Temp ) {
-        printf("ERROR:%s:sfcb_get_last:q0: test_get_last elemID=%i, 64 expected\n", __FUNCTION__, uint32Temp);
+    if ( 0 != sfcb_mkcb(sfcb) ) {
+        printf("ERROR:%s:sfcb_mkcb failed to start\n", __FUNCTION__);
         goto ERO_END;
     }
-
-
-    /* sfcb_add_append
-     *   write to SPI flash in portions of bytes
-     */
-    printf("*************************************************\n");
-    printf("INFO:%s:sfcb_add_append:q0: payload size = %d bytes\n", __FUNCTION__, g_uint16CbQ0Size);
-        // static int test_add_append (t_sfm* flash, t_sfcb* sfcb, uint8_t qNum, uint16_t qSize)
-    if ( 0 != test_add_append(&spiFlash, &sfcb, 0, g_uint16CbQ0Size) ) {
-            // int sfm_dump (t_sfm *self, int32_t start, int32_t stop)
-        sfm_dump( &spiFlash, 0, 256*g_uint16CbQ0_elems );   // dump SPI flash content
-            // exit with error
+    if ( 0 != run_sfm_update(flash, sfcb) ) {
+        printf("ERROR:%s:run_sfm_update\n", __FUNCTION__);
         goto ERO_END;
     }
-
-
-    ////////////////////////////////////////////
-    //
-    //  Multiple Pages Payloads
-    //
-    ////////////////////////////////////////////
-
-    /* sfcb_get_last
-     *   reads last written element back
-     *     test_get_last: performs the test, function adds one element with random data to the queue and reads back
-     */
-    printf("*************************************************\n");
-    printf("INFO:%s:sfcb_get_last:q1: payload size = %d bytes\n", __FUNCTION__, g_uint16CbQ1Size);
-        // static int test_get_last (t_sfm* flash, t_sfcb* sfcb, uint8_t qNum, uint16_t qSize, uint32_t *elemID)
-    if ( 0 != test_get_last(&spiFlash, &sfcb, 1, g_uint16CbQ1Size, &uint32Temp) ) {
+    /* read back */
+    memset(uint8PtrDat2, 0, qSize); // destroy buffer
+    if ( 0 != run_sfcb_get_last(flash, sfcb, qNum, uint8PtrDat2, qSize, elemID) ) {
+        printf("ERROR:%s:run_sfcb_get_last failed to start\n", __FUNCTION__);
         goto ERO_END;
     }
-    if ( 1 != uint32Temp ) {
-        printf("ERROR:%s:sfcb_get_last:q1: test_get_last elemID=%i, 1 expected\n", __FUNCTION__, uint32Temp);
+    if ( 0 != mem_cmp(uint8PtrDat2, uint8PtrDat1, qSize) ) {
+        printf("ERROR:%s:mem_cmp\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* all done */
+    ret = 0;
+
+    /* release buffers */
+    ERO_END:
+        free(uint8PtrDat1);
+        free(uint8PtrDat2);
+        return ret;
+}
+
+
+/**
+ *  @brief test_addv
+ *
+ *  writes queue element gathered from multiple fragments
+ *  reads element back and compares with the concatenated fragments
+ *
+ *  @param[in,out]  flash               spi flash model handle, #t_sfm
+ *  @param[in,out]  sfcb                spi flash circular buffer handle, #t_sfcb
+ *  @param[in]      qNum                number of tested circular buffer queue
+ *  @param[in]      qSize               test data size for selected circular buffer queue
+ *  @param[in,out]  *elemID             queue element id of read queue element
+ *  @return         int                 test state
+ *  @retval         0                   Success
+ *  @retval         -1                  Fail
+ *  @since          October 18, 2026
+ */
+static int test_addv (t_sfm* flash, t_sfcb* sfcb, uint8_t qNum, uint16_t qSize, uint32_t *elemID)
+{
+    /** Variables **/
+    uint8_t*    uint8PtrDat1 = NULL;    // reference buffer
+    uint8_t*    uint8PtrDat2 = NULL;    // read buffer
+    t_sfcb_iov  iov[4];                 // fragments
+    int         ret = -1;
+
+    /* entry message */
+    printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* prepare data set */
+    uint8PtrDat1 = malloc(qSize);
+    uint8PtrDat2 = malloc(qSize);
+    for ( uint16_t i = 0; i < qSize; i++ ) {
+        uint8PtrDat1[i] = (uint8_t) (rand() % 256);
+    }
+    /* total above 16bit length is rejected, not truncated */
+    iov[0].ptr = uint8PtrDat1;  iov[0].len = UINT16_MAX;
+    iov[1].ptr = uint8PtrDat1;  iov[1].len = 2;
+    if ( SFCB_E_MEM != sfcb_addv(sfcb, qNum, iov, 2) ) {
+        printf("ERROR:%s:sfcb_addv: 16bit overflow of total length accepted\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* split into fragments: fixed header, empty, sensor block, trailer */
+    iov[0].ptr = uint8PtrDat1;          iov[0].len = 10;
+    iov[1].ptr = NULL;                  iov[1].len = 0;
+    iov[2].ptr = uint8PtrDat1 + 10;     iov[2].len = (uint16_t) (qSize - 17);
+    iov[3].ptr = uint8PtrDat1 + qSize - 7;  iov[3].len = 7;
+    /* write into Q */
+    if ( 0 != sfcb_addv(sfcb, qNum, iov, sizeof(iov)/sizeof(iov[0])) ) {
+        printf("ERROR:%s:sfcb_addv failed to start\n", __FUNCTION__);
+        goto ERO_END;
+    }
+        // run_sfm_update (t_sfm* flash, t_sfcb* sfcb)
+    if ( 0 != run_sfm_update(flash, sfcb) ) {
+        printf("ERROR:%s:run_sfm_update\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( 0 != run_sfcb_add_done(flash, sfcb, qNum) ) {
+        printf("ERROR:%s:sfcb_add_done failed to exec\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( 0 != sfcb_mkcb(sfcb) ) {
+        printf("ERROR:%s:sfcb_mkcb failed to start\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( 0 != run_sfm_update(flash, sfcb) ) {
+        printf("ERROR:%s:run_sfm_update\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* read back */
+    memset(uint8PtrDat2, 0, qSize); // destroy buffer
+    if ( 0 != run_sfcb_get_last(flash, sfcb, qNum, uint8PtrDat2, qSize, elemID) ) {
+        printf("ERROR:%s:run_sfcb_get_last failed to start\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( 0 != mem_cmp(uint8PtrDat2, uint8PtrDat1, qSize) ) {
+        printf("ERROR:%s:mem_cmp\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* all done */
+    ret = 0;
+
+    /* release buffers */
+    ERO_END:
+        free(uint8PtrDat1);
+        free(uint8PtrDat2);
+        return ret;
+}
+
+
+
+/**
+ *  @brief test_queue_stats
+ *
+ *  checks queue statistics while write of one element and against rescan by #sfcb_mkcb
+ *
+ *  @param[in,out]  flash               spi flash model handle, #t_sfm
+ *  @param[in,out]  sfcb                spi flash circular buffer handle, #t_sfcb
+ *  @param[in]      qNum                number of tested circular buffer queue
+ *  @return         int                 test state
+ *  @retval         0                   Success
+ *  @retval         -1                  Fail
+ *  @since          October 18, 2026
+ */
+static int test_queue_stats (t_sfm* flash, t_sfcb* sfcb, uint8_t qNum)
+{
+    /** Variables **/
+    t_sfcb_stats    st[4];          // statistics: start, open, committed, rescan
+    uint8_t         uint8Dat[100];  // partial payload
+
+    /* entry message */
+    printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* initial */
+    if ( 0 != sfcb_queue_stats(sfcb, qNum, &st[0]) ) {
+        printf("ERROR:%s:sfcb_queue_stats\n", __FUNCTION__);
+        return -1;
+    }
+    /* open element */
+    memset(uint8Dat, 0x5a, sizeof(uint8Dat));
+    if ( 0 != sfcb_add(sfcb, qNum, uint8Dat, sizeof(uint8Dat)) ) {
+        printf("ERROR:%s:sfcb_add failed to start\n", __FUNCTION__);
+        return -1;
+    }
+    if ( 0 != run_sfm_update(flash, sfcb) ) {
+        printf("ERROR:%s:run_sfm_update\n", __FUNCTION__);
+        return -1;
+    }
+    sfcb_queue_stats(sfcb, qNum, &st[1]);
+    if ( (sizeof(uint8Dat) != st[1].uint16PlWrCnt) || (st[0].uint16SlotsFree != st[1].uint16SlotsFree + 1) || (st[0].uint16Entries != st[1].uint16Entries) ) {
+        printf("ERROR:%s:open: plwrcnt=%d, free=%d, entries=%d\n", __FUNCTION__, st[1].uint16PlWrCnt, st[1].uint16SlotsFree, st[1].uint16Entries);
+        return -1;
+    }
+    /* commit element, statistic without rescan */
+    if ( 0 != run_sfcb_add_done(flash, sfcb, qNum) ) {
+        return -1;
+    }
+    sfcb_queue_stats(sfcb, qNum, &st[2]);
+    if (    (0 != st[2].uint16PlWrCnt)
+         || (st[0].uint16Entries + 1 != st[2].uint16Entries)
+         || (st[0].uint32IdNewest + 1 != st[2].uint32IdNewest)
+         || (st[2].uint32IdNewest != st[2].uint32IdLastCpl)
+         || (st[1].uint16SlotsFree != st[2].uint16SlotsFree)
+    ) {
+        printf("ERROR:%s:commit: entries=%d, newest=%d, lastcpl=%d, free=%d\n", __FUNCTION__, st[2].uint16Entries, st[2].uint32IdNewest, st[2].uint32IdLastCpl, st[2].uint16SlotsFree);
+        return -1;
+    }
+    /* rescan flash, needs to be equal */
+    if ( 0 != sfcb_mkcb(sfcb) ) {
+        printf("ERROR:%s:sfcb_mkcb failed to start\n", __FUNCTION__);
+        return -1;
+    }
+    if ( 0 != run_sfm_update(flash, sfcb) ) {
+        printf("ERROR:%s:run_sfm_update\n", __FUNCTION__);
+        return -1;
+    }
+    sfcb_queue_stats(sfcb, qNum, &st[3]);
+    if ( 0 != memcmp(&st[2], &st[3], sizeof(st[2])) ) {
+        printf("ERROR:%s:rescan: entries=%d, oldest=%d, newest=%d, free=%d\n", __FUNCTION__, st[3].uint16Entries, st[3].uint32IdOldest, st[3].uint32IdNewest, st[3].uint16SlotsFree);
+        return -1;
+    }
+    /* all done */
+    return 0;
+}
+
+
+
+/**
+ *  @brief test_add_post
+ *
+ *  posts large element to queue qBig, after some page programs small element to
+ *  queue qSmall. Small element needs to complete before large element
+ *
+ *  @param[in,out]  flash               spi flash model handle, #t_sfm
+ *  @param[in,out]  sfcb                spi flash circular buffer handle, #t_sfcb
+ *  @param[in]      qBig                queue with large element
+ *  @param[in]      qBigSize            payload size of large queue
+ *  @param[in]      qSmall              queue with small element
+ *  @return         int                 test state
+ *  @retval         0                   Success
+ *  @retval         -1                  Fail
+ *  @since          October 18, 2026
+ */
+static int test_add_post (t_sfm* flash, t_sfcb* sfcb, uint8_t qBig, uint16_t qBigSize, uint8_t qSmall)
+{
+    /** Variables **/
+    uint8_t*        uint8PtrBig = NULL;     // large element
+    uint8_t*        uint8PtrRd = NULL;      // read buffer
+    uint8_t         uint8Small[12];         // small element, f.e. boot counter
+    uint32_t        uint32Counter;          // worker calls
+    uint32_t        uint32SmallDone = 0;    // worker calls up to small element complete
+    uint32_t        uint32ElemID;           // read element ID
+    t_sfcb_stats    st;                     // queue statistics
+    uint32_t        uint32IdSmall;          // last complete ID of small queue before post
+
+    /* entry message */
+    printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* prepare data set */
+    uint8PtrBig = malloc(qBigSize);
+    uint8PtrRd = malloc(qBigSize);
+    for ( uint16_t i = 0; i < qBigSize; i++ ) {
+        uint8PtrBig[i] = (uint8_t) (rand() % 256);
+    }
+    for ( uint8_t i = 0; i < sizeof(uint8Small); i++ ) {
+        uint8Small[i] = (uint8_t) (rand() % 256);
+    }
+    sfcb_queue_stats(sfcb, qSmall, &st);
+    uint32IdSmall = st.uint32IdLastCpl;
+    /* post large element */
+    if ( 0 != sfcb_add_post(sfcb, qBig, uint8PtrBig, qBigSize) ) {
+        printf("ERROR:%s:sfcb_add_post:q%d failed to start\n", __FUNCTION__, qBig);
+        return -1;
+    }
+    /* run worker, post small element after some page programs */
+    uint32Counter = 0;
+    while ( (0 != sfcb_busy(sfcb)) && ((uint32Counter++) < 10*g_uint32SpiFlashCycleOut) ) {
+        if ( 20 == uint32Counter ) {
+            if ( 0 != sfcb_add_post(sfcb, qSmall, uint8Small, sizeof(uint8Small)) ) {
+                printf("ERROR:%s:sfcb_add_post:q%d failed to start\n", __FUNCTION__, qSmall);
+                return -1;
+            }
+        }
+        sfcb_worker(sfcb);
+        if ( 0 != sfm(flash, (uint8_t*) &g_uint8Spi, sfcb_spi_len(sfcb)) ) {
+            printf("ERROR:%s:spi_flash_model\n", __FUNCTION__);
+            return -1;
+        }
+        sfcb_queue_stats(sfcb, qSmall, &st);
+        if ( (0 == uint32SmallDone) && (uint32IdSmall != st.uint32IdLastCpl) ) {
+            uint32SmallDone = uint32Counter;
+        }
+    }
+    sfcb_queue_stats(sfcb, qSmall, &st);
+    printf("INFO:%s: small element done after %d of %d worker calls, delay=%d\n", __FUNCTION__, uint32SmallDone, uint32Counter, st.uint32DelayLast);
+    if ( (0 == uint32SmallDone) || (uint32SmallDone > uint32Counter / 4) || (st.uint32DelayLast > 8) ) {
+        printf("ERROR:%s:small element starved\n", __FUNCTION__);
+        return -1;
+    }
+    /* rebuild and read back */
+    if ( 0 != sfcb_mkcb(sfcb) ) {
+        printf("ERROR:%s:sfcb_mkcb failed to start\n", __FUNCTION__);
+        return -1;
+    }
+    if ( 0 != run_sfm_update(flash, sfcb) ) {
+        printf("ERROR:%s:run_sfm_update\n", __FUNCTION__);
+        return -1;
+    }
+    if ( 0 != run_sfcb_get_last(flash, sfcb, qBig, uint8PtrRd, qBigSize, &uint32ElemID) ) {
+        return -1;
+    }
+    if ( 0 != mem_cmp(uint8PtrRd, uint8PtrBig, qBigSize) ) {
+        printf("ERROR:%s:q%d mem_cmp\n", __FUNCTION__, qBig);
+        return -1;
+    }
+    if ( 0 != run_sfcb_get_last(flash, sfcb, qSmall, uint8PtrRd, sizeof(uint8Small), &uint32ElemID) ) {
+        return -1;
+    }
+    if ( 0 != mem_cmp(uint8PtrRd, uint8Small, sizeof(uint8Small)) ) {
+        printf("ERROR:%s:q%d mem_cmp\n", __FUNCTION__, qSmall);
+        return -1;
+    }
+    /* all done */
+    free(uint8PtrBig);
+    free(uint8PtrRd);
+    return 0;
+}
+
+
+
+/**
+ *  @brief run_sfcb_idle
+ *
+ *  calls idle worker, SPI packets of background scrub are exchanged with flash model
+ *
+ *  @param[in,out]  flash               spi flash model handle, #t_sfm
+ *  @param[in,out]  sfcb                spi flash circular buffer handle, #t_sfcb
+ *  @param[in]      calls               number of worker calls
+ *  @return         uint32_t            number of SPI packets
+ *  @since          October 18, 2026
+ */
+static uint32_t run_sfcb_idle (t_sfm* flash, t_sfcb* sfcb, uint32_t calls)
+{
+    /** Variables **/
+    uint32_t    uint32Pkts = 0; // SPI packets
+
+    for ( uint32_t i = 0; i < calls; i++ ) {
+        sfcb_worker(sfcb);
+        if ( 0 != sfcb_spi_len(sfcb) ) {
+            uint32Pkts++;
+            sfm(flash, (uint8_t*) &g_uint8Spi, sfcb_spi_len(sfcb));
+        }
+    }
+    return uint32Pkts;
+}
+
+
+
+/**
+ *  @brief test_scrub
+ *
+ *  background scrub: SPI packet budget, job start during scrub, detection of damaged footer
+ *
+ *  @param[in,out]  flash               spi flash model handle, #t_sfm
+ *  @param[in,out]  sfcb                spi flash circular buffer handle, #t_sfcb
+ *  @param[in]      qNum                number of tested circular buffer queue
+ *  @return         int                 test state
+ *  @retval         0                   Success
+ *  @retval         -1                  Fail
+ *  @since          October 18, 2026
+ */
+static int test_scrub (t_sfm* flash, t_sfcb* sfcb, uint8_t qNum)
+{
+    /** Variables **/
+    t_sfcb_stats    st;                 // queue statistics
+    uint8_t         uint8Buf[32];       // read buffer
+    uint32_t        uint32Pkts;         // SPI packets of scrub
+    uint32_t        uint32ElemID;       // read element ID
+    uint32_t        uint32Adr;          // damaged flash byte
+    uint8_t         uint8Save;          // original flash byte
+
+    /* entry message */
+    printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    if ( (0 != sfcb_mkcb(sfcb)) || (0 != run_sfm_update(flash, sfcb)) ) {
+        printf("ERROR:%s:sfcb_mkcb\n", __FUNCTION__);
+        return -1;
+    }
+    /* two packets every ten calls */
+    sfcb_scrub(sfcb, 2, 10);
+    uint32Pkts = run_sfcb_idle(flash, sfcb, 105);
+    if ( uint32Pkts > 22 ) {
+        printf("ERROR:%s: budget exceeded, pkts=%d\n", __FUNCTION__, uint32Pkts);
+        return -1;
+    }
+    /* job during scrub */
+    if ( 0 != run_sfcb_get_last(flash, sfcb, qNum, uint8Buf, sizeof(uint8Buf), &uint32ElemID) ) {
+        return -1;
+    }
+    if ( sfcb_idmax(sfcb, qNum) != uint32ElemID ) {
+        printf("ERROR:%s: get_last during scrub, id=%d\n", __FUNCTION__, uint32ElemID);
+        return -1;
+    }
+    /* complete walk */
+    sfcb_scrub(sfcb, 4, 1);
+    sfcb_queue_stats(sfcb, qNum, &st);
+    for ( uint32_t i = 0; (i < 10000) && (0 == st.uint32ScrubPasses); i++ ) {
+        run_sfcb_idle(flash, sfcb, 1);
+        sfcb_queue_stats(sfcb, qNum, &st);
+    }
+    printf("INFO:%s: elems=%d, errs=%d, passes=%d\n", __FUNCTION__, st.uint32ScrubElems, st.uint32ScrubErrs, st.uint32ScrubPasses);
+    if ( (0 == st.uint32ScrubPasses) || (0 != st.uint32ScrubErrs) || (st.uint32ScrubElems < st.uint16Entries) ) {
+        printf("ERROR:%s: first walk\n", __FUNCTION__);
+        return -1;
+    }
+    /* retention error in footer of newest element */
+    uint32Adr = sfcb->ptrCbs[qNum].uint32StartPageIdMax + sfcb->ptrCbs[qNum].uint32SlotSize - 1;
+    uint8Save = flash->uint8PtrMem[uint32Adr];
+    flash->uint8PtrMem[uint32Adr] = (uint8_t) (uint8Save ^ 0x01);
+    uint32ElemID = st.uint32ScrubPasses;
+    for ( uint32_t i = 0; (i < 10000) && (st.uint32ScrubPasses == uint32ElemID); i++ ) {
+        run_sfcb_idle(flash, sfcb, 1);
+        sfcb_queue_stats(sfcb, qNum, &st);
+    }
+    flash->uint8PtrMem[uint32Adr] = uint8Save;
+    sfcb_scrub(sfcb, 0, 1);
+    printf("INFO:%s: elems=%d, errs=%d, passes=%d\n", __FUNCTION__, st.uint32ScrubElems, st.uint32ScrubErrs, st.uint32ScrubPasses);
+    if ( 1 != st.uint32ScrubErrs ) {
+        printf("ERROR:%s: damaged footer not found\n", __FUNCTION__);
+        return -1;
+    }
+    /* all done */
+    return 0;
+}
+
+
+
+/**
+ *  @brief test_init_warm
+ *
+ *  warm start with retained management data: unchanged table, interrupted job and corrupted layout
+ *
+ *  @param[in,out]  flash               spi flash model handle, #t_sfm
+ *  @param[in,out]  sfcb                spi flash circular buffer handle, #t_sfcb
+ *  @param[in,out]  sfcb_cb             retained circular buffer queue table
+ *  @param[in]      cbLen               number of entries in sfcb_cb
+ *  @return         int                 test state
+ *  @retval         0                   Success
+ *  @retval         -1                  Fail
+ *  @since          October 18, 2026
+ */
+static int test_init_warm (t_sfm* flash, t_sfcb* sfcb, t_sfcb_cb* sfcb_cb, uint8_t cbLen)
+{
+    /** Variables **/
+    t_sfcb_stats    stRef[2];   // statistics before reset
+    t_sfcb_stats    st;         // statistics after warm start
+    uint32_t        uint32Pkts; // SPI packets of warm start
+
+    /* entry message */
+    printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    for ( uint8_t i = 0; i < 2; i++ ) {
+        sfcb_queue_stats(sfcb, i, &stRef[i]);
+    }
+    /* three cases: retained table, interrupted job at queue 1, damaged layout */
+    for ( uint8_t uint8Case = 0; uint8Case < 3; uint8Case++ ) {
+        if ( 1 == uint8Case ) {
+            (sfcb_cb[1].uint16NumEntries)++;    // changed without seal
+        } else if ( 2 == uint8Case ) {
+            sfcb_cb[0].uint32StopSector = 0;
+        }
+        uint32Pkts = g_uint32SpiPkts;
+        if ( 2 == uint8Case ) {
+            if ( SFCB_E_WKR_REQ != sfcb_init_warm(sfcb, sfcb_cb, cbLen, &g_uint8Spi, sizeof(g_uint8Spi)/sizeof(g_uint8Spi[0])) ) {
+                printf("ERROR:%s:sfcb_init_warm: damaged layout accepted\n", __FUNCTION__);
+                return -1;
+            }
+            /* cold start */
+            run_sfcb_new_cbs(sfcb);
+            if ( 0 != sfcb_mkcb(sfcb) ) {
+                printf("ERROR:%s:sfcb_mkcb failed to start\n", __FUNCTION__);
+                return -1;
+            }
+        } else if ( 0 != sfcb_init_warm(sfcb, sfcb_cb, cbLen, &g_uint8Spi, sizeof(g_uint8Spi)/sizeof(g_uint8Spi[0])) ) {
+            printf("ERROR:%s:sfcb_init_warm: case=%d\n", __FUNCTION__, uint8Case);
+            return -1;
+        }
+        if ( 0 != run_sfm_update(flash, sfcb) ) {
+            printf("ERROR:%s:run_sfm_update\n", __FUNCTION__);
+            return -1;
+        }
+        uint32Pkts = g_uint32SpiPkts - uint32Pkts;
+        printf("INFO:%s: case=%d, spi packets=%d\n", __FUNCTION__, uint8Case, uint32Pkts);
+        /* retained table, only header check */
+        if ( (0 == uint8Case) && (uint32Pkts > 6) ) {
+            printf("ERROR:%s: warm start scans flash\n", __FUNCTION__);
+            return -1;
+        }
+        /* queue states equal to before reset */
+        for ( uint8_t i = 0; i < 2; i++ ) {
+            sfcb_queue_stats(sfcb, i, &st);
+            if ( (0 == sfcb_cb[i].uint8MgmtValid) || (st.uint16Entries != stRef[i].uint16Entries) || (st.uint32IdNewest != stRef[i].uint32IdNewest) || (st.uint32IdLastCpl != stRef[i].uint32IdLastCpl) || (st.uint16SlotsFree != stRef[i].uint16SlotsFree) ) {
+                printf("ERROR:%s:case=%d, q%d: valid=%d, entries=%d, newest=%d\n", __FUNCTION__, uint8Case, i, sfcb_cb[i].uint8MgmtValid, st.uint16Entries, st.uint32IdNewest);
+                return -1;
+            }
+        }
+    }
+    /* all done */
+    return 0;
+}
+
+
+
+/**
+ *  @brief test_fmt_commit
+ *
+ *  commit word element format: program count compared with header/footer format,
+ *  resume of uncommitted element after reset, read back of committed element
+ *
+ *  @return         int                 test state
+ *  @retval         0                   Success
+ *  @retval         -1                  Fail
+ *  @since          October 18, 2026
+ */
+static int test_fmt_commit (void)
+{
+    /** Variables **/
+    t_sfm       flash;              // SPI flash model
+    t_sfcb      sfcb;               // handle
+    t_sfcb_cb   sfcb_cb[2];         // q0: header/footer, q1: commit word
+    uint8_t     uint8Dat[300];      // reference data, spans two pages
+    uint8_t     uint8Rd[300];       // read buffer
+    uint16_t    uint16Part = 100;   // bytes written before reset
+    uint32_t    uint32Pkts[2];      // SPI packets per element
+    uint32_t    uint32ElemID;       // read element ID
+    t_test_q    q[2] = {
+                    {0x47114711, sizeof(uint8Dat), 8, SFCB_FMT_HEAD_FOOT},
+                    {0x08150815, sizeof(uint8Dat), 8, SFCB_FMT_COMMIT}
+                };
+    int         ret = -1;
+
+    /* entry message */
+    printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    for ( uint16_t i = 0; i < sizeof(uint8Dat); i++ ) {
+        uint8Dat[i] = (uint8_t) (i % 255);  // avoid erased pattern
+    }
+    /* one element per format */
+    if ( 0 != run_sfcb_setup(&flash, &sfcb, sfcb_cb, 2, q, 2, TEST_FIX_FLASH | TEST_FIX_MKCB) ) {
+        goto ERO_END;
+    }
+    for ( uint8_t i = 0; i < 2; i++ ) {
+        uint32Pkts[i] = g_uint32SpiPkts;
+        if ( (0 != sfcb_add(&sfcb, i, uint8Dat, sizeof(uint8Dat))) || (0 != run_sfm_update(&flash, &sfcb)) || (0 != run_sfcb_add_done(&flash, &sfcb, i)) ) {
+            printf("ERROR:%s:q%d: sfcb_add\n", __FUNCTION__, i);
+            goto ERO_END;
+        }
+        uint32Pkts[i] = g_uint32SpiPkts - uint32Pkts[i];
+    }
+    printf("INFO:%s: spi packets per element, head/foot=%d, commit=%d\n", __FUNCTION__, uint32Pkts[0], uint32Pkts[1]);
+    if ( uint32Pkts[1] >= uint32Pkts[0] ) {
+        printf("ERROR:%s: commit format without saved program\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* uncommitted element */
+    if ( (0 != sfcb_mkcb(&sfcb)) || (0 != run_sfm_update(&flash, &sfcb)) ) {
+        printf("ERROR:%s:sfcb_mkcb\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( (0 != sfcb_add(&sfcb, 1, uint8Dat, uint16Part)) || (0 != run_sfm_update(&flash, &sfcb)) ) {
+        printf("ERROR:%s:sfcb_add\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* reset, all management data is lost */
+    if ( 0 != run_sfcb_setup(&flash, &sfcb, sfcb_cb, 2, q, 2, TEST_FIX_MKCB) ) {
+        goto ERO_END;
+    }
+    if ( (uint16Part != sfcb_get_pl_wrcnt(&sfcb, 1)) || (1 != sfcb_idmax(&sfcb, 1)) ) {
+        printf("ERROR:%s: uncommitted element, wrcnt=%d, idmax=%d\n", __FUNCTION__, sfcb_get_pl_wrcnt(&sfcb, 1), sfcb_idmax(&sfcb, 1));
+        goto ERO_END;
+    }
+    /* finish element and read back */
+    if ( (0 != sfcb_add(&sfcb, 1, uint8Dat+uint16Part, (uint16_t) (sizeof(uint8Dat)-uint16Part))) || (0 != run_sfm_update(&flash, &sfcb)) || (0 != run_sfcb_add_done(&flash, &sfcb, 1)) ) {
+        printf("ERROR:%s:sfcb_add\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( (0 != sfcb_mkcb(&sfcb)) || (0 != run_sfm_update(&flash, &sfcb)) ) {
+        printf("ERROR:%s:sfcb_mkcb\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    memset(uint8Rd, 0, sizeof(uint8Rd));
+    if ( 0 != run_sfcb_get_last(&flash, &sfcb, 1, uint8Rd, sizeof(uint8Rd), &uint32ElemID) ) {
+        goto ERO_END;
+    }
+    if ( (2 != uint32ElemID) || (0 != mem_cmp(uint8Rd, uint8Dat, sizeof(uint8Dat))) ) {
+        printf("ERROR:%s: read back, id=%d\n", __FUNCTION__, uint32ElemID);
+        goto ERO_END;
+    }
+    /* all done */
+    ret = 0;
+
+    /* release flash model */
+    ERO_END:
+        free(flash.uint8PtrMem);
+        return ret;
+}
+
+
+
+/**
+ *  @brief test_fmt_compact
+ *
+ *  compact element format: capacity for small records compared with header/footer format,
+ *  queue wrap with sector erase, rebuild after reset with 32-bit IDs from sector summary
+ *
+ *  @return         int                 test state
+ *  @retval         0                   Success
+ *  @retval         -1                  Fail
+ *  @since          October 18, 2026
+ */
+static int test_fmt_compact (void)
+{
+    /** Variables **/
+    t_sfm           flash;              // SPI flash model
+    t_sfcb          sfcb;               // handle
+    t_sfcb_cb       sfcb_cb[2];         // queue table
+    t_sfcb_stats    st;                 // queue statistic
+    uint8_t         uint8Dat[40];       // record
+    uint8_t         uint8Rd[40];        // read buffer
+    uint32_t        uint32ElemID;       // read element ID
+    uint32_t        uint32PerSec[2];    // elements per sector
+    t_test_q        qCap[2] = {
+                        {0x47114711, 16, 200, SFCB_FMT_HEAD_FOOT},
+                        {0x08150815, 16, 200, SFCB_FMT_COMPACT}
+                    };
+    t_test_q        q = {0x08150815, sizeof(uint8Dat), 100, SFCB_FMT_COMPACT};
+    int             ret = -1;
+
+    /* entry message */
+    printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* capacity, 16 byte records */
+    if ( 0 != run_sfcb_setup(&flash, &sfcb, sfcb_cb, 2, qCap, 2, TEST_FIX_FLASH) ) {
+        goto ERO_END;
+    }
+    for ( uint8_t i = 0; i < 2; i++ ) {
+        uint32PerSec[i] = sfcb_cb[i].uint16NumEntriesMax / (sfcb_cb[i].uint32StopSector - sfcb_cb[i].uint32StartSector + 1);
+    }
+    printf("INFO:%s: 16 byte records per sector, head/foot=%d, compact=%d\n", __FUNCTION__, uint32PerSec[0], uint32PerSec[1]);
+    if ( uint32PerSec[1] < 2*uint32PerSec[0] ) {
+        printf("ERROR:%s: compact format without capacity gain\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* fill queue beyond its capacity, flash is still erased */
+    if ( 0 != run_sfcb_setup(&flash, &sfcb, sfcb_cb, 2, &q, 1, TEST_FIX_MKCB) ) {
+        goto ERO_END;
+    }
+    for ( uint16_t i = 0; i < sfcb_cb[0].uint16NumEntriesMax + 4; i++ ) {
+        memset(uint8Dat, (uint8_t) i, sizeof(uint8Dat));
+        if ( 0 != run_sfcb_add(&flash, &sfcb, 0, uint8Dat, sizeof(uint8Dat)) ) {
+            printf("ERROR:%s:run_sfcb_add\n", __FUNCTION__);
+            goto ERO_END;
+        }
+    }
+    sfcb_queue_stats(&sfcb, 0, &st);
+    printf("INFO:%s: oldest=%d, newest=%d, entries=%d/%d\n", __FUNCTION__, st.uint32IdOldest, st.uint32IdNewest, st.uint16Entries, st.uint16EntriesMax);
+    if ( ((uint32_t) (sfcb_cb[0].uint16NumEntriesMax + 4) != st.uint32IdNewest) || (1 >= st.uint32IdOldest) ) {
+        printf("ERROR:%s: queue wrap\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* reset, IDs from sector summary */
+    if ( 0 != run_sfcb_setup(&flash, &sfcb, sfcb_cb, 2, &q, 1, TEST_FIX_MKCB) ) {
+        goto ERO_END;
+    }
+    if ( 0 != run_sfcb_get_last(&flash, &sfcb, 0, uint8Rd, sizeof(uint8Rd), &uint32ElemID) ) {
+        goto ERO_END;
+    }
+    if ( (st.uint32IdNewest != uint32ElemID) || (0 != mem_cmp(uint8Rd, uint8Dat, sizeof(uint8Dat))) ) {
+        printf("ERROR:%s: read back, id=%d\n", __FUNCTION__, uint32ElemID);
+        goto ERO_END;
+    }
+    /* all done */
+    ret = 0;
+
+    /* release flash model */
+    ERO_END:
+        free(flash.uint8PtrMem);
+        return ret;
+}
+
+
+
+/**
+ *  @brief test_defer
+ *
+ *  deferred writes: SPI packets per record compared with posted element writes,
+ *  bursts by threshold, age and flush, deep power-down between bursts
+ *
+ *  @return         int                 test state
+ *  @retval         0                   Success
+ *  @retval         -1                  Fail
+ *  @since          October 18, 2026
+ */
+static int test_defer (void)
+{
+    /** Variables **/
+    t_sfm           flash;              // SPI flash model
+    t_sfcb          sfcb;               // handle
+    t_sfcb_cb       sfcb_cb[1];         // queue table
+    t_sfcb_stats    st;                 // queue statistic
+    uint8_t         uint8Ring[32*16];   // RAM ring, 32 records
+    uint8_t         uint8Rec[16];       // record
+    uint8_t         uint8Rd[3*16];      // read buffer
+    uint8_t         uint8Exp[3*16];     // expected last burst
+    uint32_t        uint32Cmds[2];      // SPI packets per record, posted and deferred
+    uint32_t        uint32ElemID;       // read element ID
+    uint32_t        uint32Calls;        // worker calls
+    t_test_q        q = {0x47114711, g_uint16CbQ0Size, 32, SFCB_FMT_HEAD_FOOT};
+    int             ret = -1;
+
+    /* entry message */
+    printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    if ( 0 != run_sfcb_setup(&flash, &sfcb, sfcb_cb, 1, &q, 1, TEST_FIX_FLASH | TEST_FIX_MKCB) ) {
+        goto ERO_END;
+    }
+    /* one element per record */
+    uint32Cmds[0] = flash.uint32Cmds;
+    for ( uint8_t i = 0; i < 8; i++ ) {
+        memset(uint8Rec, i, sizeof(uint8Rec));
+        if ( (0 != sfcb_add_post(&sfcb, 0, uint8Rec, sizeof(uint8Rec))) || (0 != run_sfm_update(&flash, &sfcb)) || (0 != sfcb_mkcb(&sfcb)) || (0 != run_sfm_update(&flash, &sfcb)) ) {
+            printf("ERROR:%s:sfcb_add_post\n", __FUNCTION__);
+            goto ERO_END;
+        }
+    }
+    uint32Cmds[0] = (flash.uint32Cmds - uint32Cmds[0]) / 8;
+    /* bursts of eight records, deep power-down in between */
+    if ( (0 != sfcb_defer(&sfcb, 0, uint8Ring, sizeof(uint8Ring), sizeof(uint8Rec), 8, 0)) || (0 != sfcb_deep_pd(&sfcb, 1, 2)) ) {
+        printf("ERROR:%s:sfcb_defer\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    uint32Cmds[1] = flash.uint32Cmds;
+    for ( uint8_t i = 0; i < 40; i++ ) {
+        memset(uint8Rec, 0x10 + i, sizeof(uint8Rec));
+        if ( 0 != sfcb_add_defer(&sfcb, 0, uint8Rec) ) {
+            printf("ERROR:%s:sfcb_add_defer\n", __FUNCTION__);
+            goto ERO_END;
+        }
+        for ( uint8_t j = 0; j < 40; j++ ) {
+            sfcb_worker(&sfcb);
+            if ( 0 != sfm(&flash, (uint8_t*) &g_uint8Spi, sfcb_spi_len(&sfcb)) ) {
+                printf("ERROR:%s:spi_flash_model, record=%d\n", __FUNCTION__, i);
+                goto ERO_END;
+            }
+        }
+    }
+    uint32Cmds[1] = (flash.uint32Cmds - uint32Cmds[1]) / 40;
+    sfcb_queue_stats(&sfcb, 0, &st);
+    printf("INFO:%s: spi packets per record, posted=%d, deferred=%d, newest=%d\n", __FUNCTION__, uint32Cmds[0], uint32Cmds[1], st.uint32IdNewest);
+    if ( (0 == flash.uint8Dpd) || (0 != st.uint16DefRecs) || (13 != st.uint32IdNewest) || (3*uint32Cmds[1] > uint32Cmds[0]) ) {
+        printf("ERROR:%s: deferred bursts\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* age of oldest record */
+    sfcb_defer(&sfcb, 0, uint8Ring, sizeof(uint8Ring), sizeof(uint8Rec), 8, 50);
+    sfcb_add_defer(&sfcb, 0, uint8Rec);
+    sfcb_add_defer(&sfcb, 0, uint8Rec);
+    for ( uint32Calls = 0; uint32Calls < 200; uint32Calls++ ) {
+        sfcb_worker(&sfcb);
+        if ( 0 != sfm(&flash, (uint8_t*) &g_uint8Spi, sfcb_spi_len(&sfcb)) ) {
+            printf("ERROR:%s:spi_flash_model\n", __FUNCTION__);
+            goto ERO_END;
+        }
+        sfcb_queue_stats(&sfcb, 0, &st);
+        if ( 0 == st.uint16DefRecs ) {
+            break;
+        }
+    }
+    printf("INFO:%s: aged records written after %d calls\n", __FUNCTION__, uint32Calls);
+    if ( (uint32Calls < 50) || (200 == uint32Calls) ) {
+        printf("ERROR:%s: burst by age\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* brown-out */
+    for ( uint8_t i = 0; i < 3; i++ ) {
+        memset(uint8Exp + i*sizeof(uint8Rec), 0x40 + i, sizeof(uint8Rec));
+        sfcb_add_defer(&sfcb, 0, uint8Exp + i*sizeof(uint8Rec));
+    }
+    sfcb_flush(&sfcb);
+    run_sfcb_idle(&flash, &sfcb, 40);
+    sfcb_queue_stats(&sfcb, 0, &st);
+    if ( (0 != st.uint16DefRecs) || (0 == flash.uint8Dpd) ) {
+        printf("ERROR:%s: flush\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* last burst, job releases flash from deep power-down */
+    if ( 0 != run_sfcb_get_last(&flash, &sfcb, 0, uint8Rd, sizeof(uint8Rd), &uint32ElemID) ) {
+        goto ERO_END;
+    }
+    if ( (15 != uint32ElemID) || (0 != mem_cmp(uint8Rd, uint8Exp, sizeof(uint8Exp))) ) {
+        printf("ERROR:%s: read back, id=%d\n", __FUNCTION__, uint32ElemID);
+        goto ERO_END;
+    }
+    /* all done */
+    ret = 0;
+
+    /* release flash model */
+    ERO_END:
+        free(flash.uint8PtrMem);
+        return ret;
+}
+
+
+
+/**
+ *  @brief test_quad
+ *
+ *  quad input page program: sets quad enable bit in status register 2,
+ *  all page programs of an element request four data lanes
+ *
+ *  @return         int                 test state
+ *  @retval         0                   Success
+ *  @retval         -1                  Fail
+ *  @since          October 18, 2026
+ */
+static int test_quad (void)
+{
+    /** Variables **/
+    t_sfm           flash;              // SPI flash model
+    t_sfcb          sfcb;               // handle
+    t_sfcb_cb       sfcb_cb[1];         // queue table
+    uint8_t         uint8Wr[600];       // element spans three pages
+    uint8_t         uint8Rd[600];       // read buffer
+    uint32_t        uint32Cmds;         // SPI packets of quad enable job
+    uint32_t        uint32ElemID;       // read element ID
+    uint16_t        uint16Quad = 0;     // quad page programs
+    uint16_t        uint16Single = 0;   // single lane page programs
+    t_test_q        q = {0x47114711, sizeof(uint8Wr), 8, SFCB_FMT_HEAD_FOOT};
+    int             ret = -1;
+
+    /* entry message */
+    printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    if ( 0 != run_sfcb_setup(&flash, &sfcb, sfcb_cb, 1, &q, 1, TEST_FIX_FLASH | TEST_FIX_MKCB) ) {
+        goto ERO_END;
+    }
+    /* set quad enable bit */
+    if ( (0 != sfcb_quad(&sfcb, 1)) || (0 != run_sfm_update(&flash, &sfcb)) || (0 != sfcb_isero(&sfcb)) || (0 == (flash.uint8Sr2 & 0x02)) ) {
+        printf("ERROR:%s:sfcb_quad, sr2=0x%x\n", __FUNCTION__, flash.uint8Sr2);
+        goto ERO_END;
+    }
+    /* element with quad page programs */
+    for ( uint16_t i = 0; i < sizeof(uint8Wr); i++ ) {
+        uint8Wr[i] = (uint8_t) (i * 7);
+    }
+    if ( 0 != sfcb_add(&sfcb, 0, uint8Wr, sizeof(uint8Wr)) ) {
+        printf("ERROR:%s:sfcb_add\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    while ( 0 != sfcb_busy(&sfcb) ) {
+        sfcb_worker(&sfcb);
+        if ( (0 != sfcb_spi_len(&sfcb)) && (0x32 == g_uint8Spi[0]) && (4 == sfcb_spi_lanes(&sfcb)) ) {
+            uint16Quad++;
+        }
+        if ( ((0 != sfcb_spi_len(&sfcb)) && (0x02 == g_uint8Spi[0])) || ((0x05 == g_uint8Spi[0]) && (1 != sfcb_spi_lanes(&sfcb))) ) {
+            uint16Single++;
+        }
+        if ( 0 != sfm(&flash, (uint8_t*) &g_uint8Spi, sfcb_spi_len(&sfcb)) ) {
+            printf("ERROR:%s:spi_flash_model\n", __FUNCTION__);
+            goto ERO_END;
+        }
+    }
+    printf("INFO:%s: page programs, quad=%d, single=%d\n", __FUNCTION__, uint16Quad, uint16Single);
+    if ( (uint16Quad < 3) || (0 != uint16Single) ) {
+        printf("ERROR:%s: quad page program\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( (0 != sfcb_mkcb(&sfcb)) || (0 != run_sfm_update(&flash, &sfcb)) ) {
+        printf("ERROR:%s:sfcb_mkcb\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( (0 != run_sfcb_get_last(&flash, &sfcb, 0, uint8Rd, sizeof(uint8Rd), &uint32ElemID)) || (0 != mem_cmp(uint8Rd, uint8Wr, sizeof(uint8Wr))) ) {
+        printf("ERROR:%s: read back\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* quad enable already set, no status register write */
+    uint32Cmds = flash.uint32Cmds;
+    if ( (0 != sfcb_quad(&sfcb, 1)) || (0 != run_sfm_update(&flash, &sfcb)) || (2 != flash.uint32Cmds - uint32Cmds) ) {
+        printf("ERROR:%s: quad enable set, cmds=%d\n", __FUNCTION__, flash.uint32Cmds - uint32Cmds);
+        goto ERO_END;
+    }
+    /* all done */
+    ret = 0;
+
+    /* release flash model */
+    ERO_END:
+        free(flash.uint8PtrMem);
+        return ret;
+}
+
+
+
+/**
+ *  @brief test_read_q
+ *
+ *  read requests: adjacent and overlapping ranges are merged into one
+ *  read transaction, data is scattered to every requester
+ *
+ *  @return         int                 test state
+ *  @retval         0                   Success
+ *  @retval         -1                  Fail
+ *  @since          October 18, 2026
+ */
+static int test_read_q (void)
+{
+    /** Variables **/
+    t_sfm           flash;              // SPI flash model
+    t_sfcb          sfcb;               // handle
+    t_sfcb_cb       sfcb_cb[1];         // queue table
+    t_sfcb_rd       rdq[4];             // read request table
+    uint32_t        uint32Adr[4] = {0x100, 0x110, 0x108, 0x2000};   // two adjacent, one overlapping, one apart
+    uint16_t        uint16Len[4] = {16, 16, 8, 4};
+    uint8_t         uint8Rd[4][16];     // read buffers
+    uint8_t         uint8ReqID[4];      // request slots
+    uint8_t         uint8Temp;          // help variable
+    int             ret = -1;
+
+    /* entry message */
+    printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    if ( 0 != run_sfcb_setup(&flash, &sfcb, sfcb_cb, 1, NULL, 0, TEST_FIX_FLASH) ) {
+        goto ERO_END;
+    }
+    for ( uint32_t i = 0; i < 0x3000; i++ ) {
+        flash.uint8PtrMem[i] = (uint8_t) (i ^ (i >> 8));
+    }
+    sfcb_read_q(&sfcb, rdq, 4);
+    for ( uint8_t i = 0; i < 4; i++ ) {
+        if ( 0 != sfcb_read_req(&sfcb, uint32Adr[i], uint8Rd[i], uint16Len[i], &(uint8ReqID[i])) ) {
+            printf("ERROR:%s:sfcb_read_req\n", __FUNCTION__);
+            goto ERO_END;
+        }
+    }
+    if ( (SFCB_E_MEM != sfcb_read_req(&sfcb, 0, &uint8Temp, 1, &uint8Temp)) || (SFCB_E_WKR_REQ != sfcb_read_done(&sfcb, uint8ReqID[0])) ) {
+        printf("ERROR:%s: request table full\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    run_sfcb_idle(&flash, &sfcb, 16);
+    printf("INFO:%s: read transactions=%d\n", __FUNCTION__, sfcb.uint32RdXfers);
+    if ( 2 != sfcb.uint32RdXfers ) {
+        printf("ERROR:%s: reads not merged\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    for ( uint8_t i = 0; i < 4; i++ ) {
+        if ( (0 != sfcb_read_done(&sfcb, uint8ReqID[i])) || (0 != mem_cmp(uint8Rd[i], flash.uint8PtrMem+uint32Adr[i], uint16Len[i])) ) {
+            printf("ERROR:%s: request=%d\n", __FUNCTION__, i);
+            goto ERO_END;
+        }
+    }
+    /* all done */
+    ret = 0;
+
+    /* release flash model */
+    ERO_END:
+        free(flash.uint8PtrMem);
+        return ret;
+}
+
+
+
+/**
+ *  @brief test_blank
+ *
+ *  blank check: erased region, programmed byte in middle of chunk,
+ *  unaligned start and worker busy
+ *
+ *  @return         int                 test state
+ *  @retval         0                   Success
+ *  @retval         -1                  Fail
+ *  @since          October 18, 2026
+ */
+static int test_blank (void)
+{
+    /** Variables **/
+    t_sfm           flash;              // SPI flash model
+    t_sfcb          sfcb;               // handle
+    t_sfcb_cb       sfcb_cb[1];         // queue table
+    uint32_t        uint32Used;         // first programmed address
+    int             ret = -1;
+
+    /* entry message */
+    printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    if ( 0 != run_sfcb_setup(&flash, &sfcb, sfcb_cb, 1, NULL, 0, TEST_FIX_FLASH) ) {
+        goto ERO_END;
+    }
+    /* erased region */
+    if ( 0 != sfcb_blank_check(&sfcb, 0x1003, 0x2000, &uint32Used) ) {
+        printf("ERROR:%s:sfcb_blank_check\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( SFCB_E_WKR_BSY != sfcb_blank_check(&sfcb, 0, 1, &uint32Used) ) {
+        printf("ERROR:%s: worker busy\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    run_sfcb_idle(&flash, &sfcb, 64);
+    if ( (0 != sfcb_isero(&sfcb)) || (UINT32_MAX != uint32Used) ) {
+        printf("ERROR:%s: erased region, used=0x%x\n", __FUNCTION__, uint32Used);
+        goto ERO_END;
+    }
+    /* programmed byte, last byte of region */
+    flash.uint8PtrMem[0x1234] = 0x7F;
+    if ( 0 != sfcb_blank_check(&sfcb, 0x1003, 0x1234-0x1003+1, &uint32Used) ) {
+        printf("ERROR:%s:sfcb_blank_check\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    run_sfcb_idle(&flash, &sfcb, 64);
+    if ( 0x1234 != uint32Used ) {
+        printf("ERROR:%s: programmed byte, used=0x%x\n", __FUNCTION__, uint32Used);
+        goto ERO_END;
+    }
+    /* region ends before programmed byte */
+    if ( 0 != sfcb_blank_check(&sfcb, 0x1003, 0x1234-0x1003, &uint32Used) ) {
+        printf("ERROR:%s:sfcb_blank_check\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    run_sfcb_idle(&flash, &sfcb, 64);
+    if ( (0 != sfcb_busy(&sfcb)) || (UINT32_MAX != uint32Used) ) {
+        printf("ERROR:%s: region end, used=0x%x\n", __FUNCTION__, uint32Used);
+        goto ERO_END;
+    }
+    /* all done */
+    ret = 0;
+
+    /* release flash model */
+    ERO_END:
+        free(flash.uint8PtrMem);
+        return ret;
+}
+
+
+
+/**
+ *  @brief test_pin
+ *
+ *  reader pin: blocked erase applies backpressure and keeps queue readable,
+ *  released pin erases, drop policy erases and reports conflict
+ *
+ *  @return         int                 test state
+ *  @retval         0                   Success
+ *  @retval         -1                  Fail
+ *  @since          October 18, 2026
+ */
+static int test_pin (void)
+{
+    /** Variables **/
+    t_sfm           flash;              // SPI flash model
+    t_sfcb          sfcb;               // handle
+    t_sfcb_cb       sfcb_cb[1];         // queue table
+    uint8_t         uint8Wr[240];       // element payload, element slot divides sector
+    uint8_t         uint8Rd[240];
+    uint32_t        uint32Adr;          // queue start
+    uint32_t        uint32Len;          // queue size
+    uint32_t        uint32ElemID;
+    uint32_t        uint32Adds = 0;     // accepted adds until backpressure
+    int             sfcbState = SFCB_OK;    // add state
+    t_test_q        q = {0x47114711, sizeof(uint8Wr), 16, SFCB_FMT_HEAD_FOOT};
+    int             ret = -1;
+
+    /* entry message */
+    printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    if ( 0 != run_sfcb_setup(&flash, &sfcb, sfcb_cb, 1, &q, 1, TEST_FIX_FLASH | TEST_FIX_MKCB) ) {
+        goto ERO_END;
+    }
+    uint32Adr = sfcb_cb[0].uint32StartSector * SFCB_FLASH_TOPO_SECTOR_SIZE;
+    uint32Len = (sfcb_cb[0].uint32StopSector + 1 - sfcb_cb[0].uint32StartSector) * SFCB_FLASH_TOPO_SECTOR_SIZE;
+    /* pin complete queue, backpressure */
+    if ( (SFCB_E_MEM != sfcb_pin(&sfcb, 0, uint32Adr, uint32Len + 1, SFCB_PIN_BLOCK)) || (0 != sfcb_pin(&sfcb, 0, uint32Adr, uint32Len, SFCB_PIN_BLOCK)) ) {
+        printf("ERROR:%s:sfcb_pin\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    for ( uint32_t i = 0; i < 4 * sfcb_cb[0].uint16NumEntriesMax; i++ ) {
+        memset(uint8Wr, (int) i, sizeof(uint8Wr));
+        sfcbState = sfcb_add(&sfcb, 0, uint8Wr, sizeof(uint8Wr));
+        if ( SFCB_OK != sfcbState ) {
+            break;
+        }
+        uint32Adds++;
+        if ( (0 != run_sfm_update(&flash, &sfcb)) || (0 != sfcb_mkcb(&sfcb)) || (0 != run_sfm_update(&flash, &sfcb)) ) {
+            printf("ERROR:%s: add=%d\n", __FUNCTION__, i);
+            goto ERO_END;
+        }
+    }
+    printf("INFO:%s: adds=%d until backpressure, conflicts=%d\n", __FUNCTION__, uint32Adds, sfcb_cb[0].uint32PinConflicts);
+    if ( (SFCB_E_PIN != sfcbState) || (uint32Adds != sfcb_cb[0].uint16NumEntriesMax) || (SFCB_E_PIN != sfcb_pin_state(&sfcb, 0)) ) {
+        printf("ERROR:%s: no backpressure\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* newest element is readable, oldest not erased */
+    memset(uint8Wr, (int) (uint32Adds - 1), sizeof(uint8Wr));
+    if ( (0 != sfcb_get_last(&sfcb, 0, uint8Rd, sizeof(uint8Rd), &uint32ElemID)) || (0 != run_sfm_update(&flash, &sfcb)) || (0 != mem_cmp(uint8Rd, uint8Wr, sizeof(uint8Rd))) ) {
+        printf("ERROR:%s: get last while blocked\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( 0xFF == flash.uint8PtrMem[sfcb_cb[0].uint32StartPageIdMin] ) {
+        printf("ERROR:%s: pinned oldest element erased\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* release, erase oldest sector */
+    if ( (0 != sfcb_pin(&sfcb, 0, 0, 0, SFCB_PIN_BLOCK)) || (SFCB_E_PIN != sfcb_pin_state(&sfcb, 0)) ) {
+        printf("ERROR:%s: release\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( (0 != sfcb_mkcb(&sfcb)) || (0 != run_sfm_update(&flash, &sfcb)) || (0 != sfcb_add(&sfcb, 0, uint8Wr, sizeof(uint8Wr))) || (0 != run_sfm_update(&flash, &sfcb)) ) {
+        printf("ERROR:%s: add after release\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* drop oldest, reader is informed */
+    if ( (0 != sfcb_mkcb(&sfcb)) || (0 != run_sfm_update(&flash, &sfcb)) || (0 != sfcb_pin(&sfcb, 0, uint32Adr, uint32Len, SFCB_PIN_DROP)) ) {
+        printf("ERROR:%s:sfcb_pin\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    for ( uint32_t i = 0; i < sfcb_cb[0].uint16NumEntriesMax; i++ ) {
+        if ( (0 != sfcb_add(&sfcb, 0, uint8Wr, sizeof(uint8Wr))) || (0 != run_sfm_update(&flash, &sfcb)) || (0 != sfcb_mkcb(&sfcb)) || (0 != run_sfm_update(&flash, &sfcb)) ) {
+            printf("ERROR:%s: drop add=%d\n", __FUNCTION__, i);
+            goto ERO_END;
+        }
+    }
+    if ( SFCB_E_PIN != sfcb_pin_state(&sfcb, 0) ) {
+        printf("ERROR:%s: drop not reported\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* all done */
+    ret = 0;
+
+    /* release flash model */
+    ERO_END:
+        free(flash.uint8PtrMem);
+        return ret;
+}
+
+
+
+/**
+ *  @brief test_reclaim
+ *
+ *  block reclaim: full queue frees the aligned 32KiB block of the oldest
+ *  elements with one erase instruction, elements behind block are kept
+ *
+ *  @return         int                 test state
+ *  @retval         0                   Success
+ *  @retval         -1                  Fail
+ *  @since          October 18, 2026
+ */
+static int test_reclaim (void)
+{
+    /** Variables **/
+    t_sfm           flash;              // SPI flash model
+    t_sfcb          sfcb;               // handle
+    t_sfcb_cb       sfcb_cb[1];         // queue table
+    uint8_t         uint8Wr[240];       // element payload, element slot divides sector
+    uint32_t        uint32Erase[2] = {0, 0};    // sector, block erase instructions
+    t_test_q        q = {0x47114711, sizeof(uint8Wr), 140, SFCB_FMT_HEAD_FOOT};   // 9 sectors
+    int             ret = -1;
+
+    /* entry message */
+    printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    if ( 0 != run_sfcb_setup(&flash, &sfcb, sfcb_cb, 1, &q, 1, TEST_FIX_FLASH) ) {
+        goto ERO_END;
+    }
+    if ( (SFCB_E_NO_FLASH != sfcb_reclaim(&sfcb, 0, 16384)) || (0 != sfcb_reclaim(&sfcb, 0, 32768)) ) {
+        printf("ERROR:%s:sfcb_reclaim\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* fill queue until first reclaim */
+    for ( uint32_t i = 0; (0 == uint32Erase[0]) && (0 == uint32Erase[1]); i++ ) {
+        memset(uint8Wr, (int) i, sizeof(uint8Wr));
+        if ( (0 != sfcb_mkcb(&sfcb)) || (i > 2u * sfcb_cb[0].uint16NumEntriesMax) ) {
+            printf("ERROR:%s:sfcb_mkcb\n", __FUNCTION__);
+            goto ERO_END;
+        }
+        while ( 0 != sfcb_busy(&sfcb) ) {
+            sfcb_worker(&sfcb);
+            if ( 0 != sfcb_spi_len(&sfcb) ) {
+                uint32Erase[0] += (uint32_t) (0x20 == g_uint8Spi[0]);
+                uint32Erase[1] += (uint32_t) (0x52 == g_uint8Spi[0]);
+            }
+            sfm(&flash, (uint8_t*) &g_uint8Spi, sfcb_spi_len(&sfcb));
+        }
+        if ( (0 != sfcb_add(&sfcb, 0, uint8Wr, sizeof(uint8Wr))) || (0 != run_sfm_update(&flash, &sfcb)) ) {
+            printf("ERROR:%s:sfcb_add\n", __FUNCTION__);
+            goto ERO_END;
+        }
+    }
+    printf("INFO:%s: erase sector=%d, block=%d, entries=%d\n", __FUNCTION__, uint32Erase[0], uint32Erase[1], sfcb_cb[0].uint16NumEntries);
+    if ( (0 != uint32Erase[0]) || (1 != uint32Erase[1]) || (0xFF == flash.uint8PtrMem[0]) || (0xFF != flash.uint8PtrMem[32768-1]) || (0xFF == flash.uint8PtrMem[32768]) ) {
+        printf("ERROR:%s: block reclaim\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* all done */
+    ret = 0;
+
+    /* release flash model */
+    ERO_END:
+        free(flash.uint8PtrMem);
+        return ret;
+}
+
+
+
+/**
+ *  @brief test_export
+ *
+ *  export container: wrapped queue streams elements from oldest to newest
+ *  with complete payload, 0xFF tail is exported, container smaller than occupied slots
+ *
+ *  @return         int                 test state
+ *  @retval         0                   Success
+ *  @retval         -1                  Fail
+ *  @since          October 18, 2026
+ */
+static int test_export (void)
+{
+    /** Variables **/
+    t_sfm           flash;              // SPI flash model
+    t_sfcb          sfcb;               // handle
+    t_sfcb_cb       sfcb_cb[1];         // queue table
+    uint8_t         uint8Wr[200];       // element payload
+    uint8_t         uint8Part[200+SFCB_EXP_ELEM_OVH];   // container part
+    uint16_t        uint16Used;
+    uint16_t        uint16Len;          // element payload length
+    uint32_t        uint32ID = 0;       // element ID
+    uint32_t        uint32Cnt = 0;      // exported elements
+    uint32_t        uint32Size = 0;     // container size
+    uint32_t        uint32Val;          // decoded varint
+    uint8_t         uint8Pos;
+    int             sfcbState;          // export state
+    t_test_q        q = {0x47114711, sizeof(uint8Wr), 30, SFCB_FMT_HEAD_FOOT};
+    int             ret = -1;
+
+    /* entry message */
+    printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    if ( 0 != run_sfcb_setup(&flash, &sfcb, sfcb_cb, 1, &q, 1, TEST_FIX_FLASH) ) {
+        goto ERO_END;
+    }
+    if ( SFCB_E_WKR_REQ != sfcb_export(&sfcb, 0, uint8Part, sizeof(uint8Part), &uint16Used) ) {
+        printf("ERROR:%s: export without mkcb\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* fill beyond queue size, payload i+1 bytes, written 0xFF tail */
+    for ( uint32_t i = 0; i < 70; i++ ) {
+        memset(uint8Wr, 0xFF, sizeof(uint8Wr));
+        memset(uint8Wr, (int) i, i+1);
+        if ( (0 != sfcb_mkcb(&sfcb)) || (0 != run_sfm_update(&flash, &sfcb)) ) {
+            printf("ERROR:%s:sfcb_mkcb\n", __FUNCTION__);
+            goto ERO_END;
+        }
+        if ( (0 != sfcb_add(&sfcb, 0, uint8Wr, sizeof(uint8Wr))) || (0 != run_sfm_update(&flash, &sfcb)) ) {
+            printf("ERROR:%s:sfcb_add\n", __FUNCTION__);
+            goto ERO_END;
+        }
+    }
+    if ( (0 != sfcb_mkcb(&sfcb)) || (0 != run_sfm_update(&flash, &sfcb)) ) {
+        printf("ERROR:%s:sfcb_mkcb\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( SFCB_E_MEM != sfcb_export(&sfcb, 0, uint8Part, sizeof(uint8Wr), &uint16Used) ) {
+        printf("ERROR:%s: buffer size check\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* header */
+    if ( (0 != sfcb_export(&sfcb, 0, uint8Part, sizeof(uint8Part), &uint16Used)) || (0 != run_sfm_update(&flash, &sfcb)) ) {
+        printf("ERROR:%s:sfcb_export\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( (SFCB_EXP_HEAD_LEN != uint16Used) || (0 != memcmp(uint8Part, SFCB_EXP_MAGIC, 4)) || (SFCB_EXP_VER != uint8Part[4]) || (200 != uint8Part[9]) ) {
+        printf("ERROR:%s: container header\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    uint32Size += uint16Used;
+    /* elements until trailer */
+    while ( 1 ) {
+        if ( (0 != sfcb_export(&sfcb, 0, uint8Part, sizeof(uint8Part), &uint16Used)) || (0 != run_sfm_update(&flash, &sfcb)) ) {
+            printf("ERROR:%s:sfcb_export\n", __FUNCTION__);
+            goto ERO_END;
+        }
+        uint32Size += uint16Used;
+        if ( 0 == uint8Part[0] ) {
+            break;  // zero ID delta marks trailer
+        }
+        uint8Pos = 0;
+        for ( uint8_t j = 0; j < 2; j++ ) {
+            uint32Val = 0;
+            for ( uint8_t k = 0; ; k = (uint8_t) (k + 7) ) {
+                uint32Val |= (uint32_t) (uint8Part[uint8Pos] & 0x7F) << k;
+                if ( 0 == (uint8Part[uint8Pos++] & 0x80) ) {
+                    break;
+                }
+            }
+            if ( 0 == j ) {
+                uint32ID += uint32Val;
+            } else {
+                uint16Len = (uint16_t) uint32Val;
+            }
+        }
+        if ( (0 != uint32Cnt) && (uint32ID != uint32Cnt + 1 + (70 - sfcb_cb[0].uint16NumEntries)) ) {
+            printf("ERROR:%s: element order, id=%d\n", __FUNCTION__, uint32ID);
+            goto ERO_END;
+        }
+        if (    (uint16Len != sizeof(uint8Wr)) || ((uint16_t) (uint8Pos + uint16Len + 2) != uint16Used)
+             || (uint8Part[uint8Pos+uint32ID-1] != (uint8_t) (uint32ID - 1)) || (0xFF != uint8Part[uint8Pos+uint16Len-1])
+        ) {
+            printf("ERROR:%s: element id=%d, len=%d\n", __FUNCTION__, uint32ID, uint16Len);
+            goto ERO_END;
+        }
+        uint32Cnt++;
+    }
+    printf("INFO:%s: elements=%d, container=%d byte, slots=%d byte\n", __FUNCTION__, uint32Cnt, uint32Size, sfcb_cb[0].uint16NumEntries * sfcb_cb[0].uint32SlotSize);
+    if ( (uint32Cnt != sfcb_cb[0].uint16NumEntries) || (70 != uint32ID) || (uint8Part[1] != uint32Cnt) || !(uint32Size < sfcb_cb[0].uint16NumEntries * sfcb_cb[0].uint32SlotSize) ) {
+        printf("ERROR:%s: container trailer\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* container complete */
+    sfcbState = sfcb_export(&sfcb, 0, uint8Part, sizeof(uint8Part), &uint16Used);
+    if ( SFCB_E_CB_Q_MTY != sfcbState ) {
+        printf("ERROR:%s: export end, ret=%d\n", __FUNCTION__, sfcbState);
+        goto ERO_END;
+    }
+    /* all done */
+    ret = 0;
+
+    /* release flash model */
+    ERO_END:
+        free(flash.uint8PtrMem);
+        return ret;
+}
+
+
+
+/**
+ *  @brief test_ucode
+ *
+ *  table driven raw read: read back, and job end with error if the SPI
+ *  buffer is too small for the requested length
+ *
+ *  @return         int                 test state
+ *  @retval         0                   Success
+ *  @retval         -1                  Fail
+ *  @since          October 18, 2026
+ */
+static int test_ucode (void)
+{
+    /** Variables **/
+    t_sfm           flash;              // SPI flash model
+    t_sfcb          sfcb;               // handle
+    t_sfcb_cb       sfcb_cb[1];         // queue table
+    uint8_t         uint8Rd[300];       // read buffer, exceeds SPI buffer
+    int             ret = -1;
+
+    /* entry message */
+    printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    if ( 0 != run_sfcb_setup(&flash, &sfcb, sfcb_cb, 1, NULL, 0, TEST_FIX_FLASH) ) {
+        goto ERO_END;
+    }
+    for ( uint16_t i = 0; i < sizeof(uint8Rd); i++ ) {
+        flash.uint8PtrMem[0x100+i] = (uint8_t) i;
+    }
+    /* read back */
+    memset(uint8Rd, 0, sizeof(uint8Rd));
+    if ( (0 != sfcb_flash_read(&sfcb, 0x100, uint8Rd, 64)) || (0 != run_sfm_update(&flash, &sfcb)) || (0 != sfcb_isero(&sfcb)) ) {
+        printf("ERROR:%s:sfcb_flash_read\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( (0 != mem_cmp(uint8Rd, flash.uint8PtrMem+0x100, 64)) || (0 != uint8Rd[64]) ) {
+        printf("ERROR:%s: read data\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* SPI buffer too small, job ends without read */
+    if ( 0 != sfcb_flash_read(&sfcb, 0x100, uint8Rd, sizeof(uint8Rd)) ) {
+        printf("ERROR:%s:sfcb_flash_read\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    run_sfm_update(&flash, &sfcb);
+    if ( (0 != sfcb_busy(&sfcb)) || (0 == sfcb_isero(&sfcb)) || (0 != uint8Rd[64]) ) {
+        printf("ERROR:%s: SPI buffer size check\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* all done */
+    ret = 0;
+
+    /* release flash model */
+    ERO_END:
+        free(flash.uint8PtrMem);
+        return ret;
+}
+
+
+
+/**
+ *  @brief test transform stage state
+ */
+typedef struct t_test_xfrm
+{
+    uint16_t    uint16Sum;  // checksum stage: sum of plain payload
+    uint8_t     uint8Key;   // cipher stage: key
+    uint32_t    uint32Pos;  // cipher stage: key stream position
+} t_test_xfrm;
+
+
+
+/**
+ *  @brief checksum stage
+ *
+ *  sum of plain payload as metadata
+ *
+ *  @since          October 18, 2026
+ */
+static void test_xfrm_sum_start (void *ctx, uint32_t elemID, t_sfcb_xfrm_dir dir)
+{
+    (void) elemID;
+    (void) dir;
+    ((t_test_xfrm*) ctx)->uint16Sum = 0;
+}
+static void test_xfrm_sum_chunk (void *ctx, uint8_t *data, uint16_t len, t_sfcb_xfrm_dir dir)
+{
+    (void) dir;
+    for ( uint16_t i = 0; i < len; i++ ) {
+        ((t_test_xfrm*) ctx)->uint16Sum = (uint16_t) (((t_test_xfrm*) ctx)->uint16Sum + data[i]);
+    }
+}
+static int test_xfrm_sum_end (void *ctx, uint8_t *meta, t_sfcb_xfrm_dir dir)
+{
+    if ( SFCB_XFRM_ENC == dir ) {
+        memcpy(meta, &(((t_test_xfrm*) ctx)->uint16Sum), sizeof(uint16_t));
+        return 0;
+    }
+    return memcmp(meta, &(((t_test_xfrm*) ctx)->uint16Sum), sizeof(uint16_t));
+}
+
+
+
+/**
+ *  @brief cipher stage
+ *
+ *  xor with key stream of key, element ID and position, key as metadata
+ *
+ *  @since          October 18, 2026
+ */
+static void test_xfrm_xor_start (void *ctx, uint32_t elemID, t_sfcb_xfrm_dir dir)
+{
+    (void) dir;
+    ((t_test_xfrm*) ctx)->uint32Pos = elemID * 131;
+}
+static void test_xfrm_xor_chunk (void *ctx, uint8_t *data, uint16_t len, t_sfcb_xfrm_dir dir)
+{
+    (void) dir;
+    for ( uint16_t i = 0; i < len; i++ ) {
+        data[i] = (uint8_t) (data[i] ^ (((t_test_xfrm*) ctx)->uint8Key + (((t_test_xfrm*) ctx)->uint32Pos)++));
+    }
+}
+static int test_xfrm_xor_end (void *ctx, uint8_t *meta, t_sfcb_xfrm_dir dir)
+{
+    if ( SFCB_XFRM_ENC == dir ) {
+        *meta = ((t_test_xfrm*) ctx)->uint8Key;
+        return 0;
+    }
+    return (*meta != ((t_test_xfrm*) ctx)->uint8Key);
+}
+
+
+
+/**
+ *  @brief test_xfrm
+ *
+ *  payload transform chain: checksum and cipher stage, flash holds
+ *  transformed payload and metadata in front of footer, get restores
+ *  payload and detects corruption, ID dependent key stream of an element
+ *  older than the element in write
+ *
+ *  @return         int                 test state
+ *  @retval         0                   Success
+ *  @retval         -1                  Fail
+ *  @since          October 18, 2026
+ */
+static int test_xfrm (void)
+{
+    /** Variables **/
+    t_sfm           flash;              // SPI flash model
+    t_sfcb          sfcb;               // handle
+    t_sfcb_cb       sfcb_cb[3];         // queue table
+    t_test_xfrm     ctx;                // stage state
+    t_sfcb_xfrm     chain[2] = {
+                        {test_xfrm_sum_start, test_xfrm_sum_chunk, test_xfrm_sum_end, &ctx, 2},
+                        {test_xfrm_xor_start, test_xfrm_xor_chunk, test_xfrm_xor_end, &ctx, 1}
+                    };
+    uint8_t         uint8Wr[600];       // element spans three pages
+    uint8_t         uint8Rd[600];       // read buffer
+    uint32_t        uint32Adr;          // payload of newest element
+    uint32_t        uint32ElemID;       // read element ID
+    t_test_q        q[3] = {
+                        {0x47114711, sizeof(uint8Wr), 8, SFCB_FMT_HEAD_FOOT},
+                        {0x08150815, 240, 16, SFCB_FMT_HEAD_FOOT},   // slot without spare bytes
+                        {0x12345678, 200, 16, SFCB_FMT_COMMIT}       // no footer
+                    };
+    int             ret = -1;
+
+    /* entry message */
+    printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    if ( 0 != run_sfcb_setup(&flash, &sfcb, sfcb_cb, 3, q, 3, TEST_FIX_FLASH) ) {
+        goto ERO_END;
+    }
+    ctx.uint8Key = 0x5a;
+    if ( (0 != sfcb_xfrm(&sfcb, 0, chain, 2)) || (SFCB_E_MEM != sfcb_xfrm(&sfcb, 1, chain, 2)) || (SFCB_E_FMT != sfcb_xfrm(&sfcb, 2, chain, 2)) ) {
+        printf("ERROR:%s:sfcb_xfrm\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( (0 != sfcb_mkcb(&sfcb)) || (0 != run_sfm_update(&flash, &sfcb)) ) {
+        printf("ERROR:%s:sfcb_mkcb\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* two elements, caller data untouched */
+    for ( uint8_t j = 0; j < 2; j++ ) {
+        for ( uint16_t i = 0; i < sizeof(uint8Wr); i++ ) {
+            uint8Wr[i] = (uint8_t) (i * 7 + j);
+        }
+        memcpy(uint8Rd, uint8Wr, sizeof(uint8Rd));
+        if ( (0 != run_sfcb_add(&flash, &sfcb, 0, uint8Wr, sizeof(uint8Wr))) || (0 != mem_cmp(uint8Wr, uint8Rd, sizeof(uint8Wr))) ) {
+            printf("ERROR:%s:sfcb_add\n", __FUNCTION__);
+            goto ERO_END;
+        }
+    }
+    /* flash holds transformed payload, metadata in front of footer */
+    uint32Adr = sfcb_cb[0].uint32StartPageIdMax;
+    if (    (0 == memcmp(flash.uint8PtrMem+uint32Adr+8, uint8Wr, sizeof(uint8Wr)))
+         || (0x5a != flash.uint8PtrMem[uint32Adr+sfcb_cb[0].uint32SlotSize-8-1])
+         || (0 != memcmp(flash.uint8PtrMem+uint32Adr+sfcb_cb[0].uint32SlotSize-8, flash.uint8PtrMem+uint32Adr, 8))
+    ) {
+        printf("ERROR:%s: flash layout\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* get restores payload */
+    memset(uint8Rd, 0, sizeof(uint8Rd));
+    if ( (0 != run_sfcb_get_last(&flash, &sfcb, 0, uint8Rd, sizeof(uint8Rd), &uint32ElemID)) || (0 != sfcb_isero(&sfcb)) || (0 != mem_cmp(uint8Rd, uint8Wr, sizeof(uint8Wr))) ) {
+        printf("ERROR:%s: read back\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* corrupted payload is rejected */
+    flash.uint8PtrMem[uint32Adr+8+300] ^= 0x10;
+    if ( (0 != run_sfcb_get_last(&flash, &sfcb, 0, uint8Rd, sizeof(uint8Rd), &uint32ElemID)) || (0 == sfcb_isero(&sfcb)) ) {
+        printf("ERROR:%s: corruption not detected\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* newest complete element is older than element in write, key stream of read element */
+    if ( (0 != sfcb_add(&sfcb, 0, uint8Wr, 100)) || (0 != run_sfm_update(&flash, &sfcb)) ) {
+        printf("ERROR:%s:sfcb_add\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    flash.uint8PtrMem[uint32Adr+sfcb_cb[0].uint32SlotSize-1] ^= 0x01;   // footer of second element
+    if ( (0 != sfcb_mkcb(&sfcb)) || (0 != run_sfm_update(&flash, &sfcb)) || (sfcb_idmax(&sfcb, 0) == sfcb_cb[0].uint32ElemIdLastCpl) ) {
+        printf("ERROR:%s:sfcb_mkcb\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    for ( uint16_t i = 0; i < sizeof(uint8Wr); i++ ) {
+        uint8Wr[i] = (uint8_t) (i * 7);
+    }
+    memset(uint8Rd, 0, sizeof(uint8Rd));
+    if ( (0 != run_sfcb_get_last(&flash, &sfcb, 0, uint8Rd, sizeof(uint8Rd), &uint32ElemID)) || (0 != sfcb_isero(&sfcb)) || (1 != uint32ElemID) || (0 != mem_cmp(uint8Rd, uint8Wr, sizeof(uint8Wr))) ) {
+        printf("ERROR:%s: read back of older element, id=%d\n", __FUNCTION__, uint32ElemID);
+        goto ERO_END;
+    }
+    /* all done */
+    ret = 0;
+
+    /* release flash model */
+    ERO_END:
+        free(flash.uint8PtrMem);
+        return ret;
+}
+
+
+
+/**
+ *  @brief test_arb
+ *
+ *  two flashes on one SPI bus, serviced by the bus arbiter
+ *
+ *  @return         int                 test state
+ *  @retval         0                   Success
+ *  @retval         -1                  Fail
+ *  @since          October 18, 2026
+ */
+static int test_arb (void)
+{
+    /** Variables **/
+    t_sfm           flash[2];           // two SPI flash models
+    t_sfcb          sfcb[2];            // handles
+    t_sfcb_cb       sfcb_cb[2][1];      // one queue per flash
+    t_sfcb_arb      arb;                // bus arbiter
+    t_sfcb_arb_dev  arbDev[2];          // arbiter devices
+    uint8_t         uint8Dev[2];        // device ID
+    uint8_t         uint8Dat[2][64];    // reference data
+    uint8_t         uint8Rd[2][64];     // read buffer
+    uint8_t         uint8Ring[8*32];    // deferred records of device 0
+    uint8_t         uint8DevLast;       // last device on bus
+    uint32_t        uint32Switch;       // device switches on bus
+    uint32_t        uint32Counter;      // time out
+    uint32_t        uint32ElemID;       // read element ID
+    int             sfcbState;          // job start state
+    t_test_q        q = {0x47114711, sizeof(uint8Dat[0]), 16, SFCB_FMT_HEAD_FOOT};
+    int             ret = -1;
+
+    /* entry message */
+    printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* init */
+    memset(flash, 0, sizeof(flash));
+    if ( 0 != sfcb_arb_init(&arb, arbDev, 2, &g_uint8Spi, sizeof(g_uint8Spi)/sizeof(g_uint8Spi[0])) ) {
+        printf("ERROR:%s:sfcb_arb_init\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    for ( uint8_t i = 0; i < 2; i++ ) {
+        if ( 0 != run_sfcb_setup(&flash[i], &sfcb[i], sfcb_cb[i], 1, &q, 1, TEST_FIX_FLASH) ) {
+            goto ERO_END;
+        }
+        if ( 0 != sfcb_arb_add(&arb, &sfcb[i], i, &uint8Dev[i]) ) {
+            printf("ERROR:%s:sfcb_arb_add\n", __FUNCTION__);
+            goto ERO_END;
+        }
+        for ( uint8_t j = 0; j < sizeof(uint8Dat[i]); j++ ) {
+            uint8Dat[i][j] = (uint8_t) (rand() % 256);
+        }
+    }
+    /* build queue, add element and read back on both devices in parallel */
+    uint8DevLast = SFCB_ARB_NONE;
+    uint32Switch = 0;
+    for ( uint8_t uint8Job = 0; uint8Job < 5; uint8Job++ ) {
+        for ( uint8_t i = 0; i < 2; i++ ) {
+            switch (uint8Job) {
+                case 1:
+                    sfcbState = sfcb_add(&sfcb[i], 0, uint8Dat[i], sizeof(uint8Dat[i]));
+                    break;
+                case 2:
+                    sfcbState = sfcb_add_done(&sfcb[i], 0);
+                    break;
+                case 4:
+                    sfcbState = sfcb_get_last(&sfcb[i], 0, uint8Rd[i], sizeof(uint8Rd[i]), &uint32ElemID);
+                    break;
+                default:
+                    sfcbState = sfcb_mkcb(&sfcb[i]);
+                    break;
+            }
+            if ( 0 != sfcbState ) {
+                printf("ERROR:%s:job=%d, dev=%d failed to start\n", __FUNCTION__, uint8Job, i);
+                goto ERO_END;
+            }
+        }
+        /* run bus */
+        uint32Counter = 0;
+        while ( (0 != sfcb_arb_busy(&arb)) && ((uint32Counter++) < g_uint32SpiFlashCycleOut) ) {
+            sfcb_arb_worker(&arb);
+            if ( SFCB_ARB_NONE == sfcb_arb_dev(&arb) ) {
+                continue;
+            }
+            if ( uint8DevLast != sfcb_arb_dev(&arb) ) {
+                uint8DevLast = sfcb_arb_dev(&arb);
+                uint32Switch++;
+            }
+            if ( 0 != sfm(&flash[sfcb_arb_dev(&arb)], (uint8_t*) &g_uint8Spi, sfcb_arb_spi_len(&arb)) ) {
+                printf("ERROR:%s:spi_flash_model dev=%d\n", __FUNCTION__, sfcb_arb_dev(&arb));
+                goto ERO_END;
+            }
+        }
+        if ( uint32Counter >= g_uint32SpiFlashCycleOut ) {
+            printf("ERROR:%s:job=%d timeout\n", __FUNCTION__, uint8Job);
+            goto ERO_END;
+        }
+    }
+    /* check */
+    for ( uint8_t i = 0; i < 2; i++ ) {
+        if ( 0 != mem_cmp(uint8Rd[i], uint8Dat[i], sizeof(uint8Dat[i])) ) {
+            printf("ERROR:%s:dev=%d mem_cmp\n", __FUNCTION__, i);
+            goto ERO_END;
+        }
+    }
+    printf("INFO:%s: util=%d%%, switches=%d, pkts=%d/%d\n", __FUNCTION__, sfcb_arb_util(&arb), uint32Switch, arbDev[0].uint32Pkts, arbDev[1].uint32Pkts);
+    if ( (0 == sfcb_arb_util(&arb)) || (uint32Switch <= 3) ) {
+        printf("ERROR:%s:no interleaving on bus\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* idle work: deferred records without job, deep power-down packet after burst and read */
+    if ( (0 != sfcb_defer(&sfcb[0], 0, uint8Ring, sizeof(uint8Ring), 32, 8, 0)) || (0 != sfcb_deep_pd(&sfcb[0], 1, 2)) ) {
+        printf("ERROR:%s:sfcb_defer\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    for ( uint8_t uint8Job = 0; uint8Job < 2; uint8Job++ ) {
+        if ( 0 == uint8Job ) {
+            sfcbState = sfcb_add_defer(&sfcb[0], 0, uint8Dat[1]) | sfcb_add_defer(&sfcb[0], 0, uint8Dat[1]+32) | sfcb_flush(&sfcb[0]);
+        } else {
+            sfcbState = sfcb_get_last(&sfcb[0], 0, uint8Rd[0], sizeof(uint8Rd[0]), &uint32ElemID);
+        }
+        if ( (0 != sfcbState) || (0 != sfcb_busy(&sfcb[0])) != (0 != uint8Job) ) {
+            printf("ERROR:%s:idle work=%d, failed to start\n", __FUNCTION__, uint8Job);
+            goto ERO_END;
+        }
+        uint32Counter = 0;
+        while ( ((0 != sfcb_arb_busy(&arb)) || (0 != sfcb_idle_work(&sfcb[0]))) && ((uint32Counter++) < g_uint32SpiFlashCycleOut) ) {
+            sfcb_arb_worker(&arb);
+            if ( (SFCB_ARB_NONE != sfcb_arb_dev(&arb)) && (0 != sfm(&flash[sfcb_arb_dev(&arb)], (uint8_t*) &g_uint8Spi, sfcb_arb_spi_len(&arb))) ) {
+                printf("ERROR:%s:spi_flash_model dev=%d\n", __FUNCTION__, sfcb_arb_dev(&arb));
+                goto ERO_END;
+            }
+        }
+        if ( (uint32Counter >= g_uint32SpiFlashCycleOut) || (0 == flash[0].uint8Dpd) ) {
+            printf("ERROR:%s:idle work=%d, dpd=%d\n", __FUNCTION__, uint8Job, flash[0].uint8Dpd);
+            goto ERO_END;
+        }
+    }
+    if ( 0 != mem_cmp(uint8Rd[0], uint8Dat[1], sizeof(uint8Dat[1])) ) {
+        printf("ERROR:%s:deferred records\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* all done */
+    ret = 0;
+
+    /* release flash models */
+    ERO_END:
+        for ( uint8_t i = 0; i < 2; i++ ) {
+            free(flash[i].uint8PtrMem);
+        }
+        return ret;
+}
+
+
+
+/**
+ *  @brief run_arb_wip
+ *
+ *  runs arbiter until all devices are idle, the flash reports WIP for
+ *  _wip_ arbiter ticks after a page program like a real chip in tPP
+ *
+ *  @param[in,out]  *arb                arbiter, #t_sfcb_arb
+ *  @param[in,out]  *flash              flash model per device, #t_sfm
+ *  @param[in]      wip                 page program time in arbiter ticks
+ *  @return         uint32_t            arbiter ticks until idle, zero on error
+ *  @since          October 18, 2026
+ */
+static uint32_t run_arb_wip (t_sfcb_arb *arb, t_sfm *flash, uint32_t wip)
+{
+    /** Variables **/
+    uint32_t    uint32Wip[2] = {0, 0};  // remaining program time per device
+    uint32_t    uint32Ticks = 0;
+    uint8_t     uint8Dev;
+
+    while ( 0 != sfcb_arb_busy(arb) ) {
+        if ( (uint32Ticks++) > g_uint32SpiFlashCycleOut ) {
+            printf("ERROR:%s: timeout\n", __FUNCTION__);
+            return 0;
+        }
+        for ( uint8_t i = 0; i < 2; i++ ) {
+            uint32Wip[i] = (0 != uint32Wip[i]) ? (uint32Wip[i] - 1) : 0;
+        }
+        sfcb_arb_worker(arb);
+        uint8Dev = sfcb_arb_dev(arb);
+        if ( SFCB_ARB_NONE == uint8Dev ) {
+            continue;
+        }
+        if ( 0 != sfm(&flash[uint8Dev], (uint8_t*) &g_uint8Spi, sfcb_arb_spi_len(arb)) ) {
+            printf("ERROR:%s:spi_flash_model dev=%d\n", __FUNCTION__, uint8Dev);
+            return 0;
+        }
+        if ( 0x02 == g_uint8Spi[0] ) {
+            uint32Wip[uint8Dev] = wip;  // page program starts
+        } else if ( (0x05 == g_uint8Spi[0]) && (0 != uint32Wip[uint8Dev]) ) {
+            g_uint8Spi[1] |= 0x01;      // write in progress
+        }
+    }
+    return uint32Ticks;
+}
+
+
+
+/**
+ *  @brief test_arb_mirror
+ *
+ *  mirrored queue on two chips: add starts only if both chips accept, page
+ *  programs overlap, interrupted add is detected and restored, reads are
+ *  balanced over both chips, a lag above one element is rejected
+ *
+ *  @return         int                 test state
+ *  @retval         0                   Success
+ *  @retval         -1                  Fail
+ *  @since          October 18, 2026
+ */
+static int test_arb_mirror (void)
+{
+    /** Variables **/
+    t_sfm           flash[2];           // two SPI flash models
+    t_sfcb          sfcb[2];            // handles
+    t_sfcb_cb       sfcb_cb[2][1];      // one queue per flash
+    t_sfcb_arb      arb;                // bus arbiter
+    t_sfcb_arb_dev  arbDev[2];          // arbiter devices
+    uint8_t         uint8Dev[2];        // device ID
+    uint8_t         uint8Dat[64];       // reference data
+    uint8_t         uint8Rd[64];        // read buffer
+    uint8_t         uint8Temp;          // help variable
+    uint8_t         uint8Lag;           // lagging device
+    uint8_t         uint8Served[2] = {0, 0};    // reads per device
+    uint32_t        uint32Lag;          // missing elements
+    uint32_t        uint32ElemID;       // read element ID
+    uint32_t        uint32Mirror;       // ticks of mirror add
+    uint32_t        uint32Single;       // ticks of single add
+    t_test_q        q = {0x47114711, sizeof(uint8Dat), 16, SFCB_FMT_HEAD_FOOT};
+    int             ret = -1;
+
+    /* entry message */
+    printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* init */
+    memset(flash, 0, sizeof(flash));
+    sfcb_arb_init(&arb, arbDev, 2, &g_uint8Spi, sizeof(g_uint8Spi)/sizeof(g_uint8Spi[0]));
+    for ( uint8_t i = 0; i < 2; i++ ) {
+        if ( 0 != run_sfcb_setup(&flash[i], &sfcb[i], sfcb_cb[i], 1, &q, 1, TEST_FIX_FLASH) ) {
+            goto ERO_END;
+        }
+        sfcb_arb_add(&arb, &sfcb[i], 0, &uint8Dev[i]);
+    }
+    for ( uint8_t j = 0; j < sizeof(uint8Dat); j++ ) {
+        uint8Dat[j] = (uint8_t) (rand() % 256);
+    }
+    if ( (0 != sfcb_arb_mirror(&arb, uint8Dev[0], uint8Dev[1])) || (SFCB_E_NO_CB_Q != sfcb_arb_mirror(&arb, uint8Dev[0], uint8Dev[1])) ) {
+        printf("ERROR:%s:sfcb_arb_mirror\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( SFCB_E_WKR_REQ != sfcb_arb_mirror_add(&arb, uint8Dev[0], 0, uint8Dat, sizeof(uint8Dat)) ) {
+        printf("ERROR:%s: add without mkcb\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* mirrored add, second chip is programmed in WIP of first chip */
+    if ( (0 != sfcb_arb_mirror_mkcb(&arb, uint8Dev[0])) || (0 == run_arb_wip(&arb, flash, 200)) ) {
+        printf("ERROR:%s:sfcb_arb_mirror_mkcb\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* second chip rejects, first chip is not started */
+    sfcb_cb[1][0].uint8PinFull = 1;
+    if ( (SFCB_E_PIN != sfcb_arb_mirror_add(&arb, uint8Dev[0], 0, uint8Dat, sizeof(uint8Dat))) || (0 != sfcb_busy(&sfcb[0])) ) {
+        printf("ERROR:%s: mirror add started with pinned second chip\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    sfcb_cb[1][0].uint8PinFull = 0;
+    if ( 0 != sfcb_arb_mirror_add(&arb, uint8Dev[0], 0, uint8Dat, sizeof(uint8Dat)) ) {
+        printf("ERROR:%s:sfcb_arb_mirror_add\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    uint32Mirror = run_arb_wip(&arb, flash, 200);
+    /* interrupted mirror add, only first chip programmed */
+    if ( (0 != sfcb_arb_mirror_mkcb(&arb, uint8Dev[0])) || (0 == run_arb_wip(&arb, flash, 200)) ) {
+        printf("ERROR:%s:sfcb_arb_mirror_mkcb\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    uint8Dat[0]++;
+    if ( 0 != sfcb_add(&sfcb[0], 0, uint8Dat, sizeof(uint8Dat)) ) {
+        printf("ERROR:%s:sfcb_add\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    uint32Single = run_arb_wip(&arb, flash, 200);
+    printf("INFO:%s: ticks add mirror=%d, single=%d\n", __FUNCTION__, uint32Mirror, uint32Single);
+    if ( (0 == uint32Mirror) || (0 == uint32Single) || !(uint32Mirror < uint32Single + uint32Single/2) ) {
+        printf("ERROR:%s: page programs not overlapped\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* mount, second chip lags, reads served by first chip only */
+    if ( (0 != sfcb_arb_mirror_mkcb(&arb, uint8Dev[0])) || (0 == run_arb_wip(&arb, flash, 200)) ) {
+        printf("ERROR:%s:sfcb_arb_mirror_mkcb\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( (0 != sfcb_arb_mirror_sync(&arb, uint8Dev[0], 0, &uint8Lag, &uint32Lag)) || (uint8Dev[1] != uint8Lag) || (1 != uint32Lag) ) {
+        printf("ERROR:%s:sfcb_arb_mirror_sync lag\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( (0 != sfcb_arb_mirror_get_last(&arb, uint8Dev[1], 0, uint8Rd, sizeof(uint8Rd), &uint32ElemID, &uint8Temp)) || (uint8Dev[0] != uint8Temp) ) {
+        printf("ERROR:%s:sfcb_arb_mirror_get_last from newest copy\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    run_arb_wip(&arb, flash, 200);
+    /* restore missing element */
+    if ( (0 != mem_cmp(uint8Rd, uint8Dat, sizeof(uint8Dat))) || (0 != sfcb_add(&sfcb[1], 0, uint8Rd, sizeof(uint8Rd))) ) {
+        printf("ERROR:%s: restore\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    run_arb_wip(&arb, flash, 200);
+    if ( (0 != sfcb_arb_mirror_mkcb(&arb, uint8Dev[0])) || (0 == run_arb_wip(&arb, flash, 200)) ) {
+        printf("ERROR:%s:sfcb_arb_mirror_mkcb\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( (0 != sfcb_arb_mirror_sync(&arb, uint8Dev[0], 0, &uint8Lag, &uint32Lag)) || (SFCB_ARB_NONE != uint8Lag) ) {
+        printf("ERROR:%s:sfcb_arb_mirror_sync restore\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* balanced reads */
+    for ( uint8_t i = 0; i < 4; i++ ) {
+        memset(uint8Rd, 0, sizeof(uint8Rd));
+        if ( 0 != sfcb_arb_mirror_get_last(&arb, uint8Dev[0], 0, uint8Rd, sizeof(uint8Rd), &uint32ElemID, &uint8Temp) ) {
+            printf("ERROR:%s:sfcb_arb_mirror_get_last\n", __FUNCTION__);
+            goto ERO_END;
+        }
+        run_arb_wip(&arb, flash, 200);
+        if ( (0 != mem_cmp(uint8Rd, uint8Dat, sizeof(uint8Dat))) || (2 != uint32ElemID) ) {
+            printf("ERROR:%s: read dev=%d, id=%d\n", __FUNCTION__, uint8Temp, uint32ElemID);
+            goto ERO_END;
+        }
+        uint8Served[uint8Temp]++;
+    }
+    printf("INFO:%s: reads dev0=%d, dev1=%d\n", __FUNCTION__, uint8Served[0], uint8Served[1]);
+    if ( (0 == uint8Served[0]) || (0 == uint8Served[1]) ) {
+        printf("ERROR:%s: reads not balanced\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* two interrupted adds, older element not restorable */
+    for ( uint8_t i = 0; i < 2; i++ ) {
+        if ( (0 != sfcb_arb_mirror_mkcb(&arb, uint8Dev[0])) || (0 == run_arb_wip(&arb, flash, 200)) || (0 != sfcb_add(&sfcb[0], 0, uint8Dat, sizeof(uint8Dat))) ) {
+            printf("ERROR:%s: interrupted add\n", __FUNCTION__);
+            goto ERO_END;
+        }
+        run_arb_wip(&arb, flash, 200);
+    }
+    if ( (0 != sfcb_arb_mirror_mkcb(&arb, uint8Dev[0])) || (0 == run_arb_wip(&arb, flash, 200)) ) {
+        printf("ERROR:%s:sfcb_arb_mirror_mkcb\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( (SFCB_E_MIRROR != sfcb_arb_mirror_sync(&arb, uint8Dev[0], 0, &uint8Lag, &uint32Lag)) || (uint8Dev[1] != uint8Lag) || (2 != uint32Lag) ) {
+        printf("ERROR:%s:sfcb_arb_mirror_sync lag above one\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* all done */
+    ret = 0;
+
+    /* release flash models */
+    ERO_END:
+        for ( uint8_t i = 0; i < 2; i++ ) {
+            free(flash[i].uint8PtrMem);
+        }
+        return ret;
+}
+
+
+
+#if defined(SFCB_FLASH_TYPE_NOERASE)
+/**
+ *  @brief test_fram
+ *
+ *  queue API end to end on erase-less memory: byte granular slots with wrap,
+ *  bytewise append, gathered write, statistics, resume after reset, posted
+ *  writes. Requests exceeding the payload size are rejected, also continuations
+ *
+ *  @return         int                 test state
+ *  @retval         0                   Success
+ *  @retval         -1                  Fail
+ *  @since          October 18, 2026
+ */
+static int test_fram (void)
+{
+    /** Variables **/
+    t_sfm       flash;              // FRAM model
+    t_sfcb      sfcb;               // handle
+    t_sfcb_cb   sfcb_cb[3];         // q0: small elements, q1: large elements, q2: commit word
+    uint8_t     uint8Dat[1500];     // reference data
+    uint8_t     uint8Rd[1500];      // read buffer
+    uint8_t*    uint8PtrMem = NULL; // memory content before rejected request
+    uint16_t    uint16Part = 600;   // bytes written before reset
+    uint32_t    uint32IdMax;        // highest ID before reset
+    uint32_t    uint32ElemID;       // read element ID
+    t_test_q    q[3] = {
+                    {0x47114711, 240, 32, SFCB_FMT_HEAD_FOOT},
+                    {0x08150815, sizeof(uint8Dat), 10, SFCB_FMT_HEAD_FOOT},
+                    {0x12345678, 700, 5, SFCB_FMT_COMMIT}
+                };
+    int         ret = -1;
+
+    /* entry message */
+    printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    if ( 0 != run_sfcb_setup(&flash, &sfcb, sfcb_cb, 3, q, 3, TEST_FIX_FLASH | TEST_FIX_MKCB) ) {
+        goto ERO_END;
+    }
+    /* byte granular slots, queue wraps multiple times */
+    for ( uint8_t i = 0; i < 3*q[0].uint16NumElems; i++ ) {
+        memset(uint8Dat, i, q[0].uint16PlSize);
+        if ( 0 != run_sfcb_add(&flash, &sfcb, 0, uint8Dat, q[0].uint16PlSize) ) {
+            goto ERO_END;
+        }
+    }
+    if ( (0 != test_get_last(&flash, &sfcb, 0, q[0].uint16PlSize, &uint32ElemID)) || ((uint32_t) (3*q[0].uint16NumElems+1) != uint32ElemID) ) {
+        printf("ERROR:%s:q0: wrap, id=%d\n", __FUNCTION__, uint32ElemID);
+        goto ERO_END;
+    }
+    /* bytewise append, gathered write, statistics on queue with free slots */
+    if ( 0 != test_add_append(&flash, &sfcb, 2, q[2].uint16PlSize) ) {
+        goto ERO_END;
+    }
+    if ( 0 != test_addv(&flash, &sfcb, 1, q[1].uint16PlSize, &uint32ElemID) ) {
+        goto ERO_END;
+    }
+    if ( 0 != test_queue_stats(&flash, &sfcb, 2) ) {
+        goto ERO_END;
+    }
+    /* oversized element, slot would be large enough for footer overwrite */
+    if ( SFCB_E_MEM != sfcb_add(&sfcb, 0, uint8Dat, (uint16_t) (q[0].uint16PlSize+1)) ) {
+        printf("ERROR:%s:q0: oversized element accepted\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* interrupted element */
+    for ( uint16_t i = 0; i < sizeof(uint8Dat); i++ ) {
+        uint8Dat[i] = (uint8_t) (i*7);
+    }
+    uint32IdMax = sfcb_idmax(&sfcb, 1);
+    if ( (0 != sfcb_add(&sfcb, 1, uint8Dat, uint16Part)) || (0 != run_sfm_update(&flash, &sfcb)) ) {
+        printf("ERROR:%s:q1: sfcb_add\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* reset, all management data is lost */
+    if ( 0 != run_sfcb_setup(&flash, &sfcb, sfcb_cb, 3, q, 3, TEST_FIX_MKCB) ) {
+        goto ERO_END;
+    }
+    if ( (uint16Part != sfcb_get_pl_wrcnt(&sfcb, 1)) || (uint32IdMax != sfcb_idmax(&sfcb, 1)) ) {
+        printf("ERROR:%s:q1: resume, wrcnt=%d, idmax=%d\n", __FUNCTION__, sfcb_get_pl_wrcnt(&sfcb, 1), sfcb_idmax(&sfcb, 1));
+        goto ERO_END;
+    }
+    /* continuation exceeds payload, footer and next slot stay untouched */
+    uint8PtrMem = malloc(flash.uint32Size);
+    if ( NULL == uint8PtrMem ) {
+        goto ERO_END;
+    }
+    memcpy(uint8PtrMem, flash.uint8PtrMem, flash.uint32Size);
+    if ( SFCB_E_MEM != sfcb_add(&sfcb, 1, uint8Dat+uint16Part, (uint16_t) (sizeof(uint8Dat)-uint16Part+1)) ) {
+        printf("ERROR:%s:q1: oversized continuation accepted\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( (0 != run_sfm_update(&flash, &sfcb)) || (0 != memcmp(uint8PtrMem, flash.uint8PtrMem, flash.uint32Size)) ) {
+        printf("ERROR:%s:q1: element in write modified\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* finish element and read back */
+    if ( (0 != sfcb_add(&sfcb, 1, uint8Dat+uint16Part, (uint16_t) (sizeof(uint8Dat)-uint16Part))) || (0 != run_sfm_update(&flash, &sfcb)) || (0 != run_sfcb_add_done(&flash, &sfcb, 1)) ) {
+        printf("ERROR:%s:q1: sfcb_add\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( (0 != sfcb_mkcb(&sfcb)) || (0 != run_sfm_update(&flash, &sfcb)) ) {
+        printf("ERROR:%s:sfcb_mkcb\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    memset(uint8Rd, 0, sizeof(uint8Rd));
+    if ( 0 != run_sfcb_get_last(&flash, &sfcb, 1, uint8Rd, sizeof(uint8Rd), &uint32ElemID) ) {
+        goto ERO_END;
+    }
+    if ( (uint32IdMax+1 != uint32ElemID) || (0 != mem_cmp(uint8Rd, uint8Dat, sizeof(uint8Dat))) ) {
+        printf("ERROR:%s:q1: read back, id=%d\n", __FUNCTION__, uint32ElemID);
+        goto ERO_END;
+    }
+    /* posted writes on two queues, no write cycle time */
+    for ( uint16_t i = 0; i < sizeof(uint8Dat); i++ ) {
+        uint8Dat[i] = (uint8_t) (i*11);
+    }
+    if (    (0 != sfcb_add_post(&sfcb, 1, uint8Dat, sizeof(uint8Dat)))
+         || (0 != sfcb_add_post(&sfcb, 0, uint8Dat+sizeof(uint8Dat)-q[0].uint16PlSize, q[0].uint16PlSize))
+         || (0 != run_sfm_update(&flash, &sfcb))
+    ) {
+        printf("ERROR:%s:sfcb_add_post\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( (0 != sfcb_mkcb(&sfcb)) || (0 != run_sfm_update(&flash, &sfcb)) ) {
+        printf("ERROR:%s:sfcb_mkcb\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    for ( uint8_t i = 0; i < 2; i++ ) {
+        if ( 0 != run_sfcb_get_last(&flash, &sfcb, i, uint8Rd, q[i].uint16PlSize, &uint32ElemID) ) {
+            goto ERO_END;
+        }
+        if ( 0 != mem_cmp(uint8Rd, uint8Dat+sizeof(uint8Dat)-q[i].uint16PlSize, q[i].uint16PlSize) ) {
+            printf("ERROR:%s:q%d: posted element, id=%d\n", __FUNCTION__, i, uint32ElemID);
+            goto ERO_END;
+        }
+    }
+    /* all done */
+    ret = 0;
+
+    /* release flash model */
+    ERO_END:
+        free(uint8PtrMem);
+        free(flash.uint8PtrMem);
+        return ret;
+}
+#endif
+
+
+
+#if defined(SFCB_FLASH_TYPE_NAND)
+/**
+ *  @brief test_nand
+ *
+ *  queue API end to end on SPI NAND with bad blocks: wrap over blocks,
+ *  one program execute per page and job, gathered and posted writes,
+ *  commit word format. Appends are limited by the partial programs of
+ *  the page in write, also after resume. The model rejects bad block
+ *  access and exceeded partial programs
+ *
+ *  @return         int                 test state
+ *  @retval         0                   Success
+ *  @retval         -1                  Fail
+ *  @since          October 18, 2026
+ */
+static int test_nand (void)
+{
+    /** Variables **/
+    t_sfm       flash;              // NAND model
+    t_sfcb      sfcb;               // handle
+    t_sfcb_cb   sfcb_cb[3];         // q0: page elements, q1: multi page elements, q2: commit word rejected
+    uint8_t     uint8Dat[5000];     // reference data
+    uint8_t     uint8Rd[5000];      // read buffer
+    uint8_t     uint8Cb;            // queue number
+    uint32_t    uint32IdMax;        // highest ID before reset
+    uint32_t    uint32ElemID;       // read element ID
+    uint32_t    uint32Prgs;         // program executes before add
+    t_test_q    q[2] = {
+                    {0x47114711, 1000, 128, SFCB_FMT_HEAD_FOOT},
+                    {0x08150815, sizeof(uint8Dat), 21, SFCB_FMT_HEAD_FOOT}
+                };
+    int         ret = -1;
+
+    /* entry message */
+    printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    if ( 0 != run_sfcb_setup(&flash, &sfcb, sfcb_cb, 3, q, 2, TEST_FIX_FLASH | TEST_FIX_MKCB) ) {
+        goto ERO_END;
+    }
+    /* commit word would program ECC sector of header twice */
+    if ( SFCB_E_NO_FLASH != sfcb_new_cb_fmt(&sfcb, 0x12345678, 3000, 8, SFCB_FMT_COMMIT, &uint8Cb) ) {
+        printf("ERROR:%s: commit word format accepted\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* two blocks, wrap reclaims block behind bad block */
+    for ( uint16_t i = 0; i < 2*q[0].uint16NumElems+8; i++ ) {
+        memset(uint8Dat, i, q[0].uint16PlSize);
+        if ( 0 != run_sfcb_add(&flash, &sfcb, 0, uint8Dat, q[0].uint16PlSize) ) {
+            goto ERO_END;
+        }
+    }
+    if ( (0 != test_get_last(&flash, &sfcb, 0, q[0].uint16PlSize, &uint32ElemID)) || ((uint32_t) (2*q[0].uint16NumElems+9) != uint32ElemID) ) {
+        printf("ERROR:%s:q0: wrap, id=%d\n", __FUNCTION__, uint32ElemID);
+        goto ERO_END;
+    }
+    /* element over three pages, header, payload and footer staged, one program per page */
+    for ( uint16_t i = 0; i < sizeof(uint8Dat); i++ ) {
+        uint8Dat[i] = (uint8_t) (i*3);
+    }
+    uint32Prgs = flash.uint32Prgs;
+    if ( (0 != sfcb_add(&sfcb, 1, uint8Dat, sizeof(uint8Dat))) || (0 != run_sfm_update(&flash, &sfcb)) ) {
+        printf("ERROR:%s:q1: sfcb_add\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( 3 != flash.uint32Prgs - uint32Prgs ) {
+        printf("ERROR:%s:q1: program executes, exp=3, is=%d\n", __FUNCTION__, flash.uint32Prgs - uint32Prgs);
+        goto ERO_END;
+    }
+    /* footer is written with the element, done without program */
+    if ( (0 != run_sfcb_add_done(&flash, &sfcb, 1)) || (3 != flash.uint32Prgs - uint32Prgs) ) {
+        printf("ERROR:%s:q1: sfcb_add_done programmed\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( (0 != sfcb_mkcb(&sfcb)) || (0 != run_sfm_update(&flash, &sfcb)) || (0 != run_sfcb_get_last(&flash, &sfcb, 1, uint8Rd, sizeof(uint8Rd), &uint32ElemID)) ) {
+        goto ERO_END;
+    }
+    if ( 0 != mem_cmp(uint8Rd, uint8Dat, sizeof(uint8Dat)) ) {
+        printf("ERROR:%s:q1: read back, id=%d\n", __FUNCTION__, uint32ElemID);
+        goto ERO_END;
+    }
+    /* gathered write */
+    if ( 0 != test_addv(&flash, &sfcb, 1, q[1].uint16PlSize, &uint32ElemID) ) {
+        goto ERO_END;
+    }
+    /* short element is completed, append is rejected */
+    if ( 0 != run_sfcb_add_append(&flash, &sfcb, 0, uint8Dat, 100) ) {
+        goto ERO_END;
+    }
+    if ( SFCB_E_NOP != sfcb_add(&sfcb, 0, uint8Dat+100, 100) ) {
+        printf("ERROR:%s:q0: append accepted\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( (0 != sfcb_mkcb(&sfcb)) || (0 != run_sfm_update(&flash, &sfcb)) ) {
+        printf("ERROR:%s:sfcb_mkcb\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    memset(uint8Rd, 0, sizeof(uint8Rd));
+    if ( (0 != run_sfcb_get_last(&flash, &sfcb, 0, uint8Rd, 100, &uint32ElemID)) || (0 != mem_cmp(uint8Rd, uint8Dat, 100)) ) {
+        printf("ERROR:%s:q0: short element\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* interrupted element, reset after first page program */
+    for ( uint16_t i = 0; i < sizeof(uint8Dat); i++ ) {
+        uint8Dat[i] = (uint8_t) (i*7);
+    }
+    uint32IdMax = sfcb_idmax(&sfcb, 1);
+    uint32Prgs = flash.uint32Prgs;
+    if ( 0 != sfcb_add(&sfcb, 1, uint8Dat, sizeof(uint8Dat)) ) {
+        printf("ERROR:%s:q1: sfcb_add\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    while ( (0 != sfcb_busy(&sfcb)) && (flash.uint32Prgs == uint32Prgs) ) {
+        sfcb_worker(&sfcb);
+        if ( 0 != sfm(&flash, (uint8_t*) &g_uint8Spi, sfcb_spi_len(&sfcb)) ) {
+            goto ERO_END;
+        }
+    }
+    flash.uint8Busy = 0;    // program finished during reset
+    /* reset, element without footer is abandoned, its ECC sectors are not programmed again */
+    if ( 0 != run_sfcb_setup(&flash, &sfcb, sfcb_cb, 3, q, 2, TEST_FIX_MKCB) ) {
+        goto ERO_END;
+    }
+    if ( (0 != sfcb_get_pl_wrcnt(&sfcb, 1)) || (uint32IdMax+1 != sfcb_idmax(&sfcb, 1)) ) {
+        printf("ERROR:%s:q1: reopened, wrcnt=%d, idmax=%d\n", __FUNCTION__, sfcb_get_pl_wrcnt(&sfcb, 1), sfcb_idmax(&sfcb, 1));
+        goto ERO_END;
+    }
+    if ( 0 != run_sfcb_add(&flash, &sfcb, 1, uint8Dat, sizeof(uint8Dat)) ) {
+        goto ERO_END;
+    }
+    memset(uint8Rd, 0, sizeof(uint8Rd));
+    if ( 0 != run_sfcb_get_last(&flash, &sfcb, 1, uint8Rd, sizeof(uint8Rd), &uint32ElemID) ) {
+        goto ERO_END;
+    }
+    if ( (uint32IdMax+2 != uint32ElemID) || (0 != mem_cmp(uint8Rd, uint8Dat, sizeof(uint8Dat))) ) {
+        printf("ERROR:%s:q1: element after abandoned, id=%d\n", __FUNCTION__, uint32ElemID);
+        goto ERO_END;
+    }
+    /* posted writes on two queues, page change between queues */
+    if (    (0 != sfcb_add_post(&sfcb, 1, uint8Dat, sizeof(uint8Dat)))
+         || (0 != sfcb_add_post(&sfcb, 0, uint8Dat+sizeof(uint8Dat)-q[0].uint16PlSize, q[0].uint16PlSize))
+         || (0 != run_sfm_update(&flash, &sfcb))
+    ) {
+        printf("ERROR:%s:sfcb_add_post\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    if ( (0 != sfcb_mkcb(&sfcb)) || (0 != run_sfm_update(&flash, &sfcb)) ) {
+        printf("ERROR:%s:sfcb_mkcb\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    for ( uint8_t i = 0; i < 2; i++ ) {
+        if ( 0 != run_sfcb_get_last(&flash, &sfcb, i, uint8Rd, q[i].uint16PlSize, &uint32ElemID) ) {
+            goto ERO_END;
+        }
+        if ( 0 != mem_cmp(uint8Rd, uint8Dat+sizeof(uint8Dat)-q[i].uint16PlSize, q[i].uint16PlSize) ) {
+            printf("ERROR:%s:q%d: posted element, id=%d\n", __FUNCTION__, i, uint32ElemID);
+            goto ERO_END;
+        }
+    }
+    /* bad blocks untouched */
+    for ( uint8_t i = 0; i < sizeof(g_uint16NandBad)/sizeof(g_uint16NandBad[0]); i++ ) {
+        for ( uint32_t j = 0; j < SFCB_FLASH_TOPO_SECTOR_SIZE; j++ ) {
+            if ( 0xff != flash.uint8PtrMem[g_uint16NandBad[i]*SFCB_FLASH_TOPO_SECTOR_SIZE+j] ) {
+                printf("ERROR:%s: bad block %d written\n", __FUNCTION__, g_uint16NandBad[i]);
+                goto ERO_END;
+            }
+        }
+    }
+    /* all done */
+    ret = 0;
+
+    /* release flash model */
+    ERO_END:
+        free(flash.uint8PtrMem);
+        return ret;
+}
+#endif
+
+
+
+/**
+ *  Main
+ *  ----
+ */
+int main (int argc, char *argv[])
+{
+    /** Variables **/
+    t_sfm           spiFlash;                           // SPI flash model
+    t_sfcb          sfcb;                               // SPI Flash as circular buffer
+    t_sfcb_cb       sfcb_cb[5];                         // five logical parts in SPI Flash
+    uint8_t         uint8FlashData[] = {0,1,2,3,4,5};   // SPI test data
+    uint8_t         uint8Buf[1024];                     // help buffer
+    uint32_t        uint32Temp;                         // help variable
+
+
+    /* entry message */
+    printf("INFO:%s: unit test started\n", __FUNCTION__);
+
+
+    /* optional SPI transaction trace */
+    if ( 2 == argc ) {
+        printf("INFO:%s: record SPI transactions to '%s'\n", __FUNCTION__, argv[1]);
+        if ( 0 != sfcb_trace_open(&g_trace, argv[1], 1) ) {
+            printf("ERROR:%s:sfcb_trace_open\n", __FUNCTION__);
+            goto ERO_END;
+        }
+        g_uint8TraceEna = 1;
+    }
+
+
+#if defined(SFCB_FLASH_TYPE_NOERASE)
+    /* erase-less memory, queue API end to end, reference images are NOR flash */
+    printf("INFO:%s: Memory model %s\n", __FUNCTION__, SFCB_FLASH_NAME);
+    spiFlash.uint8PtrMem = NULL;    // no image on error
+    if ( 0 != test_fram() ) {
+        goto ERO_END;
+    }
+    if ( 0 != g_uint8TraceEna ) {
+        sfcb_trace_close(&g_trace);
+    }
+    goto OK_END;
+#endif
+#if defined(SFCB_FLASH_TYPE_NAND)
+    /* SPI NAND, queue API end to end, reference images are NOR flash */
+    printf("INFO:%s: Memory model %s\n", __FUNCTION__, SFCB_FLASH_NAME);
+    spiFlash.uint8PtrMem = NULL;    // no image on error
+    if ( 0 != test_nand() ) {
+        goto ERO_END;
+    }
+    if ( 0 != g_uint8TraceEna ) {
+        sfcb_trace_close(&g_trace);
+    }
+    goto OK_END;
+#endif
+
+
+    /* init flash model */
+    printf("INFO:%s: Init Flash model W25Q16JV\n", __FUNCTION__);
+    if ( 0 != sfm_init( &spiFlash, "W25Q16JV" ) ) {
+        printf("ERROR:%s:sfm_init\n", __FUNCTION__);
+        goto ERO_END;
+    }
+
+
+    /* sfcb_init */
+    printf("INFO:%s:sfcb_init\n", __FUNCTION__);
+    printf("INFO:%s:uint8Spi_p      = %p\n",        __FUNCTION__, &g_uint8Spi);
+    printf("INFO:%s:sfcb_p          = %p\n",        __FUNCTION__, &sfcb);
+    printf("INFO:%s:sfcb_cb_p       = %p\n",        __FUNCTION__, &sfcb_cb);
+    printf("INFO:%s:sfcb_size       = %d byte\n",   __FUNCTION__, (int) sizeof(sfcb));
+    printf("INFO:%s:sfcb_cb[0]_size = %d byte\n",   __FUNCTION__, (int) sizeof(sfcb_cb[0]));
+    memset(sfcb_cb, 0xaf, sizeof(sfcb_cb)); // mess-up memory to check init
+    /* int sfcb_init (t_sfcb *self, void *cb, uint8_t cbLen, void *spi, uint16_t spiLen) */
+    sfcb_init (&sfcb, &sfcb_cb, sizeof(sfcb_cb)/sizeof(sfcb_cb[0]), &g_uint8Spi, sizeof(g_uint8Spi)/sizeof(g_uint8Spi[0]));
+    /* check for error */
+    for ( uint8_t i = 0; i < sizeof(sfcb_cb)/sizeof(sfcb_cb[0]); i++ ) {
+        /* check flags */
+        if ( 0 != (sfcb_cb[i]).uint8Used ) {
+            printf("ERROR:%s:sfcb_init:uint8Used", __FUNCTION__);
+            goto ERO_END;
+        }
+        if ( 0 != (sfcb_cb[i]).uint8MgmtValid) {
+            printf("ERROR:%s:sfcb_init:uint8MgmtValid", __FUNCTION__);
+            goto ERO_END;
+        }
+    }
+    //print_raw_sfcb_cb(&sfcb_cb, sizeof(sfcb_cb)/sizeof(sfcb_cb[0]));  // raw dump
+
+
+    /* sfcb_new_cb
+     *   adds two new circular buffers to the SPI Flash
+    */
+    printf("INFO:%s:sfcb_new_cb\n", __FUNCTION__);
+    run_sfcb_new_cbs(&sfcb);
+    print_raw_sfcb_cb(&sfcb_cb, sizeof(sfcb_cb)/sizeof(sfcb_cb[0]));    // raw dump of handling info
+
+
+    /* sfcb_mkcb
+     *   access spi flash and build circular buffers
+     */
+    printf("*************************************************\n");
+    printf("INFO:%s:sfcb_mkcb\n", __FUNCTION__);
+    if ( 0 != sfcb_mkcb(&sfcb) ) {
+        printf("ERROR:%s:sfcb_mkcb failed to start", __FUNCTION__);
+        goto ERO_END;
+    }
+        // run_sfm_update (t_sfm* flash, t_sfcb* sfcb)
+    if ( 0 != run_sfm_update(&spiFlash, &sfcb) ) {
+        printf("ERROR:%s:run_sfm_update\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    sfm_dump( &spiFlash, 0, 256 );  // dump SPI flash content
+
+
+
+    ////////////////////////////////////////////
+    //
+    //  Single Pages Payloads
+    //
+    ////////////////////////////////////////////
+
+    /* SFCB add, queue 0 */
+    printf("*************************************************\n");
+    for ( uint8_t i = 0; i < 63; i++ ) {
+        printf("INFO:%s:sfcb_add:i=%d:add\n", __FUNCTION__, i);
+        /* add element */
+            // run_sfcb_add (t_sfm* flash, t_sfcb* sfcb, uint8_t qNum, uint8_t* data, uint16_t len)
+        if ( 0 != run_sfcb_add(&spiFlash, &sfcb, 0, (uint8_t*) &uint8FlashData, sizeof(uint8FlashData)/sizeof(uint8FlashData[0])) ) {
+            printf("ERROR:%s:run_sfcb_add failed", __FUNCTION__);
+            return -1;
+        }
+    }
+    if ( 0 != sfm_cmp(&spiFlash, "./test/sfcb_flash_q0_i63.dif") ) {
+        printf("ERROR:%s:sfm_cmp:q0 Mismatch\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* check highest id */
+    if ( 63 != sfcb_idmax(&sfcb, 0) ) {
+        printf("ERROR:%s:sfcb_idmax:q0 exp,idmax=63, is,idmax=%d\n", __FUNCTION__, sfcb_idmax(&sfcb, 0));
+        goto ERO_END;
+    }
+
+
+    /* sfcb_flash_read
+     *   reads raw binary data from flash
+     */
+    printf("*************************************************\n");
+    printf("INFO:%s:sfcb_flash_read\n", __FUNCTION__);
+        // int sfcb_flash_read (t_sfcb *self, uint32_t adr, void *data, uint16_t len)
+    if ( 0 != sfcb_flash_read (&sfcb, 0, &uint8Buf, 256) ) {
+        printf("ERROR:%s:sfcb_flash_read failed to start", __FUNCTION__);
+        goto ERO_END;
+    }
+        // run_sfm_update (t_sfm* flash, t_sfcb* sfcb)
+    if ( 0 != run_sfm_update(&spiFlash, &sfcb) ) {
+        printf("ERROR:%s:run_sfm_update\n", __FUNCTION__);
+        goto ERO_END;
+    }
+    /* compare data */
+    for ( uint32_t i = 0; i < 256; i++ ) {
+        if ( spiFlash.uint8PtrMem[i] != uint8Buf[i] ) {
+            printf("ERROR:%s:sfcb_flash_read: byte=%d, exp=0x%02x, is=0x%02x\n", __FUNCTION__, i, spiFlash.uint8PtrMem[i], uint8Buf[i]);
+            goto ERO_END;
+        }
+    }
+
+
+    /* sfcb_get_last
+     *   reads last written element back
+     *     test_get_last: performs the test, function adds one element with random data to the queue and reads back
+     */
+    printf("*************************************************\n");
+    printf("INFO:%s:sfcb_get_last:q0: payload size = %d bytes\n", __FUNCTION__, g_uint16CbQ0Size);
+        // static int test_get_last (t_sfm* flash, t_sfcb* sfcb, uint8_t qNum, uint16_t qSize, uint32_t *elemID)
+    if ( 0 != test_get_last(&spiFlash, &sfcb, 0, g_uint16CbQ0Size, &uint32Temp) ) {
+        goto ERO_END;
+    }
+    if ( 64 != uint32Temp ) {
+        printf("ERROR:%s:sfcb_get_last:q0: test_get_last elemID=%i, 64 expected\n", __FUNCTION__, uint32Temp);
+        goto ERO_END;
+    }
+
+
+    /* sfcb_add_append
+     *   write to SPI flash in portions of bytes
+     */
+    printf("*************************************************\n");
+    printf("INFO:%s:sfcb_add_append:q0: payload size = %d bytes\n", __FUNCTION__, g_uint16CbQ0Size);
+        // static int test_add_append (t_sfm* flash, t_sfcb* sfcb, uint8_t qNum, uint16_t qSize)
+    if ( 0 != test_add_append(&spiFlash, &sfcb, 0, g_uint16CbQ0Size) ) {
+            // int sfm_dump (t_sfm *self, int32_t start, int32_t stop)
+        sfm_dump( &spiFlash, 0, 256*g_uint16CbQ0_elems );   // dump SPI flash content
+            // exit with error
+        goto ERO_END;
+    }
+
+
+    /* sfcb_mkcb
+     *   resume partial written queue element after reset
+     */
+    printf("*************************************************\n");
+    printf("INFO:%s:sfcb_mkcb:q0: resume element after reset\n", __FUNCTION__);
+        // static int test_add_resume (t_sfm* flash, t_sfcb* sfcb, t_sfcb_cb* sfcb_cb, uint8_t cbLen, uint8_t qNum, uint16_t qSize, uint32_t *elemID)
+    if ( 0 != test_add_resume(&spiFlash, &sfcb, sfcb_cb, sizeof(sfcb_cb)/sizeof(sfcb_cb[0]), 0, g_uint16CbQ0Size, &uint32Temp) ) {
+        goto ERO_END;
+    }
+    if ( 66 != uint32Temp ) {
+        printf("ERROR:%s:sfcb_mkcb:q0: test_add_resume elemID=%i, 66 expected\n", __FUNCTION__, uint32Temp);
+        goto ERO_END;
+    }
+
+
+    ////////////////////////////////////////////
+    //
+    //  Multiple Pages Payloads
+    //
+    ////////////////////////////////////////////
+
+    /* sfcb_get_last
+     *   reads last written element back
+     *     test_get_last: performs the test, function adds one element with random data to the queue and reads back
+     */
+    printf("*************************************************\n");
+    printf("INFO:%s:sfcb_get_last:q1: payload size = %d bytes\n", __FUNCTION__, g_uint16CbQ1Size);
+        // static int test_get_last (t_sfm* flash, t_sfcb* sfcb, uint8_t qNum, uint16_t qSize, uint32_t *elemID)
+    if ( 0 != test_get_last(&spiFlash, &sfcb, 1, g_uint16CbQ1Size, &uint32Temp) ) {
+        goto ERO_END;
+    }
+    if ( 1 != uint32Temp ) {
+        printf("ERROR:%s:sfcb_get_last:q1: test_get_last elemID=%i, 1 expected\n", __FUNCTION__, uint32Temp);
+        goto ERO_END;
+    }
+
+
+    /* sfcb_addv
+     *   gathered write of fragments into one element
+     */
+    printf("*************************************************\n");
+    printf("INFO:%s:sfcb_addv:q1: payload size = %d bytes\n", __FUNCTION__, g_uint16CbQ1Size);
+        // static int test_addv (t_sfm* flash, t_sfcb* sfcb, uint8_t qNum, uint16_t qSize, uint32_t *elemID)
+    if ( 0 != test_addv(&spiFlash, &sfcb, 1, g_uint16CbQ1Size, &uint32Temp) ) {
+        goto ERO_END;
+    }
+    if ( 2 != uint32Temp ) {
+        printf("ERROR:%s:sfcb_addv:q1: test_addv elemID=%i, 2 expected\n", __FUNCTION__, uint32Temp);
+        goto ERO_END;
+    }
+
+
+
+
+    /* sfcb_queue_stats
+     *   queue occupancy from management data
+     */
+    printf("*************************************************\n");
+    printf("INFO:%s:sfcb_queue_stats:q1\n", __FUNCTION__);
+    if ( 0 != test_queue_stats(&spiFlash, &sfcb, 1) ) {
+        goto ERO_END;
+    }
+
+
+    /* sfcb_add_post
+     *   interleaved write of large and small element
+     */
+    printf("*************************************************\n");
+    printf("INFO:%s:sfcb_add_post:q1/q0\n", __FUNCTION__);
+    if ( 0 != test_add_post(&spiFlash, &sfcb, 1, g_uint16CbQ1Size, 0) ) {
+        goto ERO_END;
+    }
+
+
+    /* sfcb_scrub
+     *   background check of retained elements
+     */
+    printf("*************************************************\n");
+    printf("INFO:%s:sfcb_scrub:q0\n", __FUNCTION__);
+    if ( 0 != test_scrub(&spiFlash, &sfcb, 0) ) {
+        goto ERO_END;
+    }
+
+
+    /* sfcb_init_warm
+     *   reuse retained management data after reset
+     */
+    printf("*************************************************\n");
+    printf("INFO:%s:sfcb_init_warm\n", __FUNCTION__);
+    if ( 0 != test_init_warm(&spiFlash, &sfcb, sfcb_cb, sizeof(sfcb_cb)/sizeof(sfcb_cb[0])) ) {
+        goto ERO_END;
+    }
+
+
+    /* sfcb_new_cb_fmt
+     *   commit word element format
+     */
+    printf("*************************************************\n");
+    printf("INFO:%s:sfcb_new_cb_fmt: commit word format\n", __FUNCTION__);
+    if ( 0 != test_fmt_commit() ) {
+        goto ERO_END;
+    }
+
+
+    /* sfcb_new_cb_fmt
+     *   compact element format
+     */
+    printf("*************************************************\n");
+    printf("INFO:%s:sfcb_new_cb_fmt: compact format\n", __FUNCTION__);
+    if ( 0 != test_fmt_compact() ) {
+        goto ERO_END;
+    }
+
+
+    /* sfcb_add_defer
+     *   deferred bursts with deep power-down
+     */
+    printf("*************************************************\n");
+    printf("INFO:%s:sfcb_add_defer: deferred bursts\n", __FUNCTION__);
+    if ( 0 != test_defer() ) {
+        goto ERO_END;
+    }
+
+
+    /* sfcb_quad
+     *   quad input page program
+     */
+    printf("*************************************************\n");
+    printf("INFO:%s:sfcb_quad: quad input page program\n", __FUNCTION__);
+    if ( 0 != test_quad() ) {
+        goto ERO_END;
+    }
+
+
+    /* sfcb_read_req
+     *   coalesced read requests
+     */
+    printf("*************************************************\n");
+    printf("INFO:%s:sfcb_read_req: coalesced reads\n", __FUNCTION__);
+    if ( 0 != test_read_q() ) {
+        goto ERO_END;
+    }
+
+
+    /* sfcb_blank_check
+     *   erased state of flash region
+     */
+    printf("*************************************************\n");
+    printf("INFO:%s:sfcb_blank_check: erased region\n", __FUNCTION__);
+    if ( 0 != test_blank() ) {
+        goto ERO_END;
+    }
+
+
+    /* sfcb_pin
+     *   erase pinning for long running readers
+     */
+    printf("*************************************************\n");
+    printf("INFO:%s:sfcb_pin: erase pinning\n", __FUNCTION__);
+    if ( 0 != test_pin() ) {
+        goto ERO_END;
+    }
+
+
+    /* sfcb_reclaim
+     *   block reclaim
+     */
+    printf("*************************************************\n");
+    printf("INFO:%s:sfcb_reclaim: 32KiB block erase\n", __FUNCTION__);
+    if ( 0 != test_reclaim() ) {
+        goto ERO_END;
+    }
+
+
+    /* sfcb_export
+     *   streaming export container
+     */
+    printf("*************************************************\n");
+    printf("INFO:%s:sfcb_export: export container\n", __FUNCTION__);
+    if ( 0 != test_export() ) {
+        goto ERO_END;
+    }
+
+
+    /* sfcb_flash_read
+     *   table driven command
+     */
+    printf("*************************************************\n");
+    printf("INFO:%s:sfcb_flash_read: microcode\n", __FUNCTION__);
+    if ( 0 != test_ucode() ) {
+        goto ERO_END;
+    }
+
+
+    /* sfcb_xfrm
+     *   payload transform chain
+     */
+    printf("*************************************************\n");
+    printf("INFO:%s:sfcb_xfrm: payload transform chain\n", __FUNCTION__);
+    if ( 0 != test_xfrm() ) {
+        goto ERO_END;
+    }
+
+
+    /* sfcb_arb_worker
+     *   two flashes on one SPI bus
+     */
+    printf("*************************************************\n");
+    printf("INFO:%s:sfcb_arb_worker: two devices\n", __FUNCTION__);
+    if ( 0 != test_arb() ) {
+        goto ERO_END;
+    }
+
+
+    /* sfcb_arb_mirror
+     *   mirrored queue on two devices
+     */
+    printf("*************************************************\n");
+    printf("INFO:%s:sfcb_arb_mirror: mirrored queue\n", __FUNCTION__);
+    if ( 0 != test_arb_mirror() ) {
         goto ERO_END;
     }
 
@@ -746,6 +3417,9 @@ int main ()
 
     /* write to file */
     sfm_store(&spiFlash, "./flash.dif");
+    if ( 0 != g_uint8TraceEna ) {
+        sfcb_trace_close(&g_trace);
+    }
 
     /* avoid warning */
     goto OK_END;
@@ -0,0 +1,320 @@
+/***********************************************************************
+ @copyright     : Siemens AG
+ @license       : BSDv3
+ @author        : Andreas Kaeberlein
+ @address       : Clemens-Winkler-Strasse 3, 09116 Chemnitz
+
+ @maintainer    : Andreas Kaeberlein
+ @telephone     : +49 371 4810-2108
+ @email         : andreas.kaeberlein@siemens.com
+
+ @file          : sfcb_image.c
+ @date          : October 18, 2026
+ @see           : https://github.com/andkae/SPI-Flash-Circular-Buffer
+
+ @brief         : Golden image builder
+                  Host tool, builds a ready to program flash image
+                  with pre-seeded elements and the sealed management
+                  data as checkpoint for #sfcb_init_warm
+***********************************************************************/
+
+
+
+/** Standard libs **/
+#include <stdio.h>          // f.e. printf
+#include <stdlib.h>         // strtoul, exit
+#include <stdint.h>         // defines fixed data types, like int8_t...
+#include <string.h>         // string handling functions
+
+/** User Libs **/
+#include "sfcb_flash_types.h"                       // flash name
+#include "spi_flash_cb.h"                           // image is written by the library itself
+#include "test/spi_flash_model/spi_flash_model.h"   // spi flash model
+
+
+
+/** Defines **/
+#define SFCB_IMAGE_MAX_Q        (16)        /**< maximum number of queues */
+#define SFCB_IMAGE_MAX_SEED     (64)        /**< maximum number of pre-seeded elements */
+#define SFCB_IMAGE_CYCLE_OUT    (10000000)  /**< worker calls until job timeout */
+
+/** management data in checkpoint, pointers and runtime data are zero **/
+#define SFCB_IMAGE_CB_FIELDS(X) \
+    X(uint8Used)                \
+    X(uint8MgmtValid)           \
+    X(uint32MagicNum)           \
+    X(uint32IdNumMax)           \
+    X(uint32IdNumMin)           \
+    X(uint32StartSector)        \
+    X(uint32StopSector)         \
+    X(uint32StartPageWrite)     \
+    X(uint32StartPageIdMin)     \
+    X(uint32StartPageIdMax)     \
+    X(uint32ElemIdLastCpl)      \
+    X(uint32SlotSize)           \
+    X(uint16NumPagesPerElem)    \
+    X(uint16NumEntriesMax)      \
+    X(uint16NumEntries)         \
+    X(uint16PlFlashOfs)         \
+    X(uint16PlSize)             \
+    X(uint8Fmt)                 \
+    X(uint8HeadLen)             \
+    X(uint8Weight)              \
+    X(uint32Gen)                \
+    X(uint16CrcLayout)          \
+    X(uint16CrcState)
+
+
+
+/** Globals **/
+uint8_t g_uint8Spi[UINT16_MAX];    // SPI packet buffer, largest possible packet
+
+
+
+/**
+ *  @brief usage
+ *
+ *  prints command line help
+ *
+ *  @param[in]      *name           program name
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void print_usage (char *name)
+{
+    printf("Usage: %s [-n cbLen] -q magicNum:elemSizeByte:numElems [-q ...] [-s queue:file ...] -o image [-c checkpoint]\n", name);
+    printf("  -q    queue specification, same arguments like sfcb_new_cb, in order of queue id\n");
+    printf("  -s    pre-seeded element of queue, payload from file, zero padded to elemSizeByte\n");
+    printf("  -n    entries of management table in firmware, default number of queues\n");
+    printf("  -o    raw flash image\n");
+    printf("  -c    C header with sealed management table for sfcb_init_warm\n");
+    printf("  Flash '%s': size=%d byte, sector=%d byte, page=%d byte\n", SFCB_FLASH_NAME, SFCB_FLASH_TOPO_FLASH_SIZE, SFCB_FLASH_TOPO_SECTOR_SIZE, SFCB_FLASH_TOPO_PAGE_SIZE);
+}
+
+
+
+/**
+ *  @brief run job
+ *
+ *  runs the worker against the flash model until the job ends
+ *
+ *  @param[in,out]  *sfcb           handle, #t_sfcb
+ *  @param[in,out]  *flash          flash model, #t_sfm
+ *  @return         int             state
+ *  @retval         0               job done
+ *  @retval         -1              flash model error or timeout
+ *  @since          October 18, 2026
+ */
+static int sfcb_image_run (t_sfcb *sfcb, t_sfm *flash)
+{
+    for ( uint32_t i = 0; i < SFCB_IMAGE_CYCLE_OUT; i++ ) {
+        if ( 0 == sfcb_busy(sfcb) ) {
+            return (0 == sfcb_isero(sfcb)) ? 0 : -1;
+        }
+        sfcb_worker(sfcb);
+        if ( 0 != sfm(flash, g_uint8Spi, sfcb_spi_len(sfcb)) ) {
+            printf("ERROR:%s: spi_flash_model, ist=0x%02x\n", __FUNCTION__, g_uint8Spi[0]);
+            return -1;
+        }
+    }
+    printf("ERROR:%s: timeout\n", __FUNCTION__);
+    return -1;
+}
+
+
+
+/**
+ *  @brief checkpoint
+ *
+ *  writes the sealed management table as C initializer
+ *
+ *  @param[in]      *path           output file
+ *  @param[in]      *cb             management table, #t_sfcb_cb
+ *  @param[in]      cbLen           entries in table
+ *  @return         int             state
+ *  @retval         0               written
+ *  @retval         -1              file error
+ *  @since          October 18, 2026
+ */
+static int sfcb_image_checkpoint (const char *path, const t_sfcb_cb *cb, uint8_t cbLen)
+{
+    /** Variables **/
+    FILE    *fp;
+
+    fp = fopen(path, "w");
+    if ( NULL == fp ) {
+        printf("ERROR:%s: open '%s'\n", __FUNCTION__, path);
+        return -1;
+    }
+    fprintf(fp, "/* sealed management data of golden image, flash '%s', generated by sfcb_image */\n", SFCB_FLASH_NAME);
+    fprintf(fp, "#define SFCB_CHECKPOINT_NUM (%d)\n", cbLen);
+    fprintf(fp, "static const t_sfcb_cb g_sfcbCheckpoint[SFCB_CHECKPOINT_NUM] = {\n");
+    for ( uint8_t i = 0; i < cbLen; i++ ) {
+        fprintf(fp, "    {   /* queue %d */\n", i);
+#define SFCB_IMAGE_CB_PRINT(field)  fprintf(fp, "        .%s = 0x%x,\n", #field, (unsigned int) cb[i].field);
+        SFCB_IMAGE_CB_FIELDS(SFCB_IMAGE_CB_PRINT)
+#undef SFCB_IMAGE_CB_PRINT
+        fprintf(fp, "    },\n");
+    }
+    fprintf(fp, "};\n");
+    fclose(fp);
+    return 0;
+}
+
+
+
+/**
+ *  Main
+ *  ----
+ */
+int main (int argc, char *argv[])
+{
+    /** Variables **/
+    t_sfcb      sfcb;                               // SPI Flash as circular buffer
+    t_sfcb_cb   sfcb_cb[SFCB_IMAGE_MAX_Q];          // queue management
+    t_sfm       flash;                              // flash content
+    char*       charPtrQ[SFCB_IMAGE_MAX_Q];         // queue specifications
+    uint8_t     uint8SeedQ[SFCB_IMAGE_MAX_SEED];    // queue of seed
+    char*       charPtrSeed[SFCB_IMAGE_MAX_SEED];   // payload file of seed
+    uint8_t     uint8NumQ = 0;                      // number of queues
+    uint8_t     uint8NumSeed = 0;                   // number of seeds
+    uint32_t    uint32CbLen = 0;                    // management table entries
+    uint8_t     uint8CbID;                          // assigned queue id
+    uint32_t    uint32Magic;
+    uint32_t    uint32ElemSize;
+    uint32_t    uint32NumElems;
+    char*       charPtrImg = NULL;                  // image file
+    char*       charPtrCkpt = NULL;                 // checkpoint file
+    char*       charPtrEnd;
+    uint8_t*    uint8PtrPl;                         // seed payload
+    FILE*       fp;
+    int         ret;
+
+
+    /* parse arguments */
+    for ( int i = 1; i < argc; i++ ) {
+        if ( (0 == strcmp(argv[i], "-q")) && (i+1 < argc) ) {
+            if ( !(uint8NumQ < SFCB_IMAGE_MAX_Q) ) {
+                printf("ERROR:%s: more than %d queues\n", __FUNCTION__, SFCB_IMAGE_MAX_Q);
+                return EXIT_FAILURE;
+            }
+            charPtrQ[uint8NumQ++] = argv[++i];
+        } else if ( (0 == strcmp(argv[i], "-s")) && (i+1 < argc) ) {
+            if ( !(uint8NumSeed < SFCB_IMAGE_MAX_SEED) ) {
+                printf("ERROR:%s: more than %d seeds\n", __FUNCTION__, SFCB_IMAGE_MAX_SEED);
+                return EXIT_FAILURE;
+            }
+            i++;
+            uint8SeedQ[uint8NumSeed] = (uint8_t) strtoul(argv[i], &charPtrEnd, 0);
+            if ( ':' != *charPtrEnd ) {
+                print_usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            charPtrSeed[uint8NumSeed++] = charPtrEnd+1;
+        } else if ( (0 == strcmp(argv[i], "-n")) && (i+1 < argc) ) {
+            uint32CbLen = (uint32_t) strtoul(argv[++i], NULL, 0);
+        } else if ( (0 == strcmp(argv[i], "-o")) && (i+1 < argc) ) {
+            charPtrImg = argv[++i];
+        } else if ( (0 == strcmp(argv[i], "-c")) && (i+1 < argc) ) {
+            charPtrCkpt = argv[++i];
+        } else {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if ( 0 == uint32CbLen ) {
+        uint32CbLen = uint8NumQ;
+    }
+    if ( (0 == uint8NumQ) || (NULL == charPtrImg) || (uint32CbLen < uint8NumQ) || (uint32CbLen > SFCB_IMAGE_MAX_Q) ) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    /* init */
+    if ( 0 != sfm_init(&flash, (char*) SFCB_FLASH_NAME) ) {
+        printf("ERROR:%s:sfm_init\n", __FUNCTION__);
+        return EXIT_FAILURE;
+    }
+    if ( SFCB_OK != sfcb_init(&sfcb, sfcb_cb, (uint8_t) uint32CbLen, g_uint8Spi, sizeof(g_uint8Spi)) ) {
+        printf("ERROR:%s: no flash type selected, use -D<FLASHTYP>\n", __FUNCTION__);
+        return EXIT_FAILURE;
+    }
+    /* create queues */
+    for ( uint8_t q = 0; q < uint8NumQ; q++ ) {
+        uint32Magic = (uint32_t) strtoul(charPtrQ[q], &charPtrEnd, 0);
+        if ( ':' != *charPtrEnd ) {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        uint32ElemSize = (uint32_t) strtoul(charPtrEnd+1, &charPtrEnd, 0);
+        if ( ':' != *charPtrEnd ) {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        uint32NumElems = (uint32_t) strtoul(charPtrEnd+1, &charPtrEnd, 0);
+        if ( (uint32ElemSize > UINT16_MAX) || (uint32NumElems > UINT16_MAX) ) {
+            printf("ERROR:%s: '%s' exceeds 16bit range\n", __FUNCTION__, charPtrQ[q]);
+            return EXIT_FAILURE;
+        }
+        ret = sfcb_new_cb(&sfcb, uint32Magic, (uint16_t) uint32ElemSize, (uint16_t) uint32NumElems, &uint8CbID);
+        if ( SFCB_OK != ret ) {
+            printf("ERROR:%s: queue %d '%s', sfcb_new_cb ret=%d\n", __FUNCTION__, q, charPtrQ[q], ret);
+            return EXIT_FAILURE;
+        }
+    }
+    /* blank device, allocate first slot */
+    if ( (SFCB_OK != sfcb_mkcb(&sfcb)) || (0 != sfcb_image_run(&sfcb, &flash)) ) {
+        printf("ERROR:%s: sfcb_mkcb\n", __FUNCTION__);
+        return EXIT_FAILURE;
+    }
+    /* pre-seeded elements */
+    for ( uint8_t s = 0; s < uint8NumSeed; s++ ) {
+        if ( !(uint8SeedQ[s] < uint8NumQ) ) {
+            printf("ERROR:%s: seed '%s' for unknown queue %d\n", __FUNCTION__, charPtrSeed[s], uint8SeedQ[s]);
+            return EXIT_FAILURE;
+        }
+        uint8PtrPl = calloc(sfcb_cb[uint8SeedQ[s]].uint16PlSize, 1);
+        fp = fopen(charPtrSeed[s], "rb");
+        if ( (NULL == uint8PtrPl) || (NULL == fp) ) {
+            printf("ERROR:%s: open '%s'\n", __FUNCTION__, charPtrSeed[s]);
+            return EXIT_FAILURE;
+        }
+        if ( 0 == fread(uint8PtrPl, 1, sfcb_cb[uint8SeedQ[s]].uint16PlSize, fp) ) {
+            printf("WARN:%s: '%s' is empty\n", __FUNCTION__, charPtrSeed[s]);
+        }
+        fclose(fp);
+        if (    (SFCB_OK != sfcb_add(&sfcb, uint8SeedQ[s], uint8PtrPl, sfcb_cb[uint8SeedQ[s]].uint16PlSize))
+             || (0 != sfcb_image_run(&sfcb, &flash))
+             || (SFCB_OK != sfcb_mkcb(&sfcb))
+             || (0 != sfcb_image_run(&sfcb, &flash))
+        ) {
+            printf("ERROR:%s: seed '%s' of queue %d\n", __FUNCTION__, charPtrSeed[s], uint8SeedQ[s]);
+            return EXIT_FAILURE;
+        }
+        free(uint8PtrPl);
+    }
+
+    /* image */
+    fp = fopen(charPtrImg, "wb");
+    if ( (NULL == fp) || (flash.uint32Size != fwrite(flash.uint8PtrMem, 1, flash.uint32Size, fp)) ) {
+        printf("ERROR:%s: write '%s'\n", __FUNCTION__, charPtrImg);
+        return EXIT_FAILURE;
+    }
+    fclose(fp);
+    /* checkpoint */
+    if ( (NULL != charPtrCkpt) && (0 != sfcb_image_checkpoint(charPtrCkpt, sfcb_cb, (uint8_t) uint32CbLen)) ) {
+        return EXIT_FAILURE;
+    }
+
+    /* report */
+    printf("Flash '%s': image '%s', %u byte\n", SFCB_FLASH_NAME, charPtrImg, flash.uint32Size);
+    for ( uint8_t q = 0; q < uint8NumQ; q++ ) {
+        printf("  queue %d: magic=0x%08x, elements=%d, next write=0x%x\n", q, sfcb_cb[q].uint32MagicNum, sfcb_cb[q].uint16NumEntries, sfcb_cb[q].uint32StartPageWrite);
+    }
+    if ( NULL != charPtrCkpt ) {
+        printf("  checkpoint               : '%s', %u entries, gen=%u\n", charPtrCkpt, uint32CbLen, sfcb_cb[0].uint32Gen);
+    }
+    free(flash.uint8PtrMem);
+
+    return EXIT_SUCCESS;
+}
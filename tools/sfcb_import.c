@@ -0,0 +1,279 @@
+/***********************************************************************
+ @copyright     : Siemens AG
+ @license       : BSDv3
+ @author        : Andreas Kaeberlein
+ @address       : Clemens-Winkler-Strasse 3, 09116 Chemnitz
+
+ @maintainer    : Andreas Kaeberlein
+ @telephone     : +49 371 4810-2108
+ @email         : andreas.kaeberlein@siemens.com
+
+ @file          : sfcb_import.c
+ @date          : October 18, 2026
+ @see           : https://github.com/andkae/SPI-Flash-Circular-Buffer
+
+ @brief         : Export container importer
+                  Host tool, checks a container written by sfcb_export
+                  and restores the queue elements
+***********************************************************************/
+
+
+
+/** Standard libs **/
+#include <stdio.h>          // f.e. printf
+#include <stdlib.h>         // exit, malloc
+#include <stdint.h>         // defines fixed data types, like int8_t...
+#include <string.h>         // string handling functions
+
+/** User Libs **/
+#include "spi_flash_cb.h"   // container format, SFCB_EXP
+
+
+
+/**
+ *  @brief usage
+ *
+ *  prints command line help
+ *
+ *  @param[in]      *name           program name
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void print_usage (char *name)
+{
+    printf("Usage: %s [-o elems.bin] container.bin\n", name);
+    printf("  -o    write elements as fixed size records, payload padded with 0xFF\n");
+    printf("  without -o every element is listed as 'id len payload-hex'\n");
+}
+
+
+
+/**
+ *  @brief CRC-16
+ *
+ *  CRC-16/CCITT-FALSE, same like the library
+ *
+ *  @param[in]      crc             start value, 0xFFFF for new CRC
+ *  @param[in]      *data           data
+ *  @param[in]      len             number of bytes
+ *  @return         uint16_t        CRC
+ *  @since          October 18, 2026
+ */
+static uint16_t sfcb_import_crc16 (uint16_t crc, const uint8_t *data, size_t len)
+{
+    for ( size_t i = 0; i < len; i++ ) {
+        crc = (uint16_t) (crc ^ ((uint16_t) data[i] << 8));
+        for ( uint8_t j = 0; j < 8; j++ ) {
+            crc = (uint16_t) ((0 != (crc & 0x8000)) ? ((crc << 1) ^ 0x1021) : (crc << 1));
+        }
+    }
+    return crc;
+}
+
+
+
+/**
+ *  @brief varint
+ *
+ *  decodes unsigned LEB128 number
+ *
+ *  @param[in]      *buf            container
+ *  @param[in]      len             container size
+ *  @param[in,out]  *pos            read position, behind number on success
+ *  @param[out]     *val            number
+ *  @return         int             state
+ *  @retval         0               decoded
+ *  @retval         -1              truncated or oversized number
+ *  @since          October 18, 2026
+ */
+static int sfcb_import_varint (const uint8_t *buf, size_t len, size_t *pos, uint32_t *val)
+{
+    *val = 0;
+    for ( uint8_t i = 0; i < 5; i++ ) {
+        if ( !(*pos < len) ) {
+            return -1;
+        }
+        *val |= (uint32_t) (buf[*pos] & 0x7F) << (7*i);
+        if ( 0 == (buf[(*pos)++] & 0x80) ) {
+            return 0;
+        }
+    }
+    return -1;
+}
+
+
+
+/**
+ *  @brief CRC check
+ *
+ *  compares little endian CRC at _pos_ with calculated one
+ *
+ *  @param[in]      *buf            container
+ *  @param[in]      len             container size
+ *  @param[in,out]  *pos            CRC position, behind CRC on success
+ *  @param[in]      crc             expected CRC
+ *  @return         int             state
+ *  @retval         0               match
+ *  @retval         -1              truncated or mismatch
+ *  @since          October 18, 2026
+ */
+static int sfcb_import_crc_chk (const uint8_t *buf, size_t len, size_t *pos, uint16_t crc)
+{
+    if ( !(*pos + 2 <= len) || (crc != (uint16_t) (buf[*pos] | (buf[*pos+1] << 8))) ) {
+        return -1;
+    }
+    *pos += 2;
+    return 0;
+}
+
+
+
+/**
+ *  Main
+ *  ----
+ */
+int main (int argc, char *argv[])
+{
+    /** Variables **/
+    FILE        *fp;
+    FILE        *fpOut = NULL;          // element records
+    char        *charPtrIn = NULL;      // container
+    char        *charPtrOut = NULL;
+    uint8_t     *uint8PtrBuf;           // container content
+    uint8_t     *uint8PtrRec;           // padded element record
+    size_t      len;                    // container size
+    size_t      pos;                    // parse position
+    size_t      start;                  // element start
+    uint32_t    uint32Magic;            // queue magic
+    uint16_t    uint16PlSize;           // queue payload size
+    uint32_t    uint32ID = 0;           // element ID
+    uint32_t    uint32Cnt = 0;          // elements
+    uint32_t    uint32Delta;
+    uint32_t    uint32Len;
+    uint32_t    uint32Val;
+    int         ret = EXIT_FAILURE;
+
+
+    /* parse arguments */
+    for ( int i = 1; i < argc; i++ ) {
+        if ( (0 == strcmp(argv[i], "-o")) && (i+1 < argc) ) {
+            charPtrOut = argv[++i];
+        } else if ( '-' != argv[i][0] ) {
+            charPtrIn = argv[i];
+        } else {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if ( NULL == charPtrIn ) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    /* load container */
+    fp = fopen(charPtrIn, "rb");
+    if ( NULL == fp ) {
+        printf("ERROR:%s: open '%s'\n", __FUNCTION__, charPtrIn);
+        return EXIT_FAILURE;
+    }
+    fseek(fp, 0, SEEK_END);
+    len = (size_t) ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    uint8PtrBuf = malloc(len + 1);
+    if ( (NULL == uint8PtrBuf) || (len != fread(uint8PtrBuf, 1, len, fp)) ) {
+        printf("ERROR:%s: read '%s'\n", __FUNCTION__, charPtrIn);
+        fclose(fp);
+        free(uint8PtrBuf);
+        return EXIT_FAILURE;
+    }
+    fclose(fp);
+    /* header */
+    pos = SFCB_EXP_HEAD_LEN - 2;
+    if ( (len < SFCB_EXP_HEAD_LEN) || (0 != memcmp(uint8PtrBuf, SFCB_EXP_MAGIC, 4)) || (SFCB_EXP_VER != uint8PtrBuf[4]) ) {
+        printf("ERROR:%s: no container version %d\n", __FUNCTION__, SFCB_EXP_VER);
+        free(uint8PtrBuf);
+        return EXIT_FAILURE;
+    }
+    if ( 0 != sfcb_import_crc_chk(uint8PtrBuf, len, &pos, sfcb_import_crc16(0xFFFF, uint8PtrBuf, pos)) ) {
+        printf("ERROR:%s: header CRC\n", __FUNCTION__);
+        free(uint8PtrBuf);
+        return EXIT_FAILURE;
+    }
+    uint32Magic = (uint32_t) uint8PtrBuf[5] | ((uint32_t) uint8PtrBuf[6] << 8) | ((uint32_t) uint8PtrBuf[7] << 16) | ((uint32_t) uint8PtrBuf[8] << 24);
+    uint16PlSize = (uint16_t) (uint8PtrBuf[9] | (uint8PtrBuf[10] << 8));
+    uint8PtrRec = malloc((size_t) uint16PlSize + 1);
+    if ( NULL == uint8PtrRec ) {
+        free(uint8PtrBuf);
+        return EXIT_FAILURE;
+    }
+    if ( NULL != charPtrOut ) {
+        fpOut = fopen(charPtrOut, "wb");
+        if ( NULL == fpOut ) {
+            printf("ERROR:%s: open '%s'\n", __FUNCTION__, charPtrOut);
+            goto END;
+        }
+    }
+    /* elements until trailer */
+    while ( 1 ) {
+        start = pos;
+        if ( 0 != sfcb_import_varint(uint8PtrBuf, len, &pos, &uint32Delta) ) {
+            printf("ERROR:%s: truncated at offset %zu\n", __FUNCTION__, start);
+            goto END;
+        }
+        if ( 0 == uint32Delta ) {
+            break;  // trailer
+        }
+        if ( (0 != sfcb_import_varint(uint8PtrBuf, len, &pos, &uint32Len)) || (uint32Len > uint16PlSize) || (pos + uint32Len > len) ) {
+            printf("ERROR:%s: element length at offset %zu\n", __FUNCTION__, start);
+            goto END;
+        }
+        pos += uint32Len;
+        if ( 0 != sfcb_import_crc_chk(uint8PtrBuf, len, &pos, sfcb_import_crc16(0xFFFF, uint8PtrBuf+start, pos-start)) ) {
+            printf("ERROR:%s: element CRC at offset %zu\n", __FUNCTION__, start);
+            goto END;
+        }
+        uint32ID += uint32Delta;
+        uint32Cnt++;
+        /* restore element */
+        memset(uint8PtrRec, 0xFF, uint16PlSize);
+        memcpy(uint8PtrRec, uint8PtrBuf+pos-2-uint32Len, uint32Len);
+        if ( NULL != fpOut ) {
+            if ( uint16PlSize != fwrite(uint8PtrRec, 1, uint16PlSize, fpOut) ) {
+                printf("ERROR:%s: write '%s'\n", __FUNCTION__, charPtrOut);
+                goto END;
+            }
+        } else {
+            printf("%u %u ", uint32ID, uint32Len);
+            for ( uint32_t i = 0; i < uint32Len; i++ ) {
+                printf("%02x", uint8PtrRec[i]);
+            }
+            printf("\n");
+        }
+    }
+    /* trailer */
+    if ( 0 != sfcb_import_varint(uint8PtrBuf, len, &pos, &uint32Val) || (uint32Val != uint32Cnt) ) {
+        printf("ERROR:%s: trailer element count\n", __FUNCTION__);
+        goto END;
+    }
+    if ( 0 != sfcb_import_varint(uint8PtrBuf, len, &pos, &uint32Val) || (uint32Val != uint32ID) ) {
+        printf("ERROR:%s: trailer last id\n", __FUNCTION__);
+        goto END;
+    }
+    if ( 0 != sfcb_import_crc_chk(uint8PtrBuf, len, &pos, sfcb_import_crc16(0xFFFF, uint8PtrBuf, pos)) ) {
+        printf("ERROR:%s: container CRC\n", __FUNCTION__);
+        goto END;
+    }
+    if ( pos != len ) {
+        printf("ERROR:%s: %zu byte behind trailer\n", __FUNCTION__, len - pos);
+        goto END;
+    }
+    fprintf((NULL != fpOut) ? stdout : stderr, "Container '%s': magic=0x%08x, payload=%d byte, elements=%u, last id=%u, %zu byte\n", charPtrIn, uint32Magic, uint16PlSize, uint32Cnt, uint32ID, len);
+    ret = EXIT_SUCCESS;
+
+END:
+    if ( NULL != fpOut ) {
+        fclose(fpOut);
+    }
+    free(uint8PtrRec);
+    free(uint8PtrBuf);
+    return ret;
+}
@@ -0,0 +1,235 @@
+/***********************************************************************
+ @copyright     : Siemens AG
+ @license       : BSDv3
+ @author        : Andreas Kaeberlein
+ @address       : Clemens-Winkler-Strasse 3, 09116 Chemnitz
+
+ @maintainer    : Andreas Kaeberlein
+ @telephone     : +49 371 4810-2108
+ @email         : andreas.kaeberlein@siemens.com
+
+ @file          : sfcb_plan.c
+ @date          : October 18, 2026
+ @see           : https://github.com/andkae/SPI-Flash-Circular-Buffer
+
+ @brief         : Layout planner
+                  Host tool, reports for a set of queue specifications
+                  the real flash layout, write amplification and lifetime
+***********************************************************************/
+
+
+
+/** Standard libs **/
+#include <stdio.h>          // f.e. printf
+#include <stdlib.h>         // strtoul, exit
+#include <stdint.h>         // defines fixed data types, like int8_t...
+#include <string.h>         // string handling functions
+
+/** User Libs **/
+#include "sfcb_flash_types.h"   // flash topology
+#include "spi_flash_cb.h"       // layout is calculated by the library itself
+
+
+
+/** Defines **/
+#define SFCB_PLAN_MAX_Q         (16)        /**< maximum number of queues */
+#define SFCB_PLAN_ENDURANCE     (100000)    /**< default sector erase cycles, W25Q16JV_Rev_H: p.64, Erase/Program Cycles */
+#define SFCB_PLAN_HEADFOOT      (2*sizeof(spi_flash_cb_elem_head))  /**< element overhead */
+
+
+
+/** Globals **/
+uint8_t g_uint8Spi[SFCB_FLASH_TOPO_PAGE_SIZE + SFCB_FLASH_TOPO_ADR_BYTE + 1];   // SPI packet buffer, not used for planning
+
+
+
+/**
+ *  @brief usage
+ *
+ *  prints command line help
+ *
+ *  @param[in]      *name           program name
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void print_usage (char *name)
+{
+    printf("Usage: %s [-e cycles] -q elemSizeByte:numElems:writesPerDay [-q ...]\n", name);
+    printf("  -q    queue specification, same arguments like sfcb_new_cb, writes per day of complete elements\n");
+    printf("  -e    sector endurance in erase cycles, default %d\n", SFCB_PLAN_ENDURANCE);
+    printf("  Flash '%s': size=%d byte, sector=%d byte, page=%d byte\n", SFCB_FLASH_NAME, SFCB_FLASH_TOPO_FLASH_SIZE, SFCB_FLASH_TOPO_SECTOR_SIZE, SFCB_FLASH_TOPO_PAGE_SIZE);
+}
+
+
+
+/**
+ *  @brief sector touching elements
+ *
+ *  determines the maximum number of queue elements which are lost
+ *  by one sector erase, elements can overlap sector boundaries
+ *
+ *  @param[in]      *cb             queue management entry, #t_sfcb_cb
+ *  @return         uint32_t        maximum number of elements in one sector
+ *  @since          October 18, 2026
+ */
+static uint32_t sfcb_plan_elems_per_erase (t_sfcb_cb *cb)
+{
+    /** Variables **/
+    const uint32_t  uint32Slot = cb->uint32SlotSize;
+    uint32_t        uint32Max = 0;
+    uint32_t        uint32Cnt;
+    uint32_t        uint32SecStart;
+
+    /* check every sector of the queue */
+    for ( uint32_t sec = 0; sec <= (cb->uint32StopSector - cb->uint32StartSector); sec++ ) {
+        uint32SecStart = sec * SFCB_FLASH_TOPO_SECTOR_SIZE;
+        uint32Cnt = 0;
+        for ( uint32_t elem = 0; elem < cb->uint16NumEntriesMax; elem++ ) {
+            if ( ((elem * uint32Slot) < (uint32SecStart + SFCB_FLASH_TOPO_SECTOR_SIZE)) && (((elem+1) * uint32Slot) > uint32SecStart) ) {
+                uint32Cnt++;
+            }
+        }
+        if ( uint32Cnt > uint32Max ) {
+            uint32Max = uint32Cnt;
+        }
+    }
+    return uint32Max;
+}
+
+
+
+/**
+ *  @brief element size suggestions
+ *
+ *  prints payload sizes which use the trailing page completely,
+ *  and sizes which do not overlap sector boundaries
+ *
+ *  @param[in]      *cb             queue management entry, #t_sfcb_cb
+ *  @return         void
+ *  @since          October 18, 2026
+ */
+static void sfcb_plan_suggest (t_sfcb_cb *cb)
+{
+    /** Variables **/
+    const uint32_t  uint32PagesPerSector = SFCB_FLASH_TOPO_SECTOR_SIZE / SFCB_FLASH_TOPO_PAGE_SIZE;
+    uint32_t        uint32LastFill;     // used bytes in trailing page
+
+    /* trailing page */
+    uint32LastFill = (uint32_t) (cb->uint16PlSize + SFCB_PLAN_HEADFOOT) - (uint32_t) (cb->uint16NumPagesPerElem - 1) * SFCB_FLASH_TOPO_PAGE_SIZE;
+    printf("    trailing page use      : %u of %d byte\n", uint32LastFill, SFCB_FLASH_TOPO_PAGE_SIZE);
+    printf("    suggest elemSizeByte   : %u (same slot, full trailing page)\n", (uint32_t) cb->uint16NumPagesPerElem * SFCB_FLASH_TOPO_PAGE_SIZE - (uint32_t) SFCB_PLAN_HEADFOOT);
+    if ( (cb->uint16NumPagesPerElem > 1) && (2*uint32LastFill < SFCB_FLASH_TOPO_PAGE_SIZE) ) {
+        printf("    suggest elemSizeByte   : %u (one page less per slot, no partial trailing page)\n", (uint32_t) (cb->uint16NumPagesPerElem - 1) * SFCB_FLASH_TOPO_PAGE_SIZE - (uint32_t) SFCB_PLAN_HEADFOOT);
+    }
+    /* slot sizes without sector overlap */
+    if ( 0 != (uint32PagesPerSector % cb->uint16NumPagesPerElem) ) {
+        for ( uint32_t pages = cb->uint16NumPagesPerElem; pages <= uint32PagesPerSector; pages++ ) {
+            if ( 0 == (uint32PagesPerSector % pages) ) {
+                printf("    suggest elemSizeByte   : %u (no sector overlap)\n", pages * SFCB_FLASH_TOPO_PAGE_SIZE - (uint32_t) SFCB_PLAN_HEADFOOT);
+                break;
+            }
+        }
+    }
+}
+
+
+
+/**
+ *  Main
+ *  ----
+ */
+int main (int argc, char *argv[])
+{
+    /** Variables **/
+    t_sfcb      sfcb;                           // SPI Flash as circular buffer
+    t_sfcb_cb   sfcb_cb[SFCB_PLAN_MAX_Q];       // queue management
+    uint32_t    uint32WrPerDay[SFCB_PLAN_MAX_Q];// element writes per day
+    uint32_t    uint32Endurance = SFCB_PLAN_ENDURANCE;
+    uint8_t     uint8NumQ = 0;                  // number of queues
+    uint8_t     uint8CbID;                      // assigned queue id
+    uint32_t    uint32ElemSize;
+    uint32_t    uint32NumElems;
+    uint32_t    uint32Slot;
+    uint32_t    uint32Lost;
+    uint32_t    uint32Used = 0;
+    double      dblErasePerDay;
+    char*       charPtrEnd;
+    int         ret;
+
+
+    /* init */
+    if ( SFCB_OK != sfcb_init(&sfcb, sfcb_cb, SFCB_PLAN_MAX_Q, g_uint8Spi, sizeof(g_uint8Spi)) ) {
+        printf("ERROR:%s: no flash type selected, use -D<FLASHTYP>\n", __FUNCTION__);
+        return EXIT_FAILURE;
+    }
+    /* parse arguments and create queues */
+    for ( int i = 1; i < argc; i++ ) {
+        if ( (0 == strcmp(argv[i], "-e")) && (i+1 < argc) ) {
+            uint32Endurance = (uint32_t) strtoul(argv[++i], NULL, 0);
+        } else if ( (0 == strcmp(argv[i], "-q")) && (i+1 < argc) ) {
+            if ( !(uint8NumQ < SFCB_PLAN_MAX_Q) ) {
+                printf("ERROR:%s: more than %d queues\n", __FUNCTION__, SFCB_PLAN_MAX_Q);
+                return EXIT_FAILURE;
+            }
+            i++;
+            uint32ElemSize = (uint32_t) strtoul(argv[i], &charPtrEnd, 0);
+            if ( ':' != *charPtrEnd ) {
+                print_usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            uint32NumElems = (uint32_t) strtoul(charPtrEnd+1, &charPtrEnd, 0);
+            uint32WrPerDay[uint8NumQ] = 0;
+            if ( ':' == *charPtrEnd ) {
+                uint32WrPerDay[uint8NumQ] = (uint32_t) strtoul(charPtrEnd+1, &charPtrEnd, 0);
+            }
+            if ( (0 == uint32ElemSize) || (0 == uint32NumElems) ) {
+                printf("ERROR:%s: '%s' needs non-zero elemSizeByte and numElems\n", __FUNCTION__, argv[i]);
+                return EXIT_FAILURE;
+            }
+            if ( (uint32ElemSize > UINT16_MAX) || (uint32NumElems > UINT16_MAX) ) {
+                printf("ERROR:%s: '%s' exceeds 16bit range\n", __FUNCTION__, argv[i]);
+                return EXIT_FAILURE;
+            }
+                // int sfcb_new_cb (t_sfcb *self, uint32_t magicNum, uint16_t elemSizeByte, uint16_t numElems, uint8_t *cbID)
+            ret = sfcb_new_cb(&sfcb, 0x5fcb0000 + uint8NumQ, (uint16_t) uint32ElemSize, (uint16_t) uint32NumElems, &uint8CbID);
+            if ( SFCB_E_FLASH_FULL == ret ) {
+                printf("ERROR:%s: queue %d '%s' exceeds flash size of %d byte\n", __FUNCTION__, uint8CbID, argv[i], SFCB_FLASH_TOPO_FLASH_SIZE);
+                return EXIT_FAILURE;
+            } else if ( SFCB_OK != ret ) {
+                printf("ERROR:%s: sfcb_new_cb ret=%d\n", __FUNCTION__, ret);
+                return EXIT_FAILURE;
+            }
+            uint8NumQ++;
+        } else {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if ( 0 == uint8NumQ ) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    /* report */
+    printf("Flash '%s': size=%d byte, sector=%d byte, page=%d byte, endurance=%u cycles\n", SFCB_FLASH_NAME, SFCB_FLASH_TOPO_FLASH_SIZE, SFCB_FLASH_TOPO_SECTOR_SIZE, SFCB_FLASH_TOPO_PAGE_SIZE, uint32Endurance);
+    for ( uint8_t q = 0; q < uint8NumQ; q++ ) {
+        uint32Slot = sfcb_cb[q].uint32SlotSize;
+        uint32Lost = sfcb_plan_elems_per_erase(&sfcb_cb[q]);
+        uint32Used += (sfcb_cb[q].uint32StopSector - sfcb_cb[q].uint32StartSector + 1) * SFCB_FLASH_TOPO_SECTOR_SIZE;
+        printf("  queue %d: elemSizeByte=%d\n", q, sfcb_cb[q].uint16PlSize);
+        printf("    sectors                : %u..%u (%u byte)\n", sfcb_cb[q].uint32StartSector, sfcb_cb[q].uint32StopSector, (sfcb_cb[q].uint32StopSector - sfcb_cb[q].uint32StartSector + 1) * SFCB_FLASH_TOPO_SECTOR_SIZE);
+        printf("    element slot           : %u byte (%d pages)\n", uint32Slot, sfcb_cb[q].uint16NumPagesPerElem);
+        printf("    elements max           : %d\n", sfcb_cb[q].uint16NumEntriesMax);
+        printf("    elements retained min  : %u (sector erase removes up to %u)\n", (uint32Lost < sfcb_cb[q].uint16NumEntriesMax) ? (sfcb_cb[q].uint16NumEntriesMax - uint32Lost) : 0, uint32Lost);
+        printf("    flash/payload byte     : %.3f\n", (double) uint32Slot / sfcb_cb[q].uint16PlSize);
+        if ( 0 != uint32WrPerDay[q] ) {
+            dblErasePerDay = (double) uint32WrPerDay[q] / sfcb_cb[q].uint16NumEntriesMax;  // every sector is erased once per ring cycle
+            printf("    erases/day/sector      : %.3f\n", dblErasePerDay);
+            printf("    years to endurance     : %.1f\n", (double) uint32Endurance / dblErasePerDay / 365.25);
+        }
+        sfcb_plan_suggest(&sfcb_cb[q]);
+    }
+    printf("  flash used               : %u of %d byte\n", uint32Used, SFCB_FLASH_TOPO_FLASH_SIZE);
+
+    return EXIT_SUCCESS;
+}
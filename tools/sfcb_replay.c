@@ -0,0 +1,142 @@
+/***********************************************************************
+ @copyright     : Siemens AG
+ @license       : BSDv3
+ @author        : Andreas Kaeberlein
+ @address       : Clemens-Winkler-Strasse 3, 09116 Chemnitz
+
+ @maintainer    : Andreas Kaeberlein
+ @telephone     : +49 371 4810-2108
+ @email         : andreas.kaeberlein@siemens.com
+
+ @file          : sfcb_replay.c
+ @date          : October 18, 2026
+ @see           : https://github.com/andkae/SPI-Flash-Circular-Buffer
+
+ @brief         : Trace replay
+                  Host tool, drives the SPI flash model with a
+                  recorded SPI transaction trace at full speed
+***********************************************************************/
+
+
+
+/** Standard libs **/
+#include <stdio.h>          // f.e. printf
+#include <stdlib.h>         // exit
+#include <stdint.h>         // defines fixed data types, like int8_t...
+#include <string.h>         // string handling functions
+#include <time.h>           // clock_gettime
+
+/** User Libs **/
+#include "sfcb_flash_types.h"                       // flash name
+#include "test/spi_flash_model/spi_flash_model.h"   // spi flash model
+#include "tools/sfcb_trace.h"                       // trace reader
+
+
+
+/** Globals **/
+uint8_t g_uint8Spi[UINT16_MAX];    // SPI packet buffer, largest possible packet
+uint8_t g_uint8Miso[UINT16_MAX];   // recorded response
+
+
+
+/**
+ *  @brief monotonic time
+ *
+ *  @return         uint64_t        wall clock time in ns
+ *  @since          October 18, 2026
+ */
+static uint64_t sfcb_replay_ns (void)
+{
+    /** Variables **/
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + (uint64_t) ts.tv_nsec;
+}
+
+
+
+/**
+ *  Main
+ *  ----
+ */
+int main (int argc, char *argv[])
+{
+    /** Variables **/
+    t_sfm           spiFlash;           // SPI flash model
+    t_sfcb_trace    trace;              // recorded trace
+    uint8_t         uint8Dir;           // record direction
+    uint16_t        uint16Len;          // record length
+    uint16_t        uint16LenMosi = 0;  // length of last replayed packet
+    uint64_t        uint64Ns;           // recorded CPU time of record
+    uint64_t        uint64NsRec = 0;    // recorded CPU time, total
+    uint64_t        uint64NsPlay = 0;   // replay time in flash model
+    uint64_t        uint64Start;        // start of transfer
+    uint32_t        uint32Pkt = 0;      // replayed packets
+    uint32_t        uint32Bytes = 0;    // replayed bytes
+    uint32_t        uint32Miss = 0;     // response mismatches
+    int             state;              // read state
+
+    /* check args */
+    if ( 2 != argc ) {
+        printf("Usage: %s trace\n", argv[0]);
+        printf("  replays the MOSI packets of trace into the flash model '%s' and compares the responses\n", SFCB_FLASH_NAME);
+        exit(EXIT_FAILURE);
+    }
+    /* init */
+    if ( 0 != sfm_init(&spiFlash, (char*) SFCB_FLASH_NAME) ) {
+        printf("ERROR:%s:sfm_init\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+    }
+    if ( 0 != sfcb_trace_open(&trace, argv[1], 0) ) {
+        printf("ERROR:%s: no trace '%s'\n", __FUNCTION__, argv[1]);
+        exit(EXIT_FAILURE);
+    }
+    /* replay */
+    while ( 1 ) {
+        state = sfcb_trace_read(&trace, &uint8Dir, g_uint8Miso, sizeof(g_uint8Miso), &uint16Len, &uint64Ns);
+        if ( 1 == state ) {
+            break;  // end of trace
+        }
+        if ( 0 != state ) {
+            printf("ERROR:%s: corrupted trace at record %u\n", __FUNCTION__, trace.uint32NumRec);
+            exit(EXIT_FAILURE);
+        }
+        uint64NsRec += uint64Ns;
+        /* request, drive flash model */
+        if ( SFCB_TRACE_MOSI == uint8Dir ) {
+            memcpy(g_uint8Spi, g_uint8Miso, uint16Len);
+            uint64Start = sfcb_replay_ns();
+            if ( 0 != sfm(&spiFlash, g_uint8Spi, uint16Len) ) {
+                printf("ERROR:%s: flash model rejects packet %u\n", __FUNCTION__, uint32Pkt);
+                exit(EXIT_FAILURE);
+            }
+            uint64NsPlay += sfcb_replay_ns() - uint64Start;
+            uint16LenMosi = uint16Len;
+            uint32Pkt++;
+            uint32Bytes += uint16Len;
+        /* response, compare */
+        } else {
+            if ( (uint16Len != uint16LenMosi) || (0 != memcmp(g_uint8Spi, g_uint8Miso, uint16Len)) ) {
+                printf("WARNING:%s: response mismatch packet %u\n", __FUNCTION__, uint32Pkt - 1);
+                uint32Miss++;
+            }
+        }
+    }
+    sfcb_trace_close(&trace);
+    /* summary */
+    printf("Trace '%s' on flash model '%s'\n", argv[1], SFCB_FLASH_NAME);
+    printf("  records                : %u\n", trace.uint32NumRec);
+    printf("  packets                : %u\n", uint32Pkt);
+    printf("  bytes                  : %u\n", uint32Bytes);
+    printf("  recorded CPU time      : %.3f ms\n", (double) uint64NsRec / 1e6);
+    printf("  replay time            : %.3f ms\n", (double) uint64NsPlay / 1e6);
+    if ( 0 != uint64NsPlay ) {
+        printf("  replay rate            : %.0f packets/s, %.1f MiB/s\n", (double) uint32Pkt * 1e9 / (double) uint64NsPlay, (double) uint32Bytes * 1e9 / (double) uint64NsPlay / 1048576.0);
+    }
+    printf("  response mismatches    : %u\n", uint32Miss);
+    if ( 0 != uint32Miss ) {
+        exit(EXIT_FAILURE);
+    }
+    exit(EXIT_SUCCESS);
+}
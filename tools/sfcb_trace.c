@@ -0,0 +1,191 @@
+/***********************************************************************
+ @copyright     : Siemens AG
+ @license       : BSDv3
+ @author        : Andreas Kaeberlein
+ @address       : Clemens-Winkler-Strasse 3, 09116 Chemnitz
+
+ @maintainer    : Andreas Kaeberlein
+ @telephone     : +49 371 4810-2108
+ @email         : andreas.kaeberlein@siemens.com
+
+ @file          : sfcb_trace.c
+ @date          : October 18, 2026
+ @see           : https://github.com/andkae/SPI-Flash-Circular-Buffer
+
+ @brief         : SPI transaction trace
+                  Host side recorder/reader of the SPI packets
+                  exchanged between sfcb_worker and the transport
+***********************************************************************/
+
+
+
+/** Standard libs **/
+#include <stdio.h>      // file handling
+#include <stdint.h>     // fixed data types
+#include <string.h>     // memcmp
+#include <time.h>       // clock_gettime
+
+/** Self **/
+#include "sfcb_trace.h"
+
+
+
+/** Defines **/
+#define SFCB_TRACE_MAGIC    "SFCBTRC"   /**< file magic */
+#define SFCB_TRACE_VERSION  (1)         /**< file format version */
+
+
+
+/**
+ *  @brief CPU time
+ *
+ *  process CPU time
+ *
+ *  @return         uint64_t        CPU time in ns
+ *  @since          October 18, 2026
+ */
+static uint64_t sfcb_trace_ns (void)
+{
+    /** Variables **/
+    struct timespec ts;
+
+    if ( 0 != clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) ) {
+        return 0;
+    }
+    return (uint64_t) ts.tv_sec * 1000000000ull + (uint64_t) ts.tv_nsec;
+}
+
+
+
+/**
+ *  sfcb_trace_open
+ *    opens trace file
+ */
+int sfcb_trace_open (t_sfcb_trace *self, const char *path, uint8_t wr)
+{
+    /** Variables **/
+    uint8_t uint8Head[sizeof(SFCB_TRACE_MAGIC)];    // magic + version
+
+    self->uint32NumRec = 0;
+    /* record */
+    if ( 0 != wr ) {
+        self->fp = fopen(path, "wb");
+        if ( NULL == self->fp ) {
+            return -1;
+        }
+        memcpy(uint8Head, SFCB_TRACE_MAGIC, sizeof(uint8Head) - 1);
+        uint8Head[sizeof(uint8Head) - 1] = SFCB_TRACE_VERSION;
+        if ( 1 != fwrite(uint8Head, sizeof(uint8Head), 1, self->fp) ) {
+            fclose(self->fp);
+            return -1;
+        }
+        self->uint64NsLast = sfcb_trace_ns();
+        return 0;
+    }
+    /* replay */
+    self->fp = fopen(path, "rb");
+    if ( NULL == self->fp ) {
+        return -1;
+    }
+    if (    (1 != fread(uint8Head, sizeof(uint8Head), 1, self->fp))
+         || (0 != memcmp(uint8Head, SFCB_TRACE_MAGIC, sizeof(uint8Head) - 1))
+         || (SFCB_TRACE_VERSION != uint8Head[sizeof(uint8Head) - 1])
+    ) {
+        fclose(self->fp);
+        return -1;  // no trace
+    }
+    return 0;
+}
+
+
+
+/**
+ *  sfcb_trace_rec
+ *    appends SPI packet to trace
+ */
+int sfcb_trace_rec (t_sfcb_trace *self, uint8_t dir, const uint8_t *spi, uint16_t len)
+{
+    /** Variables **/
+    uint8_t     uint8Rec[3 + 10];   // direction, length, max. LEB128 of 64bit
+    uint8_t     uint8RecLen;        // used bytes in uint8Rec
+    uint64_t    uint64Ns;           // CPU time
+    uint64_t    uint64Delta;        // CPU time since last record
+
+    /* nothing transfered */
+    if ( 0 == len ) {
+        return 0;
+    }
+    /* time since last record */
+    uint64Ns = sfcb_trace_ns();
+    uint64Delta = uint64Ns - self->uint64NsLast;
+    /* assemble record head */
+    uint8Rec[0] = dir;
+    uint8Rec[1] = (uint8_t) (len & 0xFF);
+    uint8Rec[2] = (uint8_t) (len >> 8);
+    uint8RecLen = 3;
+    do {
+        uint8Rec[uint8RecLen] = (uint8_t) (uint64Delta & 0x7F);
+        uint64Delta = uint64Delta >> 7;
+        if ( 0 != uint64Delta ) {
+            uint8Rec[uint8RecLen] |= 0x80;  // more bytes follow
+        }
+        uint8RecLen++;
+    } while ( 0 != uint64Delta );
+    /* write */
+    if ( (1 != fwrite(uint8Rec, uint8RecLen, 1, self->fp)) || (1 != fwrite(spi, len, 1, self->fp)) ) {
+        return -1;
+    }
+    (self->uint32NumRec)++;
+    self->uint64NsLast = sfcb_trace_ns();   // exclude file write
+    return 0;
+}
+
+
+
+/**
+ *  sfcb_trace_read
+ *    gets next record
+ */
+int sfcb_trace_read (t_sfcb_trace *self, uint8_t *dir, uint8_t *spi, uint16_t max, uint16_t *len, uint64_t *ns)
+{
+    /** Variables **/
+    uint8_t     uint8Rec[3];    // direction, length
+    int         intByte;        // LEB128 byte
+    uint8_t     uint8Shift = 0; // LEB128 bit position
+
+    /* record head */
+    if ( 1 != fread(uint8Rec, sizeof(uint8Rec), 1, self->fp) ) {
+        return 1;   // end of trace
+    }
+    *dir = uint8Rec[0];
+    *len = (uint16_t) (uint8Rec[1] | (uint8Rec[2] << 8));
+    *ns = 0;
+    do {
+        intByte = fgetc(self->fp);
+        if ( (EOF == intByte) || (uint8Shift > 63) ) {
+            return -1;
+        }
+        *ns |= (uint64_t) (intByte & 0x7F) << uint8Shift;
+        uint8Shift = (uint8_t) (uint8Shift + 7);
+    } while ( 0 != (intByte & 0x80) );
+    /* packet */
+    if ( (*len > max) || (1 != fread(spi, *len, 1, self->fp)) ) {
+        return -1;
+    }
+    (self->uint32NumRec)++;
+    return 0;
+}
+
+
+
+/**
+ *  sfcb_trace_close
+ *    closes trace file
+ */
+int sfcb_trace_close (t_sfcb_trace *self)
+{
+    if ( 0 != fclose(self->fp) ) {
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,147 @@
+/***********************************************************************
+ @copyright     : Siemens AG
+ @license       : BSDv3
+ @author        : Andreas Kaeberlein
+ @address       : Clemens-Winkler-Strasse 3, 09116 Chemnitz
+
+ @maintainer    : Andreas Kaeberlein
+ @telephone     : +49 371 4810-2108
+ @email         : andreas.kaeberlein@siemens.com
+
+ @file          : sfcb_trace.h
+ @date          : October 18, 2026
+ @see           : https://github.com/andkae/SPI-Flash-Circular-Buffer
+
+ @brief         : SPI transaction trace
+                  Host side recorder/reader of the SPI packets
+                  exchanged between sfcb_worker and the transport
+***********************************************************************/
+
+
+// Define Guard
+#ifndef __SFCB_TRACE_H
+#define __SFCB_TRACE_H
+
+
+/** Standard libs **/
+#include <stdio.h>      // FILE
+#include <stdint.h>     // fixed data types
+
+
+/* C++ compatibility */
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+
+
+/**
+ *  @defgroup SFCB_TRACE_DIR
+ *  packet direction
+ *  @{
+ */
+#define SFCB_TRACE_MOSI     (0)     /**< Packet from #sfcb_worker to flash, recorded before transfer */
+#define SFCB_TRACE_MISO     (1)     /**< Packet from flash to #sfcb_worker, recorded after transfer */
+/** @} */   // SFCB_TRACE_DIR
+
+
+
+/**
+ *  @typedef t_sfcb_trace
+ *
+ *  @brief  trace handle
+ *
+ *  File format: magic "SFCBTRC" + version byte, followed by records.
+ *  Record: direction (1 byte), length (2 byte, little endian),
+ *  CPU time since previous record in ns (unsigned LEB128), packet bytes
+ *
+ *  @since  2026-10-18
+ */
+typedef struct t_sfcb_trace
+{
+    FILE*       fp;             /**< Trace file */
+    uint64_t    uint64NsLast;   /**< CPU time of previous record */
+    uint32_t    uint32NumRec;   /**< Number of processed records */
+} t_sfcb_trace;
+
+
+
+/**
+ *  @brief open
+ *
+ *  opens trace file for record or replay
+ *
+ *  @param[in,out]  self                handle, #t_sfcb_trace
+ *  @param[in]      *path               trace file
+ *  @param[in]      wr                  0: read trace, otherwise record new trace
+ *  @return         int                 state
+ *  @retval         0                   OKAY
+ *  @retval         -1                  File not accessible or no trace
+ *  @since          2026-10-18
+ */
+int sfcb_trace_open (t_sfcb_trace *self, const char *path, uint8_t wr);
+
+
+
+/**
+ *  @brief record
+ *
+ *  appends SPI packet to the trace, call before (#SFCB_TRACE_MOSI)
+ *  and after (#SFCB_TRACE_MISO) the transfer
+ *
+ *  @param[in,out]  self                handle, #t_sfcb_trace
+ *  @param[in]      dir                 packet direction, #SFCB_TRACE_DIR
+ *  @param[in]      *spi                SPI packet
+ *  @param[in]      len                 SPI packet length, zero length packets are not recorded
+ *  @return         int                 state
+ *  @retval         0                   OKAY
+ *  @retval         -1                  File write failed
+ *  @since          2026-10-18
+ */
+int sfcb_trace_rec (t_sfcb_trace *self, uint8_t dir, const uint8_t *spi, uint16_t len);
+
+
+
+/**
+ *  @brief read
+ *
+ *  gets next record from trace
+ *
+ *  @param[in,out]  self                handle, #t_sfcb_trace
+ *  @param[out]     *dir                packet direction, #SFCB_TRACE_DIR
+ *  @param[out]     *spi                SPI packet
+ *  @param[in]      max                 size of *spi in bytes
+ *  @param[out]     *len                SPI packet length
+ *  @param[out]     *ns                 recorded CPU time since previous record
+ *  @return         int                 state
+ *  @retval         0                   OKAY
+ *  @retval         1                   End of trace
+ *  @retval         -1                  Corrupted trace or *spi to small
+ *  @since          2026-10-18
+ */
+int sfcb_trace_read (t_sfcb_trace *self, uint8_t *dir, uint8_t *spi, uint16_t max, uint16_t *len, uint64_t *ns);
+
+
+
+/**
+ *  @brief close
+ *
+ *  closes trace file
+ *
+ *  @param[in,out]  self                handle, #t_sfcb_trace
+ *  @return         int                 state
+ *  @retval         0                   OKAY
+ *  @retval         -1                  Close failed
+ *  @since          2026-10-18
+ */
+int sfcb_trace_close (t_sfcb_trace *self);
+
+
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+
+#endif // __SFCB_TRACE_H